@@ -212,6 +212,10 @@ void dna_adjust::AdjustPhasedMultiThread()
 		if (projectSettings_.g.verbose)
 			debug_file << concurrentAdjustments.print_adjusted_blocks();
 
+		// Buffers freed by the forward, reverse and combine threads were
+		// returned to the system when those threads exited
+		RecycleMatrixBuffers();
+
 		iterationCorrections_.add_message(corr_msg);
 		iterationQueue_.push_and_notify(CurrentIteration());				// currentIteration begins at 1, so not zero-indexed
 
@@ -267,6 +267,14 @@ void dna_adjust::PrepareAdjustment(const project_settings& projectSettings)
 	isFirstTimeAdjustment_ = true;
 	projectSettings_ = projectSettings;
 
+	// Select the BLAS/LAPACK backend for matrix operations
+	try {
+		matrix_backend::select(projectSettings_.a.matrix_backend);
+	}
+	catch (const std::runtime_error& e) {
+		SignalExceptionAdjustment(e.what(), 0);
+	}
+
 	if (projectSettings_.a.stage && 
 		(projectSettings_.a.adjust_mode == SimultaneousMode || 
 			projectSettings_.a.multi_thread))
@@ -466,7 +474,7 @@ void dna_adjust::UpdateBinaryFiles()
 	try {
 		// Write binary stations data.  Throws runtime_error on failure.
 		dna_io_bst bst;
-		bst.write_bst_file(projectSettings_.a.bst_file, &bstBinaryRecords_, bst_meta_);
+		bst.update_bst_file(projectSettings_.a.bst_file, &bstBinaryRecords_, bst_meta_);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionAdjustment(e.what(), 0);
@@ -478,7 +486,7 @@ void dna_adjust::UpdateBinaryFiles()
 	try {
 		// Write binary measurements data.  Throws runtime_error on failure.
 		dna_io_bms bms;
-		bms.write_bms_file(projectSettings_.a.bms_file, &bmsBinaryRecords_, bms_meta_);
+		bms.update_bms_file(projectSettings_.a.bms_file, &bmsBinaryRecords_, bms_meta_);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionAdjustment(e.what(), 0);
@@ -1172,7 +1180,13 @@ void dna_adjust::CarryStnEstimatesandVariancesForward(const UINT32& thisBlock, c
 
 	it_vUINT32 _it_jsl(v_JSL_.at(thisBlock).begin()), _it_jsl_cov;
 
-	// 1. Copy full covariance matrix and coordinate estimates of junctions to temporary
+	const matrix_2d& aposterioriVariances(v_normals_.at(thisBlock));
+	const matrix_2d& estimatedStations(v_estimatedStations_.at(thisBlock));
+
+	// 1. Gather full covariance matrix and coordinate estimates of junctions to temporary.
+	// The junctions are interleaved with the inner stations of this block, and the 
+	// temporary is inverted in place, so the 3x3 sub-blocks are read through views 
+	// of the block's matrices and gathered into the junction matrices
 	for (_it_jsl=v_JSL_.at(thisBlock).begin(); _it_jsl!=v_JSL_.at(thisBlock).end(); ++_it_jsl)
 	{
 		// get index of this JSL
@@ -1181,11 +1195,11 @@ void dna_adjust::CarryStnEstimatesandVariancesForward(const UINT32& thisBlock, c
 		
 		// copy variance elements for this JSL
 		v_junctionVariances_.at(thisBlock).copyelements(jslvar, jslvar, 
-			v_normals_.at(thisBlock), jsl, jsl, 3, 3);
+			matrix_view(aposterioriVariances, jsl, jsl, 3, 3));
 		
 		// copy junction estimates
 		v_junctionEstimatesFwd_.at(thisBlock).copyelements(est, 0, 
-			v_estimatedStations_.at(thisBlock), jsl, 0, 3, 1); 
+			matrix_view(estimatedStations, jsl, 0, 3, 1)); 
 
 		est += 3;
 
@@ -1199,9 +1213,9 @@ void dna_adjust::CarryStnEstimatesandVariancesForward(const UINT32& thisBlock, c
 			jslcovar = static_cast<UINT32>(std::distance(v_JSL_.at(thisBlock).begin(), _it_jsl_cov) * 3);
 			jsl_cov = v_blockStationsMap_.at(thisBlock)[*_it_jsl_cov] * 3;
 			v_junctionVariances_.at(thisBlock).copyelements(jslvar, jslcovar, 
-				v_normals_.at(thisBlock), jsl, jsl_cov, 3, 3);
+				matrix_view(aposterioriVariances, jsl, jsl_cov, 3, 3));
 			v_junctionVariances_.at(thisBlock).copyelements(jslcovar, jslvar, 
-				v_normals_.at(thisBlock), jsl_cov, jsl, 3, 3);
+				matrix_view(aposterioriVariances, jsl_cov, jsl, 3, 3));
 		}
 	}
 
@@ -1229,6 +1243,8 @@ void dna_adjust::CarryStnEstimatesandVariancesForward(const UINT32& thisBlock, c
 	UINT32 pseudoMsrCount(static_cast<UINT32>(v_JSL_.at(thisBlock).size()));
 	UINT32 pseudoMsrElemCount(pseudoMsrCount * 3);
 	UINT32 paramCount(0), paramCount2, msrCountNext(v_measurementParams_.at(nextBlock));
+
+	const matrix_2d& junctionVariances(v_junctionVariances_.at(thisBlock));
 	
 	// grow matrices to accommodate JSL measurements
 	v_measMinusComp_.at(nextBlock).grow(pseudoMsrElemCount, 0);
@@ -1247,13 +1263,15 @@ void dna_adjust::CarryStnEstimatesandVariancesForward(const UINT32& thisBlock, c
 		jsl = v_blockStationsMap_.at(nextBlock)[*_it_jsl] * 3;		// next block
 		jslvar = static_cast<UINT32>(std::distance(v_JSL_.at(thisBlock).begin(), _it_jsl) * 3);
 
+		// variance elements for this JSL
+		const matrix_view jslVariance(junctionVariances, jslvar, jslvar, 3, 3);
+
 		// add variance elements for this JSL to normals of the next block
-		v_normals_.at(nextBlock).blockadd(jsl, jsl,
-			v_junctionVariances_.at(thisBlock), jslvar, jslvar, 3, 3);
+		v_normals_.at(nextBlock).blockadd(jsl, jsl, jslVariance);
 
 		// copy variances elements for this JSL to v_AtVinv_ of the next block
 		v_AtVinv_.at(nextBlock).copyelements(jsl, v_measurementParams_.at(nextBlock) + paramCount,
-			v_junctionVariances_.at(thisBlock), jslvar, jslvar, 3, 3);
+			jslVariance);
 
 		// msr-comp elements
 		// Measured-computed for junction stations carried forward (from thisBlock-1)
@@ -1286,18 +1304,20 @@ void dna_adjust::CarryStnEstimatesandVariancesForward(const UINT32& thisBlock, c
 			jslcovar = static_cast<UINT32>(std::distance(v_JSL_.at(thisBlock).begin(), _it_jsl_cov) * 3);
 			jsl_cov = v_blockStationsMap_.at(nextBlock)[*_it_jsl_cov] * 3;		// next block
 
+			// covariance elements for this JSL (upper and lower)
+			const matrix_view jslCovarianceU(junctionVariances, jslvar, jslcovar, 3, 3);
+			const matrix_view jslCovarianceL(junctionVariances, jslcovar, jslvar, 3, 3);
+
 			// copy covariance elements for this JSL to normals of the next block
-			v_normals_.at(nextBlock).blockadd(jsl, jsl_cov,
-				v_junctionVariances_.at(thisBlock), jslvar, jslcovar, 3, 3);
-			v_normals_.at(nextBlock).blockadd(jsl_cov, jsl,
-				v_junctionVariances_.at(thisBlock), jslcovar, jslvar, 3, 3);
+			v_normals_.at(nextBlock).blockadd(jsl, jsl_cov, jslCovarianceU);
+			v_normals_.at(nextBlock).blockadd(jsl_cov, jsl, jslCovarianceL);
 
 			// copy covariance elements for this JSL to v_AtVinv_ of the next block
 			v_AtVinv_.at(nextBlock).copyelements(jsl_cov, v_measurementParams_.at(nextBlock) + paramCount, 
-				v_junctionVariances_.at(thisBlock), jslcovar, jslvar, 3, 3);
+				jslCovarianceL);
 
 			v_AtVinv_.at(nextBlock).copyelements(jsl, v_measurementParams_.at(nextBlock) + paramCount + paramCount2, 
-				v_junctionVariances_.at(thisBlock), jslvar, jslcovar, 3, 3);
+				jslCovarianceU);
 		}
 	}
 }
@@ -1334,7 +1354,8 @@ void dna_adjust::CarryStnEstimatesandVariancesReverse(const UINT32& nextBlock, c
 
 	it_vUINT32 _it_jsl(v_JSL_.at(nextBlock).begin()), _it_jsl_cov;
 
-	// 1. Copy full covariance matrix and coordinate estimates of junctions to temporary
+	// 1. Gather full covariance matrix and coordinate estimates of junctions to temporary
+	// (see CarryStnEstimatesandVariancesForward)
 	for (_it_jsl=v_JSL_.at(nextBlock).begin(); _it_jsl!=v_JSL_.at(nextBlock).end(); ++_it_jsl)
 	{
 		// get index of this JSL
@@ -1343,11 +1364,11 @@ void dna_adjust::CarryStnEstimatesandVariancesReverse(const UINT32& nextBlock, c
 		
 		// copy junction variance elements
 		junctionVariances->copyelements(jsl_var_next, jsl_var_next, 
-			aposterioriVariances, jsl_var_order_this, jsl_var_order_this, 3, 3);
+			matrix_view(*aposterioriVariances, jsl_var_order_this, jsl_var_order_this, 3, 3));
 		
 		// copy junction estimates
 		v_junctionEstimatesRev_.at(thisBlock).copyelements(est, 0, 
-			estimatedStationsThis, jsl_var_order_this, 0, 3, 1); 
+			matrix_view(*estimatedStationsThis, jsl_var_order_this, 0, 3, 1)); 
 
 		est += 3;
 
@@ -1361,9 +1382,9 @@ void dna_adjust::CarryStnEstimatesandVariancesReverse(const UINT32& nextBlock, c
 			jsl_covar_next = static_cast<UINT32>(std::distance(v_JSL_.at(nextBlock).begin(), _it_jsl_cov) * 3);
 			jsl_covar_order_this = v_blockStationsMap_.at(thisBlock)[*_it_jsl_cov] * 3;
 			junctionVariances->copyelements(jsl_var_next, jsl_covar_next, 
-				aposterioriVariances, jsl_var_order_this, jsl_covar_order_this, 3, 3);
+				matrix_view(*aposterioriVariances, jsl_var_order_this, jsl_covar_order_this, 3, 3));
 			junctionVariances->copyelements(jsl_covar_next, jsl_var_next, 
-				aposterioriVariances, jsl_covar_order_this, jsl_var_order_this, 3, 3);
+				matrix_view(*aposterioriVariances, jsl_covar_order_this, jsl_var_order_this, 3, 3));
 		}
 	}
 
@@ -1384,6 +1405,8 @@ void dna_adjust::CarryStnEstimatesandVariancesReverse(const UINT32& nextBlock, c
 	// 2. Perform inverse
 	FormInverseVarianceMatrix(junctionVariances);
 
+	const matrix_2d& junctionVariancesInv(*junctionVariances);
+
 	// 3. Grow msr-comp and AtVinv matrices for next block to include junction stations as measurements
 	UINT32 pseudoMsrCount(static_cast<UINT32>(v_JSL_.at(nextBlock).size()));
 	UINT32 pseudoMsrElemCount(pseudoMsrCount * 3);
@@ -1407,13 +1430,15 @@ void dna_adjust::CarryStnEstimatesandVariancesReverse(const UINT32& nextBlock, c
 		jsl_var_order_this = v_blockStationsMap_.at(thisBlock)[*_it_jsl] * 3;		// previous block
 		jsl_var_order_next = v_blockStationsMap_.at(nextBlock)[*_it_jsl] * 3;
 
+		// variance elements for this JSL
+		const matrix_view jslVariance(junctionVariancesInv, jsl_var_next, jsl_var_next, 3, 3);
+
 		// add variance elements for this JSL to normals of the next block
-		normals->blockadd(jsl_var_order_next, jsl_var_order_next,
-			*junctionVariances, jsl_var_next, jsl_var_next, 3, 3);
+		normals->blockadd(jsl_var_order_next, jsl_var_order_next, jslVariance);
 
 		// copy variances elements for this JSL to v_AtVinv_ of the next block
 		AtVinvNext->copyelements(jsl_var_order_next, v_measurementParams_.at(nextBlock) + paramCount,
-			junctionVariances, jsl_var_next, jsl_var_next, 3, 3);
+			jslVariance);
 
 		// msr-comp elements
 		// Measured-computed for junction stations carried forward (from thisBlock-1)
@@ -1446,19 +1471,20 @@ void dna_adjust::CarryStnEstimatesandVariancesReverse(const UINT32& nextBlock, c
 			jsl_covar_next = static_cast<UINT32>(std::distance(v_JSL_.at(nextBlock).begin(), _it_jsl_cov) * 3);
 			jsl_covar_order_next = v_blockStationsMap_.at(nextBlock)[*_it_jsl_cov] * 3;
 
-			// add covariance elements for this JSL to normals of the next block
-			normals->blockadd(jsl_covar_order_next, jsl_var_order_next, 
-				*junctionVariances, jsl_covar_next, jsl_var_next, 3, 3);
+			// covariance elements for this JSL (upper and lower)
+			const matrix_view jslCovarianceU(junctionVariancesInv, jsl_var_next, jsl_covar_next, 3, 3);
+			const matrix_view jslCovarianceL(junctionVariancesInv, jsl_covar_next, jsl_var_next, 3, 3);
 
-			normals->blockadd(jsl_var_order_next, jsl_covar_order_next,  
-				*junctionVariances, jsl_var_next, jsl_covar_next, 3, 3);
+			// add covariance elements for this JSL to normals of the next block
+			normals->blockadd(jsl_covar_order_next, jsl_var_order_next, jslCovarianceL);
+			normals->blockadd(jsl_var_order_next, jsl_covar_order_next, jslCovarianceU);
 
 			// copy covariance elements for this JSL to v_AtVinv_ of the next block
 			AtVinvNext->copyelements(jsl_covar_order_next, v_measurementParams_.at(nextBlock) + paramCount,
-				junctionVariances, jsl_covar_next, jsl_var_next, 3, 3);
+				jslCovarianceL);
 
 			AtVinvNext->copyelements(jsl_var_order_next, v_measurementParams_.at(nextBlock) + paramCount + paramCount2,
-				junctionVariances, jsl_var_next, jsl_covar_next, 3, 3);
+				jslCovarianceU);
 		}
 	}
 }
@@ -1940,14 +1966,10 @@ void dna_adjust::UpdateNormals_X(const UINT32& block, it_vmsr_t& _it_msr, UINT32
 		//	AtVinv->submatrix(stn1,								// component must be multiplied by -1 to
 		//		design_row+covr, 3, 3).scale(-1.), 0, 0, 3, 3);	// effect the design matrix elements
 		
-		// copy the relevant AtV-1 elements to temp and multiply 
-		// by -1 to effect the design matrix elements
-		AtVinv->submatrix(stn1, design_row+covr, &tmp, 3, 3);
-		tmp.scale(-1.);
-
-		// add variances for these stations
-		normals->blockadd(stn1, stn1,							// Station 1.
-			tmp, 0, 0, 3, 3);
+		// subtract the relevant AtV-1 elements (in place) to effect 
+		// the design matrix elements
+		normals->blocksubtract(stn1, stn1,						// Station 1.
+			*AtVinv, stn1, design_row+covr, 3, 3);
 		normals->blockadd(stn2, stn2,							// Station 2
 			*AtVinv, stn2, design_row+covr, 3, 3);	
 
@@ -1958,8 +1980,6 @@ void dna_adjust::UpdateNormals_X(const UINT32& block, it_vmsr_t& _it_msr, UINT32
 			_it_msr += 3;
 	}
 
-	matrix_2d tmp1(3, baseline_count*3), tmp2(baseline_count*3, 3);
-
 	// Build  At * V-1 * A covariances
 	for (cluster_bsl=0; cluster_bsl<baseline_stations.size(); ++cluster_bsl)
 	{
@@ -1972,26 +1992,12 @@ void dna_adjust::UpdateNormals_X(const UINT32& block, it_vmsr_t& _it_msr, UINT32
 
 			stn2 = baseline_stations.at(cluster_cov);
 
-			//// add covariances for these stations
-			//normals->blockadd(stn1, stn2,		
-			//	AtVinv->submatrix(stn1,			
-			//		design_row, 3, baseline_count*3).multiply(
-			//			design->submatrix(design_row, stn2, 
-			//				baseline_count*3, 3)), 0, 0, 3, 3);
-
-			// The following is more code, but is more efficient as it
-			// recycles matrix instances (as opposed to creating a
-			// new instance for every call to submatrix and multiply)
-			// Get AtVinv component
-			AtVinv->submatrix(stn1, design_row, 
-				&tmp1, 3, baseline_count*3);
-			// Get design component
-			design->submatrix(design_row, stn2, 
-				&tmp2, baseline_count*3, 3);
-			// multiply the components to form covariance
-			// for stations stn1 and stn2
-			//tmp.multiply(tmp1, tmp2);
-			tmp.multiply_mkl(tmp1, "N", tmp2, "N");
+			// multiply the AtVinv and design components in place 
+			// (via views) to form the covariance for stations 
+			// stn1 and stn2
+			tmp.multiply_mkl(
+				matrix_view(*AtVinv, stn1, design_row, 3, baseline_count*3), "N", 
+				matrix_view(*design, design_row, stn2, baseline_count*3, 3), "N");
 			// Now add covariances to normals
 			normals->blockadd(stn1, stn2,		
 				tmp, 0, 0, 3, 3);
@@ -2020,7 +2026,7 @@ void dna_adjust::UpdateNormals_Y(const UINT32& block, it_vmsr_t& _it_msr, UINT32
 
 		if (projectSettings_.g.verbose > 4)
 			debug_file << "- Adding variances for " << bstBinaryRecords_.at(_it_msr->station1).stationName << " to v_normals_ (block " << block+1 << "), (" << stn1 << ", " << stn1 << "): " << 
-				std::fixed << std::setprecision(16) << AtVinv->submatrix(stn1, design_row, 3, 3);
+				std::fixed << std::setprecision(16) << matrix_view(*AtVinv, stn1, design_row, 3, 3);
 
 		if (covariance_count < 1)
 		{
@@ -3456,6 +3462,7 @@ void dna_adjust::AdjustSimultaneous()
 
 		// calculate and print total time
 		PrintAdjustmentTime(it_time, iteration_time);
+		RecycleMatrixBuffers();
 		
 		// Add corrections to estimates
 		v_estimatedStations_.at(0).add(v_corrections_.at(0));
@@ -3594,6 +3601,18 @@ void dna_adjust::PrintAdjustmentTime(boost::timer::cpu_timer& time, _TIMER_TYPE_
 }
 	
 
+// Called at the end of each iteration.  Returns matrix buffers which were not
+// recycled during this iteration to the system, and prints the pool statistics
+void dna_adjust::RecycleMatrixBuffers()
+{
+	buffer_pool::reset();
+
+	if (projectSettings_.g.verbose)
+		debug_file << "Iteration " << CurrentIteration() << ". " << 
+			buffer_pool::stats().summary() << std::endl;
+}
+	
+
 void dna_adjust::PrintIteration(const UINT32& iteration)
 {
 	std::stringstream iterationMessage;
@@ -3652,6 +3671,7 @@ void dna_adjust::AdjustPhased()
 
 		// calculate and print total time
 		PrintAdjustmentTime(it_time, iteration_time);
+		RecycleMatrixBuffers();
 		
 		// Calculate and print largest adjustment correction and station ID
 		OutputLargestCorrection(corr_msg);
@@ -4291,6 +4311,8 @@ void dna_adjust::CarryStnEstimatesandVariancesCombine(
 	UINT32 jsl, jsl_cov1, jslvar, jslcovar, paramCount, paramCount2;
 	it_vUINT32 _it_jsl(v_JSL_.at(nextBlock).begin()), _it_jsl_cov;
 
+	const matrix_2d& junctionVariancesFwd(v_junctionVariancesFwd_.at(nextBlock));
+
 	paramCount = 0;
 
 	// Copy the junction variances from nextBlock (from forward) to thisBlock
@@ -4302,13 +4324,14 @@ void dna_adjust::CarryStnEstimatesandVariancesCombine(
 		jsl = v_blockStationsMap_.at(thisBlock)[*_it_jsl] * 3;
 		jslvar = static_cast<UINT32>(std::distance(v_JSL_.at(nextBlock).begin(), _it_jsl) * 3);
 
+		// variances for this JSL (from forward)
+		const matrix_view jslVariance(junctionVariancesFwd, jslvar, jslvar, 3, 3);
+
 		// add variances for this JSL to normals
-		normals->blockadd(jsl, jsl, 
-			v_junctionVariancesFwd_.at(nextBlock), jslvar, jslvar, 3, 3);
+		normals->blockadd(jsl, jsl, jslVariance);
 
 		// copy variances from v_junctionVariancesFwd_ to v_AtVinv_
-		AtVinv->copyelements(jsl, pseudomsrJSLBegin + paramCount,
-			v_junctionVariancesFwd_.at(nextBlock), jslvar, jslvar, 3, 3);
+		AtVinv->copyelements(jsl, pseudomsrJSLBegin + paramCount, jslVariance);
 
 		// msr-comp elements
 		// Measured-computed for junction stations carried forward (from thisBlock-1)
@@ -4341,17 +4364,19 @@ void dna_adjust::CarryStnEstimatesandVariancesCombine(
 			// get index of all covariances for this JSL in the next block
 			jslcovar = static_cast<UINT32>(std::distance(v_JSL_.at(nextBlock).begin(), _it_jsl_cov) * 3);
 			jsl_cov1 = v_blockStationsMap_.at(thisBlock)[*_it_jsl_cov] * 3;
+
+			// covariances for this JSL (upper and lower)
+			const matrix_view jslCovarianceU(junctionVariancesFwd, jslvar, jslcovar, 3, 3);
+			const matrix_view jslCovarianceL(junctionVariancesFwd, jslcovar, jslvar, 3, 3);
 			
 			// add covariances for this JSL to normals
-			normals->blockadd(jsl_cov1, jsl, v_junctionVariancesFwd_.at(nextBlock), jslcovar, jslvar, 3, 3);
-			normals->blockadd(jsl, jsl_cov1, v_junctionVariancesFwd_.at(nextBlock), jslvar, jslcovar, 3, 3);
+			normals->blockadd(jsl_cov1, jsl, jslCovarianceL);
+			normals->blockadd(jsl, jsl_cov1, jslCovarianceU);
 
 			// copy covariances from v_junctionVariancesFwd_ to v_AtVinv_
-			AtVinv->copyelements(jsl_cov1, pseudomsrJSLBegin + paramCount, 
-				v_junctionVariancesFwd_.at(nextBlock), jslcovar, jslvar, 3, 3);
+			AtVinv->copyelements(jsl_cov1, pseudomsrJSLBegin + paramCount, jslCovarianceL);
 
-			AtVinv->copyelements(jsl, pseudomsrJSLBegin + paramCount + paramCount2, 
-				v_junctionVariancesFwd_.at(nextBlock), jslvar, jslcovar, 3, 3);
+			AtVinv->copyelements(jsl, pseudomsrJSLBegin + paramCount + paramCount2, jslCovarianceU);
 		}
 	}
 
@@ -7241,7 +7266,6 @@ void dna_adjust::UpdateDesignNormalMeasMatrices_X(pit_vmsr_t _it_msr, UINT32& de
 	std::sort(baseline_stations.begin(), baseline_stations.end());
 
 	covc = baseline_count * 3;
-	matrix_2d tmp(3, covc);
 
 	// Build  At * V-1
 	for (cluster_bsl=0; cluster_bsl<baseline_count; ++cluster_bsl)
@@ -7270,13 +7294,10 @@ void dna_adjust::UpdateDesignNormalMeasMatrices_X(pit_vmsr_t _it_msr, UINT32& de
 		//	var_cart.submatrix(covr, 
 		//	0, 3, covc).scale(-1.), 0, 0, 3, covc);						// add entire row of this vcv
 		
-		// copy the relevant var_cart elements to temp and multiply 
-		// by -1 to effect the design matrix elements
-		var_cart.submatrix(covr, 0, &tmp, 3, covc);
-		tmp.scale(-1.);
-		// add variances/covariances for this baseline to At * V-1
-		AtVinv->blockadd(stn1, design_row_begin, 
-			tmp, 0, 0, 3, covc);										// add entire row of this vcv		
+		// subtract the relevant var_cart elements (in place) to 
+		// effect the design matrix elements
+		AtVinv->blocksubtract(stn1, design_row_begin, 
+			var_cart, covr, 0, 3, covc);								// subtract entire row of this vcv		
 		AtVinv->blockadd(stn2, design_row_begin, 
 			var_cart, covr, 0, 3, covc);								// add entire row of this vcv
 		
@@ -7307,14 +7328,10 @@ void dna_adjust::UpdateDesignNormalMeasMatrices_X(pit_vmsr_t _it_msr, UINT32& de
 		//	AtVinv->submatrix(stn1,										// component must be multiplied by -1 to
 		//		design_row_begin+covr, 3, 3).scale(-1.), 0, 0, 3, 3);	// effect the design matrix elements
 		
-		// copy the relevant var_cart elements to temp and multiply 
-		// by -1 to effect the design matrix elements
-		AtVinv->submatrix(stn1, design_row_begin+covr, &tmp0, 3, 3);
-		tmp0.scale(-1.);
-
-		// add variances for these stations
-		v_normals_.at(block).blockadd(stn1, stn1,						// Station 1.
-			tmp0, 0, 0, 3, 3);
+		// subtract the relevant AtV-1 elements (in place) to effect 
+		// the design matrix elements
+		v_normals_.at(block).blocksubtract(stn1, stn1,					// Station 1.
+			*AtVinv, stn1, design_row_begin+covr, 3, 3);
 		v_normals_.at(block).blockadd(stn2, stn2,						// Station 2
 			v_AtVinv_.at(block), stn2, design_row_begin+covr, 3, 3);	
 
@@ -7326,8 +7343,6 @@ void dna_adjust::UpdateDesignNormalMeasMatrices_X(pit_vmsr_t _it_msr, UINT32& de
 			_it_msr_temp += 3;
 	}
 
-	matrix_2d tmp1(3, baseline_count*3), tmp2(baseline_count*3, 3);
-
 	// Build  At * V-1 * A covariances
 	for (cluster_bsl=0; cluster_bsl<baseline_stations.size(); ++cluster_bsl)
 	{
@@ -7340,26 +7355,12 @@ void dna_adjust::UpdateDesignNormalMeasMatrices_X(pit_vmsr_t _it_msr, UINT32& de
 
 			stn2 = baseline_stations.at(cluster_cov);
 
-			//// add covariances for these stations
-			//v_normals_.at(block).blockadd(stn1, stn2,		
-			//	AtVinv->submatrix(stn1,			
-			//		design_row_begin, 3, baseline_count*3).multiply(
-			//			design->submatrix(design_row_begin, stn2, 
-			//				baseline_count*3, 3)), 0, 0, 3, 3);
-
-			// The following is more code, but is more efficient as it
-			// recycles matrix instances (as opposed to creating a
-			// new instance for every call to submatrix and multiply)
-			// Get AtVinv component
-			AtVinv->submatrix(stn1, design_row_begin, 
-				&tmp1, 3, baseline_count*3);
-			// Get design component
-			design->submatrix(design_row_begin, stn2, 
-				&tmp2, baseline_count*3, 3);
-			// multiply the components to form covariance
-			// for stations stn1 and stn2
-			//tmp0.multiply(tmp1, tmp2);
-			tmp0.multiply_mkl(tmp1, "N", tmp2, "N");
+			// multiply the AtVinv and design components in place 
+			// (via views) to form the covariance for stations 
+			// stn1 and stn2
+			tmp0.multiply_mkl(
+				matrix_view(*AtVinv, stn1, design_row_begin, 3, baseline_count*3), "N", 
+				matrix_view(*design, design_row_begin, stn2, baseline_count*3, 3), "N");
 			// Now add covariances to normals
 			v_normals_.at(block).blockadd(stn1, stn2,		
 				tmp0, 0, 0, 3, 3);
@@ -8138,33 +8139,59 @@ void dna_adjust::ComputeAdjustedMsrPrecisions()
 {
 	// Compute adjusted measurement precisions
 	UINT32 block;
+	v_precadjmsr_t precAdjMsrs;
+
 	switch (projectSettings_.a.adjust_mode)
 	{
 	case PhasedMode:
+		if (!projectSettings_.a.stage)
+		{
+			if (projectSettings_.a.report_mode)
+				break;
+
+			// All blocks are in memory, so compute adjusted measurement 
+			// precisions (v_precAdjMsrsFull_) for all blocks at once
+			// from design and rigorous station variances 
+			for (block=0; block<blockCount_; ++block)
+				IndexPrecisionAdjMsrs(block, &v_normals_.at(block), precAdjMsrs);
+			ComputePrecisionAdjMsrs(precAdjMsrs);
+
+			// Update measurement records and Pelzer's Global reliability
+			for (block=0; block<blockCount_; ++block)
+				UpdateMsrRecords(block);
+			break;
+		}
+
 		for (block=0; block<blockCount_; ++block)
 		{
-			// For staged adjustments, load block info
-			if (projectSettings_.a.stage)
-			{
-				DeserialiseBlockFromMappedFile(block, 7,
-					sf_normals, sf_rigorous_vars, 
-					sf_design, sf_atvinv, sf_estimated_stns,
-					sf_meas_minus_comp, sf_prec_adj_msrs);
-				v_normals_.at(block) = v_rigorousVariances_.at(block);
+			// For staged adjustments, each block is offloaded at the end of
+			// the combine pass, so nothing from that pass is still resident.
+			// Load the rigorous variances and estimates from the mapped files,
+			// and re-form the design, AtVinv and meas-minus-comp matrices (which
+			// are not stored on disk) at the final estimates.  The normals are 
+			// not required, since the precisions are computed directly from
+			// the rigorous variances.
+			DeserialiseBlockFromMappedFile(block, 6,
+				sf_rigorous_vars, 
+				sf_design, sf_atvinv, sf_estimated_stns,
+				sf_meas_minus_comp, sf_prec_adj_msrs);
 
-				FillDesignNormalMeasurementsMatrices(false, block, false);
-			}
+			FillDesignNormalMeasurementsMatrices(false, block, false);
 
 			// Compute adjusted measurement precisions (v_precAdjMsrsFull_)
 			// from design and rigorous station variances 
-			ComputePrecisionAdjMsrs(block);
+			if (!projectSettings_.a.report_mode)
+			{
+				precAdjMsrs.clear();
+				IndexPrecisionAdjMsrs(block, &v_rigorousVariances_.at(block), precAdjMsrs);
+				ComputePrecisionAdjMsrs(precAdjMsrs);
+			}
 
 			// Update measurement records and Pelzer's Global reliability
 			UpdateMsrRecords(block);
 
-			// For staged adjustments, unload all matrix data
-			if (projectSettings_.a.stage)
-				UnloadBlock(block);
+			// Unload all matrix data
+			UnloadBlock(block);
 		}
 		break;
 	case SimultaneousMode:
@@ -8699,59 +8726,62 @@ void dna_adjust::ComputePrecisionAdjMsrs(const UINT32& block /*= 0*/)
 	if (projectSettings_.a.report_mode)
 		return;
 
-	// A*V-1*At, where:
-	//   - A is design matrix
-	//   - V is the inverse of the normals (i.e. precision of estimates)
+	v_precadjmsr_t precAdjMsrs;
+	IndexPrecisionAdjMsrs(block, &v_normals_.at(block), precAdjMsrs);
+	ComputePrecisionAdjMsrs(precAdjMsrs);
+}
+	
+
+// Records, for each measurement in the block, the first row of the design 
+// matrix and of the adjusted measurement precisions vector, so that the 
+// precisions of all measurements can be computed independently.
+void dna_adjust::IndexPrecisionAdjMsrs(const UINT32& block, matrix_2d* aposterioriVariances, v_precadjmsr_t& precAdjMsrs)
+{
 	v_precAdjMsrsFull_.at(block).zero();
 
-	UINT32 design_row(0);
-	UINT32 precadjmsr_row(0);
-	
+	precadjmsr_t precAdjMsr;
+	precAdjMsr.block = block;
+	precAdjMsr.design_row = 0;
+	precAdjMsr.precadjmsr_row = 0;
+	precAdjMsr.aposterioriVariances = aposterioriVariances;
+
+	UINT32 rows;
 	it_vUINT32 _it_block_msr;
-	it_vmsr_t _it_msr;
 
-	matrix_2d *design(&v_design_.at(block)), *aposterioriVariances(&v_normals_.at(block));
+	precAdjMsrs.reserve(precAdjMsrs.size() + v_CML_.at(block).size());
 
 	// Measurements can only ever appear once in the whole CML.  That is, no one measurement will be found
 	// in two or more blocks.  Therefore, unlike precisions of adjusted stations (which may appear in one
 	// or more blocks), precisions of adjusted measurements are unique.
 	for (_it_block_msr=v_CML_.at(block).begin(); _it_block_msr!=v_CML_.at(block).end(); ++_it_block_msr)
 	{
-		if (InitialiseandValidateMsrPointer(_it_block_msr, _it_msr))
+		if (InitialiseandValidateMsrPointer(_it_block_msr, precAdjMsr._it_msr))
 			continue;
 
-		// Build  At * V-1 (diagonals only as full covariances are not required)
-		switch (_it_msr->measType)
+		precAdjMsrs.push_back(precAdjMsr);
+
+		// Move to the rows of the next measurement
+		switch (precAdjMsr._it_msr->measType)
 		{
-		case 'A':	// Horizontal angle
-			ComputePrecisionAdjMsrs_A(block, 
-				GetBlkMatrixElemStn1(block, &_it_msr), 
-				GetBlkMatrixElemStn2(block, &_it_msr), 
-				GetBlkMatrixElemStn3(block, &_it_msr),
-				design, aposterioriVariances,
-				design_row, precadjmsr_row);
-			break;
 		case 'D':	// Direction set
 			// When a target direction is found, continue to next element.  
-			if (_it_msr->vectorCount1 < 1)
+			if (precAdjMsr._it_msr->vectorCount1 < 1)
+			{
+				precAdjMsrs.pop_back();
 				continue;
-			ComputePrecisionAdjMsrs_D(block, _it_msr, 
-				design, aposterioriVariances,
-				design_row, precadjmsr_row);
+			}
+			// one row per derived angle
+			rows = precAdjMsr._it_msr->vectorCount2 - 1;
+			precAdjMsr.design_row += rows;
+			precAdjMsr.precadjmsr_row += rows;
 			break;
-		// Single station measurements
+		case 'A':	// Horizontal angle
 		case 'H':	// Orthometric height
 		case 'I':	// Astronomic latitude
 		case 'J':	// Astronomic longitude
 		case 'P':	// Geodetic latitude
 		case 'Q':	// Geodetic longitude
 		case 'R':	// Ellipsoidal height
-			ComputePrecisionAdjMsrs_HIJPQR(block,
-				GetBlkMatrixElemStn1(block, &_it_msr),				
-				design, aposterioriVariances,
-				design_row, precadjmsr_row);
-			break;
-		// Two station measurements
 		case 'B':	// Geodetic azimuth
 		case 'C':	// Chord dist
 		case 'E':	// Ellipsoid arc
@@ -8761,24 +8791,21 @@ void dna_adjust::ComputePrecisionAdjMsrs(const UINT32& block /*= 0*/)
 		case 'S':	// Slope distance
 		case 'V':	// Zenith distance
 		case 'Z':	// Vertical angle
-			ComputePrecisionAdjMsrs_BCEKLMSVZ(block, 
-				GetBlkMatrixElemStn1(block, &_it_msr), 
-				GetBlkMatrixElemStn2(block, &_it_msr), 
-				design, aposterioriVariances,
-				design_row, precadjmsr_row);
+			precAdjMsr.design_row++;
+			precAdjMsr.precadjmsr_row++;
 			break;
 		case 'G':	// GPS Baseline
 		case 'X':	// GPS Baseline cluster
-			ComputePrecisionAdjMsrs_GX(block, _it_msr, 
-				aposterioriVariances, design_row, precadjmsr_row);
-			break;
 		case 'Y':	// GPS Point cluster
-			ComputePrecisionAdjMsrs_Y(block, _it_msr, 
-				aposterioriVariances, design_row, precadjmsr_row);
-			break;		
+			// three design rows and six (upper triangular) 
+			// precision elements per baseline or point
+			rows = precAdjMsr._it_msr->vectorCount1;
+			precAdjMsr.design_row += rows * 3;
+			precAdjMsr.precadjmsr_row += rows * 6;
+			break;
 		default:
 			std::stringstream ss;
-			ss << "ComputePrecisionAdjMsrs(): Unknown measurement type - '" << static_cast<std::string>(&(_it_msr->measType)) <<
+			ss << "ComputePrecisionAdjMsrs(): Unknown measurement type - '" << static_cast<std::string>(&(precAdjMsr._it_msr->measType)) <<
 				"'." << std::endl;
 			SignalExceptionAdjustment(ss.str(), block);
 		}
@@ -8786,6 +8813,91 @@ void dna_adjust::ComputePrecisionAdjMsrs(const UINT32& block /*= 0*/)
 }
 	
 
+// Computes the precisions of adjusted measurements concurrently.  Each 
+// measurement writes only to its own rows of v_precAdjMsrsFull_.
+void dna_adjust::ComputePrecisionAdjMsrs(v_precadjmsr_t& precAdjMsrs)
+{
+	UINT32 threads(boost::thread::hardware_concurrency());
+	if (threads < 1)
+		threads = 1;
+	
+	parallel_for_each(precAdjMsrs.begin(), precAdjMsrs.end(), 
+		[this](precadjmsr_t& precAdjMsr) {
+			ComputePrecisionAdjMsr(precAdjMsr);
+		},
+		std::max(UINT32(25), static_cast<UINT32>(precAdjMsrs.size() / threads)));
+}
+	
+
+void dna_adjust::ComputePrecisionAdjMsr(precadjmsr_t& precAdjMsr)
+{
+	// A*V-1*At, where:
+	//   - A is design matrix
+	//   - V is the inverse of the normals (i.e. precision of estimates)
+	const UINT32& block(precAdjMsr.block);
+	it_vmsr_t _it_msr(precAdjMsr._it_msr);
+	UINT32 design_row(precAdjMsr.design_row);
+	UINT32 precadjmsr_row(precAdjMsr.precadjmsr_row);
+
+	matrix_2d *design(&v_design_.at(block)), *aposterioriVariances(precAdjMsr.aposterioriVariances);
+
+	// Build  At * V-1 (diagonals only as full covariances are not required)
+	switch (_it_msr->measType)
+	{
+	case 'A':	// Horizontal angle
+		ComputePrecisionAdjMsrs_A(block, 
+			GetBlkMatrixElemStn1(block, &_it_msr), 
+			GetBlkMatrixElemStn2(block, &_it_msr), 
+			GetBlkMatrixElemStn3(block, &_it_msr),
+			design, aposterioriVariances,
+			design_row, precadjmsr_row);
+		break;
+	case 'D':	// Direction set
+		ComputePrecisionAdjMsrs_D(block, _it_msr, 
+			design, aposterioriVariances,
+			design_row, precadjmsr_row);
+		break;
+	// Single station measurements
+	case 'H':	// Orthometric height
+	case 'I':	// Astronomic latitude
+	case 'J':	// Astronomic longitude
+	case 'P':	// Geodetic latitude
+	case 'Q':	// Geodetic longitude
+	case 'R':	// Ellipsoidal height
+		ComputePrecisionAdjMsrs_HIJPQR(block,
+			GetBlkMatrixElemStn1(block, &_it_msr),				
+			design, aposterioriVariances,
+			design_row, precadjmsr_row);
+		break;
+	// Two station measurements
+	case 'B':	// Geodetic azimuth
+	case 'C':	// Chord dist
+	case 'E':	// Ellipsoid arc
+	case 'K':	// Astronomic azimuth
+	case 'L':	// Level difference
+	case 'M':	// MSL arc
+	case 'S':	// Slope distance
+	case 'V':	// Zenith distance
+	case 'Z':	// Vertical angle
+		ComputePrecisionAdjMsrs_BCEKLMSVZ(block, 
+			GetBlkMatrixElemStn1(block, &_it_msr), 
+			GetBlkMatrixElemStn2(block, &_it_msr), 
+			design, aposterioriVariances,
+			design_row, precadjmsr_row);
+		break;
+	case 'G':	// GPS Baseline
+	case 'X':	// GPS Baseline cluster
+		ComputePrecisionAdjMsrs_GX(block, _it_msr, 
+			aposterioriVariances, design_row, precadjmsr_row);
+		break;
+	case 'Y':	// GPS Point cluster
+		ComputePrecisionAdjMsrs_Y(block, _it_msr, 
+			aposterioriVariances, design_row, precadjmsr_row);
+		break;
+	}
+}
+	
+
 void dna_adjust::ComputePrecisionAdjMsrs_A(const UINT32& block, const UINT32& stn1, const UINT32& stn2, const UINT32& stn3, 
 											  matrix_2d* design, matrix_2d* aposterioriVariances, 
 											  UINT32& design_row, UINT32& precadjmsr_row)
@@ -9472,10 +9584,9 @@ void dna_adjust::ComputeChiSquare_XY(const it_vmsr_t& _it_msr, UINT32& measureme
 	// 1. Form inverse variance matrix for GPS measurement
 	FormInverseGPSVarianceMatrix(_it_msr, &V);
 
-	// 2. Form residuals matrix
-	matrix_2d r(measMinusComp->submatrix(measurement_index, 0, variance_dim, 1));
+	// 2. Form residuals matrix (a view of measMinusComp, so no copy is made)
+	matrix_view r(*measMinusComp, measurement_index, 0, variance_dim, 1);
 	
-	matrix_2d rt(r.transpose());
 	matrix_2d rt_Vinv(1, variance_dim);
 	matrix_2d rt_Vinv_r(1, 1);
 	
@@ -9954,7 +10065,7 @@ void dna_adjust::PrintAdjStation(std::ostream& os,
 	os << std::setw(PAD2) << " ";
 
 	// Standard deviation in local reference frame
-	matrix_2d var_local(3, 3), var_cart(3, 3);
+	Mat3 var_local, var_cart;
 
 	// To minimise re-computation when printing to .xyz, .adj and .apu, the type b uncertainties are 
 	// added to the estimated variances held in memory. This is not a problem since, if adjust is 
@@ -9994,7 +10105,7 @@ void dna_adjust::PrintAdjStation(std::ostream& os,
 		}
 	}
 
-	var_cart.copyelements(0, 0, stationVariances, mat_idx, mat_idx, 3, 3);
+	var_cart = Mat3(*stationVariances, mat_idx, mat_idx);
 
 	PropagateVariances_LocalCart(var_cart, var_local, 
 		estLatitude, estLongitude, false);
@@ -10384,8 +10495,8 @@ void dna_adjust::PrintPosUncertainty(std::ostream& os, /*ostream* csv,*/ const U
 	double semimajor, semiminor, azimuth, hzPosU, vtPosU;
 	UINT32 ic, jc;
 
-	matrix_2d variances_cart(3, 3), variances_local(3, 3), mrotations(3, 3);
-	matrix_2d *variances(&variances_cart);
+	Mat3 variances_cart, variances_local, mrotations;
+	Mat3 *variances(&variances_cart);
 
 	switch (projectSettings_.o._apu_vcv_units)
 	{
@@ -10395,7 +10506,7 @@ void dna_adjust::PrintPosUncertainty(std::ostream& os, /*ostream* csv,*/ const U
 	}
 
 	// get cartesian matrix
-	stationVariances->submatrix(mat_idx, mat_idx, &variances_cart, 3, 3);
+	variances_cart = Mat3(*stationVariances, mat_idx, mat_idx);
 
 	// Calculate standard deviations in local reference frame
 	PropagateVariances_LocalCart<double>(variances_cart, variances_local, 
@@ -10489,7 +10600,7 @@ void dna_adjust::PrintPosUncertainty(std::ostream& os, /*ostream* csv,*/ const U
 		jc = v_blockStationsMap_.at(block)[blockStations->at(ic)] * 3;
 
 		// get cartesian submatrix corresponding to the covariance
-		stationVariances->submatrix(mat_idx, jc, &variances_cart, 3, 3);
+		variances_cart = Mat3(*stationVariances, mat_idx, jc);
 			
 		switch (projectSettings_.o._apu_vcv_units)
 		{
@@ -13880,21 +13991,26 @@ void dna_adjust::PrintAdjGNSSAlternateUnits(it_vmsr_t& _it_msr, const uint32_uin
 	// Create copy of _it_msr, transform, then send to PrintAdjMeasurementsLinear
 	vmsr_t gnss_msr;
 	// vector components (original and adjusted)
-	matrix_2d gnss_cart(3, 1), gnss_local(3, 1);
-	matrix_2d gnss_adj_cart(3, 1), gnss_adj_local(3, 1);
+	Vec3 gnss_cart, gnss_local;
+	Vec3 gnss_adj_cart, gnss_adj_local;
 	// variance components (original and adjusted)
-	matrix_2d var_cart(3, 3), var_local(3, 3), var_polar(3, 3);
-	matrix_2d var_adj_local(3, 3), var_adj_polar(3, 3);
+	Mat3 var_cart, var_local, var_polar;
+	Mat3 var_adj_cart, var_adj_local, var_adj_polar;
 
 	// For staged adjustments, load precision of adjusted measurements
 	if (projectSettings_.a.stage)
 		DeserialiseBlockFromMappedFile(b_pam.first, 1, sf_prec_adj_msrs);
 
-	// get precision of adjusted measurements
-	double lower_mtx_buffer[6];
-	memcpy(lower_mtx_buffer, v_precAdjMsrsFull_.at(b_pam.first).getbuffer(b_pam.second, 0), sizeof(lower_mtx_buffer));
-	matrix_2d var_adj_cart(3, 3, lower_mtx_buffer, 6, mtx_lower);
-	var_adj_cart.fillupper();
+	// get precision of adjusted measurements (lower triangle, stored column wise)
+	const double* lower_mtx_buffer(v_precAdjMsrsFull_.at(b_pam.first).getbuffer(b_pam.second, 0));
+	for (UINT32 c(0), r; c<3; ++c)
+	{
+		for (r=c; r<3; ++r, ++lower_mtx_buffer)
+		{
+			var_adj_cart.put(r, c, *lower_mtx_buffer);
+			var_adj_cart.put(c, r, *lower_mtx_buffer);
+		}
+	}
 
 	if (projectSettings_.a.stage)
 		// For staged adjustments, unload precision of adjusted measurements
@@ -13939,7 +14055,7 @@ void dna_adjust::PrintAdjGNSSAlternateUnits(it_vmsr_t& _it_msr, const uint32_uin
 		bstBinaryRecords_.at(_it_msr->station1).currentLongitude,
 		bstBinaryRecords_.at(_it_msr->station2).currentLongitude));
 
-	matrix_2d rotations;
+	Mat3 rotations;
 
 	Rotate_CartLocal<double>(gnss_cart, &gnss_local,
 		bstBinaryRecords_.at(_it_msr->station1).currentLatitude,
@@ -14593,15 +14709,15 @@ void dna_adjust::InitialiseTypeBUncertainties()
 	if (projectSettings_.o._apply_type_b_file)
 	{
 		// load station map
-		v_string_uint32_pair vStnsMap;
+		station_name_index stnsIndex;
 		if (projectSettings_.a.map_file.empty())
 			projectSettings_.a.map_file = projectSettings_.g.input_folder + FOLDER_SLASH + projectSettings_.g.network_name + ".map";
-		LoadStationMap(&vStnsMap, projectSettings_.a.map_file);
+		LoadStationMap(stnsIndex, projectSettings_.a.map_file);
 
 		// Load the typeb file. The typeb file contains site-specific type b uncertainties
 		try {
 
-			tbu.load_tbu_file(projectSettings_.a.type_b_file, v_typeBUncertaintiesLocal_, vStnsMap);
+			tbu.load_tbu_file(projectSettings_.a.type_b_file, v_typeBUncertaintiesLocal_, stnsIndex);
 			std::sort(v_typeBUncertaintiesLocal_.begin(), v_typeBUncertaintiesLocal_.end());
 
 			// reduce to the cartesian reference frame
@@ -14664,10 +14780,10 @@ void dna_adjust::ApplyAdditionalConstraints()
 		return;
 
 	// load station map
-	v_string_uint32_pair vStnsMap;
+	station_name_index stnsIndex;
 	if (projectSettings_.a.map_file.empty())
 		projectSettings_.a.map_file = projectSettings_.g.input_folder + FOLDER_SLASH + projectSettings_.g.network_name + ".map";
-	LoadStationMap(&vStnsMap, projectSettings_.a.map_file);
+	LoadStationMap(stnsIndex, projectSettings_.a.map_file);
 
 	std::string constraint;
 	vstring constraintStns;
@@ -14691,13 +14807,13 @@ void dna_adjust::ApplyAdditionalConstraints()
 		AddDiscontinuitySites(constraintStns);
 	}
 
-	it_pair_string_vUINT32 it_stnmap_range;
+	UINT32 stn_index;
 
 	for (const_it=constraintStns.begin(); const_it!=constraintStns.end(); ++const_it) 
 	{
 		// find this station in the station map
-		it_stnmap_range = equal_range(vStnsMap.begin(), vStnsMap.end(), (*const_it), StationNameIDCompareName());
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		stn_index = stnsIndex.find(*const_it);
+		if (stn_index == station_name_index::npos)
 		{
 			if (projectSettings_.i.apply_discontinuities)
 			{
@@ -14731,17 +14847,17 @@ void dna_adjust::ApplyAdditionalConstraints()
 		}
 
 		// set constraint
-		sprintf(bstBinaryRecords_.at(it_stnmap_range.first->second).stationConst, (constraint).c_str());
+		sprintf(bstBinaryRecords_.at(stn_index).stationConst, (constraint).c_str());
 	}
 }
 	
 
-void dna_adjust::LoadStationMap(pv_string_uint32_pair stnsMap, const std::string& stnmap_file)
+void dna_adjust::LoadStationMap(station_name_index& stnsIndex, const std::string& stnmap_file)
 {
 	try {
-		// Load station map.  Throws runtime_error on failure.
+		// Load station map index.  Throws runtime_error on failure.
 		dna_io_map map;
-		map.load_map_file(stnmap_file, stnsMap);
+		map.load_map_index(stnmap_file, stnsIndex);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionAdjustment(e.what(), 0);
@@ -15063,7 +15179,8 @@ void dna_adjust::LoadSegmentationFile()
 	UINT32 blockThreshold, minInnerStns;
 
 	try {
-		// Load segmentation file.  Throws runtime_error on failure.
+		// Load segmentation file, or its binary companion if it is up 
+		// to date.  Throws runtime_error on failure.
 		dna_io_seg seg;
 		seg.load_seg_file(projectSettings_.a.seg_file, 
 			blockCount_, blockThreshold, minInnerStns,
@@ -29,8 +29,6 @@
 	#endif
 #endif
 
-#include <mkl.h>
-
 #include <exception>
 #include <stdexcept>
 #include <fstream>
@@ -81,11 +79,13 @@
 #include <include/functions/dnastringfuncs.hpp>
 #include <include/functions/dnafilepathfuncs.hpp>
 #include <include/functions/dnaintegermanipfuncs.hpp>
+#include <include/functions/dnaparallelfuncs.hpp>
 
 #include <include/thread/dnathreading.hpp>
 #include <include/parameters/dnaepsg.hpp>
 #include <include/parameters/dnadatum.hpp>
 #include <include/math/dnamatrix_contiguous.hpp>
+#include <include/math/dnamatrix_fixed.hpp>
 #include <include/memory/dnafile_mapping.hpp>
 #include <include/parameters/dnaprojection.hpp>
 
@@ -103,6 +103,18 @@ namespace networkadjust {
 
 extern boost::mutex maxCorrMutex;
 
+// Location of a measurement's design and adjusted measurement precision 
+// rows, used to compute precisions of adjusted measurements concurrently
+typedef struct {
+	UINT32		block;
+	it_vmsr_t	_it_msr;
+	UINT32		design_row;
+	UINT32		precadjmsr_row;
+	matrix_2d*	aposterioriVariances;
+} precadjmsr_t;
+
+typedef std::vector<precadjmsr_t> v_precadjmsr_t;
+
 // forward declaration of dna_adjust
 class dna_adjust;
 
@@ -428,6 +440,7 @@ private:
 	void ValidateandFinaliseAdjustment(boost::timer::cpu_timer& tot_time);
 	void PrintAdjustmentStatus();
 	void PrintAdjustmentTime(boost::timer::cpu_timer& time, _TIMER_TYPE_);
+	void RecycleMatrixBuffers();
 	void PrintIteration(const UINT32& iteration);
 
 	void InitialiseAdjustment();
@@ -456,7 +469,7 @@ private:
 	// Adjustment helps
 	void ApplyAdditionalConstraints();
 	void AddDiscontinuitySites(vstring& constraintStns);
-	void LoadStationMap(pv_string_uint32_pair stnsMap, const std::string& stnmap_file);
+	void LoadStationMap(station_name_index& stnsIndex, const std::string& stnmap_file);
 	void ResizeMatrixVectors();
 	void LoadPhasedBlocks();
 	void LoadSegmentationFile();
@@ -714,6 +727,9 @@ private:
 	void ComputeGlobalNetStat();
 	
 	void ComputePrecisionAdjMsrs(const UINT32& block = 0);
+	void ComputePrecisionAdjMsrs(v_precadjmsr_t& precAdjMsrs);
+	void ComputePrecisionAdjMsr(precadjmsr_t& precAdjMsr);
+	void IndexPrecisionAdjMsrs(const UINT32& block, matrix_2d* aposterioriVariances, v_precadjmsr_t& precAdjMsrs);
 	void ComputePrecisionAdjMsrs_A(const UINT32& block, const UINT32& stn1, const UINT32& stn2, const UINT32& stn3, 
 		matrix_2d* design, matrix_2d* aposterioriVariances, UINT32& design_row, UINT32& precadjmsr_row);
 	void ComputePrecisionAdjMsrs_D(const UINT32& block, it_vmsr_t& _it_msr, 
@@ -807,13 +823,13 @@ private:
 	void UpdateGeographicCoords();
 
 	inline UINT32 GetBlkMatrixElemStn1(const UINT32& block, const pit_vmsr_t _it_msr) { 
-		return v_blockStationsMap_.at(block)[(*_it_msr)->station1] * 3; 
+		return v_blockStationsMap_.at(block).at((*_it_msr)->station1) * 3; 
 	}
 	inline UINT32 GetBlkMatrixElemStn2(const UINT32& block, const pit_vmsr_t _it_msr) { 
-		return v_blockStationsMap_.at(block)[(*_it_msr)->station2] * 3; 
+		return v_blockStationsMap_.at(block).at((*_it_msr)->station2) * 3; 
 	}
 	inline UINT32 GetBlkMatrixElemStn3(const UINT32& block, const pit_vmsr_t _it_msr) { 
-		return v_blockStationsMap_.at(block)[(*_it_msr)->station3] * 3; 
+		return v_blockStationsMap_.at(block).at((*_it_msr)->station3) * 3; 
 	}
 
 	void debug_BlockInformation(const UINT32& currentBlock, const std::string& adjustment_method);
@@ -9,11 +9,6 @@
 #define _WIN32_WINNT 0x0501
 #include <boost/process.hpp>
 
-// Support MKL inverse oly if compiler is Intel
-#if defined(__ICC) || defined(__INTEL_COMPILER)		// Intel compiler
-#include <mkl.h>
-#endif
-
 #include <include/config/dnaexports.hpp>
 #include <include/config/dnaversion.hpp>
 #include <include/config/dnaversion-stream.hpp>
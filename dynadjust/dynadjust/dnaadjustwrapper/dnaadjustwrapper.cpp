@@ -820,6 +820,8 @@ int main(int argc, char* argv[])
 				StringFromT(p.a.fixed_std_dev, 6)+std::string("m.")).c_str())
 			(SCALE_NORMAL_UNITY,
 				"Scale adjustment normal matrices to unity prior to computing inverse to minimise loss of precision caused by tight variances placed on constraint stations.")
+			(MATRIX_BACKEND, boost::program_options::value<std::string>(&p.a.matrix_backend),
+				"BLAS/LAPACK backend used for matrix multiplication and inversion.\n  mkl: Intel MKL\n  openblas: OpenBLAS\n  blis: BLIS\n  reference: Portable reference implementation\nDefault is the backend DynAdjust was built with.  The reference implementation is always available.")
 			(TYPE_B_GLOBAL, boost::program_options::value<std::string>(&p.a.type_b_global),
 				"Type b uncertainties to be added to each computed uncertainty. arg is a comma delimited string that provides 1D, 2D or 3D uncertainties in the local reference frame (e.g. \"up\" or \"e,n\" or \"e,n,up\").")
 			(TYPE_B_FILE, boost::program_options::value<std::string>(&p.a.type_b_file),
@@ -1127,6 +1129,8 @@ int main(int argc, char* argv[])
 
 		if (p.a.scale_normals_to_unity)
 			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Scale normals to unity: " << "yes" << std::endl;
+		if (!p.a.matrix_backend.empty())
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Matrix backend: " << p.a.matrix_backend << std::endl;
 		if (!p.a.station_constraints.empty())
 		{
 			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Station constraints: " << p.a.station_constraints << std::endl;
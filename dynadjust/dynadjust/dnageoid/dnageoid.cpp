@@ -731,7 +731,7 @@ void dna_geoid_interpolation::WriteBinaryStationFile(const std::string& bstnfile
 	try {
 		// write binary stations data.  Throws runtime_error on failure.
 		dna_io_bst bst;
-		bst.write_bst_file(bstnfileName, &bstBinaryRecords_, bst_meta_);
+		bst.update_bst_file(bstnfileName, &bstBinaryRecords_, bst_meta_);
 	}
 	catch (const std::runtime_error& e) {
 		ClearGridFileMemory();
@@ -20,19 +20,28 @@
 // Description  : DynAdjust Interoperability library
 //============================================================================
 
-//#include <include/functions/dnaparallelfuncs.hpp>
+#include <include/functions/dnaparallelfuncs.hpp>
 #include <dynadjust/dnaimport/dnainterop.hpp>
 #include <include/parameters/dnaepsg.hpp>
 #include <include/functions/dnafilepathfuncs.hpp>
+#include <include/functions/dnastationgrid.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #include <include/io/DynaML-schema.hxx>
 
 using namespace dynadjust::epsg;
 
 MsrTally	g_map_tally;
-MsrTally	g_parsemsr_tally;
-StnTally	g_parsestn_tally;
-UINT32		g_fileOrder;
+
+// Tallies and station file order used by the DynaML parser (see dnaparser_pimpl.cxx).
+// These are thread local so that files can be parsed concurrently, each by its own 
+// dna_import.  ParseXML copies these to the respective dna_import members.
+thread_local MsrTally	g_parsemsr_tally;
+thread_local StnTally	g_parsestn_tally;
+thread_local UINT32		g_fileOrder;
 
 //boost::random::mt19937 rng;
 //boost::random::uniform_real_distribution<double> stdev(0.0, 3.0);
@@ -48,7 +57,10 @@ UINT32		g_fileOrder;
 namespace dynadjust {
 namespace dynamlinterop {
 
-boost::mutex import_file_mutex;
+// Guards the current directory change in ParseXML, and the initialisation
+// of the Xerces-C++ runtime, neither of which are safe to run concurrently
+// with the parsing of other files.
+boost::mutex dynaml_parse_mutex;
 
 dna_import::dna_import()
 	: percentComplete_(-99.)
@@ -57,9 +69,10 @@ dna_import::dna_import()
 	, databaseIDsSet_(false)
 {
 	ifsInputFILE_ = 0;
-	g_fileOrder = 0;
-	p_parsemsr_tally = &g_parsemsr_tally;
-	p_parsestn_tally = &g_parsestn_tally;
+	isDNARecords_ = 0;
+	fileOrder_ = 0;
+	p_parsemsr_tally = &parsemsr_tally_;
+	p_parsestn_tally = &parsestn_tally_;
 
 #ifdef _MSC_VER
 #if (_MSC_VER < 1900)
@@ -75,6 +88,8 @@ dna_import::dna_import()
 	m_strProjectDefaultEpoch = DEFAULT_EPOCH;
 
 	stn_discontinuities_.clear();
+	m_discontsSortedbyName = false;
+	discontinuityFileHash_ = 0;
 }
 
 dna_import::~dna_import()
@@ -90,11 +105,13 @@ double dna_import::GetProgress()
 		return -1;
 
 	// Obtain exclusive use of the input file pointer
-	import_file_mutex.lock();
+	import_file_mutex_.lock();
 
 	try
 	{
-		if (ifsInputFILE_)
+		if (!vfileChunks_.empty())
+			percentComplete_ = GetChunkProgress();
+		else if (ifsInputFILE_)
 			percentComplete_ = fabs(ifsInputFILE_->tellg() * 100. / sifsFileSize_);
 	}
 	// Catch any type of error; do nothing.
@@ -106,11 +123,57 @@ double dna_import::GetProgress()
 		//	return percentComplete_;
 	}
 
-	import_file_mutex.unlock();
+	import_file_mutex_.unlock();
 
 	return percentComplete_;
 }
 
+// Returns the number of threads with which to import (see --import-threads)
+UINT32 dna_import::ImportThreads() const
+{
+	if (projectSettings_.i.import_threads > 0)
+		return projectSettings_.i.import_threads;
+	return std::max(1U, boost::thread::hardware_concurrency());
+}
+
+// Destroys the measurements, then clears the pool of station names held by
+// them.  No other measurement created by this library may remain.
+void dna_import::ReleaseMeasurements(vdnaMsrPtr* vMeasurements)
+{
+	vdnaMsrPtr().swap(*vMeasurements);
+	station_name::clear_pool();
+}
+
+// Calculates the progress of parsing a DNA file in chunks (see ParseDNAChunks)
+double dna_import::GetChunkProgress()
+{
+	// The file header has been read
+	double bytesRead(static_cast<double>(sifsFileSize_ - 
+		(vfileChunks_.back()._end - vfileChunks_.front()._begin)));
+	std::streamoff pos;
+
+	vdna_file_chunk_t::iterator _it_chunk;
+	for (_it_chunk=vfileChunks_.begin(); _it_chunk!=vfileChunks_.end(); ++_it_chunk)
+	{
+		dna_import* parser(_it_chunk->_parser.get());
+
+		// Obtain exclusive use of the chunk's stream
+		boost::lock_guard<boost::mutex> lock(parser->import_file_mutex_);
+
+		if (parser->isDNARecords_)
+		{
+			// parsing
+			if ((pos = parser->isDNARecords_->tellg()) > 0)
+				bytesRead += pos;
+		}
+		else
+			// waiting (0%) or complete (100%)
+			bytesRead += parser->percentComplete_ * parser->sifsFileSize_ / 100.;
+	}
+
+	return bytesRead * 100. / sifsFileSize_;
+}
+
 void dna_import::DetermineBoundingBox()
 {
 	if (projectSettings_.i.bounding_box.empty())
@@ -233,12 +296,48 @@ _PARSE_STATUS_ dna_import::ParseInputFile(const std::string& fileName, vdnaStnPt
 	isProcessing_ = true;
 	_filespecifiedreferenceframe = false;
 	_filespecifiedepoch = false;
+
+	// The first file may set the project reference frame and epoch, upon
+	// which the other files depend, so is always parsed
+	if (firstFile || projectSettings_.i.import_cache_folder.empty())
+		ParseInputFileContents(fileName, vStations, stnCount, vMeasurements, msrCount, 
+			clusterID, input_file_meta, firstFile, success_msg);
+	else
+		ParseCachedInputFile(fileName, vStations, stnCount, vMeasurements, msrCount, 
+			clusterID, input_file_meta, success_msg);
+
+	// Apply discontinuities (if they exist) to each file except SINEX
+	// SINEX files are automatically handled
+	if (m_ift != sinex)
+	{
+		if (p->i.apply_discontinuities)
+			ApplyDiscontinuities(vMeasurements);
+	}
+	
+	// Populate metadata
+	sprintf(input_file_meta->filename, "%s", fileName.c_str());
+	if (*stnCount > 0 && *msrCount > 0)
+		input_file_meta->datatype = stn_msr_data;
+	else if (*stnCount > 0)
+		input_file_meta->datatype = stn_data;
+	else if (*msrCount > 0)
+		input_file_meta->datatype = msr_data;
+
+	return parseStatus_;
+}
+	
+
+void dna_import::ParseInputFileContents(const std::string& fileName, vdnaStnPtr* vStations, PUINT32 stnCount, 
+							   vdnaMsrPtr* vMeasurements, PUINT32 msrCount, 
+							   PUINT32 clusterID, input_file_meta_t* input_file_meta, bool firstFile,
+							   std::string* success_msg)
+{
 	std::stringstream ss;
 
 	try 
 	{
 		// Obtain exclusive use of the input file pointer
-		import_file_mutex.lock();
+		import_file_mutex_.lock();
 
 		if (ifsInputFILE_)
 		{
@@ -248,15 +347,21 @@ _PARSE_STATUS_ dna_import::ParseInputFile(const std::string& fileName, vdnaStnPt
 
 		ifsInputFILE_ = new std::ifstream;
 
-		// Open and seek to end immediately after opening.
-		file_opener(ifsInputFILE_, fileName, std::ios::in | std::ios::ate, ascii, true);
+		{
+			// Prevent ParseXML changing the current directory whilst 
+			// the file is opened, since fileName may be a relative path
+			boost::lock_guard<boost::mutex> lock(dynaml_parse_mutex);
+
+			// Open and seek to end immediately after opening.
+			file_opener(ifsInputFILE_, fileName, std::ios::in | std::ios::ate, ascii, true);
+		}
 		
 		// get file size and return to start
 		sifsFileSize_ = (size_t)ifsInputFILE_->tellg();
 		ifsInputFILE_->seekg(0, std::ios::beg);
 
 		// release file pointer mutex
-		import_file_mutex.unlock();
+		import_file_mutex_.unlock();
 	}
 	catch (const std::ios_base::failure& f) {	
 		ss.str("");
@@ -278,13 +383,13 @@ _PARSE_STATUS_ dna_import::ParseInputFile(const std::string& fileName, vdnaStnPt
 	try
 	{
 		// Obtain exclusive use of the input file pointer
-		import_file_mutex.lock();
+		import_file_mutex_.lock();
 
 		ifsInputFILE_->get(first_chars, PRINT_LINE_LENGTH, '\n');
 		ifsInputFILE_->seekg(0, std::ios::beg);				// put back to beginning
 
 		// release file pointer mutex
-		import_file_mutex.unlock();
+		import_file_mutex_.unlock();
 	}
 	catch (const std::ios_base::failure& f) {	
 		ss.str("");
@@ -372,25 +477,229 @@ _PARSE_STATUS_ dna_import::ParseInputFile(const std::string& fileName, vdnaStnPt
 		throw XMLInteropException(ss.str(), 0);
 	}
 	///////////////////////////////////
+}
+	
 
-	// Apply discontinuities (if they exist) to each file except SINEX
-	// SINEX files are automatically handled
-	if (m_ift != sinex)
+// Loads the stations and measurements of an input file from its import 
+// cache file (see dna_io_imc) if neither the input file nor the settings
+// upon which parsing depends have changed since the cache file was written.
+// Otherwise, the input file is parsed and its cache file written.  As in 
+// MergeParseContext, the cluster IDs and station file order held in a cache
+// file are offset from those of the files loaded so far.
+void dna_import::ParseCachedInputFile(const std::string& fileName, vdnaStnPtr* vStations, PUINT32 stnCount, 
+							   vdnaMsrPtr* vMeasurements, PUINT32 msrCount, 
+							   PUINT32 clusterID, input_file_meta_t* input_file_meta,
+							   std::string* success_msg)
+{
+	dna_io_imc imc;
+	imc_parse_state_t state;
+	std::string imcFile, settings(ImportCacheSettings(fileName));
+	std::uint64_t inputSize, inputHash;
+
+	try {
+		imcFile = imc.imc_filename(projectSettings_.i.import_cache_folder, fileName);
+		imc.hash_file(fileName, inputSize, inputHash);
+	}
+	catch (const std::runtime_error& e) {
+		SignalExceptionParse(e.what(), 0);
+	}
+
+	const UINT32 clusterIDBegin(*clusterID), fileOrderBegin(fileOrder_);
+	
+	if (imc.load_imc_file(imcFile, settings, inputSize, inputHash, state, vStations, vMeasurements))
 	{
-		if (p->i.apply_discontinuities)
-			ApplyDiscontinuities(vMeasurements);
+		*stnCount = state.stnCount;
+		*msrCount = state.msrCount;
+		parsestn_tally_ = state.stn_tally;
+		parsemsr_tally_ = state.msr_tally;
+		*input_file_meta = state.input_file_meta;
+		*success_msg = state.success_msg;
+
+		m_ift = static_cast<_INPUT_FILE_TYPE_>(state.input_file_meta.filetype);
+		m_idt = static_cast<_INPUT_DATA_TYPE_>(state.datatype);
+		_filespecifiedreferenceframe = state.filespecifiedreferenceframe;
+		_filespecifiedepoch = state.filespecifiedepoch;
+
+		OffsetClusterIDs(vMeasurements, clusterIDBegin - state.clusterIDBegin);
+		(*clusterID) = clusterIDBegin + (state.clusterIDEnd - state.clusterIDBegin);
+
+		// The stations in a SINEX file are numbered from zero (see 
+		// dna_io_snx::parse_sinex_stn), and a SINEX file sets the epoch
+		if (m_ift == sinex)
+		{
+			if (!vStations->empty())
+				fileOrder_ = state.fileOrderEnd;
+			if (!state.epoch.empty())
+				datum_.SetEpoch(state.epoch);
+		}
+		else
+		{
+			_it_vdnastnptr _it_stn;
+			for (_it_stn=vStations->begin(); _it_stn!=vStations->end(); ++_it_stn)
+				_it_stn->get()->SetfileOrder(_it_stn->get()->GetfileOrder() - state.fileOrderBegin + fileOrderBegin);
+			fileOrder_ = fileOrderBegin + (state.fileOrderEnd - state.fileOrderBegin);
+		}
+
+		parseStatus_ = PARSE_SUCCESS;
+		SignalComplete();
+		return;
+	}
+
+	ParseInputFileContents(fileName, vStations, stnCount, vMeasurements, msrCount, 
+		clusterID, input_file_meta, false, success_msg);
+
+	if (parseStatus_ != PARSE_SUCCESS)
+		return;
+
+	state.input_file_meta = *input_file_meta;
+	state.stn_tally = parsestn_tally_;
+	state.msr_tally = parsemsr_tally_;
+	state.stnCount = *stnCount;
+	state.msrCount = *msrCount;
+	state.clusterIDBegin = clusterIDBegin;
+	state.clusterIDEnd = *clusterID;
+	state.fileOrderBegin = fileOrderBegin;
+	state.fileOrderEnd = fileOrder_;
+	state.datatype = static_cast<UINT16>(m_idt);
+	state.filespecifiedreferenceframe = _filespecifiedreferenceframe;
+	state.filespecifiedepoch = _filespecifiedepoch;
+	state.epoch = datum_.GetEpoch_s();
+	state.success_msg = *success_msg;
+
+	try {
+		imc.write_imc_file(imcFile, settings, inputSize, inputHash, state, vStations, vMeasurements);
 	}
+	catch (const std::runtime_error&) {
+		// A cache file which cannot be written is not an error.  The
+		// input file will simply be parsed again next time.
+	}
+}
 	
-	// Populate metadata
-	sprintf(input_file_meta->filename, "%s", fileName.c_str());
-	if (*stnCount > 0 && *msrCount > 0)
-		input_file_meta->datatype = stn_msr_data;
-	else if (*stnCount > 0)
-		input_file_meta->datatype = stn_data;
-	else if (*msrCount > 0)
-		input_file_meta->datatype = msr_data;
 
-	return parseStatus_;
+// The settings upon which the stations and measurements parsed from an 
+// input file depend.  Settings applied after parsing (e.g. station renaming 
+// and GNSS variance matrix scaling) are not included.
+std::string dna_import::ImportCacheSettings(const std::string& fileName)
+{
+	std::stringstream ss;
+	ss << boost::filesystem::absolute(fileName).string() << "|" <<
+		datum_.GetName() << "|" << datum_.GetEpoch_s() << "|" <<
+		m_strProjectDefaultEpsg << "|" << m_strProjectDefaultEpoch << "|" <<
+		projectSettings_.i.reference_frame << "|" << projectSettings_.i.epoch << "|" <<
+		projectSettings_.i.user_supplied_frame << projectSettings_.i.user_supplied_epoch <<
+		projectSettings_.i.override_input_rfame << projectSettings_.i.prefer_single_x_as_g <<
+		projectSettings_.i.simulate_measurements << projectSettings_.i.apply_discontinuities << "|" <<
+		std::hex << discontinuityFileHash_;
+	return ss.str();
+}
+
+
+// Initialises this (parse context) with the reference frame, epoch, 
+// discontinuities and settings of the parser that loaded the first file.
+// A parse context parses one input file independently of all other files, 
+// and so can be used to parse files concurrently.  Since the cluster IDs 
+// and file order of the stations parsed by a parse context start from 
+// zero, MergeParseContext must be called (in file order) to give those 
+// elements the same values they would have had if each file had been 
+// parsed in turn by parser.
+void dna_import::InitialiseParseContext(const dna_import& parser)
+{
+	projectSettings_ = parser.projectSettings_;
+	datum_ = parser.datum_;
+
+	m_strProjectDefaultEpsg = parser.m_strProjectDefaultEpsg;
+	m_strProjectDefaultEpoch = parser.m_strProjectDefaultEpoch;
+
+	stn_discontinuities_ = parser.stn_discontinuities_;
+	m_discontsSortedbyName = parser.m_discontsSortedbyName;
+	discontinuityFileHash_ = parser.discontinuityFileHash_;
+
+	fileOrder_ = 0;
+}
+	
+
+// Merges the stations and measurements parsed by a parse context, 
+// offsetting station file order and measurement cluster IDs by 
+// the stations and clusters parsed so far.  contextClusterID is the 
+// last cluster ID assigned by the parse context.
+void dna_import::MergeParseContext(const dna_import& context, vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements,
+	const UINT32& contextClusterID, PUINT32 clusterID)
+{
+	// The stations in a SINEX file are numbered from zero (see 
+	// dna_io_snx::parse_sinex_stn), so need no offset
+	if (context.m_ift == sinex && !vStations->empty())
+		fileOrder_ = context.fileOrder_;
+	else
+	{
+		_it_vdnastnptr _it_stn;
+		for (_it_stn=vStations->begin(); _it_stn!=vStations->end(); ++_it_stn)
+			_it_stn->get()->SetfileOrder(_it_stn->get()->GetfileOrder() + fileOrder_);
+		fileOrder_ += context.fileOrder_;
+	}
+
+	OffsetClusterIDs(vMeasurements, *clusterID);
+	(*clusterID) += contextClusterID;
+
+	// Track the stations renamed by the parse context
+	v_string_string_pair::const_iterator _it_renamed;
+	for (_it_renamed=context.stn_renamed_.begin(); _it_renamed!=context.stn_renamed_.end(); ++_it_renamed)
+		TrackDiscontinuitySite(_it_renamed->first, _it_renamed->second);
+}
+	
+
+void dna_import::OffsetClusterIDs(vdnaMsrPtr* vMeasurements, const UINT32& offset)
+{
+	if (offset == 0)
+		return;
+
+	UINT32 clusterID;
+
+	std::vector<CDnaDirection>::iterator _it_dirn;
+	std::vector<CDnaGpsBaseline>::iterator _it_bsl;
+	std::vector<CDnaGpsPoint>::iterator _it_pnt;
+	std::vector<CDnaCovariance>::iterator _it_cov;
+
+	_it_vdnamsrptr _it_msr;
+
+	for (_it_msr = vMeasurements->begin(); _it_msr != vMeasurements->end(); _it_msr++)
+	{
+		// Only nested type measurements (D, G, X, Y) carry a cluster ID
+		switch (_it_msr->get()->GetTypeC())
+		{
+		case 'D':	// Direction set
+			clusterID = _it_msr->get()->GetClusterID() + offset;
+			_it_msr->get()->SetClusterID(clusterID);
+			for (_it_dirn = _it_msr->get()->GetDirections_ptr()->begin();
+				_it_dirn != _it_msr->get()->GetDirections_ptr()->end(); ++_it_dirn)
+				_it_dirn->SetClusterID(clusterID);
+			break;
+		case 'G':	// GPS Baseline (treat as single-baseline cluster)
+		case 'X':	// GPS Baseline cluster
+			clusterID = _it_msr->get()->GetClusterID() + offset;
+			_it_msr->get()->SetClusterID(clusterID);
+			for (_it_bsl = _it_msr->get()->GetBaselines_ptr()->begin();
+				_it_bsl != _it_msr->get()->GetBaselines_ptr()->end(); ++_it_bsl)
+			{
+				_it_bsl->SetClusterID(clusterID);
+				for (_it_cov = _it_bsl->GetCovariances_ptr()->begin(); 
+					_it_cov != _it_bsl->GetCovariances_ptr()->end(); ++_it_cov)
+					_it_cov->SetClusterID(clusterID);
+			}
+			break;
+		case 'Y':	// GPS point cluster
+			clusterID = _it_msr->get()->GetClusterID() + offset;
+			_it_msr->get()->SetClusterID(clusterID);
+			for (_it_pnt = _it_msr->get()->GetPoints_ptr()->begin();
+				_it_pnt != _it_msr->get()->GetPoints_ptr()->end(); ++_it_pnt)
+			{
+				_it_pnt->SetClusterID(clusterID);
+				for (_it_cov = _it_pnt->GetCovariances_ptr()->begin(); 
+					_it_cov != _it_pnt->GetCovariances_ptr()->end(); ++_it_cov)
+					_it_cov->SetClusterID(clusterID);
+			}
+			break;
+		}
+	}
 }
 	
 void dna_import::ParseXML(const std::string& fileName, vdnaStnPtr* vStations, PUINT32 stnCount, 
@@ -401,6 +710,12 @@ void dna_import::ParseXML(const std::string& fileName, vdnaStnPtr* vStations, PU
 	parseStatus_ = PARSE_SUCCESS;
 	_filespecifiedreferenceframe = false;
 	_filespecifiedepoch = false;
+
+	// Obtain exclusive use of the current directory and the Xerces-C++ runtime
+	boost::lock_guard<boost::mutex> lock(dynaml_parse_mutex);
+
+	// The DynaML parser numbers stations using g_fileOrder
+	g_fileOrder = fileOrder_;
 	
 	try
 	{
@@ -473,6 +788,9 @@ void dna_import::ParseXML(const std::string& fileName, vdnaStnPtr* vStations, PU
 		doc_p.parse (*ifsInputFILE_);
 		DnaXmlFormat_p.post_DnaXmlFormat (vStations, vMeasurements);
 		SignalComplete();
+		fileOrder_ = g_fileOrder;
+		parsestn_tally_ = g_parsestn_tally;
+		parsemsr_tally_ = g_parsemsr_tally;
 		*clusterID = DnaXmlFormat_p.CurrentClusterID();
 		*stnCount = DnaXmlFormat_p.NumStationsRead();
 		*msrCount = DnaXmlFormat_p.NumMeasurementsRead();
@@ -563,13 +881,13 @@ void dna_import::ParseXML(const std::string& fileName, vdnaStnPtr* vStations, PU
 		if (ifsInputFILE_->eof())
 		{
 			// release file pointer mutex
-			import_file_mutex.unlock();
+			import_file_mutex_.unlock();
 			return;
 		}
 		if (ifsInputFILE_->rdstate() & std::ifstream::eofbit)
 		{
 			// release file pointer mutex
-			import_file_mutex.unlock();
+			import_file_mutex_.unlock();
 			return;
 		}
 		std::stringstream ss;
@@ -581,13 +899,13 @@ void dna_import::ParseXML(const std::string& fileName, vdnaStnPtr* vStations, PU
 		if (ifsInputFILE_->eof())
 		{
 			// release file pointer mutex
-			import_file_mutex.unlock();
+			import_file_mutex_.unlock();
 			return;
 		}
 		if (ifsInputFILE_->rdstate() & std::ifstream::eofbit)
 		{
 			// release file pointer mutex
-			import_file_mutex.unlock();
+			import_file_mutex_.unlock();
 			return;
 		}
 		std::stringstream ss;
@@ -645,7 +963,7 @@ void dna_import::ParseSNX(const std::string& fileName, vdnaStnPtr* vStations, PU
 		// Load sinex file and capture epoch.  Throws runtime_error on failure.
 		dna_io_snx snx;
 		snx.parse_sinex(&ifsInputFILE_, fileName, vStations, stnCount, vMeasurements, msrCount, clusterID,
-			g_parsestn_tally, g_parsemsr_tally, g_fileOrder, 
+			parsestn_tally_, parsemsr_tally_, fileOrder_, 
 			datum_, projectSettings_.i.apply_discontinuities==1, &stn_discontinuities_, m_discontsSortedbyName,
 			m_lineNo, m_columnNo, parseStatus_);
 	}
@@ -681,6 +999,18 @@ void dna_import::ParseDiscontinuities(const std::string& fileName)
 	}
 
 	discont_file.close();
+
+	try {
+		// Since SINEX files are renamed for discontinuities as they are
+		// parsed, the discontinuities form part of the settings of each
+		// import cache file (see ImportCacheSettings)
+		dna_io_imc imc;
+		std::uint64_t discontinuityFileSize;
+		imc.hash_file(fileName, discontinuityFileSize, discontinuityFileHash_);
+	}
+	catch (const std::runtime_error& e) {
+		SignalExceptionParse(e.what(), 0);
+	}
 }
 	
 // Station names in SINEX files are automatically renamed to account for discontinuities and added
@@ -1056,8 +1386,8 @@ void dna_import::ParseDNA(const std::string& fileName, vdnaStnPtr* vStations, PU
 
 	(*stnCount) = 0;
 	(*msrCount) = 0;
-	g_parsestn_tally.initialise();
-	g_parsemsr_tally.initialise();
+	parsestn_tally_.initialise();
+	parsemsr_tally_.initialise();
 
 	std::string stn_file_type(".stn"), msr_file_type(".msr");
 	std::string version, geoversion;
@@ -1076,17 +1406,17 @@ void dna_import::ParseDNA(const std::string& fileName, vdnaStnPtr* vStations, PU
 		// Read DNA header
 		
 		// Obtain exclusive use of the input file pointer
-		import_file_mutex.lock();
+		import_file_mutex_.lock();
 		// Read the dna file header, and set the
 		// reference frame based on the header and user preferences
 		dnaFile.read_dna_header(ifsInputFILE_, version, idt,			
 			datum_,											// project datum
 			fileEpsg, fileEpoch, geoversion, count);
 		// release file pointer mutex
-		import_file_mutex.unlock();
+		import_file_mutex_.unlock();
 	}
 	catch (const std::runtime_error& e) {
-		import_file_mutex.unlock();
+		import_file_mutex_.unlock();
 		parseStatus_ = PARSE_EXCEPTION_RAISED;
 		throw XMLInteropException(e.what(), 0);
 	}
@@ -1155,22 +1485,26 @@ void dna_import::ParseDNA(const std::string& fileName, vdnaStnPtr* vStations, PU
 		dsl_ = dnaFile.dna_stn_positions();
 		dsw_ = dnaFile.dna_stn_widths();
 		
+		isDNARecords_ = ifsInputFILE_;
+		
 		try {
 			// Does the user want to override the datum provided in the file with the project
 			// datum?
+			// Large files are split into chunks and parsed concurrently.
 			if (projectSettings_.i.override_input_rfame)
-				ParseDNASTN(vStations, stnCount, datum_.GetEpsgCode_s(), datum_.GetEpoch_s());
-			else
+			{
+				if (!ParseDNAChunks(fileName, stn_data, vStations, stnCount, vMeasurements, msrCount, clusterID, 
+					datum_.GetEpsgCode_s(), datum_.GetEpoch_s()))
+					ParseDNASTN(vStations, stnCount, datum_.GetEpsgCode_s(), datum_.GetEpoch_s());
+			}
+			else if (!ParseDNAChunks(fileName, stn_data, vStations, stnCount, vMeasurements, msrCount, clusterID, 
+				fileEpsg, fileEpoch))
 				ParseDNASTN(vStations, stnCount, fileEpsg, fileEpoch);
 			m_idt = stn_data;
 		}
 		catch (const std::ios_base::failure& f) {
 			if (ifsInputFILE_->eof())
-			{
-				// release file pointer mutex
-				import_file_mutex.unlock();
 				return;
-			}
 			std::stringstream ss;
 			ss << "ParseDNA(): An std::ios_base failure was encountered when attempting to read stations file  " << fileName << "." << std::endl << "  " << f.what();
 			throw XMLInteropException(ss.str(), 0);
@@ -1186,11 +1520,7 @@ void dna_import::ParseDNA(const std::string& fileName, vdnaStnPtr* vStations, PU
 		}
 		catch (...) {
 			if (ifsInputFILE_->eof())
-			{
-				// release file pointer mutex
-				import_file_mutex.unlock();
 				return;
-			}
 			std::stringstream ss;
 			ss << "ParseDNA(): An error was encountered when attempting to read stations file  " << fileName << ".";
 			throw XMLInteropException(ss.str(), 0);
@@ -1204,20 +1534,24 @@ void dna_import::ParseDNA(const std::string& fileName, vdnaStnPtr* vStations, PU
 		dml_ = dnaFile.dna_msr_positions();
 		dmw_ = dnaFile.dna_msr_widths();
 		
+		isDNARecords_ = ifsInputFILE_;
+		
 		try {
+			// Large files are split into chunks and parsed concurrently.
 			if (projectSettings_.i.override_input_rfame)
-				ParseDNAMSR(vMeasurements, msrCount, clusterID, datum_.GetEpsgCode_s(), datum_.GetEpoch_s());
-			else
+			{
+				if (!ParseDNAChunks(fileName, msr_data, vStations, stnCount, vMeasurements, msrCount, clusterID, 
+					datum_.GetEpsgCode_s(), datum_.GetEpoch_s()))
+					ParseDNAMSR(vMeasurements, msrCount, clusterID, datum_.GetEpsgCode_s(), datum_.GetEpoch_s());
+			}
+			else if (!ParseDNAChunks(fileName, msr_data, vStations, stnCount, vMeasurements, msrCount, clusterID, 
+				fileEpsg, fileEpoch))
 				ParseDNAMSR(vMeasurements, msrCount, clusterID, fileEpsg, fileEpoch);
 			m_idt = msr_data;
 		}
 		catch (const std::ios_base::failure& f) {
 			if (ifsInputFILE_->eof())
-			{
-				// release file pointer mutex
-				import_file_mutex.unlock();
 				return;
-			}
 			std::stringstream ss;
 			ss << "ParseDNA(): An std::ios_base failure was encountered when attempting to read measurements file  " << fileName << "." << std::endl << "  " << f.what();
 			throw XMLInteropException(ss.str(), 0);
@@ -1233,11 +1567,7 @@ void dna_import::ParseDNA(const std::string& fileName, vdnaStnPtr* vStations, PU
 		}
 		catch (...) {
 			if (ifsInputFILE_->eof())
-			{
-				// release file pointer mutex
-				import_file_mutex.unlock();
 				return;
-			}
 			std::stringstream ss;
 			ss << "ParseDNA(): An error was encountered when attempting to read measurements file  " << fileName << "." << std::endl;
 			ss << "  - line " << m_lineNo;
@@ -1247,84 +1577,321 @@ void dna_import::ParseDNA(const std::string& fileName, vdnaStnPtr* vStations, PU
 	}
 }
 	
-void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std::string& epsg, const std::string& epoch)
+// Parses a large DNA file in chunks, each chunk being parsed concurrently
+// by its own dna_import.  The stations and measurements parsed from each 
+// chunk are merged in file order (see MergeParseContext), and so are the 
+// same as those parsed by ParseDNASTN and ParseDNAMSR.  Returns false if 
+// the file is too small to be split, or cannot be split, into chunks.
+bool dna_import::ParseDNAChunks(const std::string& fileName, const INPUT_DATA_TYPE& idt, 
+	vdnaStnPtr* vStations, PUINT32 stnCount, 
+	vdnaMsrPtr* vMeasurements, PUINT32 msrCount, PUINT32 clusterID, 
+	const std::string& fileEpsg, const std::string& fileEpoch)
 {
-	std::string sBuf, tmp;
+	// The first record follows the header
+	size_t recordsBegin(static_cast<size_t>(isDNARecords_->tellg()));
+	if (recordsBegin >= sifsFileSize_)
+		return false;
 
-	dnaStnPtr stn_ptr;
-	vStations->clear();
+	UINT32 chunkCount(static_cast<UINT32>(std::min<size_t>(
+		ImportThreads(), (sifsFileSize_ - recordsBegin) / projectSettings_.i.parse_chunk_size)));
+	if (chunkCount < 2)
+		return false;
+
+	boost::interprocess::mapped_region dna_region;
+
+	try {
+		// Prevent ParseXML changing the current directory whilst 
+		// the file is mapped, since fileName may be a relative path
+		boost::lock_guard<boost::mutex> lock(dynaml_parse_mutex);
+
+		boost::interprocess::file_mapping dna_map(fileName.c_str(), boost::interprocess::read_only);
+		boost::interprocess::mapped_region(dna_map, boost::interprocess::read_only).swap(dna_region);
+	}
+	catch (const boost::interprocess::interprocess_exception&) {
+		return false;
+	}
 
-	//while (!ifsInputFILE_->eof())			// while EOF not found
-	while (ifsInputFILE_)
+	const char* records(static_cast<const char*>(dna_region.get_address()) + recordsBegin);
+	const char* recordsEnd(static_cast<const char*>(dna_region.get_address()) + dna_region.get_size());
+
+	vdna_file_chunk_t vChunks(chunkCount);
+	if (!FindDNAChunks(records, recordsEnd, idt, vChunks))
+		return false;
+
+	vdna_file_chunk_t::iterator _it_chunk;
+	for (_it_chunk=vChunks.begin(); _it_chunk!=vChunks.end(); ++_it_chunk)
 	{
-		// Obtain exclusive use of the input file pointer
-		import_file_mutex.lock();
+		_it_chunk->_parser.reset(new dna_import);
+		dna_import* parser(_it_chunk->_parser.get());
+		
+		parser->InitialiseParseContext(*this);
+		parser->dsl_ = dsl_;
+		parser->dsw_ = dsw_;
+		parser->dml_ = dml_;
+		parser->dmw_ = dmw_;
+		parser->m_ift = dna;
+		parser->m_lineNo = _it_chunk->_lineNo;
+		parser->sifsFileSize_ = _it_chunk->_end - _it_chunk->_begin;
+		parser->percentComplete_ = 0.;
+	}
+
+	import_file_mutex_.lock();
+	vfileChunks_.swap(vChunks);
+	import_file_mutex_.unlock();
+
+	// Parse the chunks
+	const std::ios_base::iostate exceptions(ifsInputFILE_->exceptions());
+	parallel_for_each(vfileChunks_.begin(), vfileChunks_.end(),
+		[&idt, &fileEpsg, &fileEpoch, &exceptions](dna_file_chunk_t& chunk) {
+			chunk._parser->ParseDNAChunk(chunk, idt, fileEpsg, fileEpoch, exceptions);
+		}, 1);
+
+	import_file_mutex_.lock();
+	vfileChunks_.swap(vChunks);
+	import_file_mutex_.unlock();
+
+	if (idt == stn_data)
+		vStations->clear();
+	else
+		vMeasurements->clear();
 
-		if (ifsInputFILE_->eof())
+	// Merge the chunks in file order
+	for (_it_chunk=vChunks.begin(); _it_chunk!=vChunks.end(); ++_it_chunk)
+	{
+		dna_import* parser(_it_chunk->_parser.get());
+
+		// Raise the first exception, as if the chunks were parsed in turn
+		if (_it_chunk->_exception)
 		{
-			// release file pointer mutex
-			import_file_mutex.unlock();
-			break;
+			m_lineNo = parser->m_lineNo;
+			m_columnNo = parser->m_columnNo;
+			std::rethrow_exception(_it_chunk->_exception);
 		}
 
-		m_lineNo++;
-		
-		try {
-			getline((*ifsInputFILE_), sBuf);
-		}
-		catch (...) {
-			if (ifsInputFILE_->eof())
-			{
-				// release file pointer mutex
-				import_file_mutex.unlock();
-				return;
-			}
-			std::stringstream ss;
-			ss << "ParseDNASTN(): Could not read from the station file." << std::endl;
-			m_columnNo = 0;
-			throw XMLInteropException(ss.str(), m_lineNo);
-		}
+		MergeParseContext(*parser, &_it_chunk->_vStations, &_it_chunk->_vMeasurements,
+			_it_chunk->_clusterID, clusterID);
 
-		// release file pointer mutex
-		import_file_mutex.unlock();
+		vStations->insert(vStations->end(), _it_chunk->_vStations.begin(), _it_chunk->_vStations.end());
+		vMeasurements->insert(vMeasurements->end(), _it_chunk->_vMeasurements.begin(), _it_chunk->_vMeasurements.end());
 		
-		// blank or whitespace?
-		if (trimstr(sBuf).empty())			
-			continue;
+		(*stnCount) += _it_chunk->_stnCount;
+		(*msrCount) += _it_chunk->_msrCount;
+		parsestn_tally_ += parser->parsestn_tally_;
+		parsemsr_tally_ += parser->parsemsr_tally_;
+		m_lineNo = parser->m_lineNo;
+	}
 
-		// Ignore lines with blank station name
-		if (trimstr(sBuf.substr(dsl_.stn_name, dsw_.stn_name)).empty())			
-			continue;
-		
-		// Ignore lines with comments
-		if (sBuf.compare(0, 1, "*") == 0)
-			continue;
-		
-		// initialise new station
-		stn_ptr.reset(new CDnaStation(datumFromEpsgString<std::string>(epsg), epoch));
+	return true;
+}
+	
 
-		stn_ptr->SetfileOrder(g_fileOrder++);
+// Parses a chunk of a DNA file (see ParseDNAChunks)
+void dna_import::ParseDNAChunk(dna_file_chunk_t& chunk, const INPUT_DATA_TYPE& idt, 
+	const std::string& fileEpsg, const std::string& fileEpoch,
+	const std::ios_base::iostate& exceptions)
+{
+	memory_streambuf chunkBuffer(chunk._begin, chunk._end);
+	std::istream chunkStream(&chunkBuffer);
+	chunkStream.exceptions(exceptions);
 
-		// name
-		try {
-			tmp = trimstr(sBuf.substr(dsl_.stn_name, dsw_.stn_name));	
-			stn_ptr->SetName(tmp);
+	{
+		boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+		isDNARecords_ = &chunkStream;
+	}
+
+	// As for ParseDNA, reaching the end of the chunk whilst reading a 
+	// record is not an error.  Records are read under a scoped lock of
+	// import_file_mutex_, so it is never held when an exception arrives here.
+	try {
+		if (idt == stn_data)
+			ParseDNASTN(&chunk._vStations, &chunk._stnCount, fileEpsg, fileEpoch);
+		else
+			ParseDNAMSR(&chunk._vMeasurements, &chunk._msrCount, &chunk._clusterID, fileEpsg, fileEpoch);
+	}
+	catch (const XMLInteropException&) {
+		chunk._exception = std::current_exception();
+	}
+	catch (...) {
+		if (!chunkStream.eof())
+			chunk._exception = std::current_exception();
+	}
+
+	boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+	isDNARecords_ = 0;
+	percentComplete_ = 100.;
+}
+	
+
+// Finds the records at which the DNA records in [begin, end) can be split 
+// into (at most) vChunks.size() chunks of similar size.  Since direction 
+// sets and GNSS baseline and point clusters span several lines, the lines 
+// of each measurement record are counted as ParseDNAMSR would read them.
+// Returns false if the records cannot be split.
+bool dna_import::FindDNAChunks(const char* begin, const char* end, const INPUT_DATA_TYPE& idt, vdna_file_chunk_t& vChunks)
+{
+	const size_t chunkSize((end - begin) / vChunks.size());
+	const char* line(begin);
+	const char* next;
+	std::string sBuf;
+	UINT32 c(1), lineNo(m_lineNo), lines;
+
+	vChunks.front()._begin = begin;
+	vChunks.front()._lineNo = lineNo;
+
+	while (line < end && c < vChunks.size())
+	{
+		// Start a new chunk with this record?
+		if (line >= begin + c * chunkSize)
+		{
+			vChunks.at(c - 1)._end = line;
+			vChunks.at(c)._begin = line;
+			vChunks.at(c)._lineNo = lineNo;
+			++c;
 		}
-		catch (...) {
-			std::stringstream ss;
-			ss << "ParseDNASTN(): Could not extract station name from the record:  " << std::endl << "    " << sBuf << std::endl;
-			m_columnNo = dsl_.stn_name+1;
-			throw XMLInteropException(ss.str(), m_lineNo);
+
+		next = static_cast<const char*>(memchr(line, '\n', end - line));
+		next = (next ? next + 1 : end);
+		
+		lines = 1;
+		if (idt == msr_data)
+		{
+			// getline discards the new line character
+			sBuf.assign(line, next - line);
+			if (!sBuf.empty() && sBuf.back() == '\n')
+				sBuf.pop_back();
+
+			try {
+				lines = DNAMSRRecordLines(sBuf);
+			}
+			catch (...) {
+				// Leave ParseDNAMSR to report the error
+				return false;
+			}
 		}
 
-		// constraints
-		try {
-			tmp = trimstr(sBuf.substr(dsl_.stn_const, dsw_.stn_const));	
-			stn_ptr->SetConstraints(tmp);
-			g_parsestn_tally.addstation(tmp);
+		// Move to the next record
+		for (line=next, ++lineNo; --lines > 0 && line < end; ++lineNo)
+		{
+			next = static_cast<const char*>(memchr(line, '\n', end - line));
+			line = (next ? next + 1 : end);
 		}
-		catch (...) {
-			std::stringstream ss;
+	}
+
+	vChunks.resize(c);
+	vChunks.back()._end = end;
+
+	return vChunks.size() > 1;
+}
+	
+
+// Returns the number of lines read by ParseDNAMSR for the 
+// measurement record starting with sBuf
+UINT32 dna_import::DNAMSRRecordLines(const std::string& sBuf)
+{
+	// As for ParseDNAMSR, skip blank and comment lines, and 
+	// lines without a station value
+	if (trimstr(sBuf).length() < 2)
+		return 1;
+	if (trimstr(sBuf.substr(dml_.msr_inst, dmw_.msr_inst)).empty())
+		return 1;
+	if (sBuf.compare(0, 1, "*") == 0)
+		return 1;
+
+	char cType(static_cast<char>(toupper(trimstr(sBuf.substr(dml_.msr_type, 1)).c_str()[0])));
+	UINT32 count(1);
+
+	switch (cType)
+	{
+	case 'D': // Direction set
+		// The first direction, then one line for each direction
+		ParseMsrCountValue(sBuf, count, "DNAMSRRecordLines");
+		return count + 1;
+	case 'X': // GPS Baseline cluster
+	case 'Y': // GPS point cluster
+		ParseMsrCountValue(sBuf, count, "DNAMSRRecordLines");
+	case 'G': // GPS Baseline
+		if (count == 0)
+			return 1;
+		// The stations of each baseline or point
+		if (projectSettings_.i.simulate_measurements)
+			return count;
+		// ... plus three lines for X, Y, Z, and three lines for each covariance
+		return count * 4 + (count * (count - 1) / 2) * 3;
+	default:
+		return 1;
+	}
+}
+	
+
+void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std::string& epsg, const std::string& epoch)
+{
+	std::string sBuf, tmp;
+
+	dnaStnPtr stn_ptr;
+	vStations->clear();
+
+	//while (!isDNARecords_->eof())			// while EOF not found
+	while (isDNARecords_)
+	{
+		{
+			// Obtain exclusive use of the input file pointer
+			boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+
+			if (isDNARecords_->eof())
+				break;
+
+			m_lineNo++;
+		
+			try {
+				getline((*isDNARecords_), sBuf);
+			}
+			catch (...) {
+				if (isDNARecords_->eof())
+					return;
+				std::stringstream ss;
+				ss << "ParseDNASTN(): Could not read from the station file." << std::endl;
+				m_columnNo = 0;
+				throw XMLInteropException(ss.str(), m_lineNo);
+			}
+		}
+		
+		// blank or whitespace?
+		if (trimstr_view(sBuf).empty())			
+			continue;
+
+		// Ignore lines with blank station name
+		if (fixed_field(sBuf, dsl_.stn_name, dsw_.stn_name).empty())			
+			continue;
+		
+		// Ignore lines with comments
+		if (sBuf.compare(0, 1, "*") == 0)
+			continue;
+		
+		// initialise new station
+		stn_ptr.reset(new CDnaStation(datumFromEpsgString<std::string>(epsg), epoch));
+
+		stn_ptr->SetfileOrder(fileOrder_++);
+
+		// name
+		try {
+			tmp = fixed_field(sBuf, dsl_.stn_name, dsw_.stn_name);	
+			stn_ptr->SetName(tmp);
+		}
+		catch (...) {
+			std::stringstream ss;
+			ss << "ParseDNASTN(): Could not extract station name from the record:  " << std::endl << "    " << sBuf << std::endl;
+			m_columnNo = dsl_.stn_name+1;
+			throw XMLInteropException(ss.str(), m_lineNo);
+		}
+
+		// constraints
+		try {
+			tmp = fixed_field(sBuf, dsl_.stn_const, dsw_.stn_const);	
+			stn_ptr->SetConstraints(tmp);
+			parsestn_tally_.addstation(tmp);
+		}
+		catch (...) {
+			std::stringstream ss;
 			ss << "ParseDNASTN(): Could not extract station constraints from the record:  " << std::endl << "    " << sBuf << std::endl;
 			m_columnNo = dsl_.stn_const+1;
 			throw XMLInteropException(ss.str(), m_lineNo);
@@ -1332,7 +1899,7 @@ void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std:
 
 		// coordinate type
 		try {
-			tmp = trimstr(sBuf.substr(dsl_.stn_type, dsw_.stn_type));
+			tmp = fixed_field(sBuf, dsl_.stn_type, dsw_.stn_type);
 			stn_ptr->SetCoordType(tmp);
 		}
 		catch (...) {
@@ -1344,7 +1911,7 @@ void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std:
 
 		// coordinates
 		try {
-			tmp = trimstr(sBuf.substr(dsl_.stn_e_phi_x, dsw_.stn_e_phi_x));		// easting, latitude, X
+			tmp = fixed_field(sBuf, dsl_.stn_e_phi_x, dsw_.stn_e_phi_x);		// easting, latitude, X
 			stn_ptr->SetXAxis(tmp);
 		}
 		catch (...) {
@@ -1371,7 +1938,7 @@ void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std:
 		}
 
 		try {
-			tmp = trimstr(sBuf.substr(dsl_.stn_n_lam_y, dsw_.stn_n_lam_y));		// northing, longitude, Y
+			tmp = fixed_field(sBuf, dsl_.stn_n_lam_y, dsw_.stn_n_lam_y);		// northing, longitude, Y
 			stn_ptr->SetYAxis(tmp);
 		}
 		catch (...) {
@@ -1398,7 +1965,7 @@ void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std:
 		}
 
 		try {
-			tmp = trimstr(sBuf.substr(dsl_.stn_ht_z, dsw_.stn_ht_z));		// orthometric height, Z
+			tmp = fixed_field(sBuf, dsl_.stn_ht_z, dsw_.stn_ht_z);		// orthometric height, Z
 			if (stn_ptr->GetMyCoordTypeC() == XYZ_type_i)
 				stn_ptr->SetZAxis(tmp);
 			else
@@ -1428,7 +1995,7 @@ void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std:
 		if (sBuf.length() > dsl_.stn_hemi_zo)
 		{
 			try {
-				tmp = trimstr(sBuf.substr(dsl_.stn_hemi_zo, dsw_.stn_hemi_zo));		// hemisphere-zone
+				tmp = fixed_field(sBuf, dsl_.stn_hemi_zo, dsw_.stn_hemi_zo);		// hemisphere-zone
 				stn_ptr->SetHemisphereZone(tmp);
 			}
 			catch (...) {
@@ -1452,7 +2019,7 @@ void dna_import::ParseDNASTN(vdnaStnPtr* vStations, PUINT32 stnCount, const std:
 		if (sBuf.length() > dsl_.stn_desc)
 		{
 			try {
-				tmp = trimstr(sBuf.substr(dsl_.stn_desc));		// description
+				tmp = fixed_field(sBuf, dsl_.stn_desc);		// description
 				stn_ptr->SetDescription(tmp);
 			}
 			catch (...) {		// do nothing (description is not compulsory)
@@ -1478,51 +2045,43 @@ void dna_import::ParseDNAMSR(pvdnaMsrPtr vMeasurements, PUINT32 msrCount, PUINT3
 	bool measurementRead(false);
 
 	m_msrComments.clear();
+	m_msr_db_map = msr_database_id_map();
 
-	//while (!ifsInputFILE_->eof())			// while EOF not found
-	while (ifsInputFILE_)
+	//while (!isDNARecords_->eof())			// while EOF not found
+	while (isDNARecords_)
 	{
-		// Obtain exclusive use of the input file pointer
-		import_file_mutex.lock();
-
-		if (ifsInputFILE_->eof())
 		{
-			// release file pointer mutex
-			import_file_mutex.unlock();
-			break;
-		}
+			// Obtain exclusive use of the input file pointer
+			boost::lock_guard<boost::mutex> lock(import_file_mutex_);
 
-		m_lineNo++;
+			if (isDNARecords_->eof())
+				break;
+
+			m_lineNo++;
 		
-		try {
-			getline((*ifsInputFILE_), sBuf);
-		}
-		catch (...) {
-			if (ifsInputFILE_->eof())
-			{
-				// release file pointer mutex
-				import_file_mutex.unlock();
-				return;		
+			try {
+				getline((*isDNARecords_), sBuf);
+			}
+			catch (...) {
+				if (isDNARecords_->eof())
+					return;
+				std::stringstream ss;
+				ss << "ParseDNAMSR(): Could not read from the measurement file." << std::endl;
+				m_columnNo = 0;
+				throw XMLInteropException(ss.str(), m_lineNo);
 			}
-			std::stringstream ss;
-			ss << "ParseDNAMSR(): Could not read from the measurement file." << std::endl;
-			m_columnNo = 0;
-			throw XMLInteropException(ss.str(), m_lineNo);
 		}
 		
-		// release file pointer mutex
-		import_file_mutex.unlock();
-		
 		// blank or whitespace?
-		if (trimstr(sBuf).empty())			
+		if (trimstr_view(sBuf).empty())			
 			continue;
 		
 		// one character (most likely '*') line
-		if (trimstr(sBuf).length() < 2)
+		if (trimstr_view(sBuf).length() < 2)
 			continue;
 
 		// no station value?
-		if (trimstr(sBuf.substr(dml_.msr_inst, dmw_.msr_inst)).empty())			
+		if (fixed_field(sBuf, dml_.msr_inst, dmw_.msr_inst).empty())			
 			continue;
 
 		// Capture comment (which may apply to several measurements)
@@ -1537,16 +2096,16 @@ void dna_import::ParseDNAMSR(pvdnaMsrPtr vMeasurements, PUINT32 msrCount, PUINT3
 
 			if (!m_msrComments.empty())
 				m_msrComments += "\n";
-			m_msrComments += sBuf.substr(1);
+			m_msrComments.append(sBuf, 1, std::string::npos);
 			continue;
 		}		
 		
 		// no station value?
-		if (trimstr(sBuf.substr(dml_.msr_inst, dmw_.msr_inst)).empty())			
+		if (fixed_field(sBuf, dml_.msr_inst, dmw_.msr_inst).empty())			
 			continue;
 
 		try {
-			tmp = trimstr(sBuf.substr(dml_.msr_type, 1));
+			tmp = fixed_field(sBuf, dml_.msr_type, 1);
 			cType = (tmp.c_str())[0];
 			cType = static_cast<char>(toupper(cType));
 		}
@@ -1557,24 +2116,24 @@ void dna_import::ParseDNAMSR(pvdnaMsrPtr vMeasurements, PUINT32 msrCount, PUINT3
 			throw XMLInteropException(ss.str(), m_lineNo);
 		}
 
-		ignoreMsr = boost::iequals("*", sBuf.substr(dml_.msr_ignore, dmw_.msr_ignore));
+		ignoreMsr = boost::iequals("*", std::string_view(sBuf).substr(dml_.msr_ignore, dmw_.msr_ignore));
 
 		switch (cType)
 		{
 		case 'A': // Horizontal angle
-			g_parsemsr_tally.A++;
+			parsemsr_tally_.A++;
 			msr_ptr.reset(new CDnaAngle);
 			ParseDNAMSRAngular(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'B': // Geodetic azimuth
-			g_parsemsr_tally.B++;
+			parsemsr_tally_.B++;
 			msr_ptr.reset(new CDnaAzimuth);
 			ParseDNAMSRAngular(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'C': // Chord dist
-			g_parsemsr_tally.C++;
+			parsemsr_tally_.C++;
 			msr_ptr.reset(new CDnaDistance);
 			ParseDNAMSRLinear(sBuf, msr_ptr);
 			(*msrCount) += 1;
@@ -1589,7 +2148,7 @@ void dna_import::ParseDNAMSR(pvdnaMsrPtr vMeasurements, PUINT32 msrCount, PUINT3
 			(*msrCount) += static_cast<UINT32>(msr_ptr->GetDirections_ptr()->size());
 			break;
 		case 'E': // Ellipsoid arc
-			g_parsemsr_tally.E++;
+			parsemsr_tally_.E++;
 			msr_ptr.reset(new CDnaDistance);
 			ParseDNAMSRLinear(sBuf, msr_ptr);
 			(*msrCount) += 1;
@@ -1602,67 +2161,67 @@ void dna_import::ParseDNAMSR(pvdnaMsrPtr vMeasurements, PUINT32 msrCount, PUINT3
 			(*msrCount) += static_cast<UINT32>(msr_ptr->GetBaselines_ptr()->size() * 3);
 			break;
 		case 'H': // Orthometric height
-			g_parsemsr_tally.H++;
+			parsemsr_tally_.H++;
 			msr_ptr.reset(new CDnaHeight);
 			ParseDNAMSRLinear(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'I': // Astronomic latitude
-			g_parsemsr_tally.I++;
+			parsemsr_tally_.I++;
 			msr_ptr.reset(new CDnaCoordinate);
 			ParseDNAMSRCoordinate(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'J': // Astronomic longitude
-			g_parsemsr_tally.J++;
+			parsemsr_tally_.J++;
 			msr_ptr.reset(new CDnaCoordinate);
 			ParseDNAMSRCoordinate(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'K': // Astronomic azimuth
-			g_parsemsr_tally.K++;
+			parsemsr_tally_.K++;
 			msr_ptr.reset(new CDnaAzimuth);
 			ParseDNAMSRAngular(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'L': // Level difference
-			g_parsemsr_tally.L++;
+			parsemsr_tally_.L++;
 			msr_ptr.reset(new CDnaHeightDifference);
 			ParseDNAMSRLinear(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'M': // MSL arc
-			g_parsemsr_tally.M++;
+			parsemsr_tally_.M++;
 			msr_ptr.reset(new CDnaDistance);
 			ParseDNAMSRLinear(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'P': // Geodetic latitude
-			g_parsemsr_tally.P++;
+			parsemsr_tally_.P++;
 			msr_ptr.reset(new CDnaCoordinate);
 			ParseDNAMSRCoordinate(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'Q': // Geodetic longitude
-			g_parsemsr_tally.Q++;
+			parsemsr_tally_.Q++;
 			msr_ptr.reset(new CDnaCoordinate);
 			ParseDNAMSRCoordinate(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'R': // Ellipsoidal height
-			g_parsemsr_tally.R++;
+			parsemsr_tally_.R++;
 			msr_ptr.reset(new CDnaHeight);
 			ParseDNAMSRLinear(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'S': // Slope distance
-			g_parsemsr_tally.S++;
+			parsemsr_tally_.S++;
 			msr_ptr.reset(new CDnaDistance);
 			ParseDNAMSRLinear(sBuf, msr_ptr);
 			(*msrCount) += 1;
 			break;
 		case 'V': // Zenith distance
-			g_parsemsr_tally.V++;
+			parsemsr_tally_.V++;
 			msr_ptr.reset(new CDnaDirection);
 			ParseDNAMSRAngular(sBuf, msr_ptr);
 			(*msrCount) += 1;
@@ -1674,7 +2233,7 @@ void dna_import::ParseDNAMSR(pvdnaMsrPtr vMeasurements, PUINT32 msrCount, PUINT3
 			(*msrCount) += static_cast<UINT32>(msr_ptr->GetPoints_ptr()->size() * 3);
 			break;
 		case 'Z': // Vertical angle
-			g_parsemsr_tally.Z++;
+			parsemsr_tally_.Z++;
 			msr_ptr.reset(new CDnaDirection);
 			ParseDNAMSRAngular(sBuf, msr_ptr);
 			(*msrCount) += 1;
@@ -1699,7 +2258,7 @@ void dna_import::ParseDNAMSRLinear(const std::string& sBuf, dnaMsrPtr& msr_ptr)
 {
 	// Measurement type
 	try {
-		msr_ptr->SetType(trimstr(sBuf.substr(dml_.msr_type, dmw_.msr_type)));
+		msr_ptr->SetType(fixed_field(sBuf, dml_.msr_type, dmw_.msr_type));
 	}
 	catch (...) {
 		SignalExceptionParseDNA("ParseDNAMSRLinear(): Could not extract measurement type from the record:  ",
@@ -1770,7 +2329,7 @@ void dna_import::ParseDNAMSRCoordinate(const std::string& sBuf, dnaMsrPtr& msr_p
 {
 	// Measurement type
 	try {
-		msr_ptr->SetType(trimstr(sBuf.substr(dml_.msr_type, dmw_.msr_type)));
+		msr_ptr->SetType(fixed_field(sBuf, dml_.msr_type, dmw_.msr_type));
 	}
 	catch (...) {
 		SignalExceptionParseDNA("ParseDNAMSRCoordinate(): Could not extract measurement type from the record:  ",
@@ -1817,7 +2376,7 @@ void dna_import::ParseDNAMSRGPSBaselines(std::string& sBuf, dnaMsrPtr& msr_ptr,
 	// Measurement type
 	std::string tmp;
 	try {
-		tmp = trimstr(sBuf.substr(dml_.msr_type, dmw_.msr_type));
+		tmp = fixed_field(sBuf, dml_.msr_type, dmw_.msr_type);
 	}
 	catch (...) {
 		SignalExceptionParseDNA("ParseDNAMSRGPSBaselines(): Could not extract measurement type from the record:  ",
@@ -1857,9 +2416,9 @@ void dna_import::ParseDNAMSRGPSBaselines(std::string& sBuf, dnaMsrPtr& msr_ptr,
 
 	msr_ptr->GetBaselines_ptr()->reserve(bslCount);
 	if (boost::iequals(msr_ptr->GetType(), "X"))
-		g_parsemsr_tally.X += bslCount * 3;
+		parsemsr_tally_.X += bslCount * 3;
 	else
-		g_parsemsr_tally.G += bslCount * 3;
+		parsemsr_tally_.G += bslCount * 3;
 
 	// V-scale
 	msr_ptr->SetVscale(ParseScaleVValue(sBuf, "ParseDNAMSRGPSBaselines"));
@@ -1953,11 +2512,11 @@ void dna_import::ParseDNAMSRGPSBaselines(std::string& sBuf, dnaMsrPtr& msr_ptr,
 		{
 			m_lineNo++;
 			
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 
 			// Instrument station
 			msr_ptr->SetFirst(ParseInstrumentValue(sBuf, "ParseDNAMSRGPSBaselines"));
@@ -1980,32 +2539,32 @@ void dna_import::ParseDNAMSRGPSBaselines(std::string& sBuf, dnaMsrPtr& msr_ptr,
 		if (!projectSettings_.i.simulate_measurements)
 		{
 			m_lineNo++;
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 
 			bslTmp.SetX(ParseGPSMsrValue(sBuf, "X", "ParseDNAMSRGPSBaselines"));
 			bslTmp.SetSigmaXX(ParseGPSVarValue(sBuf, "X", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRGPSBaselines"));
 
 			m_lineNo++;
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 	
 			bslTmp.SetY(ParseGPSMsrValue(sBuf, "Y", "ParseDNAMSRGPSBaselines"));
 			bslTmp.SetSigmaXY(ParseGPSVarValue(sBuf, "Y", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRGPSBaselines"));
 			bslTmp.SetSigmaYY(ParseGPSVarValue(sBuf, "Y", dml_.msr_gps_vcv_2, dmw_.msr_gps_vcv_2, "ParseDNAMSRGPSBaselines"));
 
 			m_lineNo++;
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 	
 			bslTmp.SetZ(ParseGPSMsrValue(sBuf, "Z", "ParseDNAMSRGPSBaselines"));
 			bslTmp.SetSigmaXZ(ParseGPSVarValue(sBuf, "Z", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRGPSBaselines"));
@@ -2038,7 +2597,7 @@ void dna_import::ParseDNAMSRGPSPoints(std::string& sBuf, dnaMsrPtr& msr_ptr, boo
 	// Measurement type
 	std::string tmp;
 	try {
-		tmp = trimstr(sBuf.substr(dml_.msr_type, dmw_.msr_type));
+		tmp = fixed_field(sBuf, dml_.msr_type, dmw_.msr_type);
 	}
 	catch (...) {
 		SignalExceptionParseDNA("ParseDNAMSRGPSPoints(): Could not extract measurement type from the record:  ",
@@ -2068,7 +2627,7 @@ void dna_import::ParseDNAMSRGPSPoints(std::string& sBuf, dnaMsrPtr& msr_ptr, boo
 
 	try {
 		// Measurement type (i.e. LLH or XYZ)
-		tmp = trimstr(sBuf.substr(dml_.msr_targ1, dmw_.msr_targ1));
+		tmp = fixed_field(sBuf, dml_.msr_targ1, dmw_.msr_targ1);
 	}
 	catch (...) {
 		SignalExceptionParseDNA("ParseDNAMSRGPSPoints(): Could not extract Y cluster coordinate type from the record:  ",
@@ -2094,7 +2653,7 @@ void dna_import::ParseDNAMSRGPSPoints(std::string& sBuf, dnaMsrPtr& msr_ptr, boo
 	pntTmp.SetRecordedTotal(pntCount);
 
 	msr_ptr->GetPoints_ptr()->reserve(pntCount);
-	g_parsemsr_tally.Y += pntCount * 3;
+	parsemsr_tally_.Y += pntCount * 3;
 
 	// V-scale
 	msr_ptr->SetVscale(ParseScaleVValue(sBuf, "ParseDNAMSRGPSPoints"));
@@ -2188,11 +2747,11 @@ void dna_import::ParseDNAMSRGPSPoints(std::string& sBuf, dnaMsrPtr& msr_ptr, boo
 		if (!first_run)
 		{
 			m_lineNo++;
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 
 			// Instrument station
 			msr_ptr->SetFirst(ParseInstrumentValue(sBuf, "ParseDNAMSRGPSPoints"));
@@ -2212,32 +2771,32 @@ void dna_import::ParseDNAMSRGPSPoints(std::string& sBuf, dnaMsrPtr& msr_ptr, boo
 		if (!projectSettings_.i.simulate_measurements)
 		{
 			m_lineNo++;
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 
 			pntTmp.SetX(ParseGPSMsrValue(sBuf, "X", "ParseDNAMSRGPSPoints"));
 			pntTmp.SetSigmaXX(ParseGPSVarValue(sBuf, "X", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRGPSPoints"));
 
 			m_lineNo++;
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 
 			pntTmp.SetY(ParseGPSMsrValue(sBuf, "Y", "ParseDNAMSRGPSPoints"));
 			pntTmp.SetSigmaXY(ParseGPSVarValue(sBuf, "Y", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRGPSPoints"));
 			pntTmp.SetSigmaYY(ParseGPSVarValue(sBuf, "Y", dml_.msr_gps_vcv_2, dmw_.msr_gps_vcv_2, "ParseDNAMSRGPSPoints"));
 
 			m_lineNo++;
-			// Obtain exclusive use of the input file pointer
-			import_file_mutex.lock();
-			getline((*ifsInputFILE_), sBuf);
-			// release file pointer mutex
-			import_file_mutex.unlock();
+			{
+				// Obtain exclusive use of the input file pointer
+				boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+				getline((*isDNARecords_), sBuf);
+			}
 
 			pntTmp.SetZ(ParseGPSMsrValue(sBuf, "Z", "ParseDNAMSRGPSPoints"));
 			pntTmp.SetSigmaXZ(ParseGPSVarValue(sBuf, "Z", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRGPSPoints"));
@@ -2264,11 +2823,11 @@ void dna_import::ParseDNAMSRCovariance(CDnaCovariance& cov)
 	std::string sBuf;
 		
 	m_lineNo++;
-	// Obtain exclusive use of the input file pointer
-	import_file_mutex.lock();
-	getline((*ifsInputFILE_), sBuf);
-	// release file pointer mutex
-	import_file_mutex.unlock();
+	{
+		// Obtain exclusive use of the input file pointer
+		boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+		getline((*isDNARecords_), sBuf);
+	}
 
 	// m11, m12, m13
 	cov.SetM11(ParseGPSVarValue(sBuf, "co", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRCovariance"));
@@ -2276,11 +2835,11 @@ void dna_import::ParseDNAMSRCovariance(CDnaCovariance& cov)
 	cov.SetM13(ParseGPSVarValue(sBuf, "co", dml_.msr_gps_vcv_3, dmw_.msr_gps_vcv_3, "ParseDNAMSRCovariance"));
 
 	m_lineNo++;
-	// Obtain exclusive use of the input file pointer
-	import_file_mutex.lock();
-	getline((*ifsInputFILE_), sBuf);
-	// release file pointer mutex
-	import_file_mutex.unlock();
+	{
+		// Obtain exclusive use of the input file pointer
+		boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+		getline((*isDNARecords_), sBuf);
+	}
 
 	// m21, m22, m23
 	cov.SetM21(ParseGPSVarValue(sBuf, "co", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRCovariance"));
@@ -2288,11 +2847,11 @@ void dna_import::ParseDNAMSRCovariance(CDnaCovariance& cov)
 	cov.SetM23(ParseGPSVarValue(sBuf, "co", dml_.msr_gps_vcv_3, dmw_.msr_gps_vcv_3, "ParseDNAMSRCovariance"));
 
 	m_lineNo++;
-	// Obtain exclusive use of the input file pointer
-	import_file_mutex.lock();
-	getline((*ifsInputFILE_), sBuf);
-	// release file pointer mutex
-	import_file_mutex.unlock();
+	{
+		// Obtain exclusive use of the input file pointer
+		boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+		getline((*isDNARecords_), sBuf);
+	}
 
 	// m31, m32, m33
 	cov.SetM31(ParseGPSVarValue(sBuf, "co", dml_.msr_gps_vcv_1, dmw_.msr_gps_vcv_1, "ParseDNAMSRCovariance"));
@@ -2301,10 +2860,12 @@ void dna_import::ParseDNAMSRCovariance(CDnaCovariance& cov)
 }
 	
 
-void dna_import::ParseDatabaseIds(const std::string& sBuf, const std::string& calling_function, const char msrType)
+void dna_import::ParseDatabaseIds(const std::string& sBuf, std::string_view calling_function, const char msrType)
 {
-	m_msr_db_map.is_msr_id_set = false;
-	m_msr_db_map.is_cls_id_set = false;
+	// Reset the ids, so that a measurement without ids does not take 
+	// the ids of the last measurement, and so that the ids are the same 
+	// however the file is parsed (see ParseDNAChunks)
+	m_msr_db_map = msr_database_id_map();
 
 	// No msr id?
 	if (sBuf.length() <= dml_.msr_id_msr)
@@ -2334,15 +2895,15 @@ void dna_import::ParseDatabaseIds(const std::string& sBuf, const std::string& ca
 }
 	
 
-void dna_import::ParseDatabaseClusterId(const std::string& sBuf, const std::string& calling_function)
+void dna_import::ParseDatabaseClusterId(const std::string& sBuf, std::string_view calling_function)
 {
-	std::string parsed_value;
+	std::string_view parsed_value;
 	// Cluster ID
 	try {
-		parsed_value = trimstr(sBuf.substr(dml_.msr_id_cluster, dmw_.msr_id_cluster));
+		parsed_value = fixed_field(sBuf, dml_.msr_id_cluster, dmw_.msr_id_cluster);
 		if (!parsed_value.empty())
 		{
-			m_msr_db_map.cluster_id = val_uint<UINT32, std::string>(parsed_value);
+			m_msr_db_map.cluster_id = LongFromString<UINT32>(parsed_value);
 			m_msr_db_map.is_cls_id_set = true;
 		}
 	}
@@ -2355,15 +2916,15 @@ void dna_import::ParseDatabaseClusterId(const std::string& sBuf, const std::stri
 }
 	
 
-void dna_import::ParseDatabaseMsrId(const std::string& sBuf, const std::string& calling_function)
+void dna_import::ParseDatabaseMsrId(const std::string& sBuf, std::string_view calling_function)
 {
-	std::string parsed_value;
+	std::string_view parsed_value;
 	// Measurement ID
 	try {
-		parsed_value = trimstr(sBuf.substr(dml_.msr_id_msr, dmw_.msr_id_msr));
+		parsed_value = fixed_field(sBuf, dml_.msr_id_msr, dmw_.msr_id_msr);
 		if (!parsed_value.empty())
 		{
-			m_msr_db_map.msr_id = val_uint<UINT32, std::string>(parsed_value);
+			m_msr_db_map.msr_id = LongFromString<UINT32>(parsed_value);
 			m_msr_db_map.is_msr_id_set = true;
 		}
 	}
@@ -2376,286 +2937,292 @@ void dna_import::ParseDatabaseMsrId(const std::string& sBuf, const std::string&
 }
 	
 
-std::string dna_import::ParseAngularValue(const std::string& sBuf, const std::string& calling_function)
+std::string dna_import::ParseAngularValue(const std::string& sBuf, std::string_view calling_function)
 {
-	std::string parsed_value, tmp;
+	std::string parsed_value;
+	std::string_view tmp;
+	char digits[16];
 	double d;
 	UINT32 u;
 
 	// degrees value
 	try {
-		parsed_value = trimstr(sBuf.substr(dml_.msr_ang_d, dmw_.msr_ang_d)) + ".";
+		parsed_value = fixed_field(sBuf, dml_.msr_ang_d, dmw_.msr_ang_d);
+		parsed_value += ".";
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract degrees value from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract degrees value from the record:  ",
 			sBuf, dml_.msr_ang_d);
 	}
 
 	// minutes value
 	try {
-		tmp = trimstr(sBuf.substr(dml_.msr_ang_m, dmw_.msr_ang_m));
+		tmp = fixed_field(sBuf, dml_.msr_ang_m, dmw_.msr_ang_m);
 		u = LongFromString<UINT32>(tmp);
 		if (u < 10)
 			parsed_value.append("0");
-		parsed_value.append(StringFromT<UINT32>(u));
+		parsed_value.append(digits, std::to_chars(digits, digits + sizeof(digits), u).ptr);
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract minutes value from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract minutes value from the record:  ",
 			sBuf, dml_.msr_ang_m);
 	}
 
 	// seconds value
 	size_t pos = 0;
 	try {
-		tmp = trimstr(sBuf.substr(dml_.msr_ang_s, dmw_.msr_ang_s));
+		tmp = fixed_field(sBuf, dml_.msr_ang_s, dmw_.msr_ang_s);
 		d = DoubleFromString<double>(tmp);
 		if (d < 10 && tmp.at(0) != '0')
 			parsed_value.append("0");
-		if ((pos = tmp.find(".", pos)) != std::string::npos)
-			parsed_value.append(tmp.substr(0, pos) + tmp.substr(pos+1));
+		if ((pos = tmp.find(".", pos)) != std::string_view::npos)
+		{
+			parsed_value.append(tmp.substr(0, pos));
+			parsed_value.append(tmp.substr(pos+1));
+		}
 		else
 			parsed_value.append(tmp);
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract seconds value from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract seconds value from the record:  ",
 			sBuf, dml_.msr_ang_s);
 	}
 	return parsed_value;
 }
 
-std::string dna_import::ParseLinearValue(const std::string& sBuf, const std::string& msrName, const std::string& calling_function)
+std::string_view dna_import::ParseLinearValue(const std::string& sBuf, std::string_view msrName, std::string_view calling_function)
 {
 	try {
-		return trimstr(sBuf.substr(dml_.msr_linear, dmw_.msr_linear));		// coordinate value
+		return fixed_field(sBuf, dml_.msr_linear, dmw_.msr_linear);		// coordinate value
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract the " + msrName + " value from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract the " + std::string(msrName) + " value from the record:  ",
 			sBuf, dml_.msr_linear);
 	}
 	return "";
 }
 
-std::string dna_import::ParseInstrumentValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseInstrumentValue(const std::string& sBuf, std::string_view calling_function)
 {
 
 	try {
 		// Capture string from the designated columns; throws on failure
-		std::string stn = trimstr(sBuf.substr(dml_.msr_inst, dmw_.msr_inst));		// instrument station
+		std::string_view stn = fixed_field(sBuf, dml_.msr_inst, dmw_.msr_inst);		// instrument station
 	
 		// No value supplied?
 		if (stn.empty())
-			SignalExceptionParseDNA(calling_function + "(): The following record doesn't contain an instrument station name:  ",
+			SignalExceptionParseDNA(std::string(calling_function) + "(): The following record doesn't contain an instrument station name:  ",
 				sBuf, dml_.msr_inst);
 
 		return stn;
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract first station name from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract first station name from the record:  ",
 			sBuf, dml_.msr_inst);
 	}
 	return "";
 }
 
-std::string dna_import::ParseTargetValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseTargetValue(const std::string& sBuf, std::string_view calling_function)
 {
 	try {
 		// Capture string from the designated columns; throws on failure
-		std::string stn = trimstr(sBuf.substr(dml_.msr_targ1, dmw_.msr_targ1));		// first target station
+		std::string_view stn = fixed_field(sBuf, dml_.msr_targ1, dmw_.msr_targ1);		// first target station
 	
 		// No value supplied?
 		if (stn.empty())
-			SignalExceptionParseDNA(calling_function + "(): The following record doesn't contain a target station name:  ",
+			SignalExceptionParseDNA(std::string(calling_function) + "(): The following record doesn't contain a target station name:  ",
 				sBuf, dml_.msr_targ1);
 
 		return stn;		
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract second station name from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract second station name from the record:  ",
 			sBuf, dml_.msr_targ1);
 	}
 	return "";
 }
 
-std::string dna_import::ParseTarget2Value(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseTarget2Value(const std::string& sBuf, std::string_view calling_function)
 {
 	try {
 		// Capture string from the designated columns; throws on failure
-		std::string stn = trimstr(sBuf.substr(dml_.msr_targ2, dmw_.msr_targ2));		// second target station
+		std::string_view stn = fixed_field(sBuf, dml_.msr_targ2, dmw_.msr_targ2);		// second target station
 	
 		// No value supplied?
 		if (stn.empty())
-			SignalExceptionParseDNA(calling_function + "(): The following record doesn't contain a second target station name:  ",
+			SignalExceptionParseDNA(std::string(calling_function) + "(): The following record doesn't contain a second target station name:  ",
 				sBuf, dml_.msr_targ2);
 
 		return stn;		
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract third station name from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract third station name from the record:  ",
 			sBuf, dml_.msr_targ2);
 	}
 	return "";
 }
 
-std::string dna_import::ParseStdDevValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseStdDevValue(const std::string& sBuf, std::string_view calling_function)
 {
-	std::string tmp;
+	std::string_view tmp;
 	try {
-		tmp = trimstr(sBuf.substr(dml_.msr_stddev, dmw_.msr_stddev));		// standard deviation
+		tmp = fixed_field(sBuf, dml_.msr_stddev, dmw_.msr_stddev);		// standard deviation
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract standard deviation from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract standard deviation from the record:  ",
 			sBuf, dml_.msr_stddev);
 	}
 
 	if (DoubleFromString<double>(tmp) < PRECISION_1E25)
-		SignalExceptionParseDNA(calling_function + "(): Invalid standard deviation (" + tmp + "). Values cannot be zero or negative:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Invalid standard deviation (" + std::string(tmp) + "). Values cannot be zero or negative:  ",
 			sBuf, dml_.msr_stddev);
 	return tmp;
 }
 
-std::string dna_import::ParseInstHeightValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseInstHeightValue(const std::string& sBuf, std::string_view calling_function)
 {
 	try {
 		if (sBuf.length() > dml_.msr_targ_ht)
-			return trimstr(sBuf.substr(dml_.msr_inst_ht, dmw_.msr_inst_ht));		// instrument height
+			return fixed_field(sBuf, dml_.msr_inst_ht, dmw_.msr_inst_ht);		// instrument height
 		else
-			return trimstr(sBuf.substr(dml_.msr_inst_ht));
+			return fixed_field(sBuf, dml_.msr_inst_ht);
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract instrument height from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract instrument height from the record:  ",
 			sBuf, dml_.msr_inst_ht);
 	}
 	return "";
 }
 
-std::string dna_import::ParseTargHeightValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseTargHeightValue(const std::string& sBuf, std::string_view calling_function)
 {
 	try {
 		if (sBuf.length() > static_cast<std::string::size_type>(dml_.msr_targ_ht + 1 + dmw_.msr_targ_ht))
-			return trimstr(sBuf.substr(dml_.msr_targ_ht, dmw_.msr_targ_ht));		// target height
+			return fixed_field(sBuf, dml_.msr_targ_ht, dmw_.msr_targ_ht);		// target height
 		else
-			return trimstr(sBuf.substr(dml_.msr_targ_ht));		
+			return fixed_field(sBuf, dml_.msr_targ_ht);		
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract target height from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract target height from the record:  ",
 			sBuf, dml_.msr_targ_ht);
 	}
 	return "";
 }
 
-std::string dna_import::ParseMsrCountValue(const std::string& sBuf, UINT32& msrCount, const std::string& calling_function)
+std::string_view dna_import::ParseMsrCountValue(const std::string& sBuf, UINT32& msrCount, std::string_view calling_function)
 {
 	try {
-		std::string count(trimstr(sBuf.substr(dml_.msr_targ2, dmw_.msr_targ2)));		// number of measurements
+		std::string_view count(fixed_field(sBuf, dml_.msr_targ2, dmw_.msr_targ2));		// number of measurements
 		if (count.empty())
-			SignalExceptionParseDNA(calling_function + "(): Could not extract number of measurements from the record:  ",
+			SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract number of measurements from the record:  ",
 				sBuf, dml_.msr_targ2);
 		msrCount = LongFromString<UINT32>(count);
 		return count;
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract number of measurements from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract number of measurements from the record:  ",
 			sBuf, dml_.msr_targ2);
 	}
 	return "";
 }
 
-std::string dna_import::ParseScaleVValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseScaleVValue(const std::string& sBuf, std::string_view calling_function)
 {
 	if (sBuf.length() <= dml_.msr_gps_vscale)
 		return "1";
 	
-	std::string scalar;
+	std::string_view scalar;
 	try {
 		if (sBuf.length() > dml_.msr_gps_pscale)
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_vscale, dmw_.msr_gps_vscale));		// v-scale
+			scalar = fixed_field(sBuf, dml_.msr_gps_vscale, dmw_.msr_gps_vscale);		// v-scale
 		else
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_vscale));					
+			scalar = fixed_field(sBuf, dml_.msr_gps_vscale);					
 
 		if (scalar.empty())
 			return "1";
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract v-scale from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract v-scale from the record:  ",
 			sBuf, dml_.msr_gps_vscale);
 	}
 
 	return scalar;
 }
 
-std::string dna_import::ParseScalePValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseScalePValue(const std::string& sBuf, std::string_view calling_function)
 {
 	if (sBuf.length() <= dml_.msr_gps_pscale)
 		return "1";
 	
-	std::string scalar;
+	std::string_view scalar;
 	
 	try {
 		if (sBuf.length() > dml_.msr_gps_lscale)
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_pscale, dmw_.msr_gps_pscale));		// p-scale
+			scalar = fixed_field(sBuf, dml_.msr_gps_pscale, dmw_.msr_gps_pscale);		// p-scale
 		else
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_pscale));
+			scalar = fixed_field(sBuf, dml_.msr_gps_pscale);
 	
 		if (scalar.empty())
 			return "1";
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract p-scale from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract p-scale from the record:  ",
 			sBuf, dml_.msr_gps_pscale);
 	}
 
 	return scalar;
 }
 
-std::string dna_import::ParseScaleLValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseScaleLValue(const std::string& sBuf, std::string_view calling_function)
 {
 	if (sBuf.length() <= dml_.msr_gps_lscale)
 		return "1";
 	
-	std::string scalar;
+	std::string_view scalar;
 
 	try {
 		if (sBuf.length() > dml_.msr_gps_hscale)
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_lscale, dmw_.msr_gps_lscale));		// l-scale
+			scalar = fixed_field(sBuf, dml_.msr_gps_lscale, dmw_.msr_gps_lscale);		// l-scale
 		else
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_lscale));					
+			scalar = fixed_field(sBuf, dml_.msr_gps_lscale);					
 	
 		if (scalar.empty())
 			return "1";
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract l-scale from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract l-scale from the record:  ",
 			sBuf, dml_.msr_gps_lscale);
 	}
 
 	return scalar;
 }
 
-std::string dna_import::ParseScaleHValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseScaleHValue(const std::string& sBuf, std::string_view calling_function)
 {
 	if (sBuf.length() <= dml_.msr_gps_hscale)
 		return "1";
 	
-	std::string scalar;
+	std::string_view scalar;
 
 	try {
 		if (sBuf.length() > (dml_.msr_gps_reframe))
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_hscale, dmw_.msr_gps_hscale));		// h-scale
+			scalar = fixed_field(sBuf, dml_.msr_gps_hscale, dmw_.msr_gps_hscale);		// h-scale
 		else
-			scalar = trimstr(sBuf.substr(dml_.msr_gps_hscale));		
+			scalar = fixed_field(sBuf, dml_.msr_gps_hscale);		
 	
 		if (scalar.empty())
 			return "1";
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract h-scale from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract h-scale from the record:  ",
 			sBuf, dml_.msr_gps_hscale);
 	}
 
 	return scalar;
 }
 
-std::string dna_import::ParseRefFrameValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseRefFrameValue(const std::string& sBuf, std::string_view calling_function)
 {
 	// Override the reference frame with the user specified frame?
 	if (projectSettings_.i.override_input_rfame)
@@ -2664,60 +3231,60 @@ std::string dna_import::ParseRefFrameValue(const std::string& sBuf, const std::s
 	if (sBuf.length() <= dml_.msr_gps_reframe)
 		return "";
 	
-	std::string frame;
+	std::string_view frame;
 	try {
 		if (sBuf.length() > (dml_.msr_gps_epoch))
-			frame = trimstr(sBuf.substr(dml_.msr_gps_reframe, dmw_.msr_gps_reframe));		// reference frame
+			frame = fixed_field(sBuf, dml_.msr_gps_reframe, dmw_.msr_gps_reframe);		// reference frame
 		else
-			frame = trimstr(sBuf.substr(dml_.msr_gps_reframe));		
+			frame = fixed_field(sBuf, dml_.msr_gps_reframe);		
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract reference frame from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract reference frame from the record:  ",
 			sBuf, dml_.msr_gps_reframe);
 	}
 
 	return frame;
 }
 
-std::string dna_import::ParseEpochValue(const std::string& sBuf, const std::string& calling_function)
+std::string_view dna_import::ParseEpochValue(const std::string& sBuf, std::string_view calling_function)
 {
 	if (sBuf.length() <= dml_.msr_gps_epoch)
 		return "";
 	
-	std::string epoch;
+	std::string_view epoch;
 	try {
 		if (sBuf.length() > static_cast<std::string::size_type>(dml_.msr_gps_epoch + dmw_.msr_gps_epoch))
-			epoch = trimstr(sBuf.substr(dml_.msr_gps_epoch, dmw_.msr_gps_epoch));		// epoch
+			epoch = fixed_field(sBuf, dml_.msr_gps_epoch, dmw_.msr_gps_epoch);		// epoch
 		else
-			epoch = trimstr(sBuf.substr(dml_.msr_gps_epoch));
+			epoch = fixed_field(sBuf, dml_.msr_gps_epoch);
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract epoch from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract epoch from the record:  ",
 			sBuf, dml_.msr_gps_epoch);
 	}
 
 	return epoch;
 }
 
-std::string dna_import::ParseGPSMsrValue(const std::string& sBuf, const std::string& element, const std::string& calling_function)
+std::string_view dna_import::ParseGPSMsrValue(const std::string& sBuf, std::string_view element, std::string_view calling_function)
 {
 	try {
-		return trimstr(sBuf.substr(dml_.msr_gps, dmw_.msr_gps));				// value
+		return fixed_field(sBuf, dml_.msr_gps, dmw_.msr_gps);				// value
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract GNSS " + element + " measurement from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract GNSS " + std::string(element) + " measurement from the record:  ",
 			sBuf, dml_.msr_gps);
 	}
 	return "";
 }
 
-std::string dna_import::ParseGPSVarValue(const std::string& sBuf, const std::string& element, const UINT32 location, const UINT32 width, const std::string& calling_function)
+std::string_view dna_import::ParseGPSVarValue(const std::string& sBuf, std::string_view element, const UINT32 location, const UINT32 width, std::string_view calling_function)
 {
 	try {
-		return trimstr(sBuf.substr(location, width));		// variance
+		return fixed_field(sBuf, location, width);		// variance
 	}
 	catch (...) {
-		SignalExceptionParseDNA(calling_function + "(): Could not extract GNSS " + element + " variance from the record:  ",
+		SignalExceptionParseDNA(std::string(calling_function) + "(): Could not extract GNSS " + std::string(element) + " variance from the record:  ",
 			sBuf, location);
 	}
 	return "";
@@ -2727,7 +3294,7 @@ void dna_import::ParseDNAMSRAngular(const std::string& sBuf, dnaMsrPtr& msr_ptr)
 {
 	// Measurement type
 	try {
-		msr_ptr->SetType(trimstr(sBuf.substr(dml_.msr_type, dmw_.msr_type)));
+		msr_ptr->SetType(fixed_field(sBuf, dml_.msr_type, dmw_.msr_type));
 	}
 	catch (...) {
 		SignalExceptionParseDNA("ParseDNAMSRAngular(): Could not extract measurement type from the record:  ",
@@ -2803,7 +3370,7 @@ UINT32 dna_import::ParseDNAMSRDirections(std::string& sBuf, dnaMsrPtr& msr_ptr,
 {
 	// Measurement type
 	try {
-		msr_ptr->SetType(trimstr(sBuf.substr(dml_.msr_type, dmw_.msr_type)));
+		msr_ptr->SetType(fixed_field(sBuf, dml_.msr_type, dmw_.msr_type));
 	}
 	catch (...) {
 		SignalExceptionParseDNA("ParseDNAMSRDirections(): Could not extract measurement type from the record:  ",
@@ -2857,14 +3424,14 @@ UINT32 dna_import::ParseDNAMSRDirections(std::string& sBuf, dnaMsrPtr& msr_ptr,
 	for (UINT32 dirn=0; dirn<dirnCount; ++dirn)
 	{
 		m_lineNo++;
-		// Obtain exclusive use of the input file pointer
-		import_file_mutex.lock();
-		getline((*ifsInputFILE_), sBuf);
-		// release file pointer mutex
-		import_file_mutex.unlock();
+		{
+			// Obtain exclusive use of the input file pointer
+			boost::lock_guard<boost::mutex> lock(import_file_mutex_);
+			getline((*isDNARecords_), sBuf);
+		}
 
 		// get ignore flag for sub direction and remove accordingly
-		subignoreMsr = boost::iequals("*", sBuf.substr(dml_.msr_ignore, dmw_.msr_ignore));
+		subignoreMsr = boost::iequals("*", std::string_view(sBuf).substr(dml_.msr_ignore, dmw_.msr_ignore));
 
 		if (subignoreMsr)
 		{
@@ -2879,7 +3446,7 @@ UINT32 dna_import::ParseDNAMSRDirections(std::string& sBuf, dnaMsrPtr& msr_ptr,
 
 		dirnTmp.SetFirst(msr_ptr->GetFirst());
 		dirnTmp.SetIgnore(subignoreMsr);
-		g_parsemsr_tally.D++;
+		parsemsr_tally_.D++;
 
 		// Second target station
 		dirnTmp.SetTarget(ParseTarget2Value(sBuf, "ParseDNAMSRDirections"));
@@ -3672,8 +4239,8 @@ void dna_import::LoadNetworkFiles(pvstn_t binaryStn, pvmsr_t binaryMsr,
 
 void dna_import::LoadBinaryFiles(pvstn_t binaryStn, pvmsr_t binaryMsr)
 {
-	g_parsestn_tally.initialise();
-	g_parsemsr_tally.initialise();
+	parsestn_tally_.initialise();
+	parsemsr_tally_.initialise();
 
 	try {
 		// Load binary stations data.  Throws runtime_error on failure.
@@ -3814,7 +4381,7 @@ void dna_import::ImportStnsMsrsFromNetwork(vdnaStnPtr* vStations, vdnaMsrPtr* vM
 		{
 			stnPtr->SetStationRec(binaryStn.at(*_it_data));
 			vStations->push_back(stnPtr);
-			g_parsestn_tally.addstation(stnPtr->GetConstraints());
+			parsestn_tally_.addstation(stnPtr->GetConstraints());
 			stnPtr.reset(new CDnaStation(datum_.GetName(), datum_.GetEpoch_s()));
 		}
 
@@ -3825,7 +4392,7 @@ void dna_import::ImportStnsMsrsFromNetwork(vdnaStnPtr* vStations, vdnaMsrPtr* vM
 		{
 			stnPtr->SetStationRec(binaryStn.at(*_it_data));
 			vStations->push_back(stnPtr);
-			g_parsestn_tally.addstation(stnPtr->GetConstraints());
+			parsestn_tally_.addstation(stnPtr->GetConstraints());
 			stnPtr.reset(new CDnaStation(datum_.GetName(), datum_.GetEpoch_s()));
 		}
 
@@ -3870,67 +4437,67 @@ void dna_import::ImportStnsMsrsFromNetwork(vdnaStnPtr* vStations, vdnaMsrPtr* vM
 			switch (it_msr->measType)
 			{
 			case 'A': // Horizontal angle
-				g_parsemsr_tally.A++;
+				parsemsr_tally_.A++;
 				break;
 			case 'B': // Geodetic azimuth
-				g_parsemsr_tally.B++;
+				parsemsr_tally_.B++;
 				break;
 			case 'C': // Chord dist
-				g_parsemsr_tally.C++;
+				parsemsr_tally_.C++;
 				break;
 			case 'D': // Direction set
 				if (it_msr->measStart == xMeas)
-					g_parsemsr_tally.D += it_msr->vectorCount1;
+					parsemsr_tally_.D += it_msr->vectorCount1;
 				break;
 			case 'E': // Ellipsoid arc
-				g_parsemsr_tally.E++;
+				parsemsr_tally_.E++;
 				break;
 			case 'G': // GPS Baseline
-				g_parsemsr_tally.G += 3;
+				parsemsr_tally_.G += 3;
 				break;
 			case 'H': // Orthometric height
-				g_parsemsr_tally.H++;
+				parsemsr_tally_.H++;
 				break;
 			case 'I': // Astronomic latitude
-				g_parsemsr_tally.I++;
+				parsemsr_tally_.I++;
 				break;
 			case 'J': // Astronomic longitude
-				g_parsemsr_tally.J++;
+				parsemsr_tally_.J++;
 				break;
 			case 'K': // Astronomic azimuth
-				g_parsemsr_tally.K++;
+				parsemsr_tally_.K++;
 				break;
 			case 'L': // Level difference
-				g_parsemsr_tally.L++;
+				parsemsr_tally_.L++;
 				break;
 			case 'M': // MSL arc
-				g_parsemsr_tally.M++;
+				parsemsr_tally_.M++;
 				break;
 			case 'P': // Geodetic latitude
-				g_parsemsr_tally.P++;
+				parsemsr_tally_.P++;
 				break;
 			case 'Q': // Geodetic longitude
-				g_parsemsr_tally.Q++;
+				parsemsr_tally_.Q++;
 				break;
 			case 'R': // Ellipsoidal height
-				g_parsemsr_tally.R++;
+				parsemsr_tally_.R++;
 				break;
 			case 'S': // Slope distance
-				g_parsemsr_tally.S++;
+				parsemsr_tally_.S++;
 				break;
 			case 'V': // Zenith distance
-				g_parsemsr_tally.V++;
+				parsemsr_tally_.V++;
 				break;
 			case 'X': // GPS Baseline cluster
 				if (it_msr->measStart == xMeas)
-					g_parsemsr_tally.X += it_msr->vectorCount1 * 3;
+					parsemsr_tally_.X += it_msr->vectorCount1 * 3;
 				break;
 			case 'Y': // GPS point cluster
 				if (it_msr->measStart == xMeas)
-					g_parsemsr_tally.Y += it_msr->vectorCount1 * 3;
+					parsemsr_tally_.Y += it_msr->vectorCount1 * 3;
 				break;
 			case 'Z': // Vertical angle
-				g_parsemsr_tally.Z++;
+				parsemsr_tally_.Z++;
 				break;
 			}
 
@@ -3986,7 +4553,7 @@ void dna_import::ImportStnsMsrsFromBlock(vdnaStnPtr* vStations, vdnaMsrPtr* vMea
 	{
 		stnPtr->SetStationRec(binaryStn.at(*_it_data));
 		vStations->push_back(stnPtr);
-		g_parsestn_tally.addstation(stnPtr->GetConstraints());
+		parsestn_tally_.addstation(stnPtr->GetConstraints());
 		stnPtr.reset(new CDnaStation(datum_.GetName(), datum_.GetEpoch_s()));
 	}
 
@@ -3997,7 +4564,7 @@ void dna_import::ImportStnsMsrsFromBlock(vdnaStnPtr* vStations, vdnaMsrPtr* vMea
 	{
 		stnPtr->SetStationRec(binaryStn.at(*_it_data));
 		vStations->push_back(stnPtr);
-		g_parsestn_tally.addstation(stnPtr->GetConstraints());
+		parsestn_tally_.addstation(stnPtr->GetConstraints());
 		stnPtr.reset(new CDnaStation(datum_.GetName(), datum_.GetEpoch_s()));
 	}
 
@@ -4028,67 +4595,67 @@ void dna_import::ImportStnsMsrsFromBlock(vdnaStnPtr* vStations, vdnaMsrPtr* vMea
 		switch (it_msr->measType)
 		{
 		case 'A': // Horizontal angle
-			g_parsemsr_tally.A++;
+			parsemsr_tally_.A++;
 			break;
 		case 'B': // Geodetic azimuth
-			g_parsemsr_tally.B++;
+			parsemsr_tally_.B++;
 			break;
 		case 'C': // Chord dist
-			g_parsemsr_tally.C++;
+			parsemsr_tally_.C++;
 			break;
 		case 'D': // Direction set
 			if (it_msr->measStart == xMeas)
-				g_parsemsr_tally.D += it_msr->vectorCount1;
+				parsemsr_tally_.D += it_msr->vectorCount1;
 			break;
 		case 'E': // Ellipsoid arc
-			g_parsemsr_tally.E++;
+			parsemsr_tally_.E++;
 			break;
 		case 'G': // GPS Baseline
-			g_parsemsr_tally.G += 3;
+			parsemsr_tally_.G += 3;
 			break;
 		case 'H': // Orthometric height
-			g_parsemsr_tally.H++;
+			parsemsr_tally_.H++;
 			break;
 		case 'I': // Astronomic latitude
-			g_parsemsr_tally.I++;
+			parsemsr_tally_.I++;
 			break;
 		case 'J': // Astronomic longitude
-			g_parsemsr_tally.J++;
+			parsemsr_tally_.J++;
 			break;
 		case 'K': // Astronomic azimuth
-			g_parsemsr_tally.K++;
+			parsemsr_tally_.K++;
 			break;
 		case 'L': // Level difference
-			g_parsemsr_tally.L++;
+			parsemsr_tally_.L++;
 			break;
 		case 'M': // MSL arc
-			g_parsemsr_tally.M++;
+			parsemsr_tally_.M++;
 			break;
 		case 'P': // Geodetic latitude
-			g_parsemsr_tally.P++;
+			parsemsr_tally_.P++;
 			break;
 		case 'Q': // Geodetic longitude
-			g_parsemsr_tally.Q++;
+			parsemsr_tally_.Q++;
 			break;
 		case 'R': // Ellipsoidal height
-			g_parsemsr_tally.R++;
+			parsemsr_tally_.R++;
 			break;
 		case 'S': // Slope distance
-			g_parsemsr_tally.S++;
+			parsemsr_tally_.S++;
 			break;
 		case 'V': // Zenith distance
-			g_parsemsr_tally.V++;
+			parsemsr_tally_.V++;
 			break;
 		case 'X': // GPS Baseline cluster
 			if (it_msr->measStart == xMeas)
-				g_parsemsr_tally.X += it_msr->vectorCount1 * 3;
+				parsemsr_tally_.X += it_msr->vectorCount1 * 3;
 			break;
 		case 'Y': // GPS point cluster
 			if (it_msr->measStart == xMeas)
-				g_parsemsr_tally.Y += it_msr->vectorCount1 * 3;
+				parsemsr_tally_.Y += it_msr->vectorCount1 * 3;
 			break;
 		case 'Z': // Vertical angle
-			g_parsemsr_tally.Z++;
+			parsemsr_tally_.Z++;
 			break;
 		}
 
@@ -4122,7 +4689,7 @@ void dna_import::SignalComplete()
 	percentComplete_ = -99.0;
 	
 	// Obtain exclusive use of the input file pointer
-	import_file_mutex.lock();
+	import_file_mutex_.lock();
 	
 	try {
 		if (ifsInputFILE_ != 0)
@@ -4144,7 +4711,7 @@ void dna_import::SignalComplete()
 	ifsInputFILE_ = 0;
 
 	// release file pointer mutex
-	import_file_mutex.unlock();
+	import_file_mutex_.unlock();
 }
 
 void dna_import::SignalExceptionParse(std::string msg, int i)
@@ -4888,20 +5455,21 @@ void dna_import::PrintMeasurementsToStations(std::string& m2s_file, MsrTally* pa
 	vmsrtally v_stnmsrTally;
 	v_aml_pair vAssocMsrList;
 
-	vstn_t bstBinaryRecords;
-	vmsr_t bmsBinaryRecords;
+	// The records are only read, so are used in place
+	mapped_stn_t bstBinaryRecords;
+	mapped_msr_t bmsBinaryRecords;
 	
 	try {
-		// Load binary stations data.  Throws runtime_error on failure.
+		// Map binary stations data.  Throws runtime_error on failure.
 		dna_io_bst bst;
-		bst.load_bst_file(bst_file, &bstBinaryRecords, bst_meta_);
+		bst.map_bst_file(bst_file, bstBinaryRecords, bst_meta_);
 
-		// Load binary measurements data.  Throws runtime_error on failure.
+		// Map binary measurements data.  Throws runtime_error on failure.
 		dna_io_bms bms;
-		bms.load_bms_file(bms_file, &bmsBinaryRecords, bms_meta_);
+		bms.map_bms_file(bms_file, bmsBinaryRecords, bms_meta_);
 
 		// Load aml file.  Throws runtime_error on failure.
-		aml.load_aml_file(aml_file, &vAssocMsrList, &bmsBinaryRecords);
+		aml.load_aml_file(aml_file, &vAssocMsrList, bmsBinaryRecords);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionInterop(e.what(), 0, NULL);
@@ -4928,7 +5496,7 @@ void dna_import::PrintMeasurementsToStations(std::string& m2s_file, MsrTally* pa
 	default:
 	{
 		// sort summary according to original station file order
-		CompareStnFileOrder<station_t, UINT32> stnorderCompareFunc(&bstBinaryRecords);
+		CompareStnFileOrder<station_t, UINT32, mapped_stn_t> stnorderCompareFunc(&bstBinaryRecords);
 		std::sort(vStationList.begin(), vStationList.end(), stnorderCompareFunc);
 	}
 	break;
@@ -4955,7 +5523,7 @@ void dna_import::PrintMeasurementsToStations(std::string& m2s_file, MsrTally* pa
 
 		m2s_stream << OUTPUTLINE << std::endl << std::endl;
 
-		aml.write_msr_to_stn(m2s_stream, &bstBinaryRecords, &vStationList, v_stnmsrTally, parsemsrTally);
+		aml.write_msr_to_stn(m2s_stream, bstBinaryRecords, &vStationList, v_stnmsrTally, parsemsrTally);
 
 		m2s_stream.close();
 	}
@@ -5047,21 +5615,60 @@ UINT32 dna_import::RemoveDuplicateStations(vdnaStnPtr* vStations,
 
 	// search nearby stations using a radial search	
 	//
-	// begin by sorting on latitude
+	// begin by sorting on latitude, so that each pair of nearby stations
+	// is reported from the station with the lower latitude
 	std::sort(vStations->begin(), vStations->end(), CompareLatitude<dnaStnPtr>());
 
 	vnearbyStations->clear();
-	NearbyStation_LowAcc<dnaStnPtr, stringstring_doubledouble_pair, double> 
-		nearbyStnLCompareFunc(projectSettings_.i.search_stn_radius, vnearbyStations);
-	NearbyStation_HighAcc<dnaStnPtr, double, stringstring_doubledouble_pair, CDnaEllipsoid> 
-		nearbyStnHCompareFunc(projectSettings_.i.search_stn_radius, vnearbyStations, 
-			datum_.GetEllipsoid());
-
-	// Find all occurrences of nearby stations, using a function appropriate for the search distance
-	if (projectSettings_.i.search_stn_radius < 10.0)
-		copy_if_all_occurrences(vStations->begin(), vStations->end(), nearbyStnLCompareFunc);
-	else
-		copy_if_all_occurrences(vStations->begin(), vStations->end(), nearbyStnHCompareFunc);
+
+	const double searchRadius(projectSettings_.i.search_stn_radius);
+	const CDnaEllipsoid ellipsoid(datum_.GetEllipsoid());
+
+	// Index the stations in cells slightly larger than the search radius,
+	// to allow for the difference between the sphere on which the cells 
+	// are formed and the sphere or ellipsoid on which distances are computed
+	station_grid_index stnGrid;
+	stnGrid.build(*vStations, searchRadius * 1.01);
+
+	// Search the stations of each cell concurrently, testing each station 
+	// against the stations in the surrounding cells only.  The cells are 
+	// shared between no more threads than the import may use.
+	const UINT32 threads(ImportThreads());
+	const v_grid_cell& cells(stnGrid.cells());
+	std::vector<v_stringstring_doubledouble_pair> vcellNearbyStations(cells.size());
+	vUINT32 vcells(cells.size());
+	for (UINT32 cell(0); cell<vcells.size(); ++cell)
+		vcells.at(cell) = cell;
+
+	parallel_for_each(vcells.begin(), vcells.end(),
+		[&vStations, &stnGrid, &cells, &vcellNearbyStations, &searchRadius, &ellipsoid](const UINT32& cell) {
+			NearbyStation_LowAcc<dnaStnPtr, stringstring_doubledouble_pair, double> 
+				nearbyStnLCompareFunc(searchRadius, &vcellNearbyStations.at(cell));
+			NearbyStation_HighAcc<dnaStnPtr, double, stringstring_doubledouble_pair, CDnaEllipsoid> 
+				nearbyStnHCompareFunc(searchRadius, &vcellNearbyStations.at(cell), ellipsoid);
+
+			UINT32 stn;
+			for (UINT32 s(cells.at(cell).begin); s<cells.at(cell).end; ++s)
+			{
+				stn = stnGrid.stations().at(s);
+				stnGrid.for_each_neighbour(stn,
+					[&vStations, &stn, &searchRadius, &nearbyStnLCompareFunc, &nearbyStnHCompareFunc](const UINT32& other) {
+						// Test each pair once only
+						if (other <= stn)
+							return;
+						// Use a function appropriate for the search distance
+						if (searchRadius < 10.0)
+							nearbyStnLCompareFunc(vStations->at(stn), vStations->at(other));
+						else
+							nearbyStnHCompareFunc(vStations->at(stn), vStations->at(other));
+					});
+			}
+		},
+		std::max(UINT32(64), static_cast<UINT32>(vcells.size() / threads)));
+
+	std::vector<v_stringstring_doubledouble_pair>::const_iterator _it_cell;
+	for (_it_cell=vcellNearbyStations.begin(); _it_cell!=vcellNearbyStations.end(); ++_it_cell)
+		vnearbyStations->insert(vnearbyStations->end(), _it_cell->begin(), _it_cell->end());
 	
 	// sort station pairs by name
 	std::sort(vnearbyStations->begin(), vnearbyStations->end(), CompareStationPairs<stringstring_doubledouble_pair>());
@@ -5073,6 +5680,12 @@ UINT32 dna_import::RemoveDuplicateStations(vdnaStnPtr* vStations,
 }
 	
 
+// Finds measurements (including G baselines and X clusters) which are
+// similar to the measurement before them in sort order.  Unlike the G-in-X
+// search (FindSimilarGXMeasurements), similar measurements here are of the
+// same type and compare equal, so sorting brings them together, and one
+// O(n log n) sort followed by a linear scan finds them all.  An index of
+// station pairs would find the same pairs at no lower cost.
 UINT32 dna_import::FindSimilarMeasurements(vdnaMsrPtr* vMeasurements, vdnaMsrPtr* vSimilarMeasurements)
 {
 	// sort measurements list by Type then by First station
@@ -5252,80 +5865,98 @@ UINT32 dna_import::FindSimilarGXMeasurements(vdnaMsrPtr* vMeasurements, vdnaMsrP
 	meastypeCompareFuncGX.SetComparand(msrTypes);
 	erase_if(vMeasurementsG, meastypeCompareFuncGX);
 
-	// Don't think the following sorts are needed
-	// sort measurements list by Type then by First station
-	//sort(vMeasurementsG.begin(), vMeasurementsG.end(), CompareMsr<CDnaMeasurement>());
-	//sort(vMeasurementsX.begin(), vMeasurementsX.end(), CompareMsr<CDnaMeasurement>());
-
-	bool similarG(false);
-	int similar_msrs_found(0);
-	vSimilarMeasurements->clear();
-
-	_it_vdnamsrptr _it_msrG(vMeasurementsG.begin());
-	vstring stationsX;
-	std::vector<CDnaGpsBaseline> *vgpsBslsX, *vgpsBslsG;
-	std::string epochX, epochG;
-	boost::gregorian::date dateObsX, dateObsG;
-	std::stringstream strdiffDays;
-	size_t diffDays;
-	vUINT32 cluster_ids;
-
-	// For each X Cluster, get the list of stations
-	for (_it_vdnamsrptr _it_msrX(vMeasurementsX.begin()); _it_msrX!=vMeasurementsX.end(); ++_it_msrX)
-	{
-		vgpsBslsX = _it_msrX->get()->GetBaselines_ptr();
-		GetGXMsrStations<std::string>(vgpsBslsX, stationsX);
+	// Index the G baselines by first station, so that the G baselines
+	// connected to each X cluster can be found without testing every
+	// G baseline against every cluster
+	v_string_uint32_pair vGFirstStations;
+	vGFirstStations.reserve(vMeasurementsG.size());
+	UINT32 g, x;
+	for (g=0; g<vMeasurementsG.size(); ++g)
+		vGFirstStations.push_back(string_uint32_pair(
+			vMeasurementsG.at(g)->GetBaselines_ptr()->at(0).GetFirst(), g));
+	std::sort(vGFirstStations.begin(), vGFirstStations.end());
+
+	vUINT32 vclusters(vMeasurementsX.size());
+	for (x=0; x<vclusters.size(); ++x)
+		vclusters.at(x) = x;
+
+	// Share the clusters between no more threads than the import may use
+	const UINT32 threads(ImportThreads());
+
+	// The similar G baselines of each X cluster, in the order of vMeasurementsG
+	std::vector<vUINT32> vclusterSimilarG(vMeasurementsX.size());
+
+	parallel_for_each(vclusters.begin(), vclusters.end(),
+		[&vMeasurementsX, &vMeasurementsG, &vGFirstStations, &vclusterSimilarG](const UINT32& cluster) {
+			vstring stationsX;
+			vUINT32& similarG(vclusterSimilarG.at(cluster));
+			vstring::const_iterator _it_stn;
+			it_pair_string_vUINT32 it_bsl_range;
+			_it_string_uint32_pair _it_bsl;
+			
+			// For each X Cluster, get the list of stations
+			GetGXMsrStations<std::string>(vMeasurementsX.at(cluster)->GetBaselines_ptr(), stationsX);
+			std::sort(stationsX.begin(), stationsX.end());
 
-		std::sort(stationsX.begin(), stationsX.end());
+			// Find the G baselines which have both stations in the list of 
+			// X Cluster stations
+			for (_it_stn=stationsX.begin(); _it_stn!=stationsX.end(); ++_it_stn)
+			{
+				it_bsl_range = std::equal_range(vGFirstStations.begin(), vGFirstStations.end(), 
+					string_uint32_pair(*_it_stn, 0), 
+					[](const string_uint32_pair& lhs, const string_uint32_pair& rhs) {
+						return lhs.first < rhs.first;
+					});
 
-		similarG = false;
+				for (_it_bsl=it_bsl_range.first; _it_bsl!=it_bsl_range.second; ++_it_bsl)
+					if (binary_search(stationsX.begin(), stationsX.end(), 
+						vMeasurementsG.at(_it_bsl->second)->GetBaselines_ptr()->at(0).GetTarget()))
+						similarG.push_back(_it_bsl->second);
+			}
 
-		// Check whether both stations in the G baseline exist
-		// in the list of X Cluster stations
-		for (_it_msrG=vMeasurementsG.begin(); _it_msrG!=vMeasurementsG.end(); ++_it_msrG)
-		{
-			vgpsBslsG = _it_msrG->get()->GetBaselines_ptr();
-			
-			// Is the first G baseline station in the cluster?
-			if (!binary_search(stationsX.begin(), stationsX.end(), vgpsBslsG->at(0).GetFirst()))
-				// No, then this isn't a "duplicate"
-				continue;
+			if (similarG.empty())
+				return;
 
-			// Is the second G baseline station in the cluster?
-			if (!binary_search(stationsX.begin(), stationsX.end(), vgpsBslsG->at(0).GetTarget()))
-				// No, then this isn't a "duplicate"
-				continue;
+			std::sort(similarG.begin(), similarG.end());
 
 			// Okay, both stations are in the cluster... check if this is a "duplicate"
 			// by examining epoch.  Here, the assumption is - if the observation epochs of the 
 			// X and G measurements are the same, then the X and G measurements have come from
 			// the same source data and are therefore duplicates
-			epochX = _it_msrX->get()->GetEpoch();
-			epochG = _it_msrG->get()->GetEpoch();
-
-			dateObsX = dateFromString<boost::gregorian::date>(epochX);
-			dateObsG = dateFromString<boost::gregorian::date>(epochG);
+			boost::gregorian::date dateObsX(
+				dateFromString<boost::gregorian::date>(vMeasurementsX.at(cluster)->GetEpoch()));
+
+			erase_if(similarG, 
+				[&vMeasurementsG, &dateObsX](const UINT32& bsl) {
+					boost::gregorian::days dateDifference = dateObsX - 
+						dateFromString<boost::gregorian::date>(vMeasurementsG.at(bsl)->GetEpoch());
+					return abs(dateDifference.days()) >= 5;
+				});
+		},
+		std::max(UINT32(16), static_cast<UINT32>(vclusters.size() / threads)));
 
-			boost::gregorian::days dateDifference = dateObsX - dateObsG;
-			
-			diffDays = abs(dateDifference.days());
-			//strdiffDays << "Elapsed days: " << dateDifference;
-			//TRACE("%s\n", strdiffDays.str().c_str());
+	int similar_msrs_found(0);
+	vSimilarMeasurements->clear();
 
-			if (diffDays < 5)
-			{
-				++similar_msrs_found;
-				similarG = true;
-				vSimilarMeasurements->push_back(*_it_msrG);
-				if (projectSettings_.i.ignore_similar_msr)
-					cluster_ids.push_back(_it_msrG->get()->GetClusterID());
-			}
-		}
+	_it_vdnamsrptr _it_msrG;
+	vUINT32 cluster_ids;
+	vUINT32::const_iterator _it_bsl;
 
+	for (x=0; x<vMeasurementsX.size(); ++x)
+	{
 		// Were similar G baselines found for this cluster?
-		if (similarG)
-			vSimilarMeasurements->push_back(*_it_msrX);
+		if (vclusterSimilarG.at(x).empty())
+			continue;
 
+		for (_it_bsl=vclusterSimilarG.at(x).begin(); _it_bsl!=vclusterSimilarG.at(x).end(); ++_it_bsl)
+		{
+			++similar_msrs_found;
+			vSimilarMeasurements->push_back(vMeasurementsG.at(*_it_bsl));
+			if (projectSettings_.i.ignore_similar_msr)
+				cluster_ids.push_back(vMeasurementsG.at(*_it_bsl)->GetClusterID());
+		}
+
+		vSimilarMeasurements->push_back(vMeasurementsX.at(x));
 	}
 
 	// If required, ignore the measurements
@@ -5341,31 +5972,49 @@ UINT32 dna_import::FindSimilarGXMeasurements(vdnaMsrPtr* vMeasurements, vdnaMsrP
 
 void dna_import::SortandMapStations(vdnaStnPtr* vStations)
 {
-	size_t stnCount(vStations->size());
+	UINT32 stnCount(static_cast<UINT32>(vStations->size()));
 	vStnsMap_sortName_.clear();
 	vStnsMap_sortName_.reserve(stnCount);
 
 	UINT32 stnIndex(0);
 
-	// sort on station name (by string, not int!!!)
-	// Note that the sort order after this will be the final order
-	std::sort(vStations->begin(), vStations->end());
-
-	// Create the Station-Name / ID map
+	// Create the Station-Name / ID map (in input order)
 	string_uint32_pair stnID;
 	for (stnIndex = 0; stnIndex < stnCount; stnIndex++)
 	{
 		stnID.first = vStations->at(stnIndex)->GetName();
 		stnID.second = stnIndex;
 		vStnsMap_sortName_.push_back(stnID);
-		vStations->at(stnIndex)->SetnameOrder(stnIndex);
 	}
 
-	// sort on station name (i.e. first of the pair)
-	std::sort(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), StationNameIDCompareName());
-
 	if (vStnsMap_sortName_.size() < stnCount)
 		throw XMLInteropException("SortandMapStations(): Could not allocate sufficient memory for the Station map.", 0);
+
+	// sort the map on station name (by string, not int!!!), and on input 
+	// order where names are equal.  The map holds the names contiguously, so 
+	// the comparisons need not read the names through the station pointers.
+	parallel_sort(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(),
+		[](const string_uint32_pair& lhs, const string_uint32_pair& rhs) {
+			const int compare(lhs.first.compare(rhs.first));
+			if (compare != 0)
+				return compare < 0;
+			return lhs.second < rhs.second;
+		},
+		std::max(projectSettings_.i.stn_sort_chunk_size, stnCount / ImportThreads()));
+
+	// Order the stations as per the map.
+	// Note that the sort order after this will be the final order
+	vdnaStnPtr vStationsSorted(stnCount);
+	for (stnIndex = 0; stnIndex < stnCount; stnIndex++)
+	{
+		vStationsSorted.at(stnIndex) = vStations->at(vStnsMap_sortName_.at(stnIndex).second);
+		vStationsSorted.at(stnIndex)->SetnameOrder(stnIndex);
+		vStnsMap_sortName_.at(stnIndex).second = stnIndex;
+	}
+	vStations->swap(vStationsSorted);
+
+	// Index the names for the measurement station lookups
+	stnsMapIndex_.build(vStnsMap_sortName_);
 }
 
 
@@ -5643,6 +6292,7 @@ void dna_import::SerialiseMap(const std::string& stnmap_file)
 		// write the aml file.
 		dna_io_map map;
 		map.write_map_file(stnmap_file, &vStnsMap_sortName_);
+		map.write_map_index_file(stnmap_file, stnsMapIndex_);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionInterop(e.what(), 0, NULL);
@@ -6117,9 +6767,9 @@ void dna_import::MapMeasurementStations(vdnaMsrPtr* vMeasurements, pvASLPtr vAss
 		// 1. All other measurements which have <First>
 		at_station_name = _it_msr->get()->GetFirst();		// GetFirst() invokes CDnaMeasurement member function
 		
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), at_station_name, StationNameIDCompareName());
+		at_station_index = stnsMapIndex_.find(at_station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (at_station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << at_station_name << " for a " << _it_msr->get()->GetTypeC() << " measurement";
@@ -6157,8 +6807,6 @@ void dna_import::MapMeasurementStations(vdnaMsrPtr* vMeasurements, pvASLPtr vAss
 		}
 
 		// Increment ASL associated measurement count (i.e. CAStationList.assocMsrs_)
-		at_station_index = it_stnmap_range.first->second;
-		
 		_it_msr->get()->SetStn1Index(at_station_index);
 		if (!vAssocStnList->at(at_station_index))
 			vAssocStnList->at(at_station_index).reset(new CAStationList);
@@ -6202,9 +6850,9 @@ void dna_import::MapMeasurementStations(vdnaMsrPtr* vMeasurements, pvASLPtr vAss
 		// 2. All measurements which have <Target> or <Second>
 		to_station_name = _it_msr->get()->GetTarget();		// GetTarget() invokes specialised class (i.e. CDnaDistance, etc) member function
 
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), to_station_name, StationNameIDCompareName());
+		to_station_index = stnsMapIndex_.find(to_station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (to_station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << to_station_name << " was not loaded from the stations map.  Please ensure that " << to_station_name << " is included in the list of network stations.";
@@ -6212,8 +6860,6 @@ void dna_import::MapMeasurementStations(vdnaMsrPtr* vMeasurements, pvASLPtr vAss
 		}
 
 		// Increment ASL associated measurement count (i.e. CAStationList.assocMsrs_)
-		to_station_index = it_stnmap_range.first->second;
-		
 		_it_msr->get()->SetStn2Index(to_station_index);
 
 		if (!vAssocStnList->at(to_station_index))
@@ -6273,9 +6919,9 @@ void dna_import::MapMeasurementStations(vdnaMsrPtr* vMeasurements, pvASLPtr vAss
 		// 3. All measurements which have <Target2> or <Third>
 		to2_station_name = _it_msr->get()->GetTarget2();	// GetTarget2() invokes specialised class (i.e. CDnaAngle, etc) member function
 		
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), to2_station_name, StationNameIDCompareName());
+		to2_station_index = stnsMapIndex_.find(to2_station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (to2_station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << to2_station_name << " was not loaded from the stations map.  Please ensure that " << to2_station_name << " is included in the list of network stations.";
@@ -6283,8 +6929,6 @@ void dna_import::MapMeasurementStations(vdnaMsrPtr* vMeasurements, pvASLPtr vAss
 		}
 
 		// Increment ASL associated measurement count (i.e. CAStationList.assocMsrs_)
-		to2_station_index = it_stnmap_range.first->second;
-		
 		_it_msr->get()->SetStn3Index(to2_station_index);
 
 		if (!vAssocStnList->at(to2_station_index))
@@ -6431,9 +7075,9 @@ void dna_import::MapMeasurementStationsBsl(std::vector<CDnaGpsBaseline>* vGpsBas
 		// <First> station
 		station_name = _it_msr->GetFirst();
 		
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), station_name, StationNameIDCompareName());
+		station_index = stnsMapIndex_.find(station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << station_name << " is referenced in measurement '" << _it_msr->GetType() << "' " <<
@@ -6444,8 +7088,6 @@ void dna_import::MapMeasurementStationsBsl(std::vector<CDnaGpsBaseline>* vGpsBas
 		}
 
 		// Increment ASL associated measurement count (i.e. CAStationList.assocMsrs_)
-		station_index = it_stnmap_range.first->second;
-		
 		_it_msr->SetStn1Index(station_index);
 		if (!vAssocStnList->at(station_index))
 			vAssocStnList->at(station_index).reset(new CAStationList);
@@ -6459,9 +7101,9 @@ void dna_import::MapMeasurementStationsBsl(std::vector<CDnaGpsBaseline>* vGpsBas
 		// <Second> station
 		station_name = _it_msr->GetTarget();
 
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), station_name, StationNameIDCompareName());
+		station_index = stnsMapIndex_.find(station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << station_name << " is referenced in measurement '" << _it_msr->GetType() << "' " <<
@@ -6472,8 +7114,6 @@ void dna_import::MapMeasurementStationsBsl(std::vector<CDnaGpsBaseline>* vGpsBas
 		}
 
 		// Increment ASL associated measurement count (i.e. CAStationList.assocMsrs_)
-		station_index = it_stnmap_range.first->second;
-		
 		_it_msr->SetStn2Index(station_index);
 		if (!vAssocStnList->at(station_index))
 			vAssocStnList->at(station_index).reset(new CAStationList);
@@ -6543,9 +7183,9 @@ void dna_import::MapMeasurementStationsPnt(std::vector<CDnaGpsPoint>* vGpsPoints
 		// <First> station
 		station_name = _it_msr->GetFirst();
 		
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), station_name, StationNameIDCompareName());
+		station_index = stnsMapIndex_.find(station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << station_name << " is not in the stations map.  Please ensure that " << station_name << " is included in the list of stations.";
@@ -6553,8 +7193,6 @@ void dna_import::MapMeasurementStationsPnt(std::vector<CDnaGpsPoint>* vGpsPoints
 		}
 
 		// Increment ASL associated measurement count (i.e. CAStationList.assocMsrs_)
-		station_index = it_stnmap_range.first->second;
-		
 		_it_msr->SetStn1Index(station_index);
 		if (!vAssocStnList->at(station_index))
 			vAssocStnList->at(station_index).reset(new CAStationList);
@@ -6608,17 +7246,15 @@ void dna_import::MapMeasurementStationsDir(std::vector<CDnaDirection>* vDirectio
 		// one direction to the next in the set
 		at_station_name = _it_msr->GetFirst();
 		
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), at_station_name, StationNameIDCompareName());
+		at_station_index = stnsMapIndex_.find(at_station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (at_station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << at_station_name << " is not in the stations map.  Please ensure that " << at_station_name << " is included in the list of stations.";
 			throw XMLInteropException(ss.str(), 0);
 		}
 
-		at_station_index = it_stnmap_range.first->second;
-		
 		// This is needed to initialise the at station index for every
 		// target direction
 		_it_msr->SetStn1Index(at_station_index);
@@ -6628,17 +7264,15 @@ void dna_import::MapMeasurementStationsDir(std::vector<CDnaDirection>* vDirectio
 		// <Second> station
 		to_station_name = _it_msr->GetTarget();
 		
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), to_station_name, StationNameIDCompareName());
+		to_station_index = stnsMapIndex_.find(to_station_name);
 
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if (to_station_index == station_name_index::npos)
 		{
 			ss.str("");
 			ss << to_station_name << " was not loaded from the stations map.  Please ensure that " << to_station_name << " is included in the list of network stations.";
 			throw XMLInteropException(ss.str(), 0);
 		}
 
-		to_station_index = it_stnmap_range.first->second;
-		
 		_it_msr->SetStn2Index(to_station_index);
 		if (!vAssocStnList->at(to_station_index))
 			vAssocStnList->at(to_station_index).reset(new CAStationList);
@@ -6658,20 +7292,184 @@ void dna_import::MapMeasurementStationsDir(std::vector<CDnaDirection>* vDirectio
 		vAssocStnList->at(*_it_stn).get()->IncrementMsrCount();
 }
 
-void dna_import::CompleteAssociationLists(vdnaMsrPtr* vMeasurements, pvASLPtr vAssocStnList, pvUINT32 vAssocMsrList, const _AML_TYPE_ aml_type)
+// Calls f(stnIndex, valid) once for each association of the measurement msr 
+// with a station, where valid is true if the association makes the station 
+// valid (i.e. the measurement is not ignored).  Returns the number of 
+// binary measurements (aml_type = str_msr) or measurement class instances 
+// (aml_type = cls_msr) occupied by the measurement.
+// - Clusters of directions and GNSS baselines are associated once with each 
+//   of their (unique) stations
+// - Clusters of GNSS points are associated once with each point
+// - All other measurements are associated once with each of their stations
+template<typename Func>
+UINT32 dna_import::ForEachStationAssociation(const dnaMsrPtr& msr, const pvASLPtr vAssocStnList, const _AML_TYPE_ aml_type, Func& f)
 {
-	CAStationList* currentASL;
+	UINT32 bmsCount(0);
+	
+	// Unique list of stations involved in a cluster, with validity
+	std::vector< std::pair<UINT32, bool> > msrStations;
+	std::vector< std::pair<UINT32, bool> >::iterator _it_stn, _it_stn_unique;
+	
+	std::vector<CDnaDirection>* vDirns;
+	std::vector<CDnaDirection>::iterator _it_dir;
+	std::vector<CDnaGpsBaseline>* vGpsBsls;
+	std::vector<CDnaGpsBaseline>::iterator _it_bsl;
+	std::vector<CDnaGpsPoint>* vGpsPnts;
+	std::vector<CDnaGpsPoint>::iterator _it_pnt;
+
+	switch (msr->GetTypeC())
+	{
+	case 'D':	// Direction set
+		vDirns = msr->GetDirections_ptr();
+		msrStations.reserve(vDirns->size() + 2);
+		msrStations.push_back(std::pair<UINT32, bool>(msr->GetStn1Index(), msr->NotIgnored()));
+		msrStations.push_back(std::pair<UINT32, bool>(msr->GetStn2Index(), msr->NotIgnored()));
+		
+		// Increment measurement count, same for aml_type=str_msr and aml_type=cls_msr:
+		// - Increment binary measurement count for Inst->RO, then once per direction
+		// - Increment by 1 since a cluster of directions is handled by a single measurement class instance
+		bmsCount = 1;
+		
+		for (_it_dir=vDirns->begin(); _it_dir != vDirns->end(); ++_it_dir)
+		{
+			// Stations should only be valid if the parent direction set 
+			// measurement is not ignored
+			msrStations.push_back(std::pair<UINT32, bool>(_it_dir->GetStn2Index(), 
+				_it_dir->NotIgnored() && msr->NotIgnored()));
+			if (aml_type == str_msr)
+				bmsCount++;
+		}
+		break;
+	case 'G':	// GPS Baseline (treat as single-baseline cluster)
+	case 'X':	// GPS Baseline cluster
+		vGpsBsls = msr->GetBaselines_ptr();
+		msrStations.reserve(vGpsBsls->size() * 2);
+		for (_it_bsl=vGpsBsls->begin(); _it_bsl != vGpsBsls->end(); ++_it_bsl)
+		{
+			msrStations.push_back(std::pair<UINT32, bool>(_it_bsl->GetStn1Index(), _it_bsl->NotIgnored()));
+			msrStations.push_back(std::pair<UINT32, bool>(_it_bsl->GetStn2Index(), _it_bsl->NotIgnored()));
+			
+			// add:
+			// - 3 for (X, X var); (Y, Y var, XY covar); (Z, Zvar, XZ, YZ covar), and
+			// - 3 for each covariance
+			if (aml_type == str_msr)
+				bmsCount += 3 + static_cast<UINT32>(_it_bsl->GetCovariances_ptr()->size() * 3);
+		}
+		
+		// increment by 1 since a cluster of GNSS baselines is handled by a single measurement class instance
+		if (aml_type == cls_msr)
+			bmsCount = 1;
+		break;
+	case 'Y':	// GPS point cluster
+		vGpsPnts = msr->GetPoints_ptr();
+		for (_it_pnt=vGpsPnts->begin(); _it_pnt != vGpsPnts->end(); ++_it_pnt)
+		{
+			if (!vAssocStnList->at(_it_pnt->GetStn1Index()))
+				throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station \
+									map while \ntrying to determine ASL index for the First station.", 0);
+			f(_it_pnt->GetStn1Index(), _it_pnt->NotIgnored());
+			
+			// add:
+			// - 3 for (X, X var); (Y, Y var, XY covar); (Z, Zvar, XZ, YZ covar), and
+			// - 3 for each covariance
+			if (aml_type == str_msr)
+				bmsCount += 3 + static_cast<UINT32>(_it_pnt->GetCovariances_ptr()->size() * 3);
+		}
+		
+		// increment by 1 since a cluster of GNSS points is handled by a single measurement class instance
+		if (aml_type == cls_msr)
+			bmsCount = 1;
+		return bmsCount;
+	default:
+		// <First>
+		if (!vAssocStnList->at(msr->GetStn1Index()))
+			throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station map \
+									while \ntrying to determine ASL index for the First station.", 0);
+		f(msr->GetStn1Index(), msr->NotIgnored());
+		
+		// single station measurements
+		switch (msr->GetTypeC())
+		{
+		case 'H':	// Orthometric height
+		case 'R':	// Ellipsoidal height
+		case 'I':	// Astronomic latitude
+		case 'J':	// Astronomic longitude
+		case 'P':	// Geodetic latitude
+		case 'Q':	// Geodetic longitude
+			return 1;
+		}
+
+		// <Second>
+		if (!vAssocStnList->at(msr->GetStn2Index()))
+			throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station map \
+									while \ntrying to determine ASL index for the Second station.", 0);
+		f(msr->GetStn2Index(), msr->NotIgnored());
+		
+		// dual station measurements
+		switch (msr->GetTypeC())
+		{
+		case 'B':	// Geodetic azimuth
+		case 'K':	// Astronomic azimuth
+		case 'C':	// Chord dist
+		case 'E':	// Ellipsoid arc
+		case 'M':	// MSL arc
+		case 'S':	// Slope distance
+		case 'L':	// Level difference
+		case 'V':	// Zenith distance
+		case 'Z':	// Vertical angle
+			return 1;
+		}
+
+		// <Third>
+		if (!vAssocStnList->at(msr->GetStn3Index()))
+			throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station map \
+									while \ntrying to determine ASL index for the Third station.", 0);
+		f(msr->GetStn3Index(), msr->NotIgnored());
+		
+		// triple station measurements
+		switch (msr->GetTypeC())
+		{
+		case 'A':	// Horizontal angles
+			return 1;
+		}
+		return 0;
+	}
+
+	// Strip duplicates from the stations of the cluster (a station being 
+	// valid if any of its measurements is valid), then associate the 
+	// cluster once with each station
+	std::sort(msrStations.begin(), msrStations.end());
+	_it_stn_unique = msrStations.begin();
+	for (_it_stn=msrStations.begin(); _it_stn!=msrStations.end(); ++_it_stn)
+	{
+		if (_it_stn->first != _it_stn_unique->first)
+			*(++_it_stn_unique) = *_it_stn;
+		else
+			_it_stn_unique->second = _it_stn_unique->second || _it_stn->second;
+	}
+	if (!msrStations.empty())
+		msrStations.resize(_it_stn_unique - msrStations.begin() + 1);
+
+	for (_it_stn=msrStations.begin(); _it_stn!=msrStations.end(); ++_it_stn)
+	{
+		if (!vAssocStnList->at(_it_stn->first))
+			throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station map \
+									while \ntrying to determine ASL index for a cluster station.", 0);
+		f(_it_stn->first, _it_stn->second);
+	}
+	
+	return bmsCount;
+}
 	
+
+void dna_import::CompleteAssociationLists(vdnaMsrPtr* vMeasurements, pvASLPtr vAssocStnList, pvUINT32 vAssocMsrList, const _AML_TYPE_ aml_type)
+{
 	UINT32 msrstoAllStations = 0;
-	UINT32 currentBmsFileIndex;
-	UINT32 stnIndex, stnmsr_indexAML, msrCount;
+	UINT32 stnIndex, msrCount, chunk, chunkCount;
+	const UINT32 stnCount(static_cast<UINT32>(vAssocStnList->size()));
 
 	vASLPtr::iterator _it_asl(vAssocStnList->begin());
 
-#ifdef _MSDEBUG
-	CAStationList* stnList;
-#endif
-
 	// Complete ASL (first stage, i.e. IncrementMsrCount, was done in MapMeasurementStations)
 	for (_it_asl=vAssocStnList->begin(); _it_asl!=vAssocStnList->end(); _it_asl++)
 	{
@@ -6680,9 +7478,6 @@ void dna_import::CompleteAssociationLists(vdnaMsrPtr* vMeasurements, pvASLPtr vA
 		if (_it_asl->get()->IsInvalid())		// unused station
 			continue;
 		
-#ifdef _MSDEBUG
-		stnList = _it_asl->get();
-#endif
 		_it_asl->get()->SetAMLStnIndex(msrstoAllStations);		// On first run, msrstoAllStations = 0!
 		// increment total count (for dimension of AML)
 		msrCount = _it_asl->get()->GetAssocMsrCount();
@@ -6694,10 +7489,6 @@ void dna_import::CompleteAssociationLists(vdnaMsrPtr* vMeasurements, pvASLPtr vA
 	vAssocMsrList->clear();
 	vAssocMsrList->resize(msrstoAllStations);
 
-	std::vector<CDnaDirection>* vDirns;
-	std::vector<CDnaGpsBaseline>* vGpsBsls;
-	std::vector<CDnaGpsPoint>* vGpsPnts;
-
 	// reset ASL #measurements to zero
 	for (_it_asl=vAssocStnList->begin(); _it_asl!=vAssocStnList->end(); _it_asl++)
 	{
@@ -6712,114 +7503,94 @@ void dna_import::CompleteAssociationLists(vdnaMsrPtr* vMeasurements, pvASLPtr vA
 		_it_asl->get()->SetInvalid();
 	}
 
-	currentBmsFileIndex = 0;
-	_it_vdnamsrptr _it_msr(vMeasurements->begin());
-	for (_it_msr=vMeasurements->begin(); _it_msr != vMeasurements->end(); _it_msr++)
+	// The AML is formed by a counting sort of the measurement-station associations 
+	// (i.e. by station, then by measurement).  The measurements are divided into 
+	// contiguous chunks, for which the associations are counted and then placed 
+	// concurrently.  Each chunk places its associations with a station after 
+	// those of the preceding chunks, so the AML is the same for any number of chunks.
+	typedef struct {
+		_it_vdnamsrptr	begin, end;
+		UINT32			bmsIndex;			// binary measurement index of the first measurement
+		vUINT32			stnAssocIndex;		// count of each station's associations, then the AML index of the next
+		vbool			stnValid;
+	} aml_chunk_t;
+
+	chunkCount = std::max(1U, std::min(ImportThreads(),
+		static_cast<UINT32>(vMeasurements->size() / projectSettings_.i.aml_chunk_size)));
+	std::vector<aml_chunk_t> amlChunks(chunkCount);
+	for (chunk=0; chunk<chunkCount; ++chunk)
 	{
-		// 1. Handle nested type measurements (G, X, Y) separately
-		switch (_it_msr->get()->GetTypeC())
-		{
-		case 'D':	// Direction set
-			vDirns = _it_msr->get()->GetDirections_ptr();
-			CompleteASLDirections(_it_msr, vDirns, vAssocStnList, vAssocMsrList, &currentBmsFileIndex, aml_type);
-			continue;
-		case 'G':	// GPS Baseline (treat as single-baseline cluster)
-		case 'X':	// GPS Baseline cluster
-			vGpsBsls = _it_msr->get()->GetBaselines_ptr();
-			CompleteASLGpsBaselines(vGpsBsls, vAssocStnList, vAssocMsrList, &currentBmsFileIndex, aml_type);
-			continue;
-		case 'Y':	// GPS point cluster
-			vGpsPnts = _it_msr->get()->GetPoints_ptr();
-			CompleteASLGpsPoints(vGpsPnts, vAssocStnList, vAssocMsrList, &currentBmsFileIndex, aml_type);
-			continue;
-		}
+		amlChunks.at(chunk).begin = vMeasurements->begin() + vMeasurements->size() * chunk / chunkCount;
+		amlChunks.at(chunk).end = vMeasurements->begin() + vMeasurements->size() * (chunk + 1) / chunkCount;
+	}
+
+	// 1. Count the associations of each chunk
+	parallel_for_each(amlChunks.begin(), amlChunks.end(),
+		[this, &vAssocStnList, &aml_type, &stnCount](aml_chunk_t& amlChunk) {
+			amlChunk.stnAssocIndex.assign(stnCount, 0);
+			amlChunk.stnValid.assign(stnCount, false);
+			amlChunk.bmsIndex = 0;		// the chunk's binary measurement count, until step 2
+
+			auto countAssociation = [&amlChunk](const UINT32& stn, const bool& valid) {
+				amlChunk.stnAssocIndex.at(stn)++;
+				if (valid)
+					amlChunk.stnValid.at(stn) = true;
+			};
+
+			for (_it_vdnamsrptr _it_msr=amlChunk.begin; _it_msr!=amlChunk.end; ++_it_msr)
+				amlChunk.bmsIndex += ForEachStationAssociation(*_it_msr, vAssocStnList, aml_type, countAssociation);
+		}, 1);
+
+	// 2. Find the first binary measurement index of each chunk, and the first 
+	// AML index of each chunk's associations with each station
+	UINT32 bmsIndex(0), bmsCount, amlIndex, chunkAssocCount;
+	for (chunk=0; chunk<chunkCount; ++chunk)
+	{
+		bmsCount = amlChunks.at(chunk).bmsIndex;
+		amlChunks.at(chunk).bmsIndex = bmsIndex;
+		bmsIndex += bmsCount;
+	}
 
-		// calc AML index for <First>
-		stnIndex = ((CDnaMeasurement*)_it_msr->get())->GetStn1Index();
+	for (stnIndex=0; stnIndex<stnCount; ++stnIndex)
+	{
 		if (!vAssocStnList->at(stnIndex))
-			throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station map \
-									while \ntrying to determine ASL index for the First station.", 0);
-
-		currentASL = vAssocStnList->at(stnIndex).get();
-		stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-		if (stnmsr_indexAML > msrstoAllStations)
-			throw XMLInteropException("CompleteAssociationLists(): An error occurred while trying to determine ASL index.", 0);
-		vAssocMsrList->at(stnmsr_indexAML) = currentBmsFileIndex;
-		currentASL->IncrementMsrCount();
-
-		if (_it_msr->get()->NotIgnored())
-			currentASL->SetValid();
+			continue;
 
-		// single station measurements
-		switch (_it_msr->get()->GetTypeC())
+		amlIndex = vAssocStnList->at(stnIndex)->GetAMLStnIndex() + vAssocStnList->at(stnIndex)->GetAssocMsrCount();
+		msrCount = 0;
+		for (chunk=0; chunk<chunkCount; ++chunk)
 		{
-		case 'H':	// Orthometric height
-		case 'R':	// Ellipsoidal height
-		case 'I':	// Astronomic latitude
-		case 'J':	// Astronomic longitude
-		case 'P':	// Geodetic latitude
-		case 'Q':	// Geodetic longitude
-			currentBmsFileIndex ++;
-			continue;
+			chunkAssocCount = amlChunks.at(chunk).stnAssocIndex.at(stnIndex);
+			amlChunks.at(chunk).stnAssocIndex.at(stnIndex) = amlIndex + msrCount;
+			msrCount += chunkAssocCount;
+
+			if (amlChunks.at(chunk).stnValid.at(stnIndex))
+				vAssocStnList->at(stnIndex)->SetValid();
 		}
 
-		// calc AML index for <Second>
-		stnIndex = ((CDnaMeasurement*)_it_msr->get())->GetStn2Index();
-		if (!vAssocStnList->at(stnIndex))
-			throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station map \
-									while \ntrying to determine ASL index for the Second station.", 0);
-		
-		currentASL = vAssocStnList->at(stnIndex).get();
-		stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-		if (stnmsr_indexAML > msrstoAllStations)
+		if (msrCount > 0 && amlIndex + msrCount > msrstoAllStations)
 			throw XMLInteropException("CompleteAssociationLists(): An error occurred while trying to determine ASL index.", 0);
-		vAssocMsrList->at(stnmsr_indexAML) = currentBmsFileIndex;
-		currentASL->IncrementMsrCount();
 
-		if (_it_msr->get()->NotIgnored())
-			currentASL->SetValid();
-
-		// dual station measurements
-		switch (_it_msr->get()->GetTypeC())
-		{
-		case 'B':	// Geodetic azimuth
-		case 'K':	// Astronomic azimuth
-		case 'C':	// Chord dist
-		case 'E':	// Ellipsoid arc
-		case 'M':	// MSL arc
-		case 'S':	// Slope distance
-		case 'L':	// Level difference
-		case 'V':	// Zenith distance
-		case 'Z':	// Vertical angle
-			currentBmsFileIndex ++;
-			continue;
-		}
+		vAssocStnList->at(stnIndex)->IncrementMsrCount(msrCount);
+	}
 
-		// calc AML index for <Third>
-		stnIndex = ((CDnaMeasurement*)_it_msr->get())->GetStn3Index();
-		if (!vAssocStnList->at(stnIndex))
-			throw XMLInteropException("CompleteAssociationLists(): An invalid index was found in the station map \
-									while \ntrying to determine ASL index for the Third station.", 0);
-		
-		currentASL = vAssocStnList->at(stnIndex).get();
-		stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-		if (stnmsr_indexAML > msrstoAllStations)
-			throw XMLInteropException("CompleteAssociationLists(): An error occurred while trying to determine ASL index.", 0);
-		vAssocMsrList->at(stnmsr_indexAML) = currentBmsFileIndex;
-		currentASL->IncrementMsrCount();
+	// 3. Place the associations of each chunk
+	parallel_for_each(amlChunks.begin(), amlChunks.end(),
+		[this, &vAssocStnList, &vAssocMsrList, &aml_type](aml_chunk_t& amlChunk) {
+			UINT32 bmsrIndex;
 
-		if (_it_msr->get()->NotIgnored())
-			currentASL->SetValid();
+			// Set binary msr index for all stations of a measurement (or cluster)
+			// to the first element of the measurement in the binary file
+			auto placeAssociation = [&amlChunk, &vAssocMsrList, &bmsrIndex](const UINT32& stn, const bool&) {
+				vAssocMsrList->at(amlChunk.stnAssocIndex.at(stn)++) = bmsrIndex;
+			};
 
-		// triple station measurements
-		switch (_it_msr->get()->GetTypeC())
-		{
-		case 'A':	// Horizontal angles
-			currentBmsFileIndex ++;
-			continue;
-		}
-	}
-	return;
+			for (_it_vdnamsrptr _it_msr=amlChunk.begin; _it_msr!=amlChunk.end; ++_it_msr)
+			{
+				bmsrIndex = amlChunk.bmsIndex;
+				amlChunk.bmsIndex += ForEachStationAssociation(*_it_msr, vAssocStnList, aml_type, placeAssociation);
+			}
+		}, 1);
 }
 	
 
@@ -6896,263 +7667,6 @@ void dna_import::CompleteAssociationLists(vdnaMsrPtr* vMeasurements, pvASLPtr vA
 //}
 	
 
-void dna_import::CompleteASLDirections(_it_vdnamsrptr _it_msr, std::vector<CDnaDirection>* vDirections, pvASLPtr vAssocStnList, 
-										 pvUINT32 vAssocMsrList, PUINT32 currentBmsFileIndex, const _AML_TYPE_ aml_type)
-{
-	std::ostringstream ss;
-	
-	CAStationList* currentASL;
-
-	std::string station_name;
-	UINT32 stn_indexAML, stnmsr_indexAML;
-	const UINT32 msrstoAllStations = static_cast<UINT32>(vAssocMsrList->size());
-	const UINT32 bmsrIndex(*currentBmsFileIndex);
-
-	std::vector< CDnaDirection >::iterator _it_dir(vDirections->begin());
-
-	// Unique list of stations involved in this cluster
-	vUINT32 msrStations;
-	msrStations.reserve(vDirections->size() + 1);
-
-	// calc AML index for <First>
-	stn_indexAML = _it_msr->get()->GetStn1Index();
-	if (!vAssocStnList->at(stn_indexAML))
-		throw XMLInteropException("CompleteASLDirections(): An invalid index was found in the station map \
-								while \ntrying to determine ASL index for the First station.", 0);
-
-	currentASL = vAssocStnList->at(stn_indexAML).get();
-	stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-	if (stnmsr_indexAML > msrstoAllStations)
-		throw XMLInteropException("CompleteASLDirections(): An error occurred while trying to determine ASL index.", 0);
-	vAssocMsrList->at(stnmsr_indexAML) = bmsrIndex;
-
-	if (_it_msr->get()->NotIgnored())
-		currentASL->SetValid();
-
-	// Add to unique list of stations
-	msrStations.push_back(stn_indexAML);
-
-	// calc AML index for <Second>
-	stn_indexAML = _it_msr->get()->GetStn2Index();
-	if (!vAssocStnList->at(stn_indexAML))
-		throw XMLInteropException("CompleteASLDirections(): An invalid index was found in the station map \
-								while \ntrying to determine ASL index for the Second station.", 0);
-		
-	currentASL = vAssocStnList->at(stn_indexAML).get();
-	stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-	if (stnmsr_indexAML > msrstoAllStations)
-		throw XMLInteropException("CompleteASLDirections(): An error occurred while trying to determine ASL index.", 0);
-	vAssocMsrList->at(stnmsr_indexAML) = bmsrIndex;
-
-	if (_it_msr->get()->NotIgnored())
-		currentASL->SetValid();
-
-	// Add to unique list of stations
-	msrStations.push_back(stn_indexAML);
-	
-	// Increment measurement count, same for aml_type=str_msr and aml_type=cls_msr:
-	// - Increment binary measurement count for Inst->RO, then once per direction
-	// - Increment by 1 since a cluster of directions is handled by a single measurement class instance
-	(*currentBmsFileIndex)++;
-
-	// Calc AML index for Station - Target directions
-	for (_it_dir=vDirections->begin(); _it_dir != vDirections->end(); ++_it_dir)
-	{
-		// Calc AML index for <Second>
-		stn_indexAML = _it_dir->GetStn2Index();
-		if (!vAssocStnList->at(stn_indexAML))
-			throw XMLInteropException("CompleteASLDirections(): An invalid index was found in the station map \
-									while \ntrying to determine ASL index for the Second station.", 0);
-		currentASL = vAssocStnList->at(stn_indexAML).get();
-		stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-		if (stnmsr_indexAML > msrstoAllStations)
-			throw XMLInteropException("CompleteASLDirections(): An error occurred while trying to determine \
-									AML index for the Second station.", 0);
-		
-		// All ASL entries are set to invalid on initial run of 
-		// CompleteAssociationLists, so this is vital so as to ensure a station 
-		// is to be included.  But stations should only be included if the 
-		// parent direction set measurement is not ignored
-		if (_it_dir->NotIgnored() && _it_msr->get()->NotIgnored())
-			currentASL->SetValid();
-
-		// Set binary msr index for all stations in this cluster to the first element of the 
-		// cluster in the binary file
-		vAssocMsrList->at(stnmsr_indexAML) = bmsrIndex;
-		
-		// To station
-		msrStations.push_back(stn_indexAML);
-
-		// increment file index for next measurement
-		switch (aml_type)
-		{
-		case cls_msr:		// CDnaMeasurement class
-			// do nothing, handled above.
-			break;
-		case str_msr:		// msr_t struct
-		default:
-			(*currentBmsFileIndex)++;
-			break;
-		}
-	}
-
-	// Strip duplicates from msrStations, then increment station count once
-	// for each station associated with this cluster
-	strip_duplicates(msrStations);
-	for (it_vUINT32 _it_stn=msrStations.begin(); _it_stn!=msrStations.end(); ++_it_stn)
-		vAssocStnList->at(*_it_stn).get()->IncrementMsrCount();
-}
-
-void dna_import::CompleteASLGpsBaselines(std::vector<CDnaGpsBaseline>* vGpsBaselines, pvASLPtr vAssocStnList,
-										   pvUINT32 vAssocMsrList, PUINT32 currentBmsFileIndex, const _AML_TYPE_ aml_type)
-{
-	CAStationList* currentASL;
-
-	UINT32 stn_indexAML, stnmsr_indexAML;
-	const UINT32 msrstoAllStations = static_cast<UINT32>(vAssocMsrList->size());
-	const UINT32 bmsrIndex(*currentBmsFileIndex);
-	
-	std::vector< CDnaGpsBaseline >::iterator _it_msr(vGpsBaselines->begin());
-
-	// Unique list of stations involved in this cluster
-	vUINT32 msrStations;
-	msrStations.reserve(vGpsBaselines->size());
-
-	for (_it_msr=vGpsBaselines->begin(); _it_msr != vGpsBaselines->end(); _it_msr++)
-	{
-		// Calc AML index for <First>
-		stn_indexAML = _it_msr->GetStn1Index();
-		if (!vAssocStnList->at(stn_indexAML))
-			throw XMLInteropException("CompleteASLGpsBaselines(): An invalid index was found in the station \
-									map while \ntrying to determine ASL index for the First station.", 0);
-		currentASL = vAssocStnList->at(stn_indexAML).get();
-		stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-		if (stnmsr_indexAML > msrstoAllStations)
-			throw XMLInteropException("CompleteASLGpsBaselines(): An error occurred while trying to determine the \
-									AML index for the First station.", 0);
-
-		if (_it_msr->NotIgnored())
-			currentASL->SetValid();
-
-		// Set binary msr index for all stations in this cluster to the first element of the 
-		// cluster in the binary file
-		vAssocMsrList->at(stnmsr_indexAML) = bmsrIndex;
-
-		msrStations.push_back(stn_indexAML);
-
-		// Calc AML index for <Second>
-		stn_indexAML = _it_msr->GetStn2Index();
-		if (!vAssocStnList->at(stn_indexAML))
-			throw XMLInteropException("CompleteASLGpsBaselines(): An invalid index was found in the station map \
-									while \ntrying to determine ASL index for the Second station.", 0);
-		currentASL = vAssocStnList->at(stn_indexAML).get();
-		stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-		if (stnmsr_indexAML > msrstoAllStations)
-			throw XMLInteropException("CompleteASLGpsBaselines(): An error occurred while trying to determine \
-									AML index for the Second station.", 0);
-		
-		if (_it_msr->NotIgnored())
-			currentASL->SetValid();
-
-		// Set binary msr index for all stations in this cluster to the first element of the 
-		// cluster in the binary file
-		vAssocMsrList->at(stnmsr_indexAML) = bmsrIndex;
-
-		msrStations.push_back(stn_indexAML);
-
-		// increment file index for next measurement
-		switch (aml_type)
-		{
-		case cls_msr:		// CDnaMeasurement class
-			// do nothing, handled later.
-			break;
-		case str_msr:		// msr_t struct
-		default:
-			// add:
-			// - 3 for (X, X var); (Y, Y var, XY covar); (Z, Zvar, XZ, YZ covar), and
-			// - 3 for each covariance
-			(*currentBmsFileIndex) = (*currentBmsFileIndex) + 3 + static_cast<UINT32>(_it_msr->GetCovariances_ptr()->size() * 3);
-			break;
-		}
-	}
-
-	switch (aml_type)
-	{
-	case cls_msr:
-		// increment by 1 since a cluster of GNSS baselines is handled by a single measurement class instance
-		(*currentBmsFileIndex)++;
-		break;
-	case str_msr:
-		break;
-	}
-
-	// Strip duplicates from msrStations, then increment station count for each of the stations tied to this cluster
-	strip_duplicates(msrStations);
-	for (it_vUINT32 _it_stn=msrStations.begin(); _it_stn!=msrStations.end(); ++_it_stn)
-		vAssocStnList->at(*_it_stn).get()->IncrementMsrCount();
-}
-
-void dna_import::CompleteASLGpsPoints(std::vector<CDnaGpsPoint>* vGpsPoints, pvASLPtr vAssocStnList, 
-										pvUINT32 vAssocMsrList, PUINT32 currentBmsFileIndex, const _AML_TYPE_ aml_type)
-{
-	CAStationList* currentASL;
-
-	UINT32 stn_indexAML, stnmsr_indexAML;
-	const UINT32 msrstoAllStations = static_cast<UINT32>(vAssocMsrList->size());
-	const UINT32 bmsrIndex(*currentBmsFileIndex);
-	
-	std::vector< CDnaGpsPoint >::iterator _it_msr(vGpsPoints->begin());
-
-	for (_it_msr=vGpsPoints->begin(); _it_msr != vGpsPoints->end(); _it_msr++)
-	{		
-		// Calc AML index for <First>
-		stn_indexAML = _it_msr->GetStn1Index();
-		if (!vAssocStnList->at(stn_indexAML))
-			throw XMLInteropException("CompleteASLGpsPoints(): An invalid index was found in the station \
-									map while \ntrying to determine ASL index for the First station.", 0);
-		currentASL = vAssocStnList->at(stn_indexAML).get();
-		stnmsr_indexAML = currentASL->GetAMLStnIndex() + currentASL->GetAssocMsrCount();
-		if (stnmsr_indexAML > msrstoAllStations)
-			throw XMLInteropException("CompleteASLGpsPoints(): An error occurred while trying to determine the \
-									AML index for the First station.", 0);
-
-		if (_it_msr->NotIgnored())
-			currentASL->SetValid();
-
-		// Set binary msr index for all stations in this cluster to the first element of the 
-		// cluster in the binary file
-		vAssocMsrList->at(stnmsr_indexAML) = bmsrIndex;
-
-		// Increment the measurement count
-		currentASL->IncrementMsrCount();
-
-		// increment file index for next measurement
-		switch (aml_type)
-		{
-		case cls_msr:		// CDnaMeasurement class
-			// do nothing, handled later.
-			break;
-		case str_msr:		// msr_t struct
-		default:
-			// add:
-			// - 3 for (X, X var); (Y, Y var, XY covar); (Z, Zvar, XZ, YZ covar), and
-			// - 3 for each covariance
-			(*currentBmsFileIndex) += 3 + static_cast<UINT32>(_it_msr->GetCovariances_ptr()->size() * 3);
-			break;
-		}
-	}
-
-	switch (aml_type)
-	{
-	case cls_msr:
-		// increment by 1 since a cluster of GNSS points is handled by a single measurement class instance
-		(*currentBmsFileIndex) ++;
-		break;
-	case str_msr:
-		break;
-	}
-}
-
 _PARSE_STATUS_ dna_import::LoadDNAGeoidFile(const std::string& fileName, vdnaStnPtr* vStations)
 {
 	std::ifstream geo_file;
@@ -7166,6 +7680,7 @@ _PARSE_STATUS_ dna_import::LoadDNAGeoidFile(const std::string& fileName, vdnaStn
 	}
 
 	std::string geoidRec, station, nValue, primeMeridian, primeVertical;
+	UINT32 stationIndex;
 	double value;
 
 	_it_vdnastnptr _it_stn;
@@ -7217,10 +7732,7 @@ _PARSE_STATUS_ dna_import::LoadDNAGeoidFile(const std::string& fileName, vdnaStn
 			throw XMLInteropException(ss.str(), m_lineNo);
 		}
 
-		it_stnmap_range = equal_range(vStnsMap_sortName_.begin(), vStnsMap_sortName_.end(), 
-			station, StationNameIDCompareName());
-
-		if (it_stnmap_range.first == it_stnmap_range.second)
+		if ((stationIndex = stnsMapIndex_.find(station)) == station_name_index::npos)
 			continue;	// No station exists for this geoid information
 
 		// N value
@@ -7257,7 +7769,7 @@ _PARSE_STATUS_ dna_import::LoadDNAGeoidFile(const std::string& fileName, vdnaStn
 		}		
 
 		try {
-			_it_stn = vStations->begin() + it_stnmap_range.first->second;
+			_it_stn = vStations->begin() + stationIndex;
 			_it_stn->get()->SetgeoidSep(DoubleFromString<float>(nValue));
 			
 			// correct station height only if orthometric
@@ -29,8 +29,6 @@
 #endif
 #endif
 
-#include <mkl.h>
-
 #include <exception>
 #include <system_error>
 #include <stdexcept>
@@ -49,6 +47,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
 
 #include <include/exception/dnaexception.hpp>
 #include <include/config/dnaexports.hpp>
@@ -73,6 +72,7 @@
 #include <include/io/dnaioseg.hpp>
 #include <include/io/dnaiosnx.hpp>
 #include <include/io/dnaioscalar.hpp>
+#include <include/io/dnaioimc.hpp>
 
 #include <include/functions/dnatemplatefuncs.hpp>
 #include <include/functions/dnatemplatestnmsrfuncs.hpp>
@@ -85,11 +85,31 @@ using namespace dynadjust::exception;
 using namespace dynadjust::datum_parameters;
 using namespace dynadjust::iostreams;
 
-extern UINT32 g_fileOrder;
-
 namespace dynadjust {
 namespace dynamlinterop {
 
+class dna_import;
+
+// A chunk of a DNA file, parsed by its own dna_import (see ParseDNAChunks)
+typedef struct dna_file_chunk {
+	dna_file_chunk()
+		: _begin(0), _end(0), _lineNo(0)
+		, _stnCount(0), _msrCount(0), _clusterID(0) {}
+
+	const char*		_begin;
+	const char*		_end;
+	UINT32			_lineNo;			// line number of the line before the chunk
+	boost::shared_ptr<dna_import> _parser;
+	vdnaStnPtr		_vStations;
+	vdnaMsrPtr		_vMeasurements;
+	UINT32			_stnCount;
+	UINT32			_msrCount;
+	UINT32			_clusterID;
+	std::exception_ptr	_exception;		// exception raised whilst parsing the chunk
+} dna_file_chunk_t;
+
+typedef std::vector<dna_file_chunk_t> vdna_file_chunk_t;
+
 #ifdef _MSC_VER
 class DNAIMPORT_API dna_import {
 #else
@@ -177,6 +197,8 @@ public:
 
 	void CompleteAssociationLists(vdnaMsrPtr* vMeasurements, pvASLPtr vAssocStnList, pvUINT32 vAssocMsrList, const _AML_TYPE_ aml_type = str_msr);
 
+	void ReleaseMeasurements(vdnaMsrPtr* vMeasurements);
+
 	double GetProgress();
 	inline bool IsProcessing() const { return isProcessing_; }
 	inline MsrTally& GetMsrTally() const { return *p_parsemsr_tally; }
@@ -184,7 +206,7 @@ public:
 
 	inline _PARSE_STATUS_ GetStatus() const { return parseStatus_; }
 
-	inline void ResetFileOrder() const { g_fileOrder = 0; }
+	inline void ResetFileOrder() { fileOrder_ = 0; }
 	inline bool filespecifiedReferenceFrame() const { return _filespecifiedreferenceframe; }
 	inline bool filespecifiedEpoch() const { return _filespecifiedepoch; }
 	void InitialiseDatum(const std::string& reference_frame, const std::string epoch="");
@@ -195,8 +217,26 @@ public:
 	// Discontonuity file
 	void ParseDiscontinuities(const std::string& fileName);
 
+	// Parse contexts, used to parse input files concurrently
+	void InitialiseParseContext(const dna_import& parser);
+	void MergeParseContext(const dna_import& context, vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements, 
+		const UINT32& contextClusterID, PUINT32 clusterID);
+
 private:
 	
+	// Any input file
+	void ParseInputFileContents(const std::string& fileName, vdnaStnPtr* vStations, PUINT32 stnCount, 
+		vdnaMsrPtr* vMeasurements, PUINT32 msrCount, 
+		PUINT32 clusterID, input_file_meta_t* input_file_meta, bool firstFile,
+		std::string* success_msg);
+
+	// Import cache files
+	void ParseCachedInputFile(const std::string& fileName, vdnaStnPtr* vStations, PUINT32 stnCount, 
+		vdnaMsrPtr* vMeasurements, PUINT32 msrCount, 
+		PUINT32 clusterID, input_file_meta_t* input_file_meta,
+		std::string* success_msg);
+	std::string ImportCacheSettings(const std::string& fileName);
+
 	// DynaML files
 	void ParseXML(const std::string& fileName, vdnaStnPtr* vStations, PUINT32 stnCount, 
 							   vdnaMsrPtr* vMeasurements, PUINT32 msrCount, PUINT32 clusterID, 
@@ -215,6 +255,17 @@ private:
 								const std::string& fileEpsg, const std::string& fileEpoch);
 	void ParseDNAMSR(pvdnaMsrPtr vMeasurements, PUINT32 msrCount, PUINT32 clusterID,
 								const std::string& fileEpsg, const std::string& fileEpoch);
+	bool ParseDNAChunks(const std::string& fileName, const INPUT_DATA_TYPE& idt, 
+								vdnaStnPtr* vStations, PUINT32 stnCount, 
+								vdnaMsrPtr* vMeasurements, PUINT32 msrCount, PUINT32 clusterID,
+								const std::string& fileEpsg, const std::string& fileEpoch);
+	void ParseDNAChunk(dna_file_chunk_t& chunk, const INPUT_DATA_TYPE& idt, 
+								const std::string& fileEpsg, const std::string& fileEpoch,
+								const std::ios_base::iostate& exceptions);
+	bool FindDNAChunks(const char* begin, const char* end, const INPUT_DATA_TYPE& idt, vdna_file_chunk_t& vChunks);
+	UINT32 DNAMSRRecordLines(const std::string& sBuf);
+	double GetChunkProgress();
+	UINT32 ImportThreads() const;
 
 	//void SetDefaultReferenceFrame(vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements);
 
@@ -226,27 +277,27 @@ private:
 	void ParseDNAMSRLinear(const std::string& sBuf, dnaMsrPtr& msr_ptr);
 	void ParseDNAMSRCovariance(CDnaCovariance& cov);
 
-	std::string ParseAngularValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseLinearValue(const std::string& sBuf, const std::string& msrName, const std::string& calling_function);
-	std::string ParseGPSMsrValue(const std::string& sBuf, const std::string& element, const std::string& calling_function);
-	std::string ParseGPSVarValue(const std::string& sBuf, const std::string& element, const UINT32 location, const UINT32 width, const std::string& calling_function);
-	std::string ParseInstrumentValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseTargetValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseTarget2Value(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseStdDevValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseInstHeightValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseTargHeightValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseMsrCountValue(const std::string& sBuf, UINT32& msrCount, const std::string& calling_function);
-	std::string ParseScaleVValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseScalePValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseScaleLValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseScaleHValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseRefFrameValue(const std::string& sBuf, const std::string& calling_function);
-	std::string ParseEpochValue(const std::string& sBuf, const std::string& calling_function);
-
-	void ParseDatabaseIds(const std::string& sBuf, const std::string& calling_function, const char msrType);
-	void ParseDatabaseClusterId(const std::string& sBuf, const std::string& calling_function);
-	void ParseDatabaseMsrId(const std::string& sBuf, const std::string& calling_function);
+	std::string ParseAngularValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseLinearValue(const std::string& sBuf, std::string_view msrName, std::string_view calling_function);
+	std::string_view ParseGPSMsrValue(const std::string& sBuf, std::string_view element, std::string_view calling_function);
+	std::string_view ParseGPSVarValue(const std::string& sBuf, std::string_view element, const UINT32 location, const UINT32 width, std::string_view calling_function);
+	std::string_view ParseInstrumentValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseTargetValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseTarget2Value(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseStdDevValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseInstHeightValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseTargHeightValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseMsrCountValue(const std::string& sBuf, UINT32& msrCount, std::string_view calling_function);
+	std::string_view ParseScaleVValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseScalePValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseScaleLValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseScaleHValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseRefFrameValue(const std::string& sBuf, std::string_view calling_function);
+	std::string_view ParseEpochValue(const std::string& sBuf, std::string_view calling_function);
+
+	void ParseDatabaseIds(const std::string& sBuf, std::string_view calling_function, const char msrType);
+	void ParseDatabaseClusterId(const std::string& sBuf, std::string_view calling_function);
+	void ParseDatabaseMsrId(const std::string& sBuf, std::string_view calling_function);
 
 	void LoadNetworkFiles(pvstn_t binaryStn, pvmsr_t binaryMsr, const project_settings& projectSettings, bool loadSegmentFile);
 	void LoadBinaryFiles(pvstn_t binaryStn, pvmsr_t binaryMsr);
@@ -283,12 +334,9 @@ private:
 	void RenameStationsPnt(std::vector<CDnaGpsPoint>* vGpsPoints, v_string_vstring_pair& stnRenaming);
 	void RenameStationsDir(std::vector<CDnaDirection>* vDirections, v_string_vstring_pair& stnRenaming);
 	
-	void CompleteASLDirections(_it_vdnamsrptr _it_msr, std::vector<CDnaDirection>* vDirections, pvASLPtr vAssocStnList, 
-		pvUINT32 vAssocMsrList, PUINT32 currentBmsFileIndex, const _AML_TYPE_ aml_type);
-	void CompleteASLGpsBaselines(std::vector<CDnaGpsBaseline>* vGpsBaselines, pvASLPtr vAssocStnList, 
-		pvUINT32 vAssocMsrList, PUINT32 currentBmsFileIndex, const _AML_TYPE_ aml_type);
-	void CompleteASLGpsPoints(std::vector<CDnaGpsPoint>* vGpsPoints, pvASLPtr vAssocStnList, 
-		pvUINT32 vAssocMsrList, PUINT32 currentBmsFileIndex, const _AML_TYPE_ aml_type);
+	template<typename Func>
+	UINT32 ForEachStationAssociation(const dnaMsrPtr& msr, const pvASLPtr vAssocStnList, 
+		const _AML_TYPE_ aml_type, Func& f);
 
 	//void FindUnusedStationsInIgnoredMeasurements(vdnaMsrPtr* vMeasurements, pvASLPtr vAssocStnList, pvUINT32 vAssocMsrList, pvstring vUnusedStns, pvUINT32 vIgnoredMsrs);
 
@@ -303,6 +351,8 @@ private:
 	void InitialiseDynaMLFile(const project_settings& p, vifm_t* vinput_file_meta,
 		const std::string& outfilename, std::ofstream* dynaml_file);
 
+	void OffsetClusterIDs(vdnaMsrPtr* vMeasurements, const UINT32& offset);
+
 	void DetermineBoundingBox();
 	void BuildExtractStationsList(const std::string& stnList, pvstring vstnList);
 	
@@ -325,8 +375,12 @@ private:
 	volatile double percentComplete_;
 
 	std::ifstream*	ifsInputFILE_;
+	std::istream*	isDNARecords_;		// the file (or chunk of the file) from which DNA records are read
 	size_t		sifsFileSize_;
 	bool		isProcessing_;
+	boost::mutex	import_file_mutex_;
+
+	vdna_file_chunk_t	vfileChunks_;	// chunks of the DNA file being parsed concurrently
 	
 	double		bbox_upperLat_;
 	double		bbox_upperLon_;
@@ -338,6 +392,10 @@ private:
 	MsrTally*	p_parsemsr_tally;
 	StnTally*	p_parsestn_tally;
 
+	MsrTally	parsemsr_tally_;
+	StnTally	parsestn_tally_;
+	UINT32		fileOrder_;			// file order of the next station
+
 	UINT32		m_binaryRecordCount;
 	UINT32		m_dbidRecordCount;
 	UINT32		m_lineNo;
@@ -351,9 +409,8 @@ private:
 	vvUINT32	v_JSL_;				// Junction stations
 	vvUINT32	v_CML_;				// Measurements
 
-	it_pair_string_vUINT32	it_stnmap_range;
-	
 	v_string_uint32_pair vStnsMap_sortName_;		// Station Name Map sorted on name (string)
+	station_name_index stnsMapIndex_;				// Hash index of vStnsMap_sortName_
 	
 	_PARSE_STATUS_ parseStatus_;
 
@@ -364,6 +421,7 @@ private:
 
 	v_discontinuity_tuple	stn_discontinuities_;
 	bool					m_discontsSortedbyName;
+	std::uint64_t			discontinuityFileHash_;		// hash of the discontinuity file's contents
 
 	v_string_string_pair	stn_renamed_;
 
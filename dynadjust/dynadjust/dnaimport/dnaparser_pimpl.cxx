@@ -20,9 +20,9 @@ using namespace dynadjust::measurements;
 using namespace dynadjust::epsg;
 using namespace dynadjust::exception;
 
-extern MsrTally g_parsemsr_tally;
-extern StnTally g_parsestn_tally;
-extern UINT32 g_fileOrder;
+extern thread_local MsrTally g_parsemsr_tally;
+extern thread_local StnTally g_parsestn_tally;
+extern thread_local UINT32 g_fileOrder;
 
 // Clusterpoint_pimpl
 //
@@ -0,0 +1,306 @@
+//============================================================================
+// Name         : dnaimportbench.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : DNA file parsing benchmark
+//                For each input file (e.g. the sample station and measurement
+//                files), records:
+//                  - the time taken to extract and convert every numeric
+//                    fixed width field, using a trimmed copy of the field and
+//                    boost::spirit's double_ parser (as dnaimport did before)
+//                    and using a trimmed view of the field and
+//                    DoubleFromString (std::from_chars), together with the
+//                    number of fields for which the two values differ
+//                  - the time taken by dna_import to parse the file, and the
+//                    number of lines parsed per second
+//============================================================================
+
+#include <dynadjust/dnaimport/dnainterop.hpp>
+#include <include/functions/dnafilepathfuncs.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+using namespace dynadjust;
+using namespace dynadjust::dynamlinterop;
+
+// A numeric fixed width field of a record.  The field begins after the
+// last character of the preceding value, so includes the padding
+typedef struct {
+	UINT32 _line;
+	UINT32 _pos;
+	UINT32 _width;
+} numeric_field_t;
+
+typedef std::vector<numeric_field_t> vnumeric_field_t;
+
+typedef struct {
+	std::string file;
+	UINT32 lines;
+	UINT32 fields;
+	UINT32 differ;
+	double spirit_ns;
+	double from_chars_ns;
+	UINT32 stations;
+	UINT32 measurements;
+	double parse_ms;
+} bench_result;
+
+double elapsed_ms(const boost::timer::cpu_timer& time)
+{
+	return time.elapsed().wall / 1.0e6;
+}
+
+// Reads the records of a file, and finds the numeric fields of each record
+void find_numeric_fields(const std::string& filename, vstring& records, vnumeric_field_t& fields)
+{
+	std::ifstream file;
+	file_opener(file, filename, std::ios::in, ascii, true);
+	// read to the end of the file without throwing
+	file.exceptions(std::ios::badbit);
+
+	std::string record;
+	numeric_field_t field;
+	size_t start, end, pos;
+	const char* last;
+	double d;
+
+	while (getline(file, record))
+	{
+		records.push_back(record);
+
+		// Ignore header and comment lines
+		if (record.empty() || record.at(0) == '!' || record.at(0) == '*')
+			continue;
+
+		field._line = static_cast<UINT32>(records.size() - 1);
+
+		for (pos=0; ; pos=end)
+		{
+			if ((start = record.find_first_not_of(" \r\n", pos)) == std::string::npos)
+				break;
+			if ((end = record.find_first_of(" \r\n", start)) == std::string::npos)
+				end = record.length();
+
+			// Only consider values which are wholly numeric
+			last = record.data() + end;
+			if (NumberFromChars(d, record.data() + start, last) != last)
+				continue;
+
+			field._pos = static_cast<UINT32>(pos);
+			field._width = static_cast<UINT32>(end - pos);
+			fields.push_back(field);
+		}
+	}
+}
+
+// Converts each field using a trimmed copy of the field and boost::spirit's
+// double_ parser, as dnaimport did before fixed_field and DoubleFromString
+// used std::string_view and std::from_chars
+void convert_fields_spirit(const vstring& records, const vnumeric_field_t& fields, vdouble& values)
+{
+	std::string str;
+	vdouble::iterator _it_value(values.begin());
+	for (vnumeric_field_t::const_iterator _it_field=fields.begin(); _it_field!=fields.end(); ++_it_field, ++_it_value)
+	{
+		str = trimstr(records.at(_it_field->_line).substr(_it_field->_pos, _it_field->_width));
+		*_it_value = 0.;
+		parse(str.begin(), str.end(), double_, *_it_value);
+	}
+}
+
+// Converts each field using a trimmed view of the field and DoubleFromString
+void convert_fields_from_chars(const vstring& records, const vnumeric_field_t& fields, vdouble& values)
+{
+	vdouble::iterator _it_value(values.begin());
+	for (vnumeric_field_t::const_iterator _it_field=fields.begin(); _it_field!=fields.end(); ++_it_field, ++_it_value)
+		*_it_value = DoubleFromString<double>(
+			fixed_field(records.at(_it_field->_line), _it_field->_pos, _it_field->_width));
+}
+
+// Times the conversion of a file's fields and the parsing of the file,
+// taking the fastest of repeat runs
+bench_result run_benchmark(const std::string& filename, const UINT32 repeat)
+{
+	bench_result result;
+	result.file = leafStr<std::string>(filename);
+
+	vstring records;
+	vnumeric_field_t fields;
+	find_numeric_fields(filename, records, fields);
+	result.lines = static_cast<UINT32>(records.size());
+	result.fields = static_cast<UINT32>(fields.size());
+
+	vdouble spirit_values(fields.size()), from_chars_values(fields.size());
+	boost::timer::cpu_timer time;
+	double ms;
+	UINT32 run;
+
+	// Field conversion
+	for (run=0; run<repeat; ++run)
+	{
+		time.start();
+		convert_fields_spirit(records, fields, spirit_values);
+		ms = elapsed_ms(time);
+		if (run == 0 || ms < result.spirit_ns)
+			result.spirit_ns = ms;
+
+		time.start();
+		convert_fields_from_chars(records, fields, from_chars_values);
+		ms = elapsed_ms(time);
+		if (run == 0 || ms < result.from_chars_ns)
+			result.from_chars_ns = ms;
+	}
+
+	// ms -> ns per field
+	if (!fields.empty())
+	{
+		result.spirit_ns *= 1.0e6 / fields.size();
+		result.from_chars_ns *= 1.0e6 / fields.size();
+	}
+
+	// boost::spirit's double_ parser does not always give the nearest
+	// double, whereas std::from_chars does
+	result.differ = 0;
+	for (size_t f(0); f<fields.size(); ++f)
+		if (spirit_values.at(f) != from_chars_values.at(f))
+			result.differ++;
+
+	// File parsing
+	project_settings p;
+	vdnaStnPtr vStations;
+	vdnaMsrPtr vMeasurements;
+	UINT32 stnCount, msrCount, clusterID;
+	input_file_meta_t input_file_meta;
+	std::string success_msg;
+
+	for (run=0; run<repeat; ++run)
+	{
+		dna_import parserDynaML;
+		parserDynaML.InitialiseDatum(p.i.reference_frame, p.i.epoch);
+		stnCount = msrCount = clusterID = 0;
+
+		time.start();
+		parserDynaML.ParseInputFile(filename, &vStations, &stnCount,
+			&vMeasurements, &msrCount, &clusterID, &input_file_meta, true,
+			&success_msg, &p);
+		ms = elapsed_ms(time);
+		if (run == 0 || ms < result.parse_ms)
+			result.parse_ms = ms;
+	}
+
+	result.stations = stnCount;
+	result.measurements = msrCount;
+
+	return result;
+}
+
+void print_result(std::ostream& os, const bench_result& result)
+{
+	os << std::setw(36) << std::left << result.file <<
+		std::setw(9) << std::right << result.lines <<
+		std::setw(9) << std::right << result.fields <<
+		std::setw(10) << std::right << std::fixed << std::setprecision(1) << result.spirit_ns <<
+		std::setw(10) << std::right << result.from_chars_ns <<
+		std::setw(8) << std::right << std::setprecision(2) <<
+			(result.from_chars_ns > 0. ? result.spirit_ns / result.from_chars_ns : 0.) <<
+		std::setw(8) << std::right << result.differ <<
+		std::setw(9) << std::right << result.stations <<
+		std::setw(9) << std::right << result.measurements <<
+		std::setw(10) << std::right << std::setprecision(1) << result.parse_ms <<
+		std::setw(12) << std::right << std::setprecision(0) <<
+			(result.parse_ms > 0. ? result.lines / result.parse_ms * 1000. : 0.) << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string files_str, input_folder(".");
+	UINT32 repeat(3);
+
+	boost::program_options::options_description options("Options");
+	options.add_options()
+		("help,h", "Show this help message.")
+		("files,f", boost::program_options::value<std::string>(&files_str),
+			"Comma delimited list of DNA station and measurement files to parse.")
+		("input-folder,i", boost::program_options::value<std::string>(&input_folder),
+			"Path containing the files.")
+		("repeat,r", boost::program_options::value<UINT32>(&repeat),
+			"Number of times each file is converted and parsed.  The fastest time is reported.  Default is 3.")
+		;
+
+	boost::program_options::variables_map vm;
+	try {
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, options), vm);
+		boost::program_options::notify(vm);
+	}
+	catch (const std::exception& e) {
+		std::cout << "- Error: " << e.what() << std::endl << options << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (vm.count("help") || files_str.empty())
+	{
+		std::cout << "Usage: dnaimportbench [options]" << std::endl << options << std::endl;
+		return vm.count("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (repeat < 1)
+		repeat = 1;
+
+	std::vector<std::string> file_list;
+	boost::split(file_list, files_str, boost::is_any_of(","), boost::token_compress_on);
+
+	std::cout << std::endl << "+ DNA parsing benchmark (" << repeat << " repeats, field times in ns per field, parse times in ms)" << std::endl << std::endl;
+	std::cout << std::setw(36) << std::left << "File" <<
+		std::setw(9) << std::right << "Lines" <<
+		std::setw(9) << std::right << "Fields" <<
+		std::setw(10) << std::right << "Spirit" <<
+		std::setw(10) << std::right << "Chars" <<
+		std::setw(8) << std::right << "Ratio" <<
+		std::setw(8) << std::right << "Differ" <<
+		std::setw(9) << std::right << "Stns" <<
+		std::setw(9) << std::right << "Msrs" <<
+		std::setw(10) << std::right << "Parse" <<
+		std::setw(12) << std::right << "Lines/s" << std::endl;
+	std::cout << std::string(130, '-') << std::endl;
+
+	std::vector<std::string>::const_iterator _it_str;
+	std::string filename;
+
+	try {
+		for (_it_str=file_list.begin(); _it_str!=file_list.end(); ++_it_str)
+		{
+			filename = boost::trim_copy(*_it_str);
+			if (!boost::filesystem::exists(filename))
+				filename = formPath<std::string>(input_folder, filename);
+			print_result(std::cout, run_benchmark(filename, repeat));
+		}
+	}
+	catch (const XMLInteropException& e) {
+		std::cout << std::endl << "- Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch (const std::exception& e) {
+		std::cout << std::endl << "- Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -421,6 +421,26 @@ int ParseCommandLineOptions(const int& argc, char* argv[], const boost::program_
 	if (vm.count(STATION_RENAMING_FILE))
 		p.i.rename_stations = 1;
 
+	if (p.i.parse_chunk_size == 0 || p.i.stn_sort_chunk_size == 0 || p.i.aml_chunk_size == 0)
+	{
+		std::cout << std::endl << "- Error: The parse, station sort and AML chunk sizes must be greater than zero." << std::endl << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Import cache folder
+	if (vm.count(IMPORT_CACHE_FOLDER))
+	{
+		try {
+			if (!boost::filesystem::exists(p.i.import_cache_folder))
+				boost::filesystem::create_directories(p.i.import_cache_folder);
+		}
+		catch (const boost::filesystem::filesystem_error& e) {
+			std::cout << std::endl << "- Error: Could not create the import cache folder " << p.i.import_cache_folder << "." << std::endl <<
+				"  " << e.what() << std::endl << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
 	return EXIT_SUCCESS;
 }
 
@@ -846,33 +866,52 @@ int ImportContiguousNetwork(dna_import& parserDynaML, vdnaStnPtr* vStations, vdn
 }
 	
 
+// Parses input files concurrently, each by its own dna_import (parse context),
+// on no more than the given number of threads.  Each parse context takes the
+// reference frame, epoch and discontinuities of parserDynaML.  Errors are held 
+// in each input_file_context_t, so that the files can be reported on in order.
+void ParseInputFilesConcurrently(dna_import& parserDynaML, vinput_file_context_t& vinput_files, 
+	project_settings& p, UINT32 threads)
+{
+	vinput_file_context_t::iterator _it_file;
+	for (_it_file=vinput_files.begin(); _it_file!=vinput_files.end(); ++_it_file)
+	{
+		_it_file->_parser.reset(new dna_import);
+		_it_file->_parser->InitialiseParseContext(parserDynaML);
+	}
+
+	if (threads > vinput_files.size())
+		threads = static_cast<UINT32>(vinput_files.size());
+
+	UINT32 t, nextFile(0);
+	boost::mutex nextFileMutex;
+
+	running = true;
+
+	boost::thread_group ui_interop_threads, interop_threads;
+	if (!p.g.quiet && isatty(fileno(stdout)))
+		ui_interop_threads.create_thread(dna_import_pool_progress_thread(&vinput_files));
+	for (t=0; t<threads; ++t)
+		interop_threads.create_thread(dna_import_pool_thread(&vinput_files, &nextFile, &nextFileMutex, &p));
+	interop_threads.join_all();
+
+	running = false;
+	ui_interop_threads.join_all();
+}
+	
+
 int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements,
 		vdnaStnPtr* vstationsTotal, vdnaMsrPtr* vmeasurementsTotal,
 		std::ofstream* imp_file, vifm_t* vinput_file_meta, StnTally* parsestnTally, MsrTally* parsemsrTally, 
 		UINT32& errorCount, project_settings& p)
 {
-	// For consideration:  
-	//	- All input files could be read concurrently using multi-thread for faster input
-	//	- The number of files that can be processed concurrently should be restricted to
-	//	  the number of available cores
-	//	- If multi-threading is to be used, then the progress thread will need to be redesigned.
-	//	  Currently, the progress of each file (as a percentage) is written to cout as each file
-	//	  is processed. If files are processed concurrently, progress reporting will need to be
-	//    redesigned if multiple progress threads are writing to cout.
-	//	- There is significant gain in using multi-thread.
-	//	- The catch will be the need to carefully design one progress thread that captures progress
-	//	  of all other "read" threads (rather than one progress for each), and somehow write to 
-	//	  cout the respective progress.  For example, loading four files could be displayed as 
-	//	  follows:
-	//
-	//	  + Parsing file1.xml (32%), file2.xml (16%), file3.xml (86%), file4.xml (56%)
-	//	    Done: Loaded 190 stations from file3.xml in 00.032s
-	//	  + Parsing file1.xml (72%), file2.xml (48%), file4.xml (91%)
-	//	    Done: Loaded 236 stations from file4.xml in 00.050s
-	//	  + Parsing file1.xml (87%), file2.xml (76%)
-	//	    Done: Loaded 1596 measurements from file1.xml in 01.380s
-	//	    Done: Loaded 3142 measurements from file2.xml in 02.034s
-	//
+	// The first file is parsed by parserDynaML, since its reference frame and epoch 
+	// may set the project defaults upon which the other files depend.  When there are
+	// two or more other files and more than one import thread (see --import-threads), 
+	// the other files are then parsed concurrently, each by its own dna_import (see 
+	// ParseInputFilesConcurrently).  In both cases, the files are reported on and
+	// merged in file order, so that the stations and measurements loaded are the same
+	// as those that would be loaded if each file were parsed in turn.
 	UINT32 stnCount(0), msrCount(0), clusterID(0);
 	
 	size_t pos = std::string::npos;
@@ -898,21 +937,44 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 
 	bool firstFile;
 
+	UINT32 threads(p.i.import_threads > 0 ? p.i.import_threads : boost::thread::hardware_concurrency());
+	bool concurrentParse(threads > 1 && nfiles > 2);
+	vinput_file_context_t vinput_files;
+	input_file_context_t* context(0);
+	dna_import* parser(&parserDynaML);
+
+	// Returns the path of an input file, or an empty string if the file does not exist
+	auto inputFilePath = [&p](const std::string& file) -> std::string {
+		if (boost::filesystem::exists(file))
+			return file;
+		std::string path(formPath<std::string>(p.g.input_folder, file));
+		if (boost::filesystem::exists(path))
+			return path;
+		return "";
+	};
+
 	// obtain the (default) project reference frame epsg code
 	std::string projectEpsgCode(epsgStringFromName<std::string>(p.i.reference_frame));
 
 	for (i=0; i<nfiles; i++)
 	{
+		// Having loaded the first file, parse all other files
+		if (i == 1 && concurrentParse)
+		{
+			vinput_files.resize(nfiles - 1);
+			for (size_t f=1; f<nfiles; ++f)
+				vinput_files.at(f-1)._filename = inputFilePath(p.i.input_files.at(f));
+			ParseInputFilesConcurrently(parserDynaML, vinput_files, p, threads);
+		}
+
 		stnCount = msrCount = 0;
-		input_file = p.i.input_files.at(i);
-		if (!boost::filesystem::exists(input_file))
+		memset(&input_file_meta, 0, sizeof(input_file_meta_t));
+		input_file = inputFilePath(p.i.input_files.at(i));
+		if (input_file.empty())
 		{
-			input_file = formPath<std::string>(p.g.input_folder, input_file);
-			if (!boost::filesystem::exists(input_file))
-			{	
-				std::cout << "- Error:  " << input_file << " does not exist" << std::endl;
-				return EXIT_FAILURE;
-			}
+			input_file = formPath<std::string>(p.g.input_folder, p.i.input_files.at(i));
+			std::cout << "- Error:  " << input_file << " does not exist" << std::endl;
+			return EXIT_FAILURE;
 		}
 			
 		ss = leafStr<std::string>(p.i.input_files.at(i)) + "... ";
@@ -920,19 +982,46 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 			std::cout << "  " << std::setw(strlen_arg) << std::left << ss;
 		*imp_file << "  " << std::setw(strlen_arg) << std::left << ss;
 
-		running = true;
 		firstFile = bool(i == 0);
 
-		boost::thread_group ui_interop_threads;
-		if (!p.g.quiet)
-			ui_interop_threads.create_thread(dna_import_progress_thread(&parserDynaML, &p));
-		ui_interop_threads.create_thread(dna_import_thread(&parserDynaML, &p, input_file,
-			vStations, &stnCount, vMeasurements, &msrCount,
-			&clusterID, &input_file_meta, firstFile, &status_msg,
-			&elapsed_time));
-		ui_interop_threads.join_all();
-
-		switch (parserDynaML.GetStatus())
+		if (i > 0 && concurrentParse)
+		{
+			// This file has already been parsed
+			context = &vinput_files.at(i-1);
+			parser = context->_parser.get();
+
+			stnCount = context->_stnCount;
+			msrCount = context->_msrCount;
+			vStations->swap(context->_vStations);
+			vMeasurements->swap(context->_vMeasurements);
+			input_file_meta = context->_input_file_meta;
+			status_msg = context->_status_msg;
+			elapsed_time = context->_elapsed_time;
+
+			// As for dna_import_thread
+			if (context->_exception)
+				std::cout << status_msg;
+
+			// Offset the cluster IDs and station file order from those of
+			// the files loaded so far
+			parserDynaML.MergeParseContext(*parser, vStations, vMeasurements, 
+				context->_clusterID, &clusterID);
+		}
+		else
+		{
+			running = true;
+
+			boost::thread_group ui_interop_threads;
+			if (!p.g.quiet)
+				ui_interop_threads.create_thread(dna_import_progress_thread(&parserDynaML, &p));
+			ui_interop_threads.create_thread(dna_import_thread(&parserDynaML, &p, input_file,
+				vStations, &stnCount, vMeasurements, &msrCount,
+				&clusterID, &input_file_meta, firstFile, &status_msg,
+				&elapsed_time));
+			ui_interop_threads.join_all();
+		}
+
+		switch (parser->GetStatus())
 		{
 		case PARSE_EXCEPTION_RAISED:
 			*imp_file << std::endl << status_msg;
@@ -1091,7 +1180,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 						datumSource << ". DynAdjust default (frame not present within SNX file)";
 						break;
 					default:
-						if (parserDynaML.filespecifiedReferenceFrame())
+						if (parser->filespecifiedReferenceFrame())
 							datumSource << ". Taken from " << FormatFileType<std::string>(input_file_meta.filetype) << " header.";
 						else
 							datumSource << ". Reference frame not supplied in " << FormatFileType<std::string>(input_file_meta.filetype) << " header.";
@@ -1102,7 +1191,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 					*imp_file << std::left << "  Project reference frame set to " << p.i.reference_frame << datumSource.str() << std::endl;
 				}				
 				// When the user has supplied a frame on the command line, and the input file datum field is blank
-				else if (!parserDynaML.filespecifiedReferenceFrame())
+				else if (!parser->filespecifiedReferenceFrame())
 				{
 					std::stringstream ssEpsgWarning;
 					switch (input_file_meta.filetype)
@@ -1145,7 +1234,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 					}
 					else
 					{
-						if (parserDynaML.filespecifiedEpoch())
+						if (parser->filespecifiedEpoch())
 						{
 							if (isEpsgDatumStatic(inputFileEpsgi))
 								epochSource << " (adopted reference epoch of " << inputFileDatum << ").";
@@ -1161,7 +1250,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 					}
 				}				
 				// When the user has supplied an epoch on the command line, and the input file epoch field is blank
-				else if (!parserDynaML.filespecifiedEpoch())
+				else if (!parser->filespecifiedEpoch())
 				{
 					std::stringstream ssEpochWarning;
 					ssEpochWarning << "  - Warning: Input file epoch not supplied. Adopting " << p.i.epoch << ".";
@@ -1196,7 +1285,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 					continue;
 
 				// Was the datum field empty in the file?
-				if (!parserDynaML.filespecifiedReferenceFrame())
+				if (!parser->filespecifiedReferenceFrame())
 				{					
 					std::stringstream ssEpsgWarning;
 					ssEpsgWarning << "  - Warning: Input file reference frame not supplied. Adopting " << inputFileDatum << ".";
@@ -1227,7 +1316,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 				}
 
 				// Was the epoch field empty in the file?
-				if (!parserDynaML.filespecifiedEpoch())
+				if (!parser->filespecifiedEpoch())
 				{
 					std::stringstream ssEpochWarning;
 					ssEpochWarning << "  - Warning: Input file epoch not supplied. Adopting " << p.i.epoch << ".";
@@ -1261,7 +1350,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 			//vstationsTotal.reserve(vstationsTotal.size() + stnCount);
 			// combine stations and station tally
 			vstationsTotal->insert(vstationsTotal->end(), vStations->begin(), vStations->end());
-			*parsestnTally += parserDynaML.GetStnTally();
+			*parsestnTally += parser->GetStnTally();
 			vStations->clear();
 		}
 		if (msrCount > 0) // measurements only
@@ -1269,7 +1358,7 @@ int ImportDataFiles(dna_import& parserDynaML, vdnaStnPtr* vStations, vdnaMsrPtr*
 			//vmeasurementsTotal.reserve(vmeasurementsTotal.size() + msrCount);
 			// combine measurements
 			vmeasurementsTotal->insert(vmeasurementsTotal->end(), vMeasurements->begin(), vMeasurements->end());
-			*parsemsrTally += parserDynaML.GetMsrTally();
+			*parsemsrTally += parser->GetMsrTally();
 			vMeasurements->clear();
 		}
 	}
@@ -1297,6 +1386,7 @@ int main(int argc, char* argv[])
 	boost::program_options::options_description data_screening_options("+ " + std::string(IMPORT_MODULE_SCREEN), PROGRAM_OPTIONS_LINE_LENGTH);
 	boost::program_options::options_description gnss_scaling_options("+ " + std::string(IMPORT_MODULE_GNSS_VAR), PROGRAM_OPTIONS_LINE_LENGTH);
 	boost::program_options::options_description simulation_options("+ " + std::string(IMPORT_MODULE_SIMULATE), PROGRAM_OPTIONS_LINE_LENGTH);
+	boost::program_options::options_description concurrency_options("+ " + std::string(IMPORT_MODULE_CONCURRENCY), PROGRAM_OPTIONS_LINE_LENGTH);
 	boost::program_options::options_description output_options("+ " + std::string(ALL_MODULE_OUTPUT), PROGRAM_OPTIONS_LINE_LENGTH);
 	boost::program_options::options_description export_options("+ " + std::string(ALL_MODULE_EXPORT), PROGRAM_OPTIONS_LINE_LENGTH);
 	boost::program_options::options_description generic_options("+ " + std::string(ALL_MODULE_GENERIC), PROGRAM_OPTIONS_LINE_LENGTH);
@@ -1366,6 +1456,8 @@ int main(int argc, char* argv[])
 				"Station renaming file")
 			(STATION_DISCONTINUITY_FILE, boost::program_options::value<std::string>(&p.i.stn_discontinuityfile),
 				"Station discontinuity file.  Applies discontinuity dates to station names in station and measurement files.")
+			(IMPORT_CACHE_FOLDER, boost::program_options::value<std::string>(&p.i.import_cache_folder),
+				"Folder in which to cache the stations and measurements parsed from each input file other than the first.  An unchanged input file parsed with the same options is loaded from the cache rather than parsed again.")
 			(TEST_NEARBY_STNS,
 				"Search for nearby stations.")
 			(TEST_NEARBY_STN_DIST, boost::program_options::value<double>(&p.i.search_stn_radius),
@@ -1439,6 +1531,20 @@ int main(int argc, char* argv[])
 				"Simulate exact measurements corresponding to the input measurements using the coordinates in the station file. To apply geoid--ellipsoid separations and deflections of the vertical to the simulated measurements, introduce a geoid file using the --geo-file option.")
 			;
 
+		concurrency_options.add_options()
+			(IMPORT_THREADS, boost::program_options::value<UINT32>(&p.i.import_threads),
+				"Number of threads with which to parse input files and large DNA files, and to sort and associate stations and measurements.  1 imports serially.  Default is the number of concurrent threads the CPU supports.")
+			(PARSE_CHUNK_SIZE, boost::program_options::value<UINT32>(&p.i.parse_chunk_size),
+				(std::string("Minimum size (in bytes) of the chunks into which a DNA file is split to be parsed concurrently.  Default is ")+
+				StringFromT(p.i.parse_chunk_size)+std::string(".")).c_str())
+			(STN_SORT_CHUNK_SIZE, boost::program_options::value<UINT32>(&p.i.stn_sort_chunk_size),
+				(std::string("Minimum number of stations sorted by each thread when the station map is created.  Default is ")+
+				StringFromT(p.i.stn_sort_chunk_size)+std::string(".")).c_str())
+			(AML_CHUNK_SIZE, boost::program_options::value<UINT32>(&p.i.aml_chunk_size),
+				(std::string("Minimum number of measurements in each chunk of the associated measurement list formed concurrently.  Default is ")+
+				StringFromT(p.i.aml_chunk_size)+std::string(".")).c_str())
+			;
+
 		generic_options.add_options()
 			(VERBOSE, boost::program_options::value<UINT16>(&p.g.verbose),
 				std::string("Give detailed information about what ").append(__BINARY_NAME__).append(" is doing.\n  0: No information (default)\n  1: Helpful information\n  2: Extended information\n  3: Debug level information").c_str())
@@ -1450,7 +1556,7 @@ int main(int argc, char* argv[])
 				"Provide help for a specific help category.")
 			;
 
-		allowable_options.add(standard_options).add(ref_frame_options).add(data_screening_options).add(gnss_scaling_options).add(simulation_options).add(output_options).add(export_options).add(generic_options);
+		allowable_options.add(standard_options).add(ref_frame_options).add(data_screening_options).add(gnss_scaling_options).add(simulation_options).add(concurrency_options).add(output_options).add(export_options).add(generic_options);
 
 		// add "positional options" to handle command line tokens which have no option name
 		positional_options.add(IMPORT_FILE, -1);
@@ -1511,6 +1617,9 @@ int main(int argc, char* argv[])
 		else if (str_upper<std::string, char>(IMPORT_MODULE_SIMULATE).find(help_text) != std::string::npos) {
 			std::cout << simulation_options << std::endl;
 		} 
+		else if (str_upper<std::string, char>(IMPORT_MODULE_CONCURRENCY).find(help_text) != std::string::npos) {
+			std::cout << concurrency_options << std::endl;
+		} 
 		else if (str_upper<std::string, char>(ALL_MODULE_OUTPUT).find(help_text) != std::string::npos) {
 			std::cout << output_options << std::endl;
 		} 
@@ -1685,6 +1794,11 @@ int main(int argc, char* argv[])
 		{
 			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  DNA simulated msr file: " << p.i.simulate_msrfile << std::endl;
 		}
+
+		if (!p.i.import_cache_folder.empty())
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Import cache folder: " << p.i.import_cache_folder << std::endl;
+		if (p.i.import_threads > 0)
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Import threads: " << p.i.import_threads << std::endl;
 		
 		if (!p.i.bounding_box.empty())
 		{
@@ -2813,17 +2927,18 @@ int main(int argc, char* argv[])
 				std::cout << "+ Testing internal integrity of ASL, AML and binary files... ";
 				std::cout.flush();
 			}
-			std::ifstream binaryMS(p.i.bms_file.c_str(), std::ios::in | std::ios::binary | std::ifstream::ate);	/// Open and seek to end immediately after opening.
-			if (!binaryMS.good())
-			{
-				std::cout << std::endl << "- Could not open binary file for reading." << std::endl;
-				imp_file << std::endl << "- Could not open binary file for reading." << std::endl;
+			mapped_msr_t binaryMS;
+			binary_file_meta_t bms_meta;
+			try {
+				dna_io_bms bms;
+				bms.map_bms_file(p.i.bms_file, binaryMS, bms_meta);
+			}
+			catch (const std::runtime_error& e) {
+				std::cout << std::endl << "- Could not open binary file for reading." << std::endl << e.what() << std::endl;
+				imp_file << std::endl << "- Could not open binary file for reading." << std::endl << e.what() << std::endl;
 				imp_file.close();
 				return EXIT_FAILURE;
 			}
-			// get size, then go back to beginning
-			size_t sFileSize = (size_t)binaryMS.tellg();
-			binaryMS.seekg(0, std::ios::beg);
 
 			measurement_t measRecord;
 			
@@ -2836,16 +2951,15 @@ int main(int argc, char* argv[])
 				for (msr=0; msr<amlcount; msr++)
 				{
 					amlindex = associatedSL.at(stn).get()->GetAMLStnIndex() + msr;
-					if (associatedML.at(amlindex) * sizeof(measurement_t) >= sFileSize)
+					if (associatedML.at(amlindex) >= binaryMS.size())
 					{
 						std::cout << "Error: index " << associatedML.at(amlindex) << " is out of range for the binary file." << std::endl;
 						continue;
 					}
-					binaryMS.seekg(sizeof(UINT32) + associatedML.at(amlindex) * sizeof(measurement_t), std::ios::beg);
-					binaryMS.read(reinterpret_cast<char *>(&measRecord), sizeof(measurement_t));
+					measRecord = binaryMS[associatedML.at(amlindex)];
 				}
 			}
-			binaryMS.close();
+			binaryMS.release();
 			if (!p.g.quiet)
 				std::cout << "OK." << std::endl;
 		}
@@ -2889,6 +3003,11 @@ int main(int argc, char* argv[])
 		imp_file.close();
 		return EXIT_FAILURE;
 	}
+
+	// The measurements are no longer required.  Release them, and the 
+	// station names held by them
+	vMeasurements.clear();
+	parserDynaML.ReleaseMeasurements(&vmeasurementsTotal);
 	
 	if (!userSuppliedSegFile)
 		p.i.seg_file = "";
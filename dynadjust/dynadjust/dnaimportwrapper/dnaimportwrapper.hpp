@@ -164,4 +164,137 @@ private:
 	project_settings*	_p;
 };
 
+// An input file parsed concurrently by its own dna_import (parse context).
+// See ParseInputFilesConcurrently.
+typedef struct input_file_context {
+	input_file_context()
+		: _stnCount(0), _msrCount(0), _clusterID(0), _exception(false)
+		, _elapsed_time(boost::posix_time::milliseconds(0)) {
+			memset(&_input_file_meta, 0, sizeof(input_file_meta_t));
+	}
+	std::string			_filename;
+	boost::shared_ptr<dna_import>	_parser;
+	vdnaStnPtr			_vStations;
+	vdnaMsrPtr			_vMeasurements;
+	UINT32				_stnCount;
+	UINT32				_msrCount;
+	UINT32				_clusterID;			// last cluster ID assigned by _parser
+	input_file_meta_t	_input_file_meta;
+	std::string			_status_msg;
+	bool				_exception;			// was an exception raised?
+	boost::posix_time::milliseconds		_elapsed_time;
+} input_file_context_t;
+
+typedef std::vector<input_file_context_t> vinput_file_context_t;
+
+// Parses the next input file not yet parsed by another thread, 
+// until all files have been parsed.
+class dna_import_pool_thread
+{
+public:
+	dna_import_pool_thread(vinput_file_context_t* vinput_files, PUINT32 nextFile, 
+		boost::mutex* nextFileMutex, project_settings* p)
+		: _vinput_files(vinput_files), _nextFile(nextFile)
+		, _nextFileMutex(nextFileMutex), _p(p) {};
+	void operator()()
+	{
+		UINT32 file;
+		
+		while (true)
+		{
+			_nextFileMutex->lock();
+			file = (*_nextFile)++;
+			_nextFileMutex->unlock();
+
+			if (file >= _vinput_files->size())
+				return;
+
+			input_file_context_t& context(_vinput_files->at(file));
+
+			// Does the file exist?
+			if (context._filename.empty())
+				continue;
+			
+			boost::timer::cpu_timer time;	// constructor of boost::timer::cpu_timer calls start()
+			try {
+				context._parser->ParseInputFile(context._filename, 
+					&context._vStations, &context._stnCount, 
+					&context._vMeasurements, &context._msrCount, 
+					&context._clusterID, &context._input_file_meta, false,
+					&context._status_msg, _p);
+				context._elapsed_time = boost::posix_time::milliseconds(time.elapsed().wall/MILLI_TO_NANO);
+			} 
+			catch (const XMLInteropException& e) {
+				// Hold the error until the file is reported on
+				std::stringstream err_msg;
+				err_msg << std::endl << "- Error: " << e.what() << std::endl;
+				context._status_msg = err_msg.str();
+				context._exception = true;
+			}
+		}
+	}
+
+private:
+	vinput_file_context_t*	_vinput_files;
+	PUINT32				_nextFile;
+	boost::mutex*		_nextFileMutex;
+	project_settings*	_p;
+};
+
+// Prints the progress of all files being parsed on the one line, i.e.:
+//   Parsing file1.msr (32%), file2.msr (16%), file3.stn (86%)
+class dna_import_pool_progress_thread
+{
+public:
+	dna_import_pool_progress_thread(vinput_file_context_t* vinput_files)
+		: _vinput_files(vinput_files) {};
+	void operator()()
+	{
+		double percentComplete(0.);
+		std::ostringstream ss;
+		std::string progress;
+		size_t length(0);
+		const size_t max_length(79);		// fit within an 80 column terminal
+
+		vinput_file_context_t::iterator _it_file;
+
+		while (running)
+		{
+			ss.str("");
+			for (_it_file=_vinput_files->begin(); _it_file!=_vinput_files->end(); ++_it_file)
+			{
+				// Is this file being parsed?
+				if ((percentComplete = _it_file->_parser->GetProgress()) < 0.)
+					continue;
+				if (percentComplete > 100.)
+					percentComplete = 100.;
+
+				ss << (ss.str().empty() ? "  Parsing " : ", ") << leafStr<std::string>(_it_file->_filename) << 
+					" (" << std::fixed << std::setprecision(0) << percentComplete << "%)";
+			}
+
+			progress = ss.str();
+			if (progress.length() > max_length)
+				progress = progress.substr(0, max_length - 3) + "...";
+
+			cout_mutex.lock();
+			std::cout << "\r" << std::setw(length) << std::left << progress;
+			std::cout.flush();
+			cout_mutex.unlock();
+			
+			length = std::max(length, progress.length());
+
+			boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+		}
+
+		// Clear the line
+		cout_mutex.lock();
+		std::cout << "\r" << std::setw(length) << "" << "\r";
+		std::cout.flush();
+		cout_mutex.unlock();
+	}
+private:
+	vinput_file_context_t*	_vinput_files;
+};
+
 #endif
@@ -0,0 +1,576 @@
+//============================================================================
+// Name         : dnamatrixbench.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Matrix backend benchmark
+//                Times each available BLAS/LAPACK backend on the matrix
+//                operations performed for each block of an adjustment:
+//                  - formation of the normals:      AtVinv (n x m) * A (m x n)
+//                  - computation of corrections:    Ninv (n x n) * AtVinv_m (n x 1)
+//                  - inversion of the normals:      Cholesky inverse (n x n)
+//                where n = 3 x stations in the block and m is the number of
+//                measurements.  Results from each backend are compared with
+//                those of the first (default) backend.
+//                Also times the allocation of the matrices formed for a
+//                block on each iteration, with the buffer pool disabled
+//                (each buffer obtained from the system) and enabled, and
+//                counts the buffers obtained from the system.  With
+//                --networks, allocation is timed for the blocks of
+//                segmented networks (read from the .seg and .bms files).
+//                With --test-kernels, tests the unrolled 3x3 products of
+//                matrix_fixed against matrix_backend::dgemm instead.
+//============================================================================
+
+#include <include/math/dnamatrix_contiguous.hpp>
+#include <include/math/dnamatrix_fixed.hpp>
+#include <include/math/dnamatrix_backend.hpp>
+#include <include/memory/dnamemory_pool.hpp>
+#include <include/io/dnaiobms.hpp>
+#include <include/io/dnaioseg.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <cfloat>
+#include <cstring>
+#include <random>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+using namespace dynadjust::math;
+using namespace dynadjust::memory;
+using namespace dynadjust::iostreams;
+
+typedef struct {
+	double normals_ms;
+	double corrections_ms;
+	double inverse_ms;
+	double max_diff;
+} bench_result;
+
+typedef struct {
+	double ms;						// time per iteration
+	double requests;				// buffers requested per iteration
+	double system_allocs;			// buffers obtained from the system per iteration
+} allocation_result;
+
+typedef struct {
+	UINT32 differences;
+	double max_diff;
+	UINT32 exceeded;
+} kernel_result;
+
+// Returns the largest absolute difference between two matrices
+double max_difference(const matrix_2d& lhs, const matrix_2d& rhs)
+{
+	double diff(0.);
+	for (UINT32 c(0); c<lhs.columns(); ++c)
+		for (UINT32 r(0); r<lhs.rows(); ++r)
+			diff = std::max(diff, fabs(lhs.get(r, c) - rhs.get(r, c)));
+	return diff;
+}
+
+double elapsed_ms(const boost::timer::cpu_timer& time)
+{
+	return time.elapsed().wall / 1.0e6;
+}
+
+// Forms a design matrix A (m x n) and weighted transpose AtVinv (n x m) with
+// the sparsity of a GNSS baseline network: each measurement row references
+// the three coordinates of two stations.
+void form_design(const UINT32 stations, const UINT32 measurements,
+	matrix_2d& design, matrix_2d& AtVinv)
+{
+	std::mt19937 rng(stations);
+	std::uniform_int_distribution<UINT32> station(0, stations - 1);
+	std::uniform_real_distribution<double> weight(0.5, 2.0);
+
+	UINT32 n(stations * 3), m(measurements * 3);
+	design.redim(m, n);
+	AtVinv.redim(n, m);
+	design.zero();
+	AtVinv.zero();
+
+	UINT32 msr, stn1, stn2, i;
+	double w;
+	for (msr=0; msr<measurements; ++msr)
+	{
+		stn1 = station(rng);
+		stn2 = (stn1 + 1 + station(rng) % (stations - 1)) % stations;
+		w = weight(rng);
+		for (i=0; i<3; ++i)
+		{
+			design.put(msr * 3 + i, stn1 * 3 + i, -1.);
+			design.put(msr * 3 + i, stn2 * 3 + i, 1.);
+			AtVinv.put(stn1 * 3 + i, msr * 3 + i, -w);
+			AtVinv.put(stn2 * 3 + i, msr * 3 + i, w);
+		}
+	}
+}
+
+bench_result run_benchmark(const UINT32 stations, const UINT32 repeat,
+	const matrix_2d* reference_inverse, matrix_2d& inverse)
+{
+	bench_result result = { 0., 0., 0., 0. };
+
+	const UINT32 n(stations * 3);
+	matrix_2d design, AtVinv;
+	form_design(stations, stations * 2, design, AtVinv);
+
+	matrix_2d measMinusComp(design.rows(), 1);
+	for (UINT32 r(0); r<measMinusComp.rows(); ++r)
+		measMinusComp.put(r, 0, 0.001 * (r % 7));
+
+	matrix_2d normals(n, n), At_Vinv_m(n, 1), corrections(n, 1);
+
+	for (UINT32 run(0); run<repeat; ++run)
+	{
+		// Normals
+		boost::timer::cpu_timer time;
+		normals.multiply_mkl(AtVinv, "N", design, "N");
+		result.normals_ms += elapsed_ms(time);
+
+		// Constrain all stations (as per free station s.d.) so that the
+		// normals are positive definite
+		for (UINT32 i(0); i<n; ++i)
+			normals.elementadd(i, i, 0.01);
+
+		// Inverse
+		inverse = normals;
+		time.start();
+		inverse.choleskyinverse_mkl();
+		result.inverse_ms += elapsed_ms(time);
+
+		// Corrections
+		At_Vinv_m.multiply_mkl(AtVinv, "N", measMinusComp, "N");
+		time.start();
+		corrections.multiply_mkl(inverse, "N", At_Vinv_m, "N");
+		result.corrections_ms += elapsed_ms(time);
+	}
+
+	result.normals_ms /= repeat;
+	result.inverse_ms /= repeat;
+	result.corrections_ms /= repeat;
+
+	if (reference_inverse != 0)
+		result.max_diff = max_difference(inverse, *reference_inverse);
+
+	return result;
+}
+
+// Returns the average time taken to allocate (and initialise) the design,
+// AtVinv, normals, corrections and measured minus computed vector of each
+// block, as per one iteration of an adjustment, and the number of buffers
+// requested and obtained from the system.  The pool is reset at the end of
+// each iteration, as per dna_adjust::RecycleMatrixBuffers.
+allocation_result time_allocation(const vUINT32& unknowns, const vUINT32& measurements, 
+	const UINT32 iterations)
+{
+	buffer_pool::release();
+
+	const std::size_t requests(buffer_pool::stats().requests_);
+	const std::size_t system_allocs(buffer_pool::stats().system_allocs_);
+
+	boost::timer::cpu_timer time;
+	for (UINT32 iteration(0); iteration<iterations; ++iteration)
+	{
+		for (UINT32 block(0); block<unknowns.size(); ++block)
+		{
+			const UINT32 n(unknowns.at(block)), m(measurements.at(block));
+			matrix_2d design(m, n), AtVinv(n, m), normals(n, n), corrections(n, 1), measMinusComp(m, 1);
+		}
+		buffer_pool::reset();
+	}
+
+	allocation_result result = { elapsed_ms(time) / iterations,
+		static_cast<double>(buffer_pool::stats().requests_ - requests) / iterations,
+		static_cast<double>(buffer_pool::stats().system_allocs_ - system_allocs) / iterations };
+	return result;
+}
+
+// Loads the number of unknowns and measurement quantities of each block
+// of a segmented network from network.seg and network.bms
+void load_block_sizes(const std::string& network, vUINT32& unknowns, vUINT32& measurements)
+{
+	vmsr_t bmsBinaryRecords;
+	binary_file_meta_t bms_meta;
+	dna_io_bms bms;
+	bms.load_bms_file(network + ".bms", &bmsBinaryRecords, bms_meta);
+
+	UINT32 blockCount, blockThreshold, minInnerStns;
+	vvUINT32 v_ISL, v_JSL, v_CML;
+	vUINT32 v_ContiguousNetList, v_parameterStationCount;
+	dna_io_seg seg;
+	seg.load_seg_file(network + ".seg", blockCount, blockThreshold, minInnerStns,
+		v_ISL, v_JSL, v_CML, true, &bmsBinaryRecords, &measurements, 
+		&unknowns, &v_ContiguousNetList, &v_parameterStationCount);
+}
+
+// Prints the allocation times with the pool disabled (system) and enabled
+// (pooled), the number of buffers requested, and the number of buffers 
+// obtained from the system with the pool disabled and enabled
+void print_allocation(const allocation_result& system, const allocation_result& pooled)
+{
+	std::cout << std::setw(14) << std::right << std::fixed << std::setprecision(3) << system.ms <<
+		std::setw(14) << std::right << pooled.ms <<
+		std::setw(13) << std::right << std::setprecision(1) << (pooled.ms > 0. ? system.ms / pooled.ms : 0.) << "x" <<
+		std::setw(12) << std::right << std::setprecision(0) << system.requests <<
+		std::setw(16) << std::right << system.system_allocs <<
+		std::setw(16) << std::right << pooled.system_allocs << std::endl;
+}
+
+// Prints the heading of an allocation table, following the columns 
+// which describe the block(s)
+void print_allocation_heading(const std::size_t& width)
+{
+	std::cout << 
+		std::setw(14) << std::right << "System" <<
+		std::setw(14) << std::right << "Pooled" <<
+		std::setw(14) << std::right << "Speed-up" <<
+		std::setw(12) << std::right << "Requests" <<
+		std::setw(16) << std::right << "System allocs" <<
+		std::setw(16) << std::right << "Pooled allocs" << std::endl;
+	std::cout << std::string(width + 86, '-') << std::endl;
+}
+
+// Tallies the differences between a fixed-size product and the same 
+// product formed by dgemm: the number of elements which are not bitwise
+// equal, the largest difference, and the number of elements which differ
+// by more than the rounding error of a three term sum, i.e. 
+// 2 * epsilon * sum(|a(i,k) * b(k,j)|), held in bound
+template <UINT32 R, UINT32 C>
+void compare_product(const matrix_fixed<double, R, C>& fixed, const matrix_2d& dgemm,
+	const matrix_fixed<double, R, C>& bound, kernel_result& result)
+{
+	double f, d;
+	for (UINT32 r(0); r<R; ++r)
+		for (UINT32 c(0); c<C; ++c)
+		{
+			f = fixed.get(r, c);
+			d = dgemm.get(r, c);
+			if (memcmp(&f, &d, sizeof(double)) == 0)
+				continue;
+			++result.differences;
+			result.max_diff = std::max(result.max_diff, fabs(f - d));
+			if (fabs(f - d) > 2. * DBL_EPSILON * bound.get(r, c))
+				++result.exceeded;
+		}
+}
+
+// Tests the unrolled 3x3 x 3x3 and 3x3 x 3x1 products of matrix_fixed
+// (nn, tn and nt) against the products formed by matrix_2d::multiply_mkl,
+// i.e. by matrix_backend::dgemm, of each backend.
+// The nn and nt products of the reference backend sum the terms in the
+// same order as the unrolled kernels, so must be bitwise identical.  The
+// reference tn product (a dot product of columns) is a vectorised 
+// reduction, which may order the sums differently, as may an optimised
+// library for any product.  All other products must agree to within the
+// rounding error of the sum.  Returns the number of products which fail.
+UINT32 test_kernels(const std::vector<std::string>& backend_list, const UINT32 trials)
+{
+	// When fused multiply-adds are available, the compiler may contract
+	// the unrolled kernels and the reference loops differently
+#if defined(__FMA__) || defined(__AVX2__)
+	const bool contracted(true);
+#else
+	const bool contracted(false);
+#endif
+
+	enum { nn33, tn33, nt33, nn31, tn31, kernel_count };
+	static const char* const kernels[] = { "3x3 nn", "3x3 tn", "3x3 nt", "3x1 nn", "3x1 tn" };
+
+	std::cout << std::endl << "+ Fixed-size kernel test (" << trials << " products of each kernel)" << std::endl << std::endl;
+	std::cout << std::setw(12) << std::left << "Backend" <<
+		std::setw(10) << std::left << "Kernel" <<
+		std::setw(10) << std::left << "Expect" <<
+		std::setw(14) << std::right << "Differences" <<
+		std::setw(14) << std::right << "Max diff" <<
+		std::setw(14) << std::right << "Over bound" << std::endl;
+	std::cout << std::string(74, '-') << std::endl;
+
+	UINT32 failures(0);
+	
+	for (std::vector<std::string>::const_iterator _it_backend(backend_list.begin()); _it_backend!=backend_list.end(); ++_it_backend)
+	{
+		matrix_backend::select(boost::trim_copy(*_it_backend));
+
+		std::mt19937 rng(trials);
+		std::uniform_real_distribution<double> element(-1.0e3, 1.0e3);
+
+		std::vector<kernel_result> results(kernel_count);
+		for (UINT32 k(0); k<kernel_count; ++k)
+			results.at(k) = { 0, 0., 0 };
+
+		Mat3 a, b, abs_a, abs_b, r33, bound33;
+		Vec3 v, abs_v, r31, bound31;
+		matrix_2d a2(3, 3), b2(3, 3), v2(3, 1), p33(3, 3), p31(3, 1);
+		UINT32 i, j;
+
+		for (UINT32 trial(0); trial<trials; ++trial)
+		{
+			for (i=0; i<3; ++i)
+			{
+				for (j=0; j<3; ++j)
+				{
+					a.put(i, j, element(rng));
+					b.put(i, j, element(rng));
+					abs_a.put(i, j, fabs(a.get(i, j)));
+					abs_b.put(i, j, fabs(b.get(i, j)));
+					a2.put(i, j, a.get(i, j));
+					b2.put(i, j, b.get(i, j));
+				}
+				v.put(i, 0, element(rng));
+				abs_v.put(i, 0, fabs(v.get(i, 0)));
+				v2.put(i, 0, v.get(i, 0));
+			}
+
+			r33.multiply(a, b);
+			bound33.multiply(abs_a, abs_b);
+			p33.multiply_mkl(a2, "N", b2, "N");
+			compare_product(r33, p33, bound33, results.at(nn33));
+
+			r33.multiply_tn(a, b);
+			bound33.multiply_tn(abs_a, abs_b);
+			p33.multiply_mkl(a2, "T", b2, "N");
+			compare_product(r33, p33, bound33, results.at(tn33));
+
+			r33.multiply_nt(a, b);
+			bound33.multiply_nt(abs_a, abs_b);
+			p33.multiply_mkl(a2, "N", b2, "T");
+			compare_product(r33, p33, bound33, results.at(nt33));
+
+			r31.multiply(a, v);
+			bound31.multiply(abs_a, abs_v);
+			p31.multiply_mkl(a2, "N", v2, "N");
+			compare_product(r31, p31, bound31, results.at(nn31));
+
+			r31.multiply_tn(a, v);
+			bound31.multiply_tn(abs_a, abs_v);
+			p31.multiply_mkl(a2, "T", v2, "N");
+			compare_product(r31, p31, bound31, results.at(tn31));
+		}
+
+		for (UINT32 k(0); k<kernel_count; ++k)
+		{
+			bool bitwise(!contracted && matrix_backend::name() == "reference" && k != tn33 && k != tn31);
+			
+			std::cout << std::setw(12) << std::left << matrix_backend::name() <<
+				std::setw(10) << std::left << kernels[k] <<
+				std::setw(10) << std::left << (bitwise ? "bitwise" : "rounding") <<
+				std::setw(14) << std::right << results.at(k).differences <<
+				std::setw(14) << std::right << std::scientific << std::setprecision(2) << results.at(k).max_diff <<
+				std::setw(14) << std::right << results.at(k).exceeded << std::endl;
+			
+			failures += (bitwise ? results.at(k).differences : results.at(k).exceeded);
+		}
+	}
+
+	std::cout << std::endl;
+	return failures;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string sizes_str("50,100,200,500,1000");
+	std::string backends_str, networks_str;
+	UINT32 repeat(3), iterations(20), trials(100000);
+
+	boost::program_options::options_description options("Options");
+	options.add_options()
+		("help,h", "Show this help message.")
+		("stations,s", boost::program_options::value<std::string>(&sizes_str),
+			(std::string("Comma delimited list of block sizes (number of stations).  Default is ") +
+			sizes_str + std::string(".")).c_str())
+		("backends,b", boost::program_options::value<std::string>(&backends_str),
+			(std::string("Comma delimited list of backends to benchmark.  Default is all available (") +
+			matrix_backend::available_list() + std::string(").")).c_str())
+		("repeat,r", boost::program_options::value<UINT32>(&repeat),
+			"Number of times each operation is repeated.  Default is 3.")
+		("iterations,i", boost::program_options::value<UINT32>(&iterations),
+			"Number of iterations over which matrix allocation is timed.  Default is 20.")
+		("networks,n", boost::program_options::value<std::string>(&networks_str),
+			"Comma delimited list of segmented networks.  Matrix allocation is also timed for the blocks of each network, as read from network.seg and network.bms.")
+		("test-kernels,t",
+			"Test the unrolled 3x3 products of the fixed-size matrices against the dgemm of each backend, rather than benchmark.  Fails if a product is not bitwise identical to the reference backend's where the order of summation is the same, or differs by more than rounding error otherwise.")
+		("trials", boost::program_options::value<UINT32>(&trials),
+			"Number of random products of each kernel to test.  Default is 100000.")
+		;
+
+	boost::program_options::variables_map vm;
+
+	try {
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, options), vm);
+		boost::program_options::notify(vm);
+	}
+	catch (const std::exception& e) {
+		std::cout << "- Error: " << e.what() << std::endl << options << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (vm.count("help"))
+	{
+		std::cout << "Usage: dnamatrixbench [options]" << std::endl << options << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	if (repeat < 1)
+		repeat = 1;
+	if (iterations < 1)
+		iterations = 1;
+
+	std::vector<std::string> size_list, backend_list, network_list;
+	boost::split(size_list, sizes_str, boost::is_any_of(","), boost::token_compress_on);
+	if (!networks_str.empty())
+		boost::split(network_list, networks_str, boost::is_any_of(","), boost::token_compress_on);
+	if (backends_str.empty())
+		backend_list = matrix_backend::available();
+	else
+		boost::split(backend_list, backends_str, boost::is_any_of(","), boost::token_compress_on);
+
+	if (vm.count("test-kernels"))
+	{
+		try {
+			if (test_kernels(backend_list, trials) > 0)
+			{
+				std::cout << "- Error: the fixed-size products differ from those formed by dgemm." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		catch (const std::exception& e) {
+			std::cout << std::endl << "- Error: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	std::cout << std::endl << "+ Matrix backend benchmark (" << repeat << " repeats, times in ms)" << std::endl << std::endl;
+	std::cout << std::setw(12) << std::left << "Backend" <<
+		std::setw(10) << std::right << "Stations" <<
+		std::setw(10) << std::right << "Unknowns" <<
+		std::setw(14) << std::right << "Normals" <<
+		std::setw(14) << std::right << "Inverse" <<
+		std::setw(14) << std::right << "Corrections" <<
+		std::setw(14) << std::right << "Max diff" << std::endl;
+	std::cout << std::string(88, '-') << std::endl;
+
+	try {
+		for (std::vector<std::string>::const_iterator _it_size(size_list.begin()); _it_size!=size_list.end(); ++_it_size)
+		{
+			UINT32 stations(boost::lexical_cast<UINT32>(boost::trim_copy(*_it_size)));
+			if (stations < 2)
+				continue;
+
+			matrix_2d reference_inverse;
+			bool have_reference(false);
+
+			for (std::vector<std::string>::const_iterator _it_backend(backend_list.begin()); _it_backend!=backend_list.end(); ++_it_backend)
+			{
+				matrix_backend::select(boost::trim_copy(*_it_backend));
+
+				matrix_2d inverse;
+				bench_result result(run_benchmark(stations, repeat,
+					have_reference ? &reference_inverse : 0, inverse));
+
+				if (!have_reference)
+				{
+					reference_inverse = inverse;
+					have_reference = true;
+				}
+
+				std::cout << std::setw(12) << std::left << matrix_backend::name() <<
+					std::setw(10) << std::right << stations <<
+					std::setw(10) << std::right << stations * 3 <<
+					std::setw(14) << std::right << std::fixed << std::setprecision(3) << result.normals_ms <<
+					std::setw(14) << std::right << result.inverse_ms <<
+					std::setw(14) << std::right << result.corrections_ms <<
+					std::setw(14) << std::right << std::scientific << std::setprecision(2) << result.max_diff << std::endl;
+			}
+		}
+	}
+	catch (const std::exception& e) {
+		std::cout << std::endl << "- Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << std::endl << "+ Matrix allocation benchmark (" << iterations << " iterations, times in ms and buffers per iteration)" << std::endl << std::endl;
+	std::cout << std::setw(10) << std::right << "Stations" <<
+		std::setw(10) << std::right << "Unknowns";
+	print_allocation_heading(20);
+
+	const std::size_t cache_limit(buffer_pool::cache_limit());
+
+	try {
+		for (std::vector<std::string>::const_iterator _it_size(size_list.begin()); _it_size!=size_list.end(); ++_it_size)
+		{
+			UINT32 stations(boost::lexical_cast<UINT32>(boost::trim_copy(*_it_size)));
+			if (stations < 2)
+				continue;
+
+			vUINT32 unknowns(1, stations * 3), measurements(1, stations * 6);
+
+			// A cache limit of zero returns every buffer to the system
+			buffer_pool::set_cache_limit(0);
+			allocation_result system(time_allocation(unknowns, measurements, iterations));
+			buffer_pool::set_cache_limit(cache_limit);
+			allocation_result pooled(time_allocation(unknowns, measurements, iterations));
+
+			std::cout << std::setw(10) << std::right << stations <<
+				std::setw(10) << std::right << stations * 3;
+			print_allocation(system, pooled);
+		}
+
+		if (!network_list.empty())
+		{
+			std::cout << std::endl << "+ Matrix allocation benchmark on segmented networks (" << iterations << " iterations, times in ms and buffers per iteration)" << std::endl << std::endl;
+			std::cout << std::setw(20) << std::left << "Network" <<
+				std::setw(10) << std::right << "Blocks" <<
+				std::setw(10) << std::right << "Unknowns" <<
+				std::setw(10) << std::right << "Largest";
+			print_allocation_heading(50);
+		}
+
+		for (std::vector<std::string>::const_iterator _it_network(network_list.begin()); _it_network!=network_list.end(); ++_it_network)
+		{
+			std::string network(boost::trim_copy(*_it_network));
+			vUINT32 unknowns, measurements;
+			load_block_sizes(network, unknowns, measurements);
+
+			buffer_pool::set_cache_limit(0);
+			allocation_result system(time_allocation(unknowns, measurements, iterations));
+			buffer_pool::set_cache_limit(cache_limit);
+			allocation_result pooled(time_allocation(unknowns, measurements, iterations));
+
+			std::cout << std::setw(20) << std::left << network <<
+				std::setw(10) << std::right << unknowns.size() <<
+				std::setw(10) << std::right << std::accumulate(unknowns.begin(), unknowns.end(), UINT32(0)) <<
+				std::setw(10) << std::right << *std::max_element(unknowns.begin(), unknowns.end());
+			print_allocation(system, pooled);
+		}
+	}
+	catch (const std::exception& e) {
+		std::cout << std::endl << "- Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	buffer_pool::release();
+
+	std::cout << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -2228,10 +2228,9 @@ void dna_plot::DetermineBoundingBox()
 
 void dna_plot::CalculateLimitsFromStation()
 {
-	it_pair_string_vUINT32 _it_stnmap;
-	_it_stnmap = equal_range(stnsMap_.begin(), stnsMap_.end(), pprj_->p._plot_station_centre, StationNameIDCompareName());
+	UINT32 stn_index(stnsIndex_.find(pprj_->p._plot_station_centre));
 
-	if (_it_stnmap.first == _it_stnmap.second)
+	if (stn_index == station_name_index::npos)
 	{
 		std::stringstream ss;
 		ss.str("");
@@ -2239,8 +2238,8 @@ void dna_plot::CalculateLimitsFromStation()
 		SignalExceptionPlot(ss.str(), 0, NULL);
 	}
 
-	pprj_->p._plot_centre_latitude = bstBinaryRecords_.at(_it_stnmap.first->second).initialLatitude;
-	pprj_->p._plot_centre_longitude = bstBinaryRecords_.at(_it_stnmap.first->second).initialLongitude;
+	pprj_->p._plot_centre_latitude = bstBinaryRecords_.at(stn_index).initialLatitude;
+	pprj_->p._plot_centre_longitude = bstBinaryRecords_.at(stn_index).initialLongitude;
 	
 	CalculateLimitsFromPoint();
 }
@@ -2338,7 +2337,7 @@ void dna_plot::PrintStationsDataFileBlock(const UINT32& block)
 	}
 
 	// print isl coordinates
-	it_vstn_t_const _it_stn;
+	mapped_stn_t::const_iterator _it_stn;
 	for (it_vUINT32 _it_isl=v_ISL_.at(block).begin();
 		_it_isl<v_ISL_.at(block).end(); 
 		++_it_isl)
@@ -2408,7 +2407,7 @@ void dna_plot::PrintStationsDataFile()
 
 	std::stringstream ss;
 
-	for (it_vstn_t_const _it_stn(bstBinaryRecords_.begin());
+	for (mapped_stn_t::const_iterator _it_stn(bstBinaryRecords_.begin());
 		_it_stn<bstBinaryRecords_.end(); 
 		++_it_stn)
 	{
@@ -2445,7 +2444,7 @@ void dna_plot::PrintStationsDataFile()
 }
 	
 
-void dna_plot::PrintStationDataFile(std::ostream& os, it_vstn_t_const _it_stn)
+void dna_plot::PrintStationDataFile(std::ostream& os, mapped_stn_t::const_iterator _it_stn)
 {
 	if (default_limits_) 
 	{
@@ -2464,7 +2463,7 @@ void dna_plot::PrintStationDataFile(std::ostream& os, it_vstn_t_const _it_stn)
 		_it_stn->initialLatitude << std::endl;
 }
 
-void dna_plot::PrintStationLabel(std::ostream& os, it_vstn_t_const _it_stn)
+void dna_plot::PrintStationLabel(std::ostream& os, mapped_stn_t::const_iterator _it_stn)
 {
 	if (_it_stn->unusedStation)
 		return;
@@ -2514,10 +2513,10 @@ void dna_plot::PrintStationLabels()
 	initialiseIncrementingIntegerVector<UINT32>(stnList, static_cast<UINT32>(bstBinaryRecords_.size()));
 
 	// sort stations on longitude so labels to the left are placed last
-	CompareStnLongitude<station_t, UINT32> stnorderCompareFunc(&bstBinaryRecords_, false);
+	CompareStnLongitude<station_t, UINT32, mapped_stn_t> stnorderCompareFunc(&bstBinaryRecords_, false);
 	std::sort(stnList.begin(), stnList.end(), stnorderCompareFunc);
 
-	it_vstn_t _it_bstn;
+	mapped_stn_t::const_iterator _it_bstn;
 
 	for (_it_stn=stnList.begin(); _it_stn<stnList.end(); _it_stn++)
 	{
@@ -2547,10 +2546,10 @@ void dna_plot::PrintStationLabelsBlock(const UINT32& block)
 	}
 
 	// sort ISLs on longitude so labels to the left are placed last
-	CompareStnLongitude<station_t, UINT32> stnorderCompareFunc(&bstBinaryRecords_, false);
+	CompareStnLongitude<station_t, UINT32, mapped_stn_t> stnorderCompareFunc(&bstBinaryRecords_, false);
 	std::sort(v_ISL_.at(block).begin(), v_ISL_.at(block).end(), stnorderCompareFunc);
 
-	it_vstn_t _it_bstn;
+	mapped_stn_t::const_iterator _it_bstn;
 
 	for (it_vUINT32 _it_isl(v_ISL_.at(block).begin());
 		_it_isl<v_ISL_.at(block).end(); 
@@ -2612,8 +2611,8 @@ void dna_plot::PrintPositionalUncertainty(const UINT32& block)
 		SignalExceptionPlot(e.what(), 0, NULL);
 	}
 
-	it_pair_string_vUINT32 _it_stnmap;
-	it_vstn_t_const _it_stn(bstBinaryRecords_.begin());
+	UINT32 stn_index;
+	mapped_stn_t::const_iterator _it_stn(bstBinaryRecords_.begin());
 	UINT32 precision(10);
 
 	it_vstnPU_t _it_pu;
@@ -2631,22 +2630,22 @@ void dna_plot::PrintPositionalUncertainty(const UINT32& block)
 		_it_pu!=v_stn_pu_.end();
 		++_it_pu)
 	{
-		_it_stnmap = equal_range(stnsMap_.begin(), stnsMap_.end(), _it_pu->_station, StationNameIDCompareName());
+		stn_index = stnsIndex_.find(_it_pu->_station);
 
 		// Not in the list? (Unlikely since adjust output will not contain stations not in the map, but test anyway)
-		if (_it_stnmap.first == _it_stnmap.second)
+		if (stn_index == station_name_index::npos)
 			continue;
 		
 		// no need to plot constrained stations - the uncertainties will be zero!!!	
 		// Horizontal only!!!
-		if (bstBinaryRecords_.at(_it_stnmap.first->second).stationConst[0] == 'C' &&
-			bstBinaryRecords_.at(_it_stnmap.first->second).stationConst[1] == 'C')
+		if (bstBinaryRecords_.at(stn_index).stationConst[0] == 'C' &&
+			bstBinaryRecords_.at(stn_index).stationConst[1] == 'C')
 			continue;
 
 		if (plotBlocks_)
 			// If this station is not in this block, don't print
 			if (!binary_search(v_parameterStationList_.at(block).begin(), v_parameterStationList_.at(block).end(),
-				_it_stnmap.first->second))
+				stn_index))
 				continue;
 
 		stn_apu << 
@@ -2677,8 +2676,8 @@ void dna_plot::PrintErrorEllipses(const UINT32& block)
 		SignalExceptionPlot(e.what(), 0, NULL);
 	}
 
-	it_pair_string_vUINT32 _it_stnmap;
-	it_vstn_t_const _it_stn(bstBinaryRecords_.begin());
+	UINT32 stn_index;
+	mapped_stn_t::const_iterator _it_stn(bstBinaryRecords_.begin());
 	UINT32 precision(10);
 
 	it_vstnPU_t _it_pu;
@@ -2710,22 +2709,22 @@ void dna_plot::PrintErrorEllipses(const UINT32& block)
 		_it_pu!=v_stn_pu_.end();
 		++_it_pu)
 	{
-		_it_stnmap = equal_range(stnsMap_.begin(), stnsMap_.end(), _it_pu->_station, StationNameIDCompareName());
+		stn_index = stnsIndex_.find(_it_pu->_station);
 
 		// Not in the list? (Unlikely since adjust output will not contain stations not in the map, but test anyway)
-		if (_it_stnmap.first == _it_stnmap.second)
+		if (stn_index == station_name_index::npos)
 			continue;
 		
 		// no need to plot constrained stations - the uncertainties will be zero!!!	
 		// Horizontal only!!!
-		if (bstBinaryRecords_.at(_it_stnmap.first->second).stationConst[0] == 'C' &&
-			bstBinaryRecords_.at(_it_stnmap.first->second).stationConst[1] == 'C')
+		if (bstBinaryRecords_.at(stn_index).stationConst[0] == 'C' &&
+			bstBinaryRecords_.at(stn_index).stationConst[1] == 'C')
 			continue;
 
 		if (plotBlocks_)
 			// If this station is not in this block, don't print
 			if (!binary_search(v_parameterStationList_.at(block).begin(), v_parameterStationList_.at(block).end(),
-				_it_stnmap.first->second))
+				stn_index))
 				continue;
 
 		// reduce error ellipse orientation in terms of
@@ -2763,8 +2762,8 @@ void dna_plot::PrintCorrectionArrows(const UINT32& block)
 		SignalExceptionPlot(e.what(), 0, NULL);
 	}
 
-	it_pair_string_vUINT32 _it_stnmap;
-	it_vstn_t_const _it_stn(bstBinaryRecords_.begin());
+	UINT32 stn_index;
+	mapped_stn_t::const_iterator _it_stn(bstBinaryRecords_.begin());
 	UINT32 precision(10);
 
 	it_vstnCor_t _it_cor;
@@ -2782,28 +2781,28 @@ void dna_plot::PrintCorrectionArrows(const UINT32& block)
 		++_it_cor)
 	{
 		// Find the id of this station
-		_it_stnmap = equal_range(stnsMap_.begin(), stnsMap_.end(), _it_cor->_station, StationNameIDCompareName());
+		stn_index = stnsIndex_.find(_it_cor->_station);
 
 		// Not in the list? (Unlikely since adjust will not output stations that are not 
 		// in the map, but test anyway)
-		if (_it_stnmap.first == _it_stnmap.second)
+		if (stn_index == station_name_index::npos)
 			continue;
 		
 		// no need to plot constrained stations - these won't have moved!	
 		// Horizontal only!!!
-		if (bstBinaryRecords_.at(_it_stnmap.first->second).stationConst[0] == 'C' &&
-			bstBinaryRecords_.at(_it_stnmap.first->second).stationConst[1] == 'C')
+		if (bstBinaryRecords_.at(stn_index).stationConst[0] == 'C' &&
+			bstBinaryRecords_.at(stn_index).stationConst[1] == 'C')
 			continue;
 
 		if (plotBlocks_)
 			// If this station is not in this block, don't print
 			if (!binary_search(v_parameterStationList_.at(block).begin(), v_parameterStationList_.at(block).end(),
-				_it_stnmap.first->second))
+				stn_index))
 				continue;
 
 		stn_cor << 
-			std::setw(MSR) << std::setprecision(precision) << std::fixed << std::left << bstBinaryRecords_.at(_it_stnmap.first->second).initialLongitude << "  " <<
-			std::setw(MSR) << std::setprecision(precision) << std::fixed << std::left << bstBinaryRecords_.at(_it_stnmap.first->second).initialLatitude << "  " << 
+			std::setw(MSR) << std::setprecision(precision) << std::fixed << std::left << bstBinaryRecords_.at(stn_index).initialLongitude << "  " <<
+			std::setw(MSR) << std::setprecision(precision) << std::fixed << std::left << bstBinaryRecords_.at(stn_index).initialLatitude << "  " << 
 			std::setw(MSR) << std::setprecision(4) << std::scientific << std::right << _it_cor->_east * pprj_->p._correction_scale <<
 			std::setw(MSR) << std::setprecision(4) << std::scientific << std::right << _it_cor->_north * pprj_->p._correction_scale <<
 			" 0 0 0 ";
@@ -3083,7 +3082,7 @@ bool dna_plot::WithinLimits(const double& latitude, const double& longitude)
 
 void dna_plot::PrintMeasurementsDatFileBlock(const UINT32& block, char msrType, std::ofstream* msr_file_stream)
 {
-	it_vstn_t _it_stn(bstBinaryRecords_.begin());
+	mapped_stn_t::const_iterator _it_stn(bstBinaryRecords_.begin());
 	
 	UINT32 precision(10);
 	bool FirstisWithinLimits, SecondisWithinLimits, ThirdisWithinLimits;
@@ -3092,7 +3091,7 @@ void dna_plot::PrintMeasurementsDatFileBlock(const UINT32& block, char msrType,
 	
 	it_vUINT32 _it_block_msr(v_CML_.at(block).begin());
 	vUINT32 msrIndices;
-	it_vmsr_t _it_msr;
+	mapped_msr_t::const_iterator _it_msr;
 
 	(*msr_file_stream) << ">" << std::endl;
 
@@ -3234,8 +3233,8 @@ void dna_plot::PrintMeasurementsDatFileBlock(const UINT32& block, char msrType,
 
 void dna_plot::PrintMeasurementsDatFile(char msrType, std::ofstream* msr_file_stream)
 {
-	it_vstn_t _it_stn(bstBinaryRecords_.begin());
-	it_vmsr_t _it_msr(bmsBinaryRecords_.begin());
+	mapped_stn_t::const_iterator _it_stn(bstBinaryRecords_.begin());
+	mapped_msr_t::const_iterator _it_msr(bmsBinaryRecords_.begin());
 	
 	UINT32 precision(10);
 	bool FirstisWithinLimits, SecondisWithinLimits, ThirdisWithinLimits;
@@ -3437,13 +3436,16 @@ void dna_plot::LoadNetworkFiles(const project_settings& projectSettings)
 void dna_plot::LoadBinaryFiles()
 {
 	try {
-		// Load binary stations data.  Throws runtime_error on failure.
+		// Map binary stations data.  The station coordinates are reduced 
+		// below for plotting only, so the mapping is copy_on_write and the 
+		// changes are never written to the file.  Throws runtime_error on failure.
 		dna_io_bst bst;
-		stationCount_ = bst.load_bst_file(projectSettings_.i.bst_file, &bstBinaryRecords_, bst_meta_);
+		stationCount_ = bst.map_bst_file(projectSettings_.i.bst_file, bstBinaryRecords_, bst_meta_,
+			boost::interprocess::copy_on_write);
 
-		// Load binary stations data.  Throws runtime_error on failure.
+		// Map binary measurements data.  Throws runtime_error on failure.
 		dna_io_bms bms;
-		bms.load_bms_file(projectSettings_.i.bms_file, &bmsBinaryRecords_, bms_meta_);
+		bms.map_bms_file(projectSettings_.i.bms_file, bmsBinaryRecords_, bms_meta_);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionPlot(e.what(), 0, NULL);
@@ -3458,7 +3460,7 @@ void dna_plot::LoadBinaryFiles()
 		// do nothing
 	}
 	
-	for_each(
+	std::for_each(
 		bstBinaryRecords_.begin(), 
 		bstBinaryRecords_.end(), 
 		[this] (station_t& stn) {			// use lambda expression
@@ -3468,10 +3470,10 @@ void dna_plot::LoadBinaryFiles()
 
 	// Create measurement tally to determine the measurement
 	// types that have been supplied
-	for_each(
+	std::for_each(
 		bmsBinaryRecords_.begin(), 
 		bmsBinaryRecords_.end(), 
-		[this] (measurement_t& msr) {			// use lambda expression
+		[this] (const measurement_t& msr) {			// use lambda expression
 			
 			switch (msr.measType)
 			{
@@ -3556,9 +3558,9 @@ void dna_plot::LoadBinaryFiles()
 void dna_plot::LoadStationMap()
 {
 	try {
-		// Load station map.  Throws runtime_error on failure.
+		// Load station map index.  Throws runtime_error on failure.
 		dna_io_map map;
-		map.load_map_file(projectSettings_.i.map_file, &stnsMap_);
+		map.load_map_index(projectSettings_.i.map_file, stnsIndex_);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionPlot(e.what(), 0, NULL);
@@ -3643,10 +3645,10 @@ void dna_plot::LoadPosUncertaintyFile()
 
 	char line[PRINT_LINE_LENGTH];
 	bool dataBlocks(false);
-	it_pair_string_vUINT32 _it_stnmap;
+	UINT32 stn_index;
 
 	APU_UNITS_UI vcv_units;
-	matrix_2d vcv_cart(3, 3), vcv_local(3, 3);
+	Mat3 vcv_cart, vcv_local;
 
 	try {
 		
@@ -3776,10 +3778,10 @@ void dna_plot::LoadPosUncertaintyFile()
 				// Get reference of this station in bstBinaryRecords.
 				if (dataBlocks || vcv_units == XYZ_apu_ui)
 				{
-					_it_stnmap = equal_range(stnsMap_.begin(), stnsMap_.end(), posUnc._station, StationNameIDCompareName());
+					stn_index = stnsIndex_.find(posUnc._station);
 
 					// Not in the list? (Unlikely since adjust output will not contain stations not in the map, but test anyway)
-					if (_it_stnmap.first == _it_stnmap.second)
+					if (stn_index == station_name_index::npos)
 						continue;
 				}
 
@@ -3802,8 +3804,8 @@ void dna_plot::LoadPosUncertaintyFile()
 
 					// Calculate correlations in local reference frame
 					PropagateVariances_LocalCart<double>(vcv_cart, vcv_local, 
-						bstBinaryRecords_.at(_it_stnmap.first->second).currentLatitude, 
-						bstBinaryRecords_.at(_it_stnmap.first->second).currentLongitude, false);
+						bstBinaryRecords_.at(stn_index).currentLatitude, 
+						bstBinaryRecords_.at(stn_index).currentLongitude, false);
 
 					posUnc._xx = vcv_local.get(0, 0);
 					posUnc._xy = vcv_local.get(0, 1);
@@ -3819,7 +3821,7 @@ void dna_plot::LoadPosUncertaintyFile()
 
 				// Data in blocks?  Set the vector element accordingly, otherwise add to the vector
 				if (dataBlocks)
-					v_stn_pu_.at(_it_stnmap.first->second) = posUnc;
+					v_stn_pu_.at(stn_index) = posUnc;
 				else
 					v_stn_pu_.push_back(posUnc);
 
@@ -3852,8 +3854,8 @@ void dna_plot::LoadPosUncertaintyFile()
 	apu_file.close();
 }
 
-void dna_plot::ComputeStationCorrection(it_vstn_t_const _it_stn, stationCorrections_t& stnCor,
-	matrix_2d& currentEstimates, matrix_2d& initialEstimates)
+void dna_plot::ComputeStationCorrection(mapped_stn_t::const_iterator _it_stn, stationCorrections_t& stnCor,
+	Vec3& currentEstimates, Vec3& initialEstimates)
 {
 	// Compute XYZ for current estimates
 	GeoToCart<double>(
@@ -3931,13 +3933,13 @@ void dna_plot::ComputeStationCorrections()
 	v_stn_corrs_.reserve(bstBinaryRecords_.size());
 
 	stationCorrections_t stnCor;
-	matrix_2d currentEstimates(3, 1), initialEstimates(3, 1);
+	Vec3 currentEstimates, initialEstimates;
 
 	average_correction_ = 0.0;
 	UINT32 correction_count(0);
 
 	// compute corrections for every station in the network
-	for (it_vstn_t_const _it_stn=bstBinaryRecords_.begin();
+	for (mapped_stn_t::const_iterator _it_stn=bstBinaryRecords_.begin();
 		_it_stn!=bstBinaryRecords_.end(); 
 		++_it_stn)
 	{
@@ -4015,7 +4017,7 @@ void dna_plot::LoadCorrectionsFile()
 
 	char line[PRINT_LINE_LENGTH];
 	bool dataBlocks(false);
-	it_pair_string_vUINT32 _it_stnmap;
+	UINT32 stn_index;
 
 	try {
 		
@@ -4129,13 +4131,13 @@ void dna_plot::LoadCorrectionsFile()
 				// Get reference of this station in bstBinaryRecords.
 				if (dataBlocks)
 				{
-					_it_stnmap = equal_range(stnsMap_.begin(), stnsMap_.end(), stnCor._station, StationNameIDCompareName());
+					stn_index = stnsIndex_.find(stnCor._station);
 
 					// Not in the list? (Unlikely since adjust output will not contain stations not in the map, but test anyway)
-					if (_it_stnmap.first == _it_stnmap.second)
+					if (stn_index == station_name_index::npos)
 						continue;
 		
-					v_stn_corrs_.at(_it_stnmap.first->second) = stnCor;
+					v_stn_corrs_.at(stn_index) = stnCor;
 				}
 				else
 					v_stn_corrs_.push_back(stnCor);
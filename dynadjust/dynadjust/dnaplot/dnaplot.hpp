@@ -76,6 +76,7 @@
 #include <include/measurement_types/dnagpsbaseline.hpp>
 
 #include <include/math/dnamatrix_contiguous.hpp>
+#include <include/math/dnamatrix_fixed.hpp>
 
 #include <include/io/dnaiobst.hpp>
 #include <include/io/dnaiobms.hpp>
@@ -163,8 +164,8 @@ private:
 	void CleanupGMTFiles();
 
 	void ComputeStationCorrections();
-	void ComputeStationCorrection(it_vstn_t_const _it_stn, stationCorrections_t& stnCor,
-		matrix_2d& currentEstimates, matrix_2d& initialEstimates);
+	void ComputeStationCorrection(mapped_stn_t::const_iterator _it_stn, stationCorrections_t& stnCor,
+		Vec3& currentEstimates, Vec3& initialEstimates);
 	void LoadCorrectionsFile();
 	
 	//void SortandMapStations();
@@ -174,11 +175,11 @@ private:
 	void FormGMTDataFileNames(const UINT32& block=0);
 	void PrintGMTParameters();
 	
-	void PrintStationDataFile(std::ostream& os, it_vstn_t_const _it_stn);
+	void PrintStationDataFile(std::ostream& os, mapped_stn_t::const_iterator _it_stn);
 	void PrintStationsDataFile();
 	void PrintStationsDataFileBlock(const UINT32& block);
 	
-	void PrintStationLabel(std::ostream& os, it_vstn_t_const _it_stn);
+	void PrintStationLabel(std::ostream& os, mapped_stn_t::const_iterator _it_stn);
 	void PrintStationLabels();
 	void PrintStationLabelsBlock(const UINT32& block);
 	
@@ -222,13 +223,13 @@ private:
 	MsrTally				parsemsrTally_;		// total network tally
 	std::vector<MsrTally>		v_msr_tally_;		// per block tally
 
-	vstn_t					bstBinaryRecords_;
-	vmsr_t					bmsBinaryRecords_;
+	mapped_stn_t			bstBinaryRecords_;		// copy_on_write, since stations are reduced (see LoadBinaryFiles)
+	mapped_msr_t			bmsBinaryRecords_;		// read_only
 	binary_file_meta_t		bst_meta_;
 	binary_file_meta_t		bms_meta_;
 	std::string					output_folder_;
 	std::string					network_name_;
-	v_string_uint32_pair	stnsMap_;		// Station Name Map sorted on name (string)
+	station_name_index		stnsIndex_;		// Station Name Map index
 	_PLOT_STATUS_			plotStatus_;
 	project_settings		projectSettings_;
 	project_settings*		pprj_;
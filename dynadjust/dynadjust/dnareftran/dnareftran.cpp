@@ -163,6 +163,7 @@ void dna_reftran::IdentifyStationPlate()
 	}
 
 	std::sort(vplateMap_.begin(), vplateMap_.end());
+	plateMapIndex_.build(vplateMap_);
 }
 
 	
@@ -577,7 +578,7 @@ void dna_reftran::WriteBinaryStationFile(const std::string& bstfileName)
 	try {
 		// write binary stations data.  Throws runtime_error on failure.
 		dna_io_bst bst;
-		bst.write_bst_file(bstfileName, &bstBinaryRecords_, bst_meta_);
+		bst.update_bst_file(bstfileName, &bstBinaryRecords_, bst_meta_);
 	}
 	catch (const std::runtime_error& e) {
 		throw RefTranException(e.what());
@@ -611,7 +612,7 @@ void dna_reftran::WriteBinaryMeasurementFile(const std::string& bmsfileName)
 	try {
 		// write binary measurement data.  Throws runtime_error on failure.
 		dna_io_bms bms;
-		bms.write_bms_file(bmsfileName, &bmsBinaryRecords_, bms_meta_);
+		bms.update_bms_file(bmsfileName, &bmsBinaryRecords_, bms_meta_);
 	}
 	catch (const std::runtime_error& e) {
 		throw RefTranException(e.what());
@@ -619,12 +620,11 @@ void dna_reftran::WriteBinaryMeasurementFile(const std::string& bmsfileName)
 }
 	
 
-UINT32 dna_reftran::DetermineTectonicPlate(const std::string& plate)
+UINT32 dna_reftran::DetermineTectonicPlate(std::string_view plate)
 {
-	it_pair_string_vUINT32 it_plate = equal_range(vplateMap_.begin(), vplateMap_.end(), 
-		plate, StationNameIDCompareName());
+	UINT32 plateIndex(plateMapIndex_.find(plate));
 
-	if (it_plate.first == it_plate.second)
+	if (plateIndex == station_name_index::npos)
 	{
 		std::stringstream error_msg;
 		error_msg << "An attempt to find plate motion model parameters failed for " << 
@@ -632,7 +632,7 @@ UINT32 dna_reftran::DetermineTectonicPlate(const std::string& plate)
 		throw RefTranException(error_msg.str());
 	}
 
-	return it_plate.first->second;
+	return plateIndex;
 }
 	
 
@@ -668,7 +668,7 @@ void dna_reftran::ObtainPlateMotionParameters(it_vstn_t& stn_it, double* reduced
 // If an exception is thrown, there's not much more we can do
 void dna_reftran::JoinTransformationParameters(it_vstn_t& stn_it, double* reduced_parameters, 
 	const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters,
-	transformationType transType, const matrix_2d& coordinates)
+	transformationType transType, const Vec3& coordinates)
 {
 	
 	transformation_parameter_set transP_a, transP_b;
@@ -753,7 +753,7 @@ void dna_reftran::JoinTransformationParameters(it_vstn_t& stn_it, double* reduce
 
 	if (projectSettings_.g.verbose > 1 && data_type_ == stn_data)
 	{
-		matrix_2d coordinates_step(3, 1);
+		Vec3 coordinates_step;
 		Transform_7parameter<double>(coordinates, coordinates_step, reduced_parameters);
 
 		*rft_file << std::setw(PAD3) << std::left << "JN" << 
@@ -854,7 +854,7 @@ void dna_reftran::JoinTransformationParameters(it_vstn_t& stn_it, double* reduce
 }
 	
 
-void dna_reftran::TransformEpochs_PlateMotionModel(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+void dna_reftran::TransformEpochs_PlateMotionModel(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 	const CDnaDatum& datumFrom, const CDnaDatum& datumTo)
 {
 	// Propagate parameters using the appropriate Plate Motion Model.
@@ -916,7 +916,7 @@ void dna_reftran::TransformEpochs_PlateMotionModel(it_vstn_t& stn_it, const matr
 }
 	
 
-void dna_reftran::TransformFrames_PlateMotionModel(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+void dna_reftran::TransformFrames_PlateMotionModel(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 	const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters)
 {
 	// For this scenario, three steps are involved.  The sequence is very similar to
@@ -931,7 +931,7 @@ void dna_reftran::TransformFrames_PlateMotionModel(it_vstn_t& stn_it, const matr
 	CDnaDatum datumStep1(epsgCodeFromName<UINT32, std::string>(ITRF2014_s), datumFrom.GetEpoch());
 	CDnaDatum datumStep2(epsgCodeFromName<UINT32, std::string>(ITRF2014_s), datumTo.GetEpoch());
 
-	matrix_2d coordinates_tmp(coordinates);
+	Vec3 coordinates_tmp(coordinates);
 
 	//	1. Transform datumFrom to ITRF2014 (using the epoch of the input dynamic frame)
 	if (datumFrom.GetEpsgCode_i() != datumStep1.GetEpsgCode_i())
@@ -979,7 +979,7 @@ void dna_reftran::TransformFrames_PlateMotionModel(it_vstn_t& stn_it, const matr
 // Secondary scenario - no parameters exist, in which case a REFTRAN_DIRECT_PARAMS_UNAVAILABLE exception is
 // thrown and caught, and TransformFrames_Join handles the transformation using ITRF2014 as a step.
 
-void dna_reftran::TransformFrames_WithoutPlateMotionModel(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+void dna_reftran::TransformFrames_WithoutPlateMotionModel(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 	const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters,
 	transformationType transType)
 {
@@ -1091,7 +1091,7 @@ void dna_reftran::TransformFrames_WithoutPlateMotionModel(it_vstn_t& stn_it, con
 }
 
 
-void dna_reftran::TransformDynamic(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+void dna_reftran::TransformDynamic(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 	const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters,
 	transformationType transType)
 {
@@ -1141,7 +1141,7 @@ void dna_reftran::TransformDynamic(it_vstn_t& stn_it, const matrix_2d& coordinat
 }
 	
 
-void dna_reftran::Transform(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+void dna_reftran::Transform(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 	const CDnaDatum& datumFrom, transformation_parameter_set& transformParameters)
 {
 	transformationType transformation_type;	
@@ -1208,7 +1208,7 @@ void dna_reftran::Transform(it_vstn_t& stn_it, const matrix_2d& coordinates, mat
 // Try joining two sets associated with ITRF2014
 // If this attempt raises an exception, it will be caught by the 
 // calling method
-void dna_reftran::TransformFrames_Join(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+void dna_reftran::TransformFrames_Join(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 	const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters,
 	transformationType transType)
 {
@@ -1510,7 +1510,7 @@ void dna_reftran::TransformStationRecords(const std::string& newFrame, const std
 void dna_reftran::TransformStation(it_vstn_t& stn_it, const CDnaDatum& datumFrom, 
 		transformation_parameter_set& transformParameters)
 {
-	matrix_2d coordinates(3, 1), coordinates_mod(3, 1);
+	Vec3 coordinates, coordinates_mod;
 
 	// 1. Convert to cartesian.  Why?  Native form of coordinates in bst file 
 	// is geographic
@@ -1689,8 +1689,8 @@ void dna_reftran::TransformMeasurement_GX(it_vmsr_t& msr_it, const CDnaDatum& da
 	UINT32 covariance_count;
 	it_vstn_t stn1_it, stn2_it;
 
-	matrix_2d coordinates1(3, 1), coordinates2(3, 1), 
-		coordinates1_mod(3, 1), coordinates2_mod(3, 1);
+	Vec3 coordinates1, coordinates2, 
+		coordinates1_mod, coordinates2_mod;
 
 	//// 1. Get upper triangular a-priori measurements variance matrix
 	//matrix_2d vmat;
@@ -1774,7 +1774,7 @@ void dna_reftran::TransformMeasurement_Y(it_vmsr_t& msr_it, const CDnaDatum& dat
 	UINT32 covariance_count;
 	it_vstn_t stn_it;
 
-	matrix_2d coordinates(3, 1), coordinates_mod(3, 1);
+	Vec3 coordinates, coordinates_mod;
 	
 	_COORD_TYPE_ coordType(CDnaStation::GetCoordTypeC(msr_it->coordType));
 
@@ -60,6 +60,7 @@
 #include <include/functions/dnatemplatematrixfuncs.hpp>
 #include <include/functions/dnatransparamfuncs.hpp>
 #include <include/functions/dnafilepathfuncs.hpp>
+#include <include/functions/dnastationindex.hpp>
 
 #include <include/parameters/dnaepsg.hpp>
 #include <include/parameters/dnaellipsoid.hpp>
@@ -70,6 +71,7 @@
 #include <include/parameters/dnaframesubstitutions.hpp>
 
 #include <include/math/dnamatrix_contiguous.hpp>
+#include <include/math/dnamatrix_fixed.hpp>
 #include <include/measurement_types/dnameasurement.hpp>
 
 using namespace dynadjust::measurements;
@@ -152,33 +154,33 @@ private:
 	void ObtainHelmertParameters(const CDnaDatum& datumFrom, const CDnaDatum& datumTo, 
 		transformation_parameter_set& transParams, double& timeElapsed, transformationType transType);
 	
-	UINT32 DetermineTectonicPlate(const std::string& plate);
+	UINT32 DetermineTectonicPlate(std::string_view plate);
 
 	void ObtainPlateMotionParameters(it_vstn_t& stn_it, double* reduced_parameters, const CDnaDatum& datumFrom, const CDnaDatum& datumTo,
 		transformation_parameter_set& transformParameters, double& timeElapsed);
 
 	void JoinTransformationParameters(it_vstn_t& stn_it, double* reduced_parameters, const CDnaDatum& datumFrom, const CDnaDatum& datumTo,
-		transformation_parameter_set& transformParameters, transformationType transType, const matrix_2d& coordinates);
+		transformation_parameter_set& transformParameters, transformationType transType, const Vec3& coordinates);
 
-	void Transform(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod, 
+	void Transform(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod, 
 		const CDnaDatum& datumFrom, transformation_parameter_set& transformParameters);
 
-	void TransformDynamic(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+	void TransformDynamic(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 		const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters,
 		transformationType transType);
 
-	void TransformFrames_Join(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+	void TransformFrames_Join(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 		const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters,
 		transformationType transType);
 
-	void TransformFrames_PlateMotionModel(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+	void TransformFrames_PlateMotionModel(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 		const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters);
 
-	void TransformFrames_WithoutPlateMotionModel(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+	void TransformFrames_WithoutPlateMotionModel(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 		const CDnaDatum& datumFrom, const CDnaDatum& datumTo, transformation_parameter_set& transformParameters,
 		transformationType transType);
 
-	void TransformEpochs_PlateMotionModel(it_vstn_t& stn_it, const matrix_2d& coordinates, matrix_2d& coordinates_mod,
+	void TransformEpochs_PlateMotionModel(it_vstn_t& stn_it, const Vec3& coordinates, Vec3& coordinates_mod,
 		const CDnaDatum& datumFrom, const CDnaDatum& datumTo);
 
 	void TransformStation(it_vstn_t& stn_it, const CDnaDatum& datumFrom,
@@ -229,6 +231,7 @@ private:
 	std::vector<string_string_pair>		_v_msr_substitutions;		// station substitutions made
 
 	v_string_uint32_pair 			vplateMap_;					// Plate Map index sorted on plate ID
+	station_name_index				plateMapIndex_;				// Hash index of vplateMap_
 
 	std::ofstream* 					rft_file;
 	_INPUT_DATA_TYPE_ 				data_type_;					// stations or measurements
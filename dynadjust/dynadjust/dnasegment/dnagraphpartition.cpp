@@ -0,0 +1,702 @@
+//============================================================================
+// Name         : dnagraphpartition.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Multilevel graph partitioning for network segmentation
+//============================================================================
+
+#include <dynadjust/dnasegment/dnagraphpartition.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <set>
+#include <utility>
+
+namespace dynadjust {
+namespace networksegment {
+
+// Clusters with more stations than this are connected as a star
+const UINT32 CLIQUE_LIMIT = 8;
+// Coarsening stops once a graph has this many vertices...
+const UINT32 COARSEN_TO = 40;
+// ...or when a level reduces the vertex count by less than 5%
+const double COARSEN_MIN_REDUCTION = 0.95;
+// Permitted imbalance between the two halves of a bisection
+const double BISECTION_IMBALANCE = 0.05;
+const UINT32 INITIAL_BISECTION_TRIES = 4;
+const UINT32 REFINEMENT_PASSES = 8;
+
+const UINT32 NOT_SET = UINT_MAX;
+
+const char REGION_BEFORE = -1;		// vertices in parts already created
+const char REGION_CURRENT = 0;		// vertices being partitioned
+const char REGION_AFTER = 1;		// vertices in parts yet to be created
+
+dna_graph_partition::dna_graph_partition()
+	: partSize_(1)
+{
+}
+
+void dna_graph_partition::BuildGraph(const UINT32& stationCount, const vvUINT32& msrStations)
+{
+	std::vector< std::pair<UINT32, UINT32> > edges;
+	vUINT32 stations;
+	UINT32 i, j;
+
+	for (vvUINT32::const_iterator _it_msr(msrStations.begin()); _it_msr!=msrStations.end(); ++_it_msr)
+	{
+		stations = *_it_msr;
+		strip_duplicates(stations);
+
+		if (stations.size() < 2)
+			continue;
+
+		if (stations.size() <= CLIQUE_LIMIT)
+		{
+			for (i=0; i<stations.size(); ++i)
+			{
+				for (j=i+1; j<stations.size(); ++j)
+				{
+					edges.push_back(std::make_pair(stations.at(i), stations.at(j)));
+					edges.push_back(std::make_pair(stations.at(j), stations.at(i)));
+				}
+			}
+		}
+		else
+		{
+			for (i=1; i<stations.size(); ++i)
+			{
+				edges.push_back(std::make_pair(stations.at(0), stations.at(i)));
+				edges.push_back(std::make_pair(stations.at(i), stations.at(0)));
+			}
+		}
+	}
+
+	std::sort(edges.begin(), edges.end());
+
+	graph_.xadj.assign(stationCount + 1, 0);
+	graph_.adjncy.clear();
+	graph_.adjwgt.clear();
+	graph_.vwgt.assign(stationCount, 1);
+
+	// Combine repeated edges (i.e. multiple measurements between
+	// the same two stations) into a single weighted edge
+	std::vector< std::pair<UINT32, UINT32> >::const_iterator _it_edge;
+	for (_it_edge=edges.begin(); _it_edge!=edges.end(); ++_it_edge)
+	{
+		if (_it_edge != edges.begin() && *_it_edge == *(_it_edge - 1))
+		{
+			graph_.adjwgt.back()++;
+			continue;
+		}
+		graph_.adjncy.push_back(_it_edge->second);
+		graph_.adjwgt.push_back(1);
+		graph_.xadj.at(_it_edge->first + 1)++;
+	}
+
+	for (i=0; i<stationCount; ++i)
+		graph_.xadj.at(i + 1) += graph_.xadj.at(i);
+}
+
+
+void dna_graph_partition::OrderParts(const UINT32& partSize, vvUINT32& parts, vUINT32& partComponent)
+{
+	parts.clear();
+	partComponent.clear();
+
+	partSize_ = std::max(partSize, UINT32(1));
+	region_.assign(graph_.nvtxs(), REGION_CURRENT);
+	vertexMap_.assign(graph_.nvtxs(), NOT_SET);
+
+	vvUINT32 components, componentParts;
+	FindComponents(components);
+
+	for (UINT32 c(0); c<components.size(); ++c)
+	{
+		componentParts.clear();
+		PartitionRecursive(components.at(c), componentParts);
+
+		parts.insert(parts.end(), componentParts.begin(), componentParts.end());
+		partComponent.insert(partComponent.end(), componentParts.size(), c);
+	}
+}
+
+
+UINT32 dna_graph_partition::EdgeCut(const vvUINT32& parts) const
+{
+	vUINT32 part(graph_.nvtxs(), NOT_SET);
+	UINT32 p, v, e, cut(0);
+	for (p=0; p<parts.size(); ++p)
+		for (v=0; v<parts.at(p).size(); ++v)
+			part.at(parts.at(p).at(v)) = p;
+
+	for (v=0; v<graph_.nvtxs(); ++v)
+		for (e=graph_.xadj.at(v); e<graph_.xadj.at(v+1); ++e)
+			if (part.at(v) != part.at(graph_.adjncy.at(e)))
+				cut += graph_.adjwgt.at(e);
+
+	// each edge is counted twice
+	return cut / 2;
+}
+
+
+void dna_graph_partition::FindComponents(vvUINT32& components) const
+{
+	components.clear();
+
+	std::vector<bool> visited(graph_.nvtxs(), false);
+	std::deque<UINT32> queue;
+	UINT32 v, u, e;
+
+	for (v=0; v<graph_.nvtxs(); ++v)
+	{
+		if (visited.at(v))
+			continue;
+
+		components.push_back(vUINT32());
+		visited.at(v) = true;
+		queue.push_back(v);
+
+		while (!queue.empty())
+		{
+			u = queue.front();
+			queue.pop_front();
+			components.back().push_back(u);
+
+			for (e=graph_.xadj.at(u); e<graph_.xadj.at(u+1); ++e)
+			{
+				if (visited.at(graph_.adjncy.at(e)))
+					continue;
+				visited.at(graph_.adjncy.at(e)) = true;
+				queue.push_back(graph_.adjncy.at(e));
+			}
+		}
+
+		std::sort(components.back().begin(), components.back().end());
+	}
+}
+
+
+// Bisects vertices, such that the first half lies next to the parts already
+// created and the second half lies next to the parts yet to be created.
+// Each half is then partitioned in turn, until each part has partSize_
+// or fewer stations.
+void dna_graph_partition::PartitionRecursive(const vUINT32& vertices, vvUINT32& parts)
+{
+	if (vertices.size() <= partSize_)
+	{
+		parts.push_back(vertices);
+		return;
+	}
+
+	partition_graph_t subgraph;
+	vUINT32 side, first, second;
+
+	ExtractSubgraph(vertices, subgraph);
+	Bisect(subgraph, side);
+
+	for (UINT32 v(0); v<vertices.size(); ++v)
+	{
+		if (side.at(v) == 0)
+			first.push_back(vertices.at(v));
+		else
+			second.push_back(vertices.at(v));
+	}
+
+	if (first.empty() || second.empty())
+	{
+		// Should not happen, but guard against an endless recursion
+		first.assign(vertices.begin(), vertices.begin() + vertices.size() / 2);
+		second.assign(vertices.begin() + vertices.size() / 2, vertices.end());
+	}
+
+	vUINT32::const_iterator _it_v;
+	for (_it_v=second.begin(); _it_v!=second.end(); ++_it_v)
+		region_.at(*_it_v) = REGION_AFTER;
+
+	PartitionRecursive(first, parts);
+
+	for (_it_v=first.begin(); _it_v!=first.end(); ++_it_v)
+		region_.at(*_it_v) = REGION_BEFORE;
+	for (_it_v=second.begin(); _it_v!=second.end(); ++_it_v)
+		region_.at(*_it_v) = REGION_CURRENT;
+
+	PartitionRecursive(second, parts);
+}
+
+
+// Creates the subgraph induced by vertices.  If any of the vertices are
+// connected to parts already created (or yet to be created), two fixed
+// vertices are appended to represent those parts (terminal propagation).
+// Bisecting the subgraph then also minimises the number of measurements
+// that must be carried across the half lying between a vertex and the
+// parts it is connected to.
+void dna_graph_partition::ExtractSubgraph(const vUINT32& vertices, partition_graph_t& subgraph)
+{
+	const UINT32 nvtxs(static_cast<UINT32>(vertices.size()));
+	UINT32 v, e, u;
+	vUINT32 before(nvtxs, 0), after(nvtxs, 0);
+	bool terminals(false);
+
+	for (v=0; v<nvtxs; ++v)
+		vertexMap_.at(vertices.at(v)) = v;
+
+	// Weight of the edges connecting each vertex to other parts
+	for (v=0; v<nvtxs; ++v)
+	{
+		for (e=graph_.xadj.at(vertices.at(v)); e<graph_.xadj.at(vertices.at(v)+1); ++e)
+		{
+			u = graph_.adjncy.at(e);
+			if (vertexMap_.at(u) != NOT_SET)
+				continue;
+			if (region_.at(u) == REGION_BEFORE)
+				before.at(v) += graph_.adjwgt.at(e);
+			else if (region_.at(u) == REGION_AFTER)
+				after.at(v) += graph_.adjwgt.at(e);
+		}
+		if (before.at(v) || after.at(v))
+			terminals = true;
+	}
+
+	subgraph.fixed = (terminals ? 2 : 0);
+	subgraph.xadj.assign(1, 0);
+	subgraph.adjncy.clear();
+	subgraph.adjwgt.clear();
+	subgraph.vwgt.resize(nvtxs + subgraph.fixed);
+
+	vUINT32 terminalAdj[2];
+	vUINT32 terminalWgt[2];
+
+	for (v=0; v<nvtxs; ++v)
+	{
+		subgraph.vwgt.at(v) = graph_.vwgt.at(vertices.at(v));
+		for (e=graph_.xadj.at(vertices.at(v)); e<graph_.xadj.at(vertices.at(v)+1); ++e)
+		{
+			if ((u = vertexMap_.at(graph_.adjncy.at(e))) == NOT_SET)
+				continue;
+			subgraph.adjncy.push_back(u);
+			subgraph.adjwgt.push_back(graph_.adjwgt.at(e));
+		}
+
+		if (before.at(v))
+		{
+			subgraph.adjncy.push_back(nvtxs);
+			subgraph.adjwgt.push_back(before.at(v));
+			terminalAdj[0].push_back(v);
+			terminalWgt[0].push_back(before.at(v));
+		}
+		if (after.at(v))
+		{
+			subgraph.adjncy.push_back(nvtxs + 1);
+			subgraph.adjwgt.push_back(after.at(v));
+			terminalAdj[1].push_back(v);
+			terminalWgt[1].push_back(after.at(v));
+		}
+
+		subgraph.xadj.push_back(static_cast<UINT32>(subgraph.adjncy.size()));
+	}
+
+	for (v=0; v<nvtxs; ++v)
+		vertexMap_.at(vertices.at(v)) = NOT_SET;
+
+	// The fixed vertices have no weight, so do not affect the balance
+	for (u=0; u<subgraph.fixed; ++u)
+	{
+		subgraph.vwgt.at(nvtxs + u) = 0;
+		subgraph.adjncy.insert(subgraph.adjncy.end(), terminalAdj[u].begin(), terminalAdj[u].end());
+		subgraph.adjwgt.insert(subgraph.adjwgt.end(), terminalWgt[u].begin(), terminalWgt[u].end());
+		subgraph.xadj.push_back(static_cast<UINT32>(subgraph.adjncy.size()));
+	}
+}
+
+
+void dna_graph_partition::Bisect(const partition_graph_t& graph, vUINT32& side) const
+{
+	std::vector<partition_graph_t> levels(1, graph);
+	vvUINT32 cmaps;
+
+	// 1. Coarsen
+	while (levels.back().nvtxs() > COARSEN_TO)
+	{
+		partition_graph_t coarse;
+		vUINT32 cmap;
+		Coarsen(levels.back(), coarse, cmap);
+
+		if (coarse.nvtxs() > COARSEN_MIN_REDUCTION * levels.back().nvtxs())
+			break;
+
+		cmaps.push_back(cmap);
+		levels.push_back(coarse);
+	}
+
+	// 2. Bisect the coarsest graph
+	InitialBisection(levels.back(), side);
+
+	// 3. Project the bisection back to the original graph, refining
+	//    the bisection at each level
+	vUINT32 fine_side;
+	for (size_t level(levels.size() - 1); level>0; --level)
+	{
+		const vUINT32& cmap(cmaps.at(level - 1));
+		fine_side.resize(cmap.size());
+		for (UINT32 v(0); v<cmap.size(); ++v)
+			fine_side.at(v) = side.at(cmap.at(v));
+		side.swap(fine_side);
+
+		RefineBisection(levels.at(level - 1), side);
+	}
+}
+
+
+// Heavy edge matching.  Each vertex is matched with the unmatched
+// neighbour connected by the heaviest edge, and each matched pair
+// becomes a single vertex in the coarse graph.
+void dna_graph_partition::Coarsen(const partition_graph_t& graph, partition_graph_t& coarse, vUINT32& cmap) const
+{
+	const UINT32 nvtxs(graph.nvtxs());
+	UINT32 v, u, e, c, total(0);
+
+	for (v=0; v<nvtxs; ++v)
+		total += graph.vwgt.at(v);
+
+	// Prevent coarse vertices from becoming too heavy to balance a bisection
+	const UINT32 maxvwgt(std::max(UINT32(1), static_cast<UINT32>(1.5 * total / COARSEN_TO)));
+
+	// Visit vertices in order of increasing degree, so that
+	// poorly connected vertices are matched first
+	vUINT32 order(nvtxs);
+	for (v=0; v<nvtxs; ++v)
+		order.at(v) = v;
+	std::stable_sort(order.begin(), order.end(),
+		[&graph](const UINT32& lhs, const UINT32& rhs) {
+			return (graph.xadj.at(lhs+1) - graph.xadj.at(lhs)) <
+				(graph.xadj.at(rhs+1) - graph.xadj.at(rhs)); });
+
+	// Fixed vertices are never matched
+	vUINT32 match(nvtxs, NOT_SET);
+	UINT32 best, best_wgt;
+	const UINT32 free_vtxs(nvtxs - graph.fixed);
+	for (v=free_vtxs; v<nvtxs; ++v)
+		match.at(v) = v;
+
+	for (vUINT32::const_iterator _it_v(order.begin()); _it_v!=order.end(); ++_it_v)
+	{
+		v = *_it_v;
+		if (match.at(v) != NOT_SET)
+			continue;
+
+		best = v;
+		best_wgt = 0;
+		for (e=graph.xadj.at(v); e<graph.xadj.at(v+1); ++e)
+		{
+			u = graph.adjncy.at(e);
+			if (match.at(u) != NOT_SET || u == v)
+				continue;
+			if (graph.vwgt.at(v) + graph.vwgt.at(u) > maxvwgt)
+				continue;
+			if (graph.adjwgt.at(e) > best_wgt)
+			{
+				best = u;
+				best_wgt = graph.adjwgt.at(e);
+			}
+		}
+
+		match.at(v) = best;
+		match.at(best) = v;
+	}
+
+	// Number the coarse vertices.  Since fixed vertices are last
+	// and unmatched, they remain the last vertices of the coarse graph
+	cmap.assign(nvtxs, NOT_SET);
+	vUINT32 members;
+	members.reserve(nvtxs);
+	UINT32 cnvtxs(0);
+	for (v=0; v<nvtxs; ++v)
+	{
+		if (cmap.at(v) != NOT_SET)
+			continue;
+		cmap.at(v) = cmap.at(match.at(v)) = cnvtxs++;
+		members.push_back(v);
+	}
+
+	// Create the coarse graph, combining the edges of each matched pair
+	coarse.xadj.assign(1, 0);
+	coarse.adjncy.clear();
+	coarse.adjwgt.clear();
+	coarse.vwgt.assign(cnvtxs, 0);
+	coarse.fixed = graph.fixed;
+
+	vUINT32 marker(cnvtxs, NOT_SET);
+	UINT32 m, fine, cu, start;
+
+	for (c=0; c<cnvtxs; ++c)
+	{
+		start = static_cast<UINT32>(coarse.adjncy.size());
+
+		for (m=0; m<2; ++m)
+		{
+			fine = (m == 0 ? members.at(c) : match.at(members.at(c)));
+			if (m == 1 && fine == members.at(c))
+				break;
+
+			coarse.vwgt.at(c) += graph.vwgt.at(fine);
+
+			for (e=graph.xadj.at(fine); e<graph.xadj.at(fine+1); ++e)
+			{
+				if ((cu = cmap.at(graph.adjncy.at(e))) == c)
+					continue;
+				if (marker.at(cu) == NOT_SET)
+				{
+					marker.at(cu) = static_cast<UINT32>(coarse.adjncy.size());
+					coarse.adjncy.push_back(cu);
+					coarse.adjwgt.push_back(graph.adjwgt.at(e));
+				}
+				else
+					coarse.adjwgt.at(marker.at(cu)) += graph.adjwgt.at(e);
+			}
+		}
+
+		for (e=start; e<coarse.adjncy.size(); ++e)
+			marker.at(coarse.adjncy.at(e)) = NOT_SET;
+
+		coarse.xadj.push_back(static_cast<UINT32>(coarse.adjncy.size()));
+	}
+}
+
+
+// Greedy graph growing.  Starting from a seed vertex, the vertex
+// whose addition most reduces the cut is added to the growing half
+// until it holds half the vertex weight.  Several seeds are tried,
+// and the bisection with the lowest cut is retained.
+void dna_graph_partition::InitialBisection(const partition_graph_t& graph, vUINT32& side) const
+{
+	const UINT32 nvtxs(graph.nvtxs());
+	UINT32 v, e, total(0);
+
+	for (v=0; v<nvtxs; ++v)
+		total += graph.vwgt.at(v);
+
+	// Fixed vertices (if any) are the last two vertices, and must
+	// be in the first and second halves respectively
+	const UINT32 free_vtxs(nvtxs - graph.fixed);
+
+	vUINT32 seeds;
+	if (graph.fixed)
+		seeds.push_back(free_vtxs);
+	seeds.push_back(PseudoPeripheralVertex(graph, 0));
+	for (UINT32 t(1); t<INITIAL_BISECTION_TRIES && t<free_vtxs; ++t)
+		seeds.push_back(t * free_vtxs / INITIAL_BISECTION_TRIES);
+	strip_duplicates(seeds);
+
+	vUINT32 trial;
+	UINT32 cut, best_cut(NOT_SET), grown;
+	std::vector<int> gain(nvtxs);
+	std::set< std::pair<int, UINT32> > frontier;		// (-gain, vertex)
+
+	// Moves v to the growing half, and updates the gains of its neighbours
+	auto move_vertex = [&](const UINT32& v) {
+		trial.at(v) = 0;
+		grown += graph.vwgt.at(v);
+
+		for (UINT32 e(graph.xadj.at(v)); e<graph.xadj.at(v+1); ++e)
+		{
+			UINT32 u(graph.adjncy.at(e));
+			if (trial.at(u) == 0 || u >= free_vtxs)
+				continue;
+			frontier.erase(std::make_pair(-gain.at(u), u));
+			gain.at(u) += 2 * static_cast<int>(graph.adjwgt.at(e));
+			frontier.insert(std::make_pair(-gain.at(u), u));
+		}
+	};
+
+	for (vUINT32::const_iterator _it_seed(seeds.begin()); _it_seed!=seeds.end(); ++_it_seed)
+	{
+		trial.assign(nvtxs, 1);
+		frontier.clear();
+		grown = 0;
+
+		for (v=0; v<nvtxs; ++v)
+		{
+			gain.at(v) = 0;
+			for (e=graph.xadj.at(v); e<graph.xadj.at(v+1); ++e)
+				gain.at(v) -= static_cast<int>(graph.adjwgt.at(e));
+		}
+
+		if (graph.fixed)
+			move_vertex(free_vtxs);
+
+		v = *_it_seed;
+		if (v >= free_vtxs)
+			v = (frontier.empty() ? 0 : frontier.begin()->second);
+
+		while (grown < total / 2)
+		{
+			frontier.erase(std::make_pair(-gain.at(v), v));
+			move_vertex(v);
+
+			if (!frontier.empty())
+				v = frontier.begin()->second;
+			else
+			{
+				// The growing half is not connected to the remaining
+				// vertices, so continue from the next available vertex
+				for (v=0; v<free_vtxs; ++v)
+					if (trial.at(v) == 1)
+						break;
+				if (v == free_vtxs)
+					break;
+			}
+		}
+
+		RefineBisection(graph, trial);
+
+		if ((cut = CutWeight(graph, trial)) < best_cut)
+		{
+			best_cut = cut;
+			side = trial;
+		}
+	}
+}
+
+
+// Greedy boundary refinement.  Vertices on the boundary are moved to
+// the other half if this reduces the cut (or improves the balance
+// without increasing the cut), subject to the balance constraint.
+void dna_graph_partition::RefineBisection(const partition_graph_t& graph, vUINT32& side) const
+{
+	const UINT32 nvtxs(graph.nvtxs());
+	UINT32 v, e, pass, moved, from, to, maxvwgt(0);
+	UINT32 weight[2] = { 0, 0 };
+	int internal, external;
+
+	for (v=0; v<nvtxs; ++v)
+	{
+		weight[side.at(v)] += graph.vwgt.at(v);
+		maxvwgt = std::max(maxvwgt, graph.vwgt.at(v));
+	}
+
+	const UINT32 total(weight[0] + weight[1]);
+	const UINT32 maxweight(std::max(
+		static_cast<UINT32>(total * (1. + BISECTION_IMBALANCE) / 2.),
+		total / 2 + maxvwgt));
+
+	std::vector< std::pair<int, UINT32> > boundary;		// (-gain, vertex)
+
+	for (pass=0; pass<REFINEMENT_PASSES; ++pass)
+	{
+		boundary.clear();
+		for (v=0; v<nvtxs; ++v)
+		{
+			internal = external = 0;
+			for (e=graph.xadj.at(v); e<graph.xadj.at(v+1); ++e)
+			{
+				if (side.at(graph.adjncy.at(e)) == side.at(v))
+					internal += graph.adjwgt.at(e);
+				else
+					external += graph.adjwgt.at(e);
+			}
+			if (external > 0)
+				boundary.push_back(std::make_pair(internal - external, v));
+		}
+
+		std::sort(boundary.begin(), boundary.end());
+		moved = 0;
+
+		for (std::vector< std::pair<int, UINT32> >::const_iterator _it_b(boundary.begin()); _it_b!=boundary.end(); ++_it_b)
+		{
+			v = _it_b->second;
+			if (v >= nvtxs - graph.fixed)
+				continue;
+			from = side.at(v);
+			to = 1 - from;
+
+			// Don't empty a half, or exceed the balance constraint
+			if (weight[from] == graph.vwgt.at(v) || weight[to] + graph.vwgt.at(v) > maxweight)
+				continue;
+
+			// Gains change as neighbours move, so recompute
+			internal = external = 0;
+			for (e=graph.xadj.at(v); e<graph.xadj.at(v+1); ++e)
+			{
+				if (side.at(graph.adjncy.at(e)) == from)
+					internal += graph.adjwgt.at(e);
+				else
+					external += graph.adjwgt.at(e);
+			}
+
+			if (external > internal ||
+				(external == internal && weight[from] > weight[to] + graph.vwgt.at(v)))
+			{
+				side.at(v) = to;
+				weight[from] -= graph.vwgt.at(v);
+				weight[to] += graph.vwgt.at(v);
+				++moved;
+			}
+		}
+
+		if (moved == 0)
+			break;
+	}
+}
+
+
+// Returns the last vertex reached by a breadth first search, repeated once
+UINT32 dna_graph_partition::PseudoPeripheralVertex(const partition_graph_t& graph, const UINT32& start) const
+{
+	UINT32 v(start), u, e, pass;
+	std::vector<bool> visited;
+	std::deque<UINT32> queue;
+
+	for (pass=0; pass<2; ++pass)
+	{
+		visited.assign(graph.nvtxs(), false);
+		queue.assign(1, v);
+		visited.at(v) = true;
+
+		while (!queue.empty())
+		{
+			v = queue.front();
+			queue.pop_front();
+			for (e=graph.xadj.at(v); e<graph.xadj.at(v+1); ++e)
+			{
+				if (visited.at(u = graph.adjncy.at(e)))
+					continue;
+				visited.at(u) = true;
+				queue.push_back(u);
+			}
+		}
+	}
+
+	return v;
+}
+
+
+UINT32 dna_graph_partition::CutWeight(const partition_graph_t& graph, const vUINT32& side) const
+{
+	UINT32 v, e, cut(0);
+	for (v=0; v<graph.nvtxs(); ++v)
+		for (e=graph.xadj.at(v); e<graph.xadj.at(v+1); ++e)
+			if (side.at(v) != side.at(graph.adjncy.at(e)))
+				cut += graph.adjwgt.at(e);
+	return cut / 2;
+}
+
+
+}	// namespace networksegment
+}	// namespace dynadjust
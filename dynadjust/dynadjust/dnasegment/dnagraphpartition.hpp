@@ -0,0 +1,109 @@
+//============================================================================
+// Name         : dnagraphpartition.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Multilevel graph partitioning for network segmentation
+//                Stations are the vertices of a graph, and measurements
+//                are the edges connecting them.  The graph is divided by
+//                recursive bisection, where each bisection is computed by
+//                the multilevel (coarsen, partition, refine) scheme used
+//                by METIS:
+//                  1. the graph is coarsened by heavy edge matching,
+//                  2. the coarsest graph is bisected by greedy graph growing,
+//                  3. the bisection is projected back to the original graph,
+//                     and refined at each level by moving boundary vertices
+//                     that reduce the weight of the cut.
+//                Parts are returned in an order suitable for a sequential
+//                (phased) adjustment, in which stations connecting two
+//                parts are carried forward as junctions.
+//============================================================================
+
+#ifndef DNAGRAPHPARTITION_H_
+#define DNAGRAPHPARTITION_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <vector>
+
+#include <include/config/dnatypes.hpp>
+#include <include/functions/dnatemplatefuncs.hpp>
+
+namespace dynadjust {
+namespace networksegment {
+
+// Graph held in compressed sparse row format
+typedef struct {
+	vUINT32		xadj;			// offset of each vertex's adjacency list in adjncy (size nvtxs + 1)
+	vUINT32		adjncy;			// adjacent vertices
+	vUINT32		adjwgt;			// weight of each edge (i.e. number of measurements)
+	vUINT32		vwgt;			// weight of each vertex (i.e. number of stations)
+	UINT32		fixed;			// number of fixed vertices, held at the end of vwgt (0 or 2)
+	inline UINT32 nvtxs() const { return static_cast<UINT32>(vwgt.size()); }
+} partition_graph_t;
+
+class dna_graph_partition {
+public:
+	dna_graph_partition();
+
+private:
+	// Disallow use of compiler generated functions. See dnaadjust.hpp
+	dna_graph_partition(const dna_graph_partition&);
+	dna_graph_partition& operator=(const dna_graph_partition&);
+
+public:
+	// Creates the station graph.  msrStations holds, for each measurement,
+	// the (zero based) indices of the stations it connects.  Clusters are
+	// connected as a clique, or as a star if larger than CLIQUE_LIMIT.
+	void BuildGraph(const UINT32& stationCount, const vvUINT32& msrStations);
+
+	// Divides each connected part of the graph into parts of at most
+	// partSize stations.  parts are ordered so that adjacent parts share
+	// the most measurements.  partComponent holds the connected network
+	// to which each part belongs.
+	void OrderParts(const UINT32& partSize, vvUINT32& parts, vUINT32& partComponent);
+
+	// Sum of the weights of the edges between parts
+	UINT32 EdgeCut(const vvUINT32& parts) const;
+
+private:
+	void FindComponents(vvUINT32& components) const;
+	void PartitionRecursive(const vUINT32& vertices, vvUINT32& parts);
+
+	void ExtractSubgraph(const vUINT32& vertices, partition_graph_t& subgraph);
+	void Bisect(const partition_graph_t& graph, vUINT32& side) const;
+	void Coarsen(const partition_graph_t& graph, partition_graph_t& coarse, vUINT32& cmap) const;
+	void InitialBisection(const partition_graph_t& graph, vUINT32& side) const;
+	void RefineBisection(const partition_graph_t& graph, vUINT32& side) const;
+
+	UINT32 PseudoPeripheralVertex(const partition_graph_t& graph, const UINT32& start) const;
+	UINT32 CutWeight(const partition_graph_t& graph, const vUINT32& side) const;
+
+	partition_graph_t	graph_;
+	UINT32				partSize_;
+	std::vector<char>	region_;		// position of each vertex relative to the vertices being partitioned
+	vUINT32				vertexMap_;		// index of each vertex in the subgraph being extracted
+};
+
+}	// namespace networksegment
+}	// namespace dynadjust
+
+#endif /* DNAGRAPHPARTITION_H_ */
@@ -27,6 +27,10 @@ namespace networksegment {
 
 dna_segment::dna_segment()
 	: isProcessing_(false)
+	, componentsFollow_(false)
+	, currJunctStnHeap_(CompareMeasCount<CAStationList, UINT32>(&vAssocStnList_))
+	, freeStnHeap_(CompareMeasCount<CAStationList, UINT32>(&vAssocStnList_))
+	, startingStn_(0)
 {
 	network_name_ = "";
 }
@@ -39,7 +43,7 @@ dna_segment::~dna_segment()
 
 double dna_segment::GetProgress() const
 { 
-	return ((bstBinaryRecords_.size() - vfreeStnList_.size()) * 100. / bstBinaryRecords_.size()); 
+	return ((bstBinaryRecords_.size() - freeStnHeap_.size()) * 100. / bstBinaryRecords_.size()); 
 }
 
 void dna_segment::LoadNetFile()
@@ -135,8 +139,12 @@ void dna_segment::PrepareSegmentation(project_settings* p)
 	LoadAssociationFiles(p->s.asl_file, p->s.aml_file);
 	LoadStationMap(p->s.map_file);
 	BuildFreeStationAvailabilityList();
+	BuildMeasurementView();
 	
-	SortbyMeasurementCount(&vfreeStnList_);
+	// The default starting station is the station with the 
+	// lowest number of measurements
+	if (!freeStnHeap_.empty())
+		startingStn_ = LowestMeasurementCountStation(freeStnHeap_);
 }
 
 
@@ -149,6 +157,7 @@ void dna_segment::InitialiseSegmentation()
 	network_name_ = "network_name";		// network name
 	
 	vinitialStns_.clear();
+	currJunctStnHeap_.clear();
 	vCurrJunctStnList_.clear();
 	vCurrInnerStnList_.clear();
 	vCurrMeasurementList_.clear();
@@ -157,144 +166,1458 @@ void dna_segment::InitialiseSegmentation()
 	bmsBinaryRecords_.clear();
 	vAssocStnList_.clear();
 	vAssocMsrList_.clear();
-	vfreeStnList_.clear();
+	freeStnHeap_.clear();
 	vfreeMsrList_.clear();
 	stnsMap_.clear();
+	vMsrView_.clear();
+	vMsrViewStations_.clear();
+	vCurrBlockStns_.clear();
 
 	vJSL_.clear();
 	vISL_.clear();
 	vCML_.clear();
+	vBlockCosts_.clear();
+
+	resegmentedBlocks_.clear();
+	incrementalWarning_.clear();
+}
+	
+
+_SEGMENT_STATUS_ dna_segment::SegmentNetwork(project_settings* p)
+{
+	isProcessing_ = true;	
+
+	output_folder_ = p->g.output_folder;
+
+	if ((debug_level_ = p->g.verbose) > 2)
+	{
+		std::string s(p->s.seg_file + ".trace");
+		try {
+			// Create trace file.  Throws runtime_error on failure.
+			file_opener(trace_file, s);
+			print_file_header(trace_file, "DYNADJUST SEGMENTATION TRACE FILE");
+			trace_file << OUTPUTLINE << std::endl << std::endl;
+		}
+		catch (const std::runtime_error& e) {
+			SignalExceptionSerialise(e.what(), 0, NULL);
+		}
+	}
+	
+	if ((debug_level_ = p->g.verbose) > 1)
+	{
+		std::string s(p->s.seg_file + ".debug");
+			
+		try {
+			// Create debug file.  Throws runtime_error on failure.
+			file_opener(debug_file, s);
+		}
+		catch (const std::ios_base::failure& f) {
+			SignalExceptionSerialise(f.what(), 0, NULL);
+		}
+	}
+
+	segmentStatus_ = SEGMENT_SUCCESS;
+	std::ostringstream ss;
+
+	if (debug_level_ > 2)
+		WriteFreeStnListSortedbyASLMsrCount();
+
+	currentBlock_ = 1;
+
+	if (debug_level_ > 2)
+		trace_file << "Block " << currentBlock_ << "..." << std::endl;
+	
+	boost::timer::cpu_timer time;
+
+	v_ContiguousNetList_.clear();
+	v_ContiguousNetList_.push_back(currentNetwork_ = 0);
+
+	if (bstBinaryRecords_.empty())
+		SignalExceptionSerialise("SegmentNetwork(): the binary stations file has not been loaded into memory yet.", 0, NULL);
+	if (bmsBinaryRecords_.empty())
+		SignalExceptionSerialise("SegmentNetwork(): the binary measurements file has not been loaded into memory yet.", 0, NULL);
+	if (vAssocStnList_.empty())
+		SignalExceptionSerialise("SegmentNetwork(): the Associated Station List (ASL) has not been loaded into memory yet.", 0, NULL);
+	if (vAssocFreeMsrList_.empty())
+		SignalExceptionSerialise("SegmentNetwork(): the Associated Measurements List (AML) has not been loaded into memory yet.", 0, NULL);
+	if (stnsMap_.empty())
+		SignalExceptionSerialise("SegmentNetwork(): the station map has not been loaded into memory yet.", 0, NULL);
+
+	// Update the previous segmentation (if supplied).  If it
+	// cannot be used, segment the network afresh.
+	if (projectSettings_.s.seg_previous_file.empty() || !SegmentNetworkIncremental())
+	{
+		if (projectSettings_.s.seg_partitioner == "greedy")
+		{
+			// Segment isolated networks concurrently if possible
+			if (!SegmentNetworkComponents())
+				SegmentNetworkGreedy();
+		}
+		else if (projectSettings_.s.seg_partitioner == "multilevel")
+			SegmentNetworkMultilevel();
+		else
+		{
+			ss.str("");
+			ss << "SegmentNetwork(): " << projectSettings_.s.seg_partitioner << " is not a valid partitioner.";
+			SignalExceptionSerialise(ss.str(), 0, NULL);
+		}
+	}
+
+	boost::posix_time::milliseconds elapsed_time(boost::posix_time::milliseconds(0));
+	if (debug_level_ > 1)
+		elapsed_time = boost::posix_time::milliseconds(time.elapsed().wall/MILLI_TO_NANO);
+	
+	isProcessing_ = false;	
+
+	CalculateAverageBlockSize();
+
+	char valid_stations(0);
+	char valid_measurements_not_included(0);
+	if (freeStnHeap_.size())
+	{
+		valid_stations = 1;
+		ss.str("");
+		ss << std::endl << "- Warning: The following stations were not used:" << std::endl;
+		ss << "  ";
+		vUINT32 vfreeStnList(freeStnHeap_.elements());
+		SortbyMeasurementCount(vfreeStnList);
+		it_vUINT32_const _it_freestn(vfreeStnList.begin());
+		for (; _it_freestn!=vfreeStnList.end(); ++_it_freestn)
+			ss << bstBinaryRecords_.at(*_it_freestn).stationName << " ";
+		ss << std::endl;
+		ss << "- Possible reasons why these stations were not used include:" << std::endl;
+		ss << "  - No measurements to these stations were found," << std::endl;
+		ss << "  - The network is made up of non-contiguous blocks," << std::endl;
+		ss << "  - There is a bug in this program." << std::endl;
+
+		if (debug_level_ > 1)
+			debug_file << ss.str();
+	}
+
+	if (debug_level_ > 1)
+	{
+		debug_file << formatedElapsedTime<std::string>(&elapsed_time, "+ Network segmentation took ") <<
+			" The network is now ready for adjustment." << std::endl;
+		debug_file.close();
+	}
+
+	isProcessing_ = false;	
+
+	if (valid_measurements_not_included || valid_stations)
+		return (segmentStatus_ = SEGMENT_BLOCK_ERROR);
+
+	return (segmentStatus_ = SEGMENT_SUCCESS);
+}
+	
+
+// Creates blocks by growing each block outward from the junction stations
+// of the previous block
+void dna_segment::SegmentNetworkGreedy()
+{
+	// The inner stations for the first block are created from segmentCriteria._initialStns
+	// Junction stations are retrieved from measurements connected to the inner stations
+	BuildFirstBlock();
+	
+	while (!freeStnHeap_.empty())
+	{
+		isProcessing_ = true;
+
+		currentBlock_++;
+
+		if (debug_level_ > 2)
+			trace_file << "Block " << currentBlock_ << "..." << std::endl;
+
+		v_ContiguousNetList_.push_back(currentNetwork_);
+
+		// The inner stations for the next block are the junction stations from the previous block
+		// The junction stations are retrieved from measurements connected to the inner stations
+		// BuildNextBlock applies the min and max station constraints using segmentCriteria
+		BuildNextBlock();
+	
+		if (freeStnHeap_.empty())
+			break;
+	}
+}
+	
+
+// Segments each isolated network concurrently, then appends the blocks of
+// each network in the order in which SegmentNetworkGreedy would create them.
+// The blocks are the same as those created by SegmentNetworkGreedy.
+// Returns false if the network cannot be segmented this way, i.e. when:
+//  - isolated networks are to be added to the same block (force_contiguous_blocks),
+//    since the blocks of one network then depend on those of the last,
+//  - stations are selected by searching associated stations (seg_search_level),
+//    since the first station of each network may then depend on the others,
+//  - the starting stations are in different networks, or are not valid,
+//  - debug or trace files are to be written,
+//  - fewer than two threads are to be used (see --segment-threads), or
+//  - there is only one network.
+bool dna_segment::SegmentNetworkComponents()
+{
+	if (projectSettings_.s.force_contiguous_blocks || projectSettings_.s.seg_search_level > 0 ||
+		debug_level_ > 1)
+		return false;
+
+	UINT32 threads(projectSettings_.s.segment_threads > 0 ?
+		projectSettings_.s.segment_threads : boost::thread::hardware_concurrency());
+	if (threads < 2)
+		return false;
+
+	vnetwork_component_t vComponents;
+	if (!FindNetworkComponents(vComponents))
+		return false;
+
+	UINT32 c, block, componentCount(static_cast<UINT32>(vComponents.size()));
+
+	// The first network starts from the starting stations, and the 
+	// networks that follow start from the station with the lowest
+	// measurement count.  Each network but the last has to carry on as
+	// if the stations of the networks that follow are free.
+	for (c=0; c<componentCount; ++c)
+	{
+		vComponents.at(c)._segment.reset(new dna_segment);
+		vComponents.at(c)._segment->componentsFollow_ = (c + 1 < componentCount);
+	}
+
+	// As for BuildFirstBlock
+	if (vinitialStns_.empty())
+		vinitialStns_.push_back(bstBinaryRecords_.at(startingStn_).stationName);
+	vComponents.front()._segment->vinitialStns_ = vinitialStns_;
+
+	// Segment the networks.  Exceptions thrown whilst segmenting a 
+	// network are rethrown by parallel_for_each.
+	const dna_segment& network(*this);
+
+	try {
+		parallel_for_each(vComponents.begin(), vComponents.end(),
+			[&network](network_component_t& component) {
+				component._segment->SegmentComponent(network, component);
+			},
+			std::max(UINT32(1), componentCount / threads));
+	}
+	catch (const NetSegmentException& e) {
+		SignalExceptionSerialise(e.what(), 0, NULL);
+	}
+
+	// Append the blocks of each network, mapping the stations and
+	// measurements of each block back to those of this network
+	UINT32 networkOffset(0);
+	v_ContiguousNetList_.clear();
+	vISL_.clear();
+	vJSL_.clear();
+	vCML_.clear();
+
+	vnetwork_component_t::iterator _it_component;
+	it_vUINT32 _it_index;
+
+	for (_it_component=vComponents.begin(); _it_component!=vComponents.end(); ++_it_component)
+	{
+		const dna_segment& segment(*(_it_component->_segment));
+
+		for (block=0; block<segment.vISL_.size(); ++block)
+		{
+			vISL_.push_back(segment.vISL_.at(block));
+			for (_it_index=vISL_.back().begin(); _it_index!=vISL_.back().end(); ++_it_index)
+				*_it_index = _it_component->_stations.at(*_it_index);
+
+			vJSL_.push_back(segment.vJSL_.at(block));
+			for (_it_index=vJSL_.back().begin(); _it_index!=vJSL_.back().end(); ++_it_index)
+				*_it_index = _it_component->_stations.at(*_it_index);
+
+			vCML_.push_back(segment.vCML_.at(block));
+			for (_it_index=vCML_.back().begin(); _it_index!=vCML_.back().end(); ++_it_index)
+				*_it_index = _it_component->_measurements.at(*_it_index);
+
+			// Network IDs continue on from the last network
+			v_ContiguousNetList_.push_back(networkOffset + segment.v_ContiguousNetList_.at(block));
+		}
+
+		if (!v_ContiguousNetList_.empty())
+			networkOffset = v_ContiguousNetList_.back();
+
+		// The stations of this network are no longer free
+		for (_it_index=_it_component->_stations.begin(); _it_index!=_it_component->_stations.end(); ++_it_index)
+		{
+			if (!freeStnHeap_.contains(*_it_index))
+				continue;
+			vfreeStnAvailability_.at(*_it_index).consume();
+			freeStnHeap_.erase(*_it_index);
+		}
+
+		_it_component->_segment.reset();
+	}
+
+	currentBlock_ = static_cast<UINT32>(vISL_.size());
+	currentNetwork_ = networkOffset;
+
+	return true;
+}
+	
+
+// Finds the isolated networks of free stations, i.e. the connected components
+// of the station graph, ordered by the station SegmentNetworkGreedy would select
+// to start each network.  Returns false if the starting stations are unknown,
+// not free, or are in different networks, or if there is only one network.
+bool dna_segment::FindNetworkComponents(vnetwork_component_t& vComponents)
+{
+	vComponents.clear();
+
+	vUINT32 vMsrAMLIndex;
+	vvUINT32 vMsrStations;
+	GetFreeStationMeasurements(vMsrAMLIndex, vMsrStations);
+
+	// Join the stations of each measurement (union-find).  vRoot
+	// holds the station from which each station was reached.
+	const UINT32 stationCount(static_cast<UINT32>(bstBinaryRecords_.size()));
+	vUINT32 vRoot(stationCount);
+	UINT32 stn, root, c;
+	for (stn=0; stn<stationCount; ++stn)
+		vRoot.at(stn) = stn;
+
+	auto findRoot = [&vRoot](UINT32 s) {
+		while (vRoot.at(s) != s)
+			s = vRoot.at(s) = vRoot.at(vRoot.at(s));
+		return s;
+	};
+
+	vvUINT32::const_iterator _it_msr;
+	it_vUINT32_const _it_stn;
+	for (_it_msr=vMsrStations.begin(); _it_msr!=vMsrStations.end(); ++_it_msr)
+	{
+		if (_it_msr->empty())
+			continue;
+		root = findRoot(_it_msr->front());
+		for (_it_stn=_it_msr->begin()+1; _it_stn!=_it_msr->end(); ++_it_stn)
+			vRoot.at(findRoot(*_it_stn)) = root;
+	}
+
+	// Find the station SelectJunction would select to start each network,
+	// i.e. the network's first station in freeStnHeap_ order (the lowest
+	// measurement count, then station index)
+	vUINT32 vComponentIndex(stationCount, UINT_MAX), vFirstStn;
+	const vUINT32& vfreeStnList(freeStnHeap_.elements());
+	for (_it_stn=vfreeStnList.begin(); _it_stn!=vfreeStnList.end(); ++_it_stn)
+	{
+		root = findRoot(*_it_stn);
+		if (vComponentIndex.at(root) == UINT_MAX)
+		{
+			vComponentIndex.at(root) = static_cast<UINT32>(vFirstStn.size());
+			vFirstStn.push_back(*_it_stn);
+		}
+		else if (freeStnHeap_.precedes(*_it_stn, vFirstStn.at(vComponentIndex.at(root))))
+			vFirstStn.at(vComponentIndex.at(root)) = *_it_stn;
+	}
+
+	// Number the networks in the order of their first stations
+	const stn_heap_t& freeStnHeap(freeStnHeap_);
+	std::sort(vFirstStn.begin(), vFirstStn.end(), 
+		[&freeStnHeap](const UINT32& lhs, const UINT32& rhs) {
+			return freeStnHeap.precedes(lhs, rhs);
+		});
+
+	for (c=0; c<vFirstStn.size(); ++c)
+		vComponentIndex.at(findRoot(vFirstStn.at(c))) = c;
+	vComponents.resize(vFirstStn.size());
+
+	if (vComponents.size() < 2)
+		return false;
+
+	// Add the stations to each network, in station order
+	for (stn=0; stn<stationCount; ++stn)
+	{
+		root = findRoot(stn);
+		if (vComponentIndex.at(root) != UINT_MAX)
+			vComponents.at(vComponentIndex.at(root))._stations.push_back(stn);
+	}
+
+	// Find the network containing the starting stations
+	vUINT32 vStartingStns;
+	if (vinitialStns_.empty())
+		vStartingStns.push_back(startingStn_);
+
+	it_pair_string_vUINT32 it_stnmap_range;
+	_it_vstr_const _it_name;
+	for (_it_name=vinitialStns_.begin(); _it_name!=vinitialStns_.end(); ++_it_name)
+	{
+		it_stnmap_range = equal_range(stnsMap_.begin(), stnsMap_.end(), *_it_name, StationNameIDCompareName());
+		// Leave unknown stations to VerifyStationsandBuildBlock
+		if (it_stnmap_range.first == it_stnmap_range.second)
+			return false;
+		vStartingStns.push_back(it_stnmap_range.first->second);
+	}
+
+	root = findRoot(vStartingStns.front());
+	for (_it_stn=vStartingStns.begin(); _it_stn!=vStartingStns.end(); ++_it_stn)
+	{
+		if (!freeStnHeap_.contains(*_it_stn) || findRoot(*_it_stn) != root)
+			return false;
+	}
+
+	// The network containing the starting stations is segmented first.  The 
+	// order of the networks that follow is unchanged.
+	c = vComponentIndex.at(root);
+	std::rotate(vComponents.begin(), vComponents.begin() + c, vComponents.begin() + c + 1);
+
+	return true;
+}
+	
+
+// Segments an isolated network (component) of network.  The stations and 
+// measurement records of the isolated network are copied from network, and
+// numbered in the same order, so that SegmentComponent creates the same 
+// blocks as SegmentNetworkGreedy.  On return, component._measurements holds
+// the network's binary measurement records.
+void dna_segment::SegmentComponent(const dna_segment& network, network_component_t& component)
+{
+	projectSettings_ = network.projectSettings_;
+	debug_level_ = 0;
+
+	const vUINT32& vStations(component._stations);
+	vUINT32& vRecords(component._measurements);
+	vUINT32 msrStations;
+	it_vUINT32_const _it_stn, _it_rec;
+	UINT32 m, msrCount, amlIndex, first, last;
+	bool inNetwork;
+
+	// 1. Find the binary measurement records of the measurements connected
+	//    to the network's stations (all records in the case of clusters)
+	vRecords.clear();
+	for (_it_stn=vStations.begin(); _it_stn!=vStations.end(); ++_it_stn)
+	{
+		msrCount = network.vASLCount_.at(*_it_stn);
+		amlIndex = network.vAssocStnList_.at(*_it_stn).GetAMLStnIndex();
+
+		for (m=0; m<msrCount; ++m, ++amlIndex)
+		{
+			const aml_pair& aml(network.vAssocFreeMsrList_.at(amlIndex));
+
+			// is this measurement ignored or already used?
+			if (!aml.available || network.bmsBinaryRecords_.at(aml.bmsr_index).ignore)
+				continue;
+
+			// Only measurements between the network's stations
+			GetMsrStations(network.bmsBinaryRecords_, aml.bmsr_index, msrStations);
+			inNetwork = true;
+			for (it_vUINT32_const _it_mstn=msrStations.begin(); _it_mstn!=msrStations.end(); ++_it_mstn)
+			{
+				if (!std::binary_search(vStations.begin(), vStations.end(), *_it_mstn))
+				{
+					inNetwork = false;
+					break;
+				}
+			}
+			if (!inNetwork)
+				continue;
+
+			first = last = aml.bmsr_index;
+			switch (network.bmsBinaryRecords_.at(aml.bmsr_index).measType)
+			{
+			case 'D':
+			case 'X':
+			case 'Y':
+				first = GetFirstMsrIndex<UINT32>(network.bmsBinaryRecords_, aml.bmsr_index);
+				while (last + 1 < network.bmsBinaryRecords_.size() &&
+					network.bmsBinaryRecords_.at(last + 1).clusterID == network.bmsBinaryRecords_.at(first).clusterID)
+					++last;
+			}
+
+			for (; first<=last; ++first)
+				vRecords.push_back(first);
+		}
+	}
+
+	strip_duplicates(vRecords);
+
+	// Local station index of a station of network
+	auto localStation = [&vStations](const UINT32& stn) {
+		return static_cast<UINT32>(std::distance(vStations.begin(), 
+			std::lower_bound(vStations.begin(), vStations.end(), stn)));
+	};
+
+	// 2. Copy the binary records
+	bstBinaryRecords_.reserve(vStations.size());
+	for (_it_stn=vStations.begin(); _it_stn!=vStations.end(); ++_it_stn)
+		bstBinaryRecords_.push_back(network.bstBinaryRecords_.at(*_it_stn));
+
+	bmsBinaryRecords_.reserve(vRecords.size());
+	for (_it_rec=vRecords.begin(); _it_rec!=vRecords.end(); ++_it_rec)
+	{
+		bmsBinaryRecords_.push_back(network.bmsBinaryRecords_.at(*_it_rec));
+		measurement_t& msr(bmsBinaryRecords_.back());
+
+		msr.station1 = localStation(msr.station1);
+		if (MsrTally::Stations(msr.measType) >= TWO_STATION)
+			msr.station2 = localStation(msr.station2);
+		if (MsrTally::Stations(msr.measType) == THREE_STATION)
+			msr.station3 = localStation(msr.station3);
+	}
+
+	clusteridCompareFunc_.SetAMLPointer(const_cast<pvmsr_t>(&bmsBinaryRecords_));
+
+	// 3. Copy the associated station and measurement lists.  Measurements
+	//    not copied above are not available.
+	vAssocStnList_.reserve(vStations.size());
+	vASLCount_.reserve(vStations.size());
+	for (_it_stn=vStations.begin(); _it_stn!=vStations.end(); ++_it_stn)
+	{
+		const CAStationList& asl(network.vAssocStnList_.at(*_it_stn));
+		vAssocStnList_.push_back(CAStationList());
+		vAssocStnList_.back().SetAssocMsrCount(asl.GetAssocMsrCount());
+		vAssocStnList_.back().SetAvailMsrCount(asl.GetAvailMsrCount());
+		vAssocStnList_.back().SetAMLStnIndex(static_cast<UINT32>(vAssocFreeMsrList_.size()));
+		*vAssocStnList_.back().ValidityPtr() = asl.Validity();
+
+		msrCount = network.vASLCount_.at(*_it_stn);
+		amlIndex = asl.GetAMLStnIndex();
+		vASLCount_.push_back(msrCount);
+
+		for (m=0; m<msrCount; ++m, ++amlIndex)
+		{
+			const aml_pair& aml(network.vAssocFreeMsrList_.at(amlIndex));
+			_it_rec = std::lower_bound(vRecords.begin(), vRecords.end(), aml.bmsr_index);
+			if (aml.available && _it_rec != vRecords.end() && *_it_rec == aml.bmsr_index)
+				vAssocFreeMsrList_.push_back(aml_pair(static_cast<UINT32>(std::distance(vRecords.cbegin(), _it_rec)), true));
+			else
+				vAssocFreeMsrList_.push_back(aml_pair(0, false));
+		}
+	}
+
+	// 4. Station map (for the starting stations) and free stations
+	v_string_uint32_pair::const_iterator _it_stnmap;
+	if (!vinitialStns_.empty())
+		for (_it_stnmap=network.stnsMap_.begin(); _it_stnmap!=network.stnsMap_.end(); ++_it_stnmap)
+			if (std::binary_search(vStations.begin(), vStations.end(), _it_stnmap->second))
+				stnsMap_.push_back(string_uint32_pair(_it_stnmap->first, localStation(_it_stnmap->second)));
+
+	BuildFreeStationAvailabilityList();
+	BuildMeasurementView();
+
+	vUINT32 vfreeStnList;
+	for (_it_stn=vStations.begin(); _it_stn!=vStations.end(); ++_it_stn)
+		if (network.freeStnHeap_.contains(*_it_stn))
+			vfreeStnList.push_back(localStation(*_it_stn));
+	freeStnHeap_.assign(vfreeStnList);
+
+	// 5. Segment the network, as SegmentNetworkGreedy would
+	currentNetwork_ = 0;
+	currentBlock_ = 0;
+	v_ContiguousNetList_.clear();
+
+	if (!vinitialStns_.empty())
+	{
+		currentBlock_ = 1;
+		v_ContiguousNetList_.push_back(currentNetwork_);
+		BuildFirstBlock();
+	}
+
+	while (!freeStnHeap_.empty() || (componentsFollow_ && !currJunctStnHeap_.empty()))
+	{
+		currentBlock_++;
+		v_ContiguousNetList_.push_back(currentNetwork_);
+		BuildNextBlock();
+	}
+}
+	
+
+// Collects the measurements connected to the free stations.  For each
+// measurement (or cluster), the AML index of its first record and the 
+// stations associated with it are returned.
+void dna_segment::GetFreeStationMeasurements(vUINT32& vMsrAMLIndex, vvUINT32& vMsrStations)
+{
+	std::vector<bool> msrFound(bmsBinaryRecords_.size(), false);
+	UINT32 m, msrCount, amlIndex;
+
+	vMsrAMLIndex.clear();
+	vMsrStations.clear();
+
+	vUINT32 vfreeStnList(freeStnHeap_.elements());
+	std::sort(vfreeStnList.begin(), vfreeStnList.end());
+
+	it_vUINT32_const _it_stn;
+	for (_it_stn=vfreeStnList.begin(); _it_stn!=vfreeStnList.end(); ++_it_stn)
+	{
+		msrCount = vASLCount_.at(*_it_stn);
+		amlIndex = vAssocStnList_.at(*_it_stn).GetAMLStnIndex();
+
+		for (m=0; m<msrCount; ++m, ++amlIndex)
+		{
+			// is this measurement ignored or already used?
+			if (!vAssocFreeMsrList_.at(amlIndex).available)
+				continue;
+
+			const msr_view_t& msrView(vMsrView_.at(vAssocFreeMsrList_.at(amlIndex).bmsr_index));
+
+			// Only keep pointers to the starting element of each measurement
+			if (msrView._ignore || !msrView._first)
+				continue;
+
+			// Has this measurement been found via another station?
+			if (msrFound.at(msrView._firstIndex))
+				continue;
+			msrFound.at(msrView._firstIndex) = true;
+
+			vMsrAMLIndex.push_back(amlIndex);
+			vMsrStations.push_back(vUINT32(
+				vMsrViewStations_.begin() + msrView._stnOffset,
+				vMsrViewStations_.begin() + msrView._stnOffset + msrView._stnCount));
+		}
+	}
+}
+	
+
+// Creates blocks from a partition of the station graph (see dna_graph_partition).
+// The graph is divided into parts of no more than a quarter of the block size
+// threshold, ordered so that consecutive parts share the fewest measurements.
+// Consecutive parts are then merged into blocks.
+//
+// A station first appears (as a junction) in the block containing its part,
+// and is carried forward to the block containing the last measurement
+// connected to it, where it becomes an inner.  A measurement is added to the
+// block containing the last part of all its stations.
+void dna_segment::SegmentNetworkMultilevel()
+{
+	const UINT32 NOT_SET(UINT_MAX);
+	const UINT32 stationCount(static_cast<UINT32>(bstBinaryRecords_.size()));
+
+	// 1. Collect the measurements connected to free stations
+	vUINT32 vMsrAMLIndex;			// AML index of each measurement
+	vvUINT32 vMsrStations;			// stations associated with each measurement
+	GetFreeStationMeasurements(vMsrAMLIndex, vMsrStations);
+
+	// 2. Create the graph of free stations connected by measurements.
+	//    Stations without measurements cannot be added to a block.
+	vUINT32 graphStn, graphIndex(stationCount, NOT_SET);
+	vvUINT32 graphMsrStations(vMsrStations.size());
+	UINT32 msr, stn;
+	it_vUINT32_const _it_stn;
+
+	for (msr=0; msr<vMsrStations.size(); ++msr)
+	{
+		for (_it_stn=vMsrStations.at(msr).begin(); _it_stn!=vMsrStations.at(msr).end(); ++_it_stn)
+		{
+			if (!freeStnHeap_.contains(*_it_stn))
+				continue;
+			if (graphIndex.at(*_it_stn) == NOT_SET)
+			{
+				graphIndex.at(*_it_stn) = static_cast<UINT32>(graphStn.size());
+				graphStn.push_back(*_it_stn);
+			}
+			graphMsrStations.at(msr).push_back(graphIndex.at(*_it_stn));
+		}
+	}
+
+	if (graphStn.empty())
+		return;
+
+	dna_graph_partition partitioner;
+	partitioner.BuildGraph(static_cast<UINT32>(graphStn.size()), graphMsrStations);
+
+	vvUINT32 parts;
+	vUINT32 partNetwork;
+	partitioner.OrderParts(std::max(UINT32(1), projectSettings_.s.max_total_stations / 4), parts, partNetwork);
+
+	vUINT32 stnPart(graphStn.size());
+	UINT32 part, partCount(static_cast<UINT32>(parts.size()));
+
+	// 3. Begin with the network containing the first starting station (if
+	//    supplied), from the end of that network nearest to the station
+	if (!vinitialStns_.empty())
+	{
+		RemoveDuplicateStations(&vinitialStns_);
+		VerifyStationsandBuildBlock(true);
+
+		it_pair_string_vUINT32 it_stnmap_range(equal_range(stnsMap_.begin(), stnsMap_.end(), 
+			vinitialStns_.front(), StationNameIDCompareName()));
+		
+		for (part=0; part<partCount; ++part)
+			if (find(parts.at(part).begin(), parts.at(part).end(), graphIndex.at(it_stnmap_range.first->second)) != parts.at(part).end())
+				break;
+
+		if (part < partCount)
+		{
+			UINT32 first(part), last(part);
+			while (first > 0 && partNetwork.at(first - 1) == partNetwork.at(part))
+				--first;
+			while (last + 1 < partCount && partNetwork.at(last + 1) == partNetwork.at(part))
+				++last;
+
+			if (part - first > last - part)
+				std::reverse(parts.begin() + first, parts.begin() + last + 1);
+
+			std::rotate(parts.begin(), parts.begin() + first, parts.begin() + last + 1);
+			std::rotate(partNetwork.begin(), partNetwork.begin() + first, partNetwork.begin() + last + 1);
+		}
+	}
+	else
+		vinitialStns_.push_back(bstBinaryRecords_.at(graphStn.at(parts.front().front())).stationName);
+
+	for (part=0; part<partCount; ++part)
+		for (_it_stn=parts.at(part).begin(); _it_stn!=parts.at(part).end(); ++_it_stn)
+			stnPart.at(*_it_stn) = part;
+
+	// 4. Find the last part in which each station is required
+	vUINT32 msrPart(vMsrStations.size(), NOT_SET), stnLastPart(stnPart);
+
+	for (msr=0; msr<graphMsrStations.size(); ++msr)
+	{
+		if (graphMsrStations.at(msr).empty())
+			continue;
+		msrPart.at(msr) = 0;
+		for (_it_stn=graphMsrStations.at(msr).begin(); _it_stn!=graphMsrStations.at(msr).end(); ++_it_stn)
+			msrPart.at(msr) = std::max(msrPart.at(msr), stnPart.at(*_it_stn));
+		for (_it_stn=graphMsrStations.at(msr).begin(); _it_stn!=graphMsrStations.at(msr).end(); ++_it_stn)
+			stnLastPart.at(*_it_stn) = std::max(stnLastPart.at(*_it_stn), msrPart.at(msr));
+	}
+
+	// 5. Merge consecutive parts into blocks.  The stations in a block formed
+	//    from parts first to last are the stations whose last part lies within
+	//    first to last (inners), plus the stations carried past last (junctions).
+	vUINT32 partInners(partCount, 0), partCarried(partCount + 1, 0);
+	for (stn=0; stn<graphStn.size(); ++stn)
+	{
+		partInners.at(stnLastPart.at(stn))++;
+		partCarried.at(stnPart.at(stn))++;
+		partCarried.at(stnLastPart.at(stn))--;
+	}
+	for (part=1; part<partCount; ++part)
+		partCarried.at(part) += partCarried.at(part - 1);
+
+	vUINT32 partBlock(partCount);
+	UINT32 inners, blockCount(0);
+
+	for (part=0; part<partCount; ++blockCount)
+	{
+		inners = partInners.at(part);
+		partBlock.at(part++) = blockCount;
+
+		for (; part<partCount; ++part)
+		{
+			// Isolated networks form individual blocks
+			if (!projectSettings_.s.force_contiguous_blocks && partNetwork.at(part) != partNetwork.at(part - 1))
+				break;
+
+			// Has the station count threshold been reached?
+			if (inners + partInners.at(part) + partCarried.at(part) > projectSettings_.s.max_total_stations)
+				if (inners > 0 && inners >= projectSettings_.s.min_inner_stations)
+					break;
+
+			inners += partInners.at(part);
+			partBlock.at(part) = blockCount;
+		}
+	}
+
+	// 6. Create the blocks
+	vvUINT32 blockNewStns(blockCount), blockMsrs(blockCount);
+	for (stn=0; stn<graphStn.size(); ++stn)
+		blockNewStns.at(partBlock.at(stnPart.at(stn))).push_back(stn);
+	for (msr=0; msr<msrPart.size(); ++msr)
+		if (msrPart.at(msr) != NOT_SET)
+			blockMsrs.at(partBlock.at(msrPart.at(msr))).push_back(msr);
+
+	v_ContiguousNetList_.clear();
+	currentNetwork_ = 0;
+
+	vUINT32 carriedStns, junctionStns;
+	UINT32 block;
+
+	for (block=0, part=0; block<blockCount; ++block)
+	{
+		isProcessing_ = true;
+		currentBlock_ = block + 1;
+
+		if (debug_level_ > 2 && block > 0)
+			trace_file << "Block " << currentBlock_ << "..." << std::endl;
+
+		if (block > 0 && partNetwork.at(part) != partNetwork.at(part - 1))
+		{
+			if (!projectSettings_.s.force_contiguous_blocks)
+				++currentNetwork_;
+
+			if (debug_level_ > 1)
+				debug_file << "+ Non-contiguous block found... creating a new block using " << 
+					bstBinaryRecords_.at(graphStn.at(parts.at(part).front())).stationName << std::endl;
+		}
+		v_ContiguousNetList_.push_back(currentNetwork_);
+
+		while (part < partCount && partBlock.at(part) == block)
+			++part;
+
+		vCurrInnerStnList_.clear();
+		vCurrJunctStnList_.clear();
+		vCurrMeasurementList_.clear();
+
+		// Add the stations first appearing in this block
+		for (_it_stn=blockNewStns.at(block).begin(); _it_stn!=blockNewStns.at(block).end(); ++_it_stn)
+		{
+			carriedStns.push_back(*_it_stn);
+			MoveFreeStn(graphStn.at(*_it_stn), 
+				(partBlock.at(stnLastPart.at(*_it_stn)) == block ? "inner" : "junction"));
+		}
+
+		// Stations not required by later blocks are inners, the rest are carried forward
+		junctionStns.clear();
+		for (_it_stn=carriedStns.begin(); _it_stn!=carriedStns.end(); ++_it_stn)
+		{
+			if (partBlock.at(stnLastPart.at(*_it_stn)) == block)
+				vCurrInnerStnList_.push_back(graphStn.at(*_it_stn));
+			else
+			{
+				vCurrJunctStnList_.push_back(graphStn.at(*_it_stn));
+				junctionStns.push_back(*_it_stn);
+			}
+		}
+		carriedStns.swap(junctionStns);
+
+		// Add (and consume) the measurements
+		for (_it_stn=blockMsrs.at(block).begin(); _it_stn!=blockMsrs.at(block).end(); ++_it_stn)
+			AddtoCurrentMsrList(vMsrAMLIndex.at(*_it_stn), vMsrStations.at(*_it_stn));
+
+		AddCurrentBlock();
+	}
 }
 	
 
-_SEGMENT_STATUS_ dna_segment::SegmentNetwork(project_settings* p)
-{
-	isProcessing_ = true;	
+// Updates a previous segmentation of an earlier version of this network 
+// (projectSettings_.s.seg_previous_file).  The measurements of the previous
+// segmentation are matched to the current binary file by the signatures held
+// in the previous .seg.bin file (see dna_io_seg::measurement_signature).  The blocks touched by new or removed measurements,
+// together with the blocks either side of them, are re-grown from the stations
+// shared with the preceding block.  All other measurements remain in their 
+// previous blocks, so the order of the untouched blocks is unchanged.
+//
+// Returns false if the previous segmentation cannot be used, in which case
+// the network must be segmented afresh.
+bool dna_segment::SegmentNetworkIncremental()
+{
+	const UINT32 NOT_SET(UINT_MAX);
+	const std::string& prevSegFile(projectSettings_.s.seg_previous_file);
+	std::stringstream ss;
+
+	// 1. Load the previous segmentation, together with the signature of each
+	//    measurement and the name of each inner station
+	UINT32 prevBlockCount(0), prevThreshold, prevMinInner, block;
+	vvUINT32 prevISL, prevJSL, prevCML;
+	vUINT32 prevNetList;
+	std::vector<std::uint64_t> prevMsrSignatures;
+	vstring prevInnerStnNames;
+	dna_io_seg seg;
+
+	try {
+		seg.load_seg_file_header_f(prevSegFile, prevBlockCount, prevThreshold, prevMinInner);
+		
+		if (!seg.load_seg_binary_file(prevSegFile, prevBlockCount, prevThreshold, prevMinInner,
+			prevISL, prevJSL, prevCML, prevNetList, &prevMsrSignatures, &prevInnerStnNames))
+		{
+			ss << "The binary segmentation file of " << leafStr<std::string>(prevSegFile) << 
+				" is missing, out of date" << std::endl <<
+				"  or was created by an earlier version.";
+			incrementalWarning_ = ss.str();
+			return false;
+		}
+	}
+	catch (const std::runtime_error& e) {
+		SignalExceptionSerialise(e.what(), 0, NULL);
+	}
+
+	if (prevBlockCount == 0)
+	{
+		ss << leafStr<std::string>(prevSegFile) << " does not contain any blocks.";
+		incrementalWarning_ = ss.str();
+		return false;
+	}
+
+	// 2. Match the measurements of the previous segmentation to the 
+	//    measurements connected to the current free stations
+	vUINT32 vMsrAMLIndex;			// AML index of each measurement
+	vvUINT32 vMsrStations;			// stations associated with each measurement
+	GetFreeStationMeasurements(vMsrAMLIndex, vMsrStations);
+
+	const UINT32 msrCount(static_cast<UINT32>(vMsrAMLIndex.size()));
+	UINT32 msr, firstIndex;
+
+	std::vector< std::pair<std::uint64_t, UINT32> > prevSignatures, currSignatures;
+	vUINT32 prevMsrBlock;			// block of each measurement in the previous segmentation
+	vvUINT32::const_iterator _it_cml;
+	it_vUINT32_const _it_msr, _it_stn;
+
+	for (block=0, _it_cml=prevCML.begin(); _it_cml!=prevCML.end(); ++_it_cml, ++block)
+	{
+		for (_it_msr=_it_cml->begin(); _it_msr!=_it_cml->end(); ++_it_msr)
+		{
+			prevSignatures.push_back(std::make_pair(
+				prevMsrSignatures.at(prevMsrBlock.size()),
+				static_cast<UINT32>(prevMsrBlock.size())));
+			prevMsrBlock.push_back(block);
+		}
+	}
+
+	for (msr=0; msr<msrCount; ++msr)
+	{
+		firstIndex = GetFirstMsrIndex<UINT32>(bmsBinaryRecords_, vAssocFreeMsrList_.at(vMsrAMLIndex.at(msr)).bmsr_index);
+		currSignatures.push_back(std::make_pair(
+			seg.measurement_signature(bmsBinaryRecords_, bstBinaryRecords_, firstIndex), msr));
+	}
+
+	std::sort(prevSignatures.begin(), prevSignatures.end());
+	std::sort(currSignatures.begin(), currSignatures.end());
+
+	// Each measurement retains its previous block, unless it is new
+	vUINT32 msrBlock(msrCount, NOT_SET);
+	std::vector<bool> prevMsrMatched(prevMsrBlock.size(), false);
+	
+	std::vector< std::pair<std::uint64_t, UINT32> >::const_iterator 
+		_it_prev(prevSignatures.begin()), _it_curr(currSignatures.begin());
+	while (_it_prev != prevSignatures.end() && _it_curr != currSignatures.end())
+	{
+		if (_it_prev->first < _it_curr->first)
+			++_it_prev;
+		else if (_it_curr->first < _it_prev->first)
+			++_it_curr;
+		else
+		{
+			msrBlock.at(_it_curr->second) = prevMsrBlock.at(_it_prev->second);
+			prevMsrMatched.at(_it_prev->second) = true;
+			++_it_prev;
+			++_it_curr;
+		}
+	}
+
+	// 3. Find the blocks touched by removed measurements, and the blocks 
+	//    in which the stations of new measurements were previously inners
+	const UINT32 stationCount(static_cast<UINT32>(bstBinaryRecords_.size()));
+	vUINT32 stnPrevBlock(stationCount, NOT_SET);
+
+	vstring::const_iterator _it_name(prevInnerStnNames.begin());
+
+	for (block=0; block<prevBlockCount; ++block)
+	{
+		for (_it_stn=prevISL.at(block).begin(); _it_stn!=prevISL.at(block).end(); ++_it_stn, ++_it_name)
+		{
+			it_pair_string_vUINT32 it_stnmap_range(equal_range(stnsMap_.begin(), stnsMap_.end(), 
+				*_it_name, StationNameIDCompareName()));
+			if (it_stnmap_range.first != it_stnmap_range.second)
+				stnPrevBlock.at(it_stnmap_range.first->second) = block;
+		}
+	}
+
+	UINT32 firstTouched(NOT_SET), lastTouched(0), removedCount(0), addedCount(0);
+	bool touched;
+
+	for (msr=0; msr<prevMsrBlock.size(); ++msr)
+	{
+		if (prevMsrMatched.at(msr))
+			continue;
+		removedCount++;
+		firstTouched = std::min(firstTouched, prevMsrBlock.at(msr));
+		lastTouched = std::max(lastTouched, prevMsrBlock.at(msr));
+	}
+
+	for (msr=0; msr<msrCount; ++msr)
+	{
+		if (msrBlock.at(msr) != NOT_SET)
+			continue;
+		addedCount++;
+		
+		touched = false;
+		for (_it_stn=vMsrStations.at(msr).begin(); _it_stn!=vMsrStations.at(msr).end(); ++_it_stn)
+		{
+			if (stnPrevBlock.at(*_it_stn) == NOT_SET)
+				continue;
+			firstTouched = std::min(firstTouched, stnPrevBlock.at(*_it_stn));
+			lastTouched = std::max(lastTouched, stnPrevBlock.at(*_it_stn));
+			touched = true;
+		}
+
+		// Measurements between new stations only are added to the last block
+		if (!touched)
+		{
+			firstTouched = std::min(firstTouched, prevBlockCount - 1);
+			lastTouched = prevBlockCount - 1;
+		}
+	}
+
+	// 4. Re-grow the touched blocks and their neighbours
+	UINT32 blockCount(prevBlockCount), rangeFirst(0), rangeLast(0), rangeCount(0);
+
+	if (firstTouched != NOT_SET)
+	{
+		rangeFirst = (firstTouched > 0 ? firstTouched - 1 : 0);
+		rangeLast = std::min(lastTouched + 1, prevBlockCount - 1);
+
+		std::vector<bool> msrFollowsRange(msrCount, false);
+		for (msr=0; msr<msrCount; ++msr)
+			msrFollowsRange.at(msr) = (msrBlock.at(msr) != NOT_SET && msrBlock.at(msr) > rangeLast);
+
+		// The re-grown blocks may be as large as the largest block 
+		// they replace, or the block size threshold
+		UINT32 maxBlockSize(projectSettings_.s.max_total_stations);
+		for (block=rangeFirst; block<=rangeLast; ++block)
+			maxBlockSize = std::max(maxBlockSize, 
+				static_cast<UINT32>(prevISL.at(block).size() + prevJSL.at(block).size()));
+
+		rangeCount = ReGrowBlocks(vMsrStations, rangeFirst, rangeLast, maxBlockSize, msrBlock);
+
+		// Blocks after the range follow the re-grown blocks
+		for (msr=0; msr<msrCount; ++msr)
+			if (msrFollowsRange.at(msr))
+				msrBlock.at(msr) = msrBlock.at(msr) - rangeLast + rangeFirst + rangeCount - 1;
+
+		blockCount = blockCount - (rangeLast - rangeFirst + 1) + rangeCount;
+	}
+		
+	// Remove empty blocks
+	vUINT32 blockIndex(blockCount, NOT_SET);
+	for (msr=0; msr<msrCount; ++msr)
+		blockIndex.at(msrBlock.at(msr)) = 0;
+	
+	UINT32 newBlock(0), newFirst(NOT_SET), newLast(0);
+	for (block=0; block<blockCount; ++block)
+	{
+		if (blockIndex.at(block) == NOT_SET)
+			continue;
+		if (firstTouched != NOT_SET && block >= rangeFirst && block < rangeFirst + rangeCount)
+		{
+			newFirst = std::min(newFirst, newBlock);
+			newLast = newBlock;
+		}
+		blockIndex.at(block) = newBlock++;
+	}
+	blockCount = newBlock;
+
+	for (msr=0; msr<msrCount; ++msr)
+		msrBlock.at(msr) = blockIndex.at(msrBlock.at(msr));
+
+	if (newFirst != NOT_SET)
+		ss << newFirst + 1 << " to " << newLast + 1 << " (previously " << rangeFirst + 1 << " to " << rangeLast + 1 << " of " << prevBlockCount << ")";
+	else
+		ss << "none";
+	ss << ", " << addedCount << " new and " << removedCount << " removed measurements";
+	resegmentedBlocks_ = ss.str();
+
+	if (debug_level_ > 1)
+		debug_file << "+ Incremental segmentation of " << prevSegFile << ": re-segmented blocks " << resegmentedBlocks_ << std::endl;
+
+	// 5. Find the first and last block in which each station is required
+	vUINT32 stnFirstBlock(stationCount, NOT_SET), stnLastBlock(stationCount, 0);
+	for (msr=0; msr<msrCount; ++msr)
+	{
+		for (_it_stn=vMsrStations.at(msr).begin(); _it_stn!=vMsrStations.at(msr).end(); ++_it_stn)
+		{
+			stnFirstBlock.at(*_it_stn) = std::min(stnFirstBlock.at(*_it_stn), msrBlock.at(msr));
+			stnLastBlock.at(*_it_stn) = std::max(stnLastBlock.at(*_it_stn), msrBlock.at(msr));
+		}
+	}
+
+	// 6. Create the blocks
+	vvUINT32 blockNewStns(blockCount), blockMsrs(blockCount);
+	UINT32 stn;
+	for (stn=0; stn<stationCount; ++stn)
+		if (stnFirstBlock.at(stn) != NOT_SET)
+			blockNewStns.at(stnFirstBlock.at(stn)).push_back(stn);
+	for (msr=0; msr<msrCount; ++msr)
+		blockMsrs.at(msrBlock.at(msr)).push_back(msr);
+
+	if (vinitialStns_.empty() && !blockNewStns.empty())
+		vinitialStns_.push_back(bstBinaryRecords_.at(blockNewStns.front().front()).stationName);
+
+	v_ContiguousNetList_.clear();
+	currentNetwork_ = 0;
+
+	vUINT32 carriedStns, junctionStns;
+
+	for (block=0; block<blockCount; ++block)
+	{
+		isProcessing_ = true;
+		currentBlock_ = block + 1;
+
+		// A block which shares no stations with the previous block
+		// begins a new network
+		if (block > 0 && carriedStns.empty() && !projectSettings_.s.force_contiguous_blocks)
+			++currentNetwork_;
+		v_ContiguousNetList_.push_back(currentNetwork_);
+
+		vCurrInnerStnList_.clear();
+		vCurrJunctStnList_.clear();
+		vCurrMeasurementList_.clear();
+
+		// Add the stations first appearing in this block
+		for (_it_stn=blockNewStns.at(block).begin(); _it_stn!=blockNewStns.at(block).end(); ++_it_stn)
+		{
+			carriedStns.push_back(*_it_stn);
+			MoveFreeStn(*_it_stn, (stnLastBlock.at(*_it_stn) == block ? "inner" : "junction"));
+		}
+
+		// Stations not required by later blocks are inners, the rest are carried forward
+		junctionStns.clear();
+		for (_it_stn=carriedStns.begin(); _it_stn!=carriedStns.end(); ++_it_stn)
+		{
+			if (stnLastBlock.at(*_it_stn) == block)
+				vCurrInnerStnList_.push_back(*_it_stn);
+			else
+			{
+				vCurrJunctStnList_.push_back(*_it_stn);
+				junctionStns.push_back(*_it_stn);
+			}
+		}
+		carriedStns.swap(junctionStns);
+
+		// Add (and consume) the measurements
+		for (_it_msr=blockMsrs.at(block).begin(); _it_msr!=blockMsrs.at(block).end(); ++_it_msr)
+			AddtoCurrentMsrList(vMsrAMLIndex.at(*_it_msr), vMsrStations.at(*_it_msr));
+
+		AddCurrentBlock();
+	}
+
+	return true;
+}
+
+
+// Re-grows blocks rangeFirst to rangeLast of a previous segmentation. On 
+// entry, msrBlock holds the previous block of each measurement (or NOT_SET
+// for new measurements).  The stations connected to the measurements in
+// the range are ordered by a breadth-first search, beginning with the 
+// stations shared with the preceding blocks, and divided into parts of
+// equal size, one per previous block (unless the parts would exceed
+// maxBlockSize).  As for 
+// SegmentNetworkMultilevel, a measurement is added to the block containing 
+// the last part of all its stations.  On return, msrBlock holds the new 
+// block (from rangeFirst) of each measurement in the range.
+//
+// Returns the number of blocks created in the range.
+UINT32 dna_segment::ReGrowBlocks(const vvUINT32& vMsrStations, const UINT32& rangeFirst,
+	const UINT32& rangeLast, const UINT32& maxBlockSize, vUINT32& msrBlock)
+{
+	const UINT32 NOT_SET(UINT_MAX);
+	const UINT32 stationCount(static_cast<UINT32>(bstBinaryRecords_.size()));
+	const UINT32 msrCount(static_cast<UINT32>(vMsrStations.size()));
+
+	UINT32 msr, stn;
+	it_vUINT32_const _it_stn, _it_msr;
+
+	// Stations in the range, the measurements connected to them, the first
+	// previous block in which they appear, and the stations already added
+	// to preceding blocks
+	vUINT32 rangeStns, stnFirstBlock(stationCount, NOT_SET);
+	vvUINT32 stnMsrs(stationCount);
+	std::vector<bool> stnInRange(stationCount, false), stnPreceding(stationCount, false);
+
+	for (msr=0; msr<msrCount; ++msr)
+	{
+		if (msrBlock.at(msr) != NOT_SET && msrBlock.at(msr) < rangeFirst)
+		{
+			for (_it_stn=vMsrStations.at(msr).begin(); _it_stn!=vMsrStations.at(msr).end(); ++_it_stn)
+				stnPreceding.at(*_it_stn) = true;
+			continue;
+		}
+
+		if (msrBlock.at(msr) != NOT_SET && msrBlock.at(msr) > rangeLast)
+			continue;
+
+		for (_it_stn=vMsrStations.at(msr).begin(); _it_stn!=vMsrStations.at(msr).end(); ++_it_stn)
+		{
+			stnMsrs.at(*_it_stn).push_back(msr);
+			stnFirstBlock.at(*_it_stn) = std::min(stnFirstBlock.at(*_it_stn), msrBlock.at(msr));
+			if (!stnInRange.at(*_it_stn))
+			{
+				stnInRange.at(*_it_stn) = true;
+				rangeStns.push_back(*_it_stn);
+			}
+		}
+	}
 
-	output_folder_ = p->g.output_folder;
+	// Order the stations by a breadth-first search from the preceding
+	// blocks.  Isolated networks are searched in their previous block 
+	// order, from the station that appeared first.
+	vUINT32 stnOrder, networkStart;
+	std::vector<bool> stnVisited(stationCount, false);
+	UINT32 next(0);
+
+	v_uint32_uint32_pair stnBlockOrder;
+	for (_it_stn=rangeStns.begin(); _it_stn!=rangeStns.end(); ++_it_stn)
+		stnBlockOrder.push_back(uint32_uint32_pair(stnFirstBlock.at(*_it_stn), *_it_stn));
+	std::sort(stnBlockOrder.begin(), stnBlockOrder.end());
+	for (next=0; next<stnBlockOrder.size(); ++next)
+		rangeStns.at(next) = stnBlockOrder.at(next).second;
+	next = 0;
+
+	for (_it_stn=rangeStns.begin(); _it_stn!=rangeStns.end(); ++_it_stn)
+	{
+		if (!stnPreceding.at(*_it_stn))
+			continue;
+		stnVisited.at(*_it_stn) = true;
+		stnOrder.push_back(*_it_stn);
+	}
 
-	if ((debug_level_ = p->g.verbose) > 2)
+	for (_it_stn=rangeStns.begin(); stnOrder.size() < rangeStns.size(); )
 	{
-		std::string s(p->s.seg_file + ".trace");
-		try {
-			// Create trace file.  Throws runtime_error on failure.
-			file_opener(trace_file, s);
-			print_file_header(trace_file, "DYNADJUST SEGMENTATION TRACE FILE");
-			trace_file << OUTPUTLINE << std::endl << std::endl;
+		if (next == stnOrder.size())
+		{
+			// start the next isolated network
+			while (stnVisited.at(*_it_stn))
+				++_it_stn;
+			stnVisited.at(*_it_stn) = true;
+			networkStart.push_back(static_cast<UINT32>(stnOrder.size()));
+			stnOrder.push_back(*_it_stn);
 		}
-		catch (const std::runtime_error& e) {
-			SignalExceptionSerialise(e.what(), 0, NULL);
+
+		stn = stnOrder.at(next++);
+		for (_it_msr=stnMsrs.at(stn).begin(); _it_msr!=stnMsrs.at(stn).end(); ++_it_msr)
+		{
+			for (it_vUINT32_const _it_assoc=vMsrStations.at(*_it_msr).begin(); _it_assoc!=vMsrStations.at(*_it_msr).end(); ++_it_assoc)
+			{
+				if (!stnInRange.at(*_it_assoc) || stnVisited.at(*_it_assoc))
+					continue;
+				stnVisited.at(*_it_assoc) = true;
+				stnOrder.push_back(*_it_assoc);
+			}
 		}
 	}
-	
-	if ((debug_level_ = p->g.verbose) > 1)
+
+	// Divide the stations into parts, one per previous block.  Unless 
+	// contiguous blocks are forced, isolated networks begin a new part.
+	UINT32 partCount(rangeLast - rangeFirst + 1);
+	UINT32 partSize(std::max(UINT32(1), (static_cast<UINT32>(stnOrder.size()) + partCount - 1) / partCount));
+	if (partSize > maxBlockSize)
+		partSize = std::max(UINT32(1), maxBlockSize);
+
+	vUINT32 stnPart(stationCount, 0);
+	it_vUINT32_const _it_network(networkStart.begin());
+	UINT32 part(0), partStns(0);
+
+	for (next=0; next<stnOrder.size(); ++next)
 	{
-		std::string s(p->s.seg_file + ".debug");
-			
-		try {
-			// Create debug file.  Throws runtime_error on failure.
-			file_opener(debug_file, s);
+		if (_it_network != networkStart.end() && *_it_network == next)
+		{
+			++_it_network;
+			if (!projectSettings_.s.force_contiguous_blocks && partStns > 0)
+			{
+				++part;
+				partStns = 0;
+			}
 		}
-		catch (const std::ios_base::failure& f) {
-			SignalExceptionSerialise(f.what(), 0, NULL);
+		
+		if (partStns == partSize)
+		{
+			++part;
+			partStns = 0;
 		}
+
+		stnPart.at(stnOrder.at(next)) = part;
+		partStns++;
 	}
+	partCount = part + 1;
 
-	segmentStatus_ = SEGMENT_SUCCESS;
-	std::ostringstream ss;
+	// Add each measurement to the block containing the last part of all its stations
+	for (msr=0; msr<msrCount; ++msr)
+	{
+		if (msrBlock.at(msr) != NOT_SET && (msrBlock.at(msr) < rangeFirst || msrBlock.at(msr) > rangeLast))
+			continue;
 
-	if (debug_level_ > 2)
-		WriteFreeStnListSortedbyASLMsrCount();
+		msrBlock.at(msr) = 0;
+		for (_it_stn=vMsrStations.at(msr).begin(); _it_stn!=vMsrStations.at(msr).end(); ++_it_stn)
+			msrBlock.at(msr) = std::max(msrBlock.at(msr), stnPart.at(*_it_stn));
+		msrBlock.at(msr) += rangeFirst;
+	}
 
-	currentBlock_ = 1;
+	return partCount;
+}
 
-	if (debug_level_ > 2)
-		trace_file << "Block " << currentBlock_ << "..." << std::endl;
-	
-	boost::timer::cpu_timer time;
 
-	v_ContiguousNetList_.clear();
-	v_ContiguousNetList_.push_back(currentNetwork_ = 0);
+UINT32 dna_segment::junctionStationCount() const
+{
+	UINT32 junctions(0);
+	for (vvUINT32::const_iterator _it_jsl(vJSL_.begin()); _it_jsl!=vJSL_.end(); ++_it_jsl)
+		junctions += static_cast<UINT32>(_it_jsl->size());
+	return junctions;
+}
 
-	if (bstBinaryRecords_.empty())
-		SignalExceptionSerialise("SegmentNetwork(): the binary stations file has not been loaded into memory yet.", 0, NULL);
-	if (bmsBinaryRecords_.empty())
-		SignalExceptionSerialise("SegmentNetwork(): the binary measurements file has not been loaded into memory yet.", 0, NULL);
-	if (vAssocStnList_.empty())
-		SignalExceptionSerialise("SegmentNetwork(): the Associated Station List (ASL) has not been loaded into memory yet.", 0, NULL);
-	if (vAssocFreeMsrList_.empty())
-		SignalExceptionSerialise("SegmentNetwork(): the Associated Measurements List (AML) has not been loaded into memory yet.", 0, NULL);
-	if (stnsMap_.empty())
-		SignalExceptionSerialise("SegmentNetwork(): the station map has not been loaded into memory yet.", 0, NULL);
 
-	// The inner stations for the first block are created from segmentCriteria._initialStns
-	// Junction stations are retrieved from measurements connected to the inner stations
-	BuildFirstBlock();
-	
-	while (!vfreeStnList_.empty())
-	{
-		isProcessing_ = true;
+void dna_segment::EstimateBlockCosts(const dna_segment_cost& costModel, bool measure)
+{
+	// Number of blocks (spread evenly over the range of block
+	// sizes) for which the matrix kernels are timed
+	const UINT32 MEASURED_BLOCKS(12);
 
-		currentBlock_++;
+	vBlockCosts_.clear();
+	vBlockCosts_.resize(vISL_.size());
 
-		if (debug_level_ > 2)
-			trace_file << "Block " << currentBlock_ << "..." << std::endl;
+	UINT32 b, block_count(static_cast<UINT32>(vISL_.size()));
+	it_vUINT32_const _it_cml;
 
-		v_ContiguousNetList_.push_back(currentNetwork_);
+	for (b=0; b<block_count; ++b)
+	{
+		blockCost_t& cost(vBlockCosts_.at(b));
+		cost._parameters = static_cast<UINT32>(vISL_.at(b).size() + vJSL_.at(b).size()) * 3;
+		cost._junctionParameters = static_cast<UINT32>(vJSL_.at(b).size()) * 3;
+		cost._measurements = 0;
+		for (_it_cml=vCML_.at(b).begin(); _it_cml!=vCML_.at(b).end(); ++_it_cml)
+			cost._measurements += dna_io_seg::measurement_quantities(bmsBinaryRecords_.at(*_it_cml));
+
+		costModel.PredictBlock(cost);
+	}
 
-		// The inner stations for the next block are the junction stations from the previous block
-		// The junction stations are retrieved from measurements connected to the inner stations
-		// BuildNextBlock applies the min and max station constraints using segmentCriteria
-		BuildNextBlock();
-	
-		if (vfreeStnList_.empty())
-			break;
+	if (!measure || block_count == 0)
+		return;
+
+	// Sort blocks by size, then time the kernels of a sample 
+	// of blocks, including the smallest and largest
+	vUINT32 blocks(block_count);
+	for (b=0; b<block_count; ++b)
+		blocks.at(b) = b;
+	std::stable_sort(blocks.begin(), blocks.end(),
+		[this](const UINT32& lhs, const UINT32& rhs) {
+			return vBlockCosts_.at(lhs)._parameters < vBlockCosts_.at(rhs)._parameters; });
+
+	const UINT32 samples(std::min(block_count, MEASURED_BLOCKS));
+	for (b=0; b<samples; ++b)
+	{
+		if (samples == 1)
+			costModel.MeasureBlock(vBlockCosts_.at(blocks.back()));
+		else
+			costModel.MeasureBlock(vBlockCosts_.at(blocks.at(
+				static_cast<UINT32>(static_cast<double>(b) * (block_count - 1) / (samples - 1) + 0.5))));
 	}
+}
 
-	boost::posix_time::milliseconds elapsed_time(boost::posix_time::milliseconds(0));
-	if (debug_level_ > 1)
-		elapsed_time = boost::posix_time::milliseconds(time.elapsed().wall/MILLI_TO_NANO);
-	
-	isProcessing_ = false;	
 
-	CalculateAverageBlockSize();
+// In the reverse pass, a block carries to the previous block the junctions
+// of the previous block, unless the previous block belongs to another 
+// contiguous network.
+void dna_segment::AnalyseSegmentation(vblock_analysis_t& blocks, segment_analysis_t& network) const
+{
+	UINT32 b, block_count(static_cast<UINT32>(vISL_.size()));
+	UINT32 reverseJunctions;
+	it_vUINT32_const _it_cml;
 
-	char valid_stations(0);
-	char valid_measurements_not_included(0);
-	if (vfreeStnList_.size())
-	{
-		valid_stations = 1;
-		ss.str("");
-		ss << std::endl << "- Warning: The following stations were not used:" << std::endl;
-		ss << "  ";
-		it_vUINT32_const _it_freestn(vfreeStnList_.begin());
-		for (; _it_freestn!=vfreeStnList_.end(); ++_it_freestn)
-			ss << bstBinaryRecords_.at(*_it_freestn).stationName << " ";
-		ss << std::endl;
-		ss << "- Possible reasons why these stations were not used include:" << std::endl;
-		ss << "  - No measurements to these stations were found," << std::endl;
-		ss << "  - The network is made up of non-contiguous blocks," << std::endl;
-		ss << "  - There is a bug in this program." << std::endl;
+	blocks.clear();
+	blocks.resize(block_count);
+	network = segment_analysis_t();
+	network._blockCount = block_count;
 
-		if (debug_level_ > 1)
-			debug_file << ss.str();
-	}
+	double maxCombine(0.);
 
-	if (debug_level_ > 1)
+	for (b=0; b<block_count; ++b)
 	{
-		debug_file << formatedElapsedTime<std::string>(&elapsed_time, "+ Network segmentation took ") <<
-			" The network is now ready for adjustment." << std::endl;
-		debug_file.close();
+		block_analysis_t& block(blocks.at(b));
+		block._network = v_ContiguousNetList_.at(b);
+		block._innerStations = static_cast<UINT32>(vISL_.at(b).size());
+		block._junctionStations = static_cast<UINT32>(vJSL_.at(b).size());
+		block._parameters = (block._innerStations + block._junctionStations) * 3;
+		block._measurements = static_cast<UINT32>(vCML_.at(b).size());
+		block._msrQuantities = 0;
+		for (_it_cml=vCML_.at(b).begin(); _it_cml!=vCML_.at(b).end(); ++_it_cml)
+			block._msrQuantities += dna_io_seg::measurement_quantities(bmsBinaryRecords_.at(*_it_cml));
+		block._junctionRatio = (block._parameters > 0 ? 
+			static_cast<double>(block._junctionStations * 3) / block._parameters : 0.);
+
+		reverseJunctions = 0;
+		if (b > 0 && v_ContiguousNetList_.at(b - 1) == block._network)
+			reverseJunctions = static_cast<UINT32>(vJSL_.at(b - 1).size());
+
+		block._forwardFlops = dna_segment_cost::PassFlops(block._parameters, block._junctionStations * 3);
+		block._reverseFlops = dna_segment_cost::PassFlops(block._parameters, reverseJunctions * 3);
+		block._combineFlops = dna_segment_cost::CombineFlops(block._parameters, block._junctionStations * 3);
+
+		if (b == 0 || block._network != blocks.at(b - 1)._network)
+			network._networkCount++;
+		network._stationSolutions += block._innerStations + block._junctionStations;
+		network._junctionStations += block._junctionStations;
+		network._maxParameters = std::max(network._maxParameters, block._parameters);
+		network._measurements += block._measurements;
+		network._msrQuantities += block._msrQuantities;
+		network._forwardFlops += block._forwardFlops;
+		network._reverseFlops += block._reverseFlops;
+		network._combineFlops += block._combineFlops;
+		maxCombine = std::max(maxCombine, block._combineFlops);
 	}
 
-	isProcessing_ = false;	
+	if (network._stationSolutions > 0)
+		network._junctionRatio = static_cast<double>(network._junctionStations) / network._stationSolutions;
+	network._totalFlops = network._forwardFlops + network._reverseFlops + network._combineFlops;
+	network._criticalPathFlops = std::max(network._forwardFlops, network._reverseFlops) + maxCombine;
+	if (network._criticalPathFlops > 0.)
+		network._parallelism = network._totalFlops / network._criticalPathFlops;
+}
 
-	if (valid_measurements_not_included || valid_stations)
-		return (segmentStatus_ = SEGMENT_BLOCK_ERROR);
 
-	return (segmentStatus_ = SEGMENT_SUCCESS);
+void dna_segment::SelectBlockSize(project_settings* p, const dna_segment_cost& costModel,
+	vblock_size_trial_t& trials)
+{
+	// Block size thresholds tried: COST_MIN_BLOCK_STATIONS, increasing
+	// geometrically by COST_BLOCK_STATIONS_STEP
+	const UINT32 COST_MIN_BLOCK_STATIONS(30);
+	const double COST_BLOCK_STATIONS_STEP(1.5);
+	// Stop once this many successive thresholds are slower than the best
+	const UINT32 COST_SLOWER_TRIALS(2);
+
+	const UINT32 threads(p->s.target_threads > 0 ? p->s.target_threads : costModel.backendThreads());
+	const double min_inner_ratio(static_cast<double>(p->s.min_inner_stations) / 
+		std::max(1U, p->s.max_total_stations));
+
+	trials.clear();
+
+	UINT32 max_total(COST_MIN_BLOCK_STATIONS), slower(0);
+	UINT32 best(UINT_MAX), smallest(0);
+
+	while (true)
+	{
+		project_settings trial_settings(*p);
+		trial_settings.g.verbose = 0;
+		trial_settings.s.max_total_stations = max_total;
+		trial_settings.s.min_inner_stations = std::max(1U, 
+			static_cast<UINT32>(max_total * min_inner_ratio + 0.5));
+
+		dna_segment trialSegment;
+		trialSegment.InitialiseSegmentation();
+		trialSegment.PrepareSegmentation(&trial_settings);
+		trialSegment.SegmentNetwork(&trial_settings);
+		trialSegment.EstimateBlockCosts(costModel);
+
+		block_size_trial_t trial;
+		trial._maxTotalStations = trial_settings.s.max_total_stations;
+		trial._minInnerStations = trial_settings.s.min_inner_stations;
+		trial._blockCount = static_cast<UINT32>(trialSegment.blockCount());
+		trial._junctionCount = trialSegment.junctionStationCount();
+		trial._predictedTime = costModel.PredictAdjustment(trialSegment.BlockCosts(), threads, trial._mode);
+		trial._memory = costModel.PredictMemory(trialSegment.BlockCosts());
+		trial._withinBudget = (p->s.target_memory == 0 || trial._memory <= p->s.target_memory);
+		trials.push_back(trial);
+
+		const UINT32 t(static_cast<UINT32>(trials.size() - 1));
+		if (trial._memory < trials.at(smallest)._memory)
+			smallest = t;
+
+		if (trial._withinBudget)
+		{
+			if (best == UINT_MAX || trial._predictedTime < trials.at(best)._predictedTime)
+			{
+				best = t;
+				slower = 0;
+			}
+			else
+				++slower;
+		}
+		
+		// Larger blocks will require more memory, and once
+		// the network is a single block, nothing will change
+		if (!trial._withinBudget && 
+			(best != UINT_MAX || trial._memory > trials.at(smallest)._memory))
+			break;
+		if (trial._blockCount < 2 || slower == COST_SLOWER_TRIALS)
+			break;
+
+		max_total = static_cast<UINT32>(ceil(max_total * COST_BLOCK_STATIONS_STEP));
+	}
+
+	// If no threshold is within the memory budget, 
+	// adopt the one requiring the least memory
+	if (best == UINT_MAX)
+		best = smallest;
+
+	p->s.max_total_stations = trials.at(best)._maxTotalStations;
+	p->s.min_inner_stations = trials.at(best)._minInnerStations;
 }
-	
+
 
 void dna_segment::CalculateAverageBlockSize()
 {
@@ -317,11 +1640,11 @@ void dna_segment::CalculateAverageBlockSize()
 
 std::string dna_segment::DefaultStartingStation()
 {
-	if (vfreeStnList_.empty())
+	if (freeStnHeap_.empty())
 		return "";
 	if (bstBinaryRecords_.empty())
 		return "";
-	return bstBinaryRecords_.at(vfreeStnList_.at(0)).stationName;
+	return bstBinaryRecords_.at(startingStn_).stationName;
 }
 	
 
@@ -334,15 +1657,15 @@ vstring dna_segment::StartingStations()
 // throws NetSegmentException on failure
 void dna_segment::BuildFirstBlock()
 {	
+	currJunctStnHeap_.clear();
 	vCurrJunctStnList_.clear();
 	vCurrInnerStnList_.clear();
 	vCurrMeasurementList_.clear();
 
 	if (vinitialStns_.empty())
-		// no station specified? then pick the first one on the free list
-		// Remember, vfreeStnList_ is not sorted alphabetically, but according
-		// to the number of measurements connected to each station
-		vinitialStns_.push_back(bstBinaryRecords_.at(vfreeStnList_.at(0)).stationName);
+		// no station specified? then pick the free station with
+		// the lowest number of measurements connected to it
+		vinitialStns_.push_back(bstBinaryRecords_.at(startingStn_).stationName);
 	else	
 		RemoveDuplicateStations(&vinitialStns_);		// remove duplicates
 	
@@ -361,7 +1684,6 @@ void dna_segment::VerifyStationsandBuildBlock(bool validationOnly)
 	UINT32 stn_index;
 #endif
 
-	it_vUINT32 _it_freeisl;
 	_it_vstr_const _it_name(vinitialStns_.begin());
 	it_pair_string_vUINT32 it_stnmap_range;
 	v_string_uint32_pair::iterator _it_stnmap(stnsMap_.begin());
@@ -386,22 +1708,13 @@ void dna_segment::VerifyStationsandBuildBlock(bool validationOnly)
 		stn_index = _it_stnmap->second;
 #endif
 		// add this station to inner station list if it is on the free stations list only.
-		// vfreeStnList_ is sorted according to the number of measurements connected to each station
-		// hence, a binary_search (or lower_bound or similar) cannot be used here
-
-		// Check if this station is available before trying to find it.  Why?
-		// find_if over a large vector is not fast like binary_search
 		if (vfreeStnAvailability_.at(_it_stnmap->second).isfree())
 		{			
-			// Ok, find it and remove it
-			//if ((_it_freeisl = find_if(vfreeStnList_.begin(), vfreeStnList_.end(),
-			//	bind1st(std::equal_to<UINT32>(), _it_stnmap->second))) != vfreeStnList_.end())
-			if ((_it_freeisl = find_if(vfreeStnList_.begin(), vfreeStnList_.end(),
-				[&_it_stnmap](const UINT32& freeStn) {
-					return freeStn == _it_stnmap->second; } )) != vfreeStnList_.end())
+			// Ok, remove it from the free station list
+			if (freeStnHeap_.contains(_it_stnmap->second))
 			{
 				if (!validationOnly)
-					MoveFreeStnToInnerList(_it_freeisl, _it_stnmap->second);
+					MoveFreeStnToInnerList(_it_stnmap->second);
 			}
 		}
 		else
@@ -425,13 +1738,9 @@ void dna_segment::VerifyStationsandBuildBlock(bool validationOnly)
 
 UINT32 dna_segment::SelectInner()
 {
-	// Sort the list of junction stations by the number of measurements 
-	// connected to them, and begin with the station that has the lowest 
-	// number of measurements
-	SortbyMeasurementCount(&vCurrJunctStnList_);
-	
-	it_vUINT32 it_currjsl(vCurrJunctStnList_.begin());
-	UINT32 stn_index = *it_currjsl;
+	// Begin with the junction station that has the lowest 
+	// number of measurements connected to it
+	UINT32 stn_index = LowestMeasurementCountStation(currJunctStnHeap_);
 
 	if (debug_level_ > 2)
 		trace_file << " + Inner '" << bstBinaryRecords_.at(stn_index).stationName << "'" << std::endl;
@@ -441,7 +1750,7 @@ UINT32 dna_segment::SelectInner()
 #endif
 
 	// add this junction station to inner station list
-	MoveStation(vCurrJunctStnList_, it_currjsl, vCurrInnerStnList_, stn_index);
+	MoveJunctionStnToInnerList(stn_index);
 
 	return stn_index;
 }
@@ -452,23 +1761,19 @@ UINT32 dna_segment::SelectInner()
 // but measurements still remain and stations exist in the free list.
 void dna_segment::SelectJunction()
 {
-	SortbyMeasurementCount(&vfreeStnList_);
-	
-	it_vUINT32 it_newjsl(vfreeStnList_.begin());
-
-	MoveFreeStnToJunctionList(it_newjsl, *it_newjsl);
+	MoveFreeStnToJunctionList(LowestMeasurementCountStation(freeStnHeap_));
 }
 
 
-it_vUINT32 dna_segment::MoveStation(vUINT32& fromList, it_vUINT32 it_from, vUINT32& toList, const UINT32& stn_index)
+void dna_segment::MoveJunctionStnToInnerList(const UINT32& stn_index)
 {
-	// Move a station from one list to another list
-	toList.push_back(stn_index);	
-	return fromList.erase(it_from);
+	// Move a station from the junction list to the inner list
+	currJunctStnHeap_.erase(stn_index);
+	vCurrInnerStnList_.push_back(stn_index);
 }
 	
 
-void dna_segment::MoveFreeStn(it_vUINT32 it_freeisl, vUINT32& toList, const UINT32& stn_index, const std::string& type)
+void dna_segment::MoveFreeStn(const UINT32& stn_index, const std::string& type)
 {
 	if (debug_level_ > 2)
 		trace_file << " + New " << type << " station (" << stn_index << ") '" << 
@@ -481,30 +1786,31 @@ void dna_segment::MoveFreeStn(it_vUINT32 it_freeisl, vUINT32& toList, const UINT
 	// Mark this station as unavailable
 	vfreeStnAvailability_.at(stn_index).consume();
 
-	// Move a station from the free station list to the specified list
-	// stnList may be either inner or junction list
-	MoveStation(vfreeStnList_, it_freeisl, toList, stn_index);
+	// Remove this station from the free station list
+	freeStnHeap_.erase(stn_index);
 }
 	
 
-void dna_segment::MoveFreeStnToJunctionList(it_vUINT32 it_freeisl, const UINT32& stn_index)
+void dna_segment::MoveFreeStnToJunctionList(const UINT32& stn_index)
 {
 	// Move a station from the free station list to the junction list
-	MoveFreeStn(it_freeisl, vCurrJunctStnList_, stn_index, "junction");	
+	MoveFreeStn(stn_index, "junction");
+	currJunctStnHeap_.push(stn_index);
 }
 	
 
-void dna_segment::MoveFreeStnToInnerList(it_vUINT32 it_freeisl, const UINT32& stn_index)
+void dna_segment::MoveFreeStnToInnerList(const UINT32& stn_index)
 {
-	// Move a station from the free station list to the junction list
-	MoveFreeStn(it_freeisl, vCurrInnerStnList_, stn_index, "inner");
+	// Move a station from the free station list to the inner list
+	MoveFreeStn(stn_index, "inner");
+	vCurrInnerStnList_.push_back(stn_index);
 }
 	
 
 // throws NetSegmentException on failure
 void dna_segment::BuildNextBlock()
 {
-	// vCurrJunctStnList_ carries the previous block's junction stations. Thus,
+	// currJunctStnHeap_ carries the previous block's junction stations. Thus,
 	// don't clear it as these stations will become the inners for the next block
 	vCurrInnerStnList_.clear();
 	vCurrMeasurementList_.clear();
@@ -515,23 +1821,23 @@ void dna_segment::BuildNextBlock()
 
 	// Select a new junction station if there are none on the JSL
 	// that have free measurements left
-	if (vCurrJunctStnList_.empty() && !vfreeStnList_.empty())
+	if (currJunctStnHeap_.empty() && !freeStnHeap_.empty())
 	{
 		if (!projectSettings_.s.force_contiguous_blocks)
 			v_ContiguousNetList_.back() = ++currentNetwork_;
 
 		if (debug_level_ > 1)
 		{
-			debug_file << "+ Non-contiguous block found... creating a new block using " << bstBinaryRecords_.at(vfreeStnList_.at(0)).stationName << std::endl;
+			debug_file << "+ Non-contiguous block found... creating a new block using " << bstBinaryRecords_.at(freeStnHeap_.top()).stationName << std::endl;
 			if (debug_level_ > 2)
-				trace_file << " + Non-contiguous block found... creating a new block using " << bstBinaryRecords_.at(vfreeStnList_.at(0)).stationName << std::endl;
+				trace_file << " + Non-contiguous block found... creating a new block using " << bstBinaryRecords_.at(freeStnHeap_.top()).stationName << std::endl;
 		}
 
 		// Select a new junction from the free station list
 		SelectJunction();
 	}
 	
-	if (vCurrJunctStnList_.empty())
+	if (currJunctStnHeap_.empty())
 	{
 		coutSummary();
 		SignalExceptionSerialise("BuildNextBlock(): An invalid junction list has been created.  This is most likely a bug.", 0, NULL);
@@ -548,8 +1854,10 @@ void dna_segment::BuildNextBlock()
 	while (!block_threshold_reached)
 	{
 		// Attempt to add non-contiguous blocks to this block if the 
-		// station limit hasn't been reached
-		if (vfreeStnList_.empty() /*|| vfreeMsrList_.empty()*/)
+		// station limit hasn't been reached.  If this is one of several
+		// isolated networks, carry on as if the stations of the networks
+		// that follow are free.
+		if (freeStnHeap_.empty() && !componentsFollow_ /*|| vfreeMsrList_.empty()*/)
 			break;
 
 		// Is the junction list empty?  force_contiguous_blocks determines what to 
@@ -558,10 +1866,10 @@ void dna_segment::BuildNextBlock()
 		{
 			// Add non-contiguous blocks to this block if the 
 			// station limit hasn't been reached
-			if (vCurrJunctStnList_.empty())
+			if (currJunctStnHeap_.empty())
 				SelectJunction();
 		}
-		else if (vCurrJunctStnList_.empty())
+		else if (currJunctStnHeap_.empty())
 			break;
 
 		// Get next station from current junction list
@@ -571,7 +1879,7 @@ void dna_segment::BuildNextBlock()
 		// add AML indices to CML for all measurements connected to this station
 		GetInnerMeasurements(stn_index);
 
-		currentTotalSize = static_cast<UINT32>(vCurrInnerStnList_.size() + vCurrJunctStnList_.size());
+		currentTotalSize = static_cast<UINT32>(vCurrInnerStnList_.size() + currJunctStnHeap_.size());
 
 		// Has the station count threshold been exceeded?
 		//if (currentTotalSize >= seg_max_total_stations_)
@@ -600,6 +1908,15 @@ void dna_segment::FinaliseBlock()
 	FindCommonMeasurements();
 	MoveJunctiontoISL();
 
+	vCurrJunctStnList_ = currJunctStnHeap_.elements();
+
+	AddCurrentBlock();
+}
+	
+
+// Adds the current inner, junction and measurement lists to the block lists
+void dna_segment::AddCurrentBlock()
+{
 	// Sort lists
 	std::sort(vCurrInnerStnList_.begin(), vCurrInnerStnList_.end());
 	std::sort(vCurrJunctStnList_.begin(), vCurrJunctStnList_.end());
@@ -627,8 +1944,8 @@ void dna_segment::FinaliseBlock()
 			trace_file << currentTotalSize << " total stations, " << currentMsrSize << " measurements." << std::endl;
 		
 			trace_file << "   - Inners (" << currentISLSize << "):" << std::endl << "     ";
-			it_vUINT32_const _it_freeisl(vfreeStnList_.end());
-			for (_it_freeisl=vCurrInnerStnList_.begin(); _it_freeisl!=vCurrInnerStnList_.end(); ++_it_freeisl)
+			it_vUINT32_const _it_freeisl(vCurrInnerStnList_.begin());
+			for (;  _it_freeisl!=vCurrInnerStnList_.end(); ++_it_freeisl)
 				trace_file << "'" << bstBinaryRecords_.at(*_it_freeisl).stationName << "' ";
 			trace_file << std::endl;
 
@@ -696,8 +2013,7 @@ void dna_segment::GetInnerMeasurements(const UINT32& innerStation)
 	std::string from, to, to2;
 #endif
 
-	measurement_t measRecord;
-	vUINT32 msrStations;
+	it_vUINT32_const _it_first, _it_last;
 
 	// Get the original measurement count
 	UINT32 m, msrCount(vASLCount_.at(innerStation));
@@ -712,12 +2028,13 @@ void dna_segment::GetInnerMeasurements(const UINT32& innerStation)
 		if (!vAssocFreeMsrList_.at(amlIndex).available)
 			continue;
 		
-		measRecord = bmsBinaryRecords_.at(vAssocFreeMsrList_.at(amlIndex).bmsr_index);
+		const msr_view_t& msrView(vMsrView_.at(vAssocFreeMsrList_.at(amlIndex).bmsr_index));
 
-		if (measRecord.ignore)
+		if (msrView._ignore)
 			continue;
 
 #ifdef _MSDEBUG
+		const measurement_t& measRecord(bmsBinaryRecords_.at(vAssocFreeMsrList_.at(amlIndex).bmsr_index));
 		from = bstBinaryRecords_.at(measRecord.station1).stationName;
 		if (MsrTally::Stations(measRecord.measType) >= TWO_STATION)
 		{
@@ -730,23 +2047,18 @@ void dna_segment::GetInnerMeasurements(const UINT32& innerStation)
 		// When a non-measurement element is found (i.e. Y or Z or covariance component),
 		// continue to next element.  Hence, only pointers to the starting element of each
 		// measurement are kept. See declaration of measRecord.measStart for more info.
-		switch (measRecord.measType)
-		{
-		case 'G':
-		case 'X':
-		case 'Y':
-			if (measRecord.measStart != xMeas)
-				continue;
-		}		
+		if (!msrView._first)
+			continue;
 
 		// Get all the stations associated with this measurement
-		GetMsrStations(bmsBinaryRecords_, vAssocFreeMsrList_.at(amlIndex).bmsr_index, msrStations);
+		_it_first = vMsrViewStations_.begin() + msrView._stnOffset;
+		_it_last = _it_first + msrView._stnCount;
 
 		// Add this measurement to the current measurement list
-		AddtoCurrentMsrList(amlIndex, msrStations);
+		AddtoCurrentMsrList(amlIndex, _it_first, _it_last);
 
 		// if this station is not on JSL, move it from the freestnlist to JSL
-		AddtoJunctionStnList(msrStations);
+		AddtoJunctionStnList(_it_first, _it_last);
 	}
 }
 
@@ -754,6 +2066,11 @@ void dna_segment::GetInnerMeasurements(const UINT32& innerStation)
 //	- consume this measurement and all other occurences of it on the AML
 //	- add this measurement to the current list of measurements for this block.
 bool dna_segment::AddtoCurrentMsrList(const UINT32& amlIndex, const vUINT32& msrStations)
+{
+	return AddtoCurrentMsrList(amlIndex, msrStations.begin(), msrStations.end());
+}
+	
+bool dna_segment::AddtoCurrentMsrList(const UINT32& amlIndex, it_vUINT32_const _it_first, it_vUINT32_const _it_last)
 {
 	if (!vAssocFreeMsrList_.at(amlIndex).available)
 		return false;
@@ -767,7 +2084,7 @@ bool dna_segment::AddtoCurrentMsrList(const UINT32& amlIndex, const vUINT32& msr
 	UINT32 stn_index;
 #endif
 
-	UINT32 firstIndex(GetFirstMsrIndex<UINT32>(bmsBinaryRecords_, bmsrindex));
+	UINT32 firstIndex(vMsrView_.at(bmsrindex)._firstIndex);
 
 	// Add the index of the first binary measurement record to the measurement list
 	vCurrMeasurementList_.push_back(firstIndex);
@@ -781,13 +2098,13 @@ bool dna_segment::AddtoCurrentMsrList(const UINT32& amlIndex, const vUINT32& msr
 	}
 
 	it_aml_pair _it_aml;
-	it_vUINT32_const _it_stn, _it_msr;
+	it_vUINT32_const _it_stn;
 	
 	// 1) consume each occurrence of this measurement (and all other
 	//	  measurements within a cluster) on the AML, then
 	// 2) Decrement the measurement count for all stations associated 
 	//	  with this measurement.
-	for (_it_stn=msrStations.begin(); _it_stn!=msrStations.end(); ++_it_stn)
+	for (_it_stn=_it_first; _it_stn!=_it_last; ++_it_stn)
 	{
 		// Consume the occurrences of this measurement (and other measurements in a cluster)
 		// in the aml for the stations in msrStations
@@ -817,7 +2134,7 @@ bool dna_segment::AddtoCurrentMsrList(const UINT32& amlIndex, const vUINT32& msr
 				_it_aml->consume();
 
 				// Decrement the measurement count.
-				vAssocStnList_.at(*_it_stn).DecrementMsrCount();
+				DecrementMsrCount(*_it_stn);
 				break;
 			}
 		}
@@ -838,14 +2155,19 @@ bool dna_segment::AddtoCurrentMsrList(const UINT32& amlIndex, const vUINT32& msr
 void dna_segment::FindCommonMeasurements()
 {
 	// Create a temporary vector
-	vUINT32 vCurrBlockStnList(vCurrJunctStnList_), msrStations;
+	vUINT32 vCurrBlockStnList(currJunctStnHeap_.elements());
 	
 	std::sort(vCurrBlockStnList.begin(), vCurrBlockStnList.end());
 
-	it_vUINT32 _it_stn, _it_mstn;
-	measurement_t measRecord;
+	it_vUINT32 _it_stn;
+	it_vUINT32_const _it_first, _it_last, _it_mstn;
 	bool inList;
 
+	// Flag the stations on vCurrBlockStnList.  No stations are added to or
+	// removed from the junction list here, so the flags are cleared on return.
+	for (_it_stn=vCurrBlockStnList.begin(); _it_stn!=vCurrBlockStnList.end(); ++_it_stn)
+		vCurrBlockStns_.at(*_it_stn) = true;
+
 	if (debug_level_ > 2)
 		trace_file << " + FindCommonMeasurements()" << std::endl;
 
@@ -871,20 +2193,21 @@ void dna_segment::FindCommonMeasurements()
 			if (!vAssocFreeMsrList_.at(amlIndex).available)
 				continue;
 			
-			measRecord = bmsBinaryRecords_.at(vAssocFreeMsrList_.at(amlIndex).bmsr_index);
+			const msr_view_t& msrView(vMsrView_.at(vAssocFreeMsrList_.at(amlIndex).bmsr_index));
 
-			if (measRecord.ignore)
+			if (msrView._ignore)
 				continue;
 
 			// Get all the stations associated with this measurement
-			GetMsrStations(bmsBinaryRecords_, vAssocFreeMsrList_.at(amlIndex).bmsr_index, msrStations);
+			_it_first = vMsrViewStations_.begin() + msrView._stnOffset;
+			_it_last = _it_first + msrView._stnCount;
 
 			// Since a single station measurement is not associated with other stations,
 			// add the measurement to the list
-			if (msrStations.size() == 1)
+			if (msrView._stnCount == 1)
 			{
 				// Add this measurement to the current measurement list
-				AddtoCurrentMsrList(amlIndex, msrStations);
+				AddtoCurrentMsrList(amlIndex, _it_first, _it_last);
 				continue;
 			}
 			
@@ -894,12 +2217,12 @@ void dna_segment::FindCommonMeasurements()
 			inList = true;
 			
 			// Two or more station measurements
-			for (_it_mstn=msrStations.begin(); _it_mstn!=msrStations.end(); ++_it_mstn)
+			for (_it_mstn=_it_first; _it_mstn!=_it_last; ++_it_mstn)
 			{
 				// If one station in msrStations (which are all stations 
 				// associated with the current measurement) is not in the junction list,
 				// then this cannot be a "common measurement".
-				if (!binary_search(vCurrBlockStnList.begin(), vCurrBlockStnList.end(), *_it_mstn))
+				if (!vCurrBlockStns_.at(*_it_mstn))
 				{
 					// The station at _it_mstn is not in vCurrBlockStnList, so this is not a
 					// "common measurement" - break out of loop.
@@ -911,9 +2234,12 @@ void dna_segment::FindCommonMeasurements()
 			// If all stations in msrStations are found within vCurrBlockStnList, then
 			// add this measurement to the current measurement list
 			if (inList)
-				AddtoCurrentMsrList(amlIndex, msrStations);
+				AddtoCurrentMsrList(amlIndex, _it_first, _it_last);
 		}
 	}
+
+	for (_it_stn=vCurrBlockStnList.begin(); _it_stn!=vCurrBlockStnList.end(); ++_it_stn)
+		vCurrBlockStns_.at(*_it_stn) = false;
 }
 
 UINT32 dna_segment::GetAvailableMsrCount(const UINT32& stn_index)
@@ -922,6 +2248,19 @@ UINT32 dna_segment::GetAvailableMsrCount(const UINT32& stn_index)
 }
 
 
+// Decrements the measurement count for a station, and restores the 
+// order of the junction or free station list it is on
+void dna_segment::DecrementMsrCount(const UINT32& stn_index)
+{
+	vAssocStnList_.at(stn_index).DecrementMsrCount();
+
+	if (currJunctStnHeap_.contains(stn_index))
+		currJunctStnHeap_.decrease(stn_index);
+	else if (freeStnHeap_.contains(stn_index))
+		freeStnHeap_.decrease(stn_index);
+}
+
+
 // Name:				MoveJunctiontoISL
 // Purpose:				Moves stations on the inner list to the junction list.  The
 //						condition for moving a station is that there are no more
@@ -939,74 +2278,51 @@ void dna_segment::MoveJunctiontoISL()
 	std::string station_name;
 #endif
 
-	it_vUINT32 _it_currjsl(vCurrJunctStnList_.begin());
-	UINT32 stn_index;
+	// Take a copy of the junction list, since stations 
+	// are removed from currJunctStnHeap_ as they are moved
+	vUINT32 vCurrJunctStnList(currJunctStnHeap_.elements());
+	std::sort(vCurrJunctStnList.begin(), vCurrJunctStnList.end());
 
-	while (!vCurrJunctStnList_.empty())
-	{
-		stn_index = *_it_currjsl;
+	it_vUINT32_const _it_currjsl;
 
+	for (_it_currjsl=vCurrJunctStnList.begin(); _it_currjsl!=vCurrJunctStnList.end(); ++_it_currjsl)
+	{
 #ifdef _MSDEBUG		
-		station_name = bstBinaryRecords_.at(stn_index).stationName;
+		station_name = bstBinaryRecords_.at(*_it_currjsl).stationName;
 #endif
 
 		// Are there no more available measurements connected to this station?
-		if (GetAvailableMsrCount(stn_index) == 0)
-		{
-			if (debug_level_ > 2)
-				trace_file << "   - Junction station '" << 
-					bstBinaryRecords_.at(static_cast<UINT32>(stn_index)).stationName << 
-					"' was moved to inner list (no more available measurements)." << std::endl;
-
-			// Move this station from the junctions list to inners list
-			_it_currjsl = MoveStation(vCurrJunctStnList_, _it_currjsl, 
-				vCurrInnerStnList_, stn_index);
+		if (GetAvailableMsrCount(*_it_currjsl) > 0)
+			continue;
 
-			// Have all JSLs been removed?
-			if (vCurrJunctStnList_.empty())
-				// end the while loop
-				break;
-			else if (_it_currjsl == vCurrJunctStnList_.end())
-				// reset the iterator to the previous junction station
-				--_it_currjsl;
+		if (debug_level_ > 2)
+			trace_file << "   - Junction station '" << 
+				bstBinaryRecords_.at(*_it_currjsl).stationName << 
+				"' was moved to inner list (no more available measurements)." << std::endl;
 
-			continue;
-		}
-		
-		// move to the next junction, unless the iterator is 
-		// pointing to the last
-		if (++_it_currjsl == vCurrJunctStnList_.end())
-			break;
+		// Move this station from the junctions list to inners list
+		MoveJunctionStnToInnerList(*_it_currjsl);
 	}
 }
 
 void dna_segment::AddtoJunctionStnList(const vUINT32& msrStations)
+{
+	AddtoJunctionStnList(msrStations.begin(), msrStations.end());
+}
+
+void dna_segment::AddtoJunctionStnList(it_vUINT32_const _it_first, it_vUINT32_const _it_last)
 {
 	it_vUINT32_const _it_stn;
-	it_vUINT32 _it_freeisl;
-	for (_it_stn=msrStations.begin(); _it_stn!=msrStations.end(); ++_it_stn)
-	{
-		// If First station is not already in the junction list...
-		//if (find_if(vCurrJunctStnList_.begin(), vCurrJunctStnList_.end(),
-		//	bind1st(equal_to<UINT32>(), *_it_stn)) == vCurrJunctStnList_.end())
-		if (find_if(vCurrJunctStnList_.begin(), vCurrJunctStnList_.end(),
-			[&_it_stn](const UINT32& junctionStn) {
-				return junctionStn == *_it_stn; }) == vCurrJunctStnList_.end())
-		{
-			// If the first station is available, get an iterator to it and move it
-			if (vfreeStnAvailability_.at(*_it_stn).isfree())
-			{
-				// Move it to the list of junctions
-				//if ((_it_freeisl = find_if(vfreeStnList_.begin(), vfreeStnList_.end(),
-				//	bind1st(equal_to<UINT32>(), *_it_stn))) != vfreeStnList_.end())
-				if ((_it_freeisl = find_if(vfreeStnList_.begin(), vfreeStnList_.end(),
-					[&_it_stn](const UINT32& freeStn) {
-						return freeStn == *_it_stn; })) != vfreeStnList_.end())
-				{
-					MoveFreeStnToJunctionList(_it_freeisl, *_it_stn);
-				}
-			}
-		}
+	for (_it_stn=_it_first; _it_stn!=_it_last; ++_it_stn)
+	{
+		// If this station is not already in the junction list...
+		if (currJunctStnHeap_.contains(*_it_stn))
+			continue;
+		
+		// ...and is available, move it to the list of junctions
+		if (vfreeStnAvailability_.at(*_it_stn).isfree())
+			if (freeStnHeap_.contains(*_it_stn))
+				MoveFreeStnToJunctionList(*_it_stn);
 	}
 }
 
@@ -1062,10 +2378,11 @@ void dna_segment::SignalExceptionSerialise(const std::string& msg, const int& i,
 void dna_segment::LoadAssociationFiles(const std::string& aslfileName, const std::string& amlfileName)
 {
 	UINT32 stn, stnCount(0);
+	vUINT32 vfreeStnList;
 	
 	try {
 		dna_io_asl asl;
-		stnCount = asl.load_asl_file(aslfileName, &vAssocStnList_, &vfreeStnList_);
+		stnCount = asl.load_asl_file(aslfileName, &vAssocStnList_, &vfreeStnList);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionSerialise(e.what(), 0, NULL);
@@ -1084,7 +2401,10 @@ void dna_segment::LoadAssociationFiles(const std::string& aslfileName, const std
 	}
 
 	// remove stations from the free list that are invalid
-	RemoveInvalidFreeStations();
+	RemoveInvalidFreeStations(vfreeStnList);
+
+	// Create the free station list, ordered by measurement count
+	freeStnHeap_.assign(vfreeStnList);
 
 	// Load associated measurements list.  Throws runtime_error on failure.
 	try {
@@ -1147,9 +2467,6 @@ void dna_segment::LoadBinaryFiles(const std::string& bstrfileName, const std::st
 
 void dna_segment::IdentifyInnerMsrsandAssociatedStns(const UINT32& innerStation, vUINT32& totalStations)
 {
-	it_vmsr_t measRecord;
-	vUINT32 msrStations;
-	
 	// Get the original measurement count
 	UINT32 m, msrCount(vASLCount_.at(innerStation));
 	// Get the aml index, initialised to the last measurement for this station
@@ -1163,27 +2480,21 @@ void dna_segment::IdentifyInnerMsrsandAssociatedStns(const UINT32& innerStation,
 		if (!vAssocFreeMsrList_.at(amlIndex).available)
 			continue;
 		
-		measRecord = bmsBinaryRecords_.begin() + vAssocFreeMsrList_.at(amlIndex).bmsr_index;
+		const msr_view_t& msrView(vMsrView_.at(vAssocFreeMsrList_.at(amlIndex).bmsr_index));
 
-		if (measRecord->ignore)
+		if (msrView._ignore)
 			continue;
 
 		// When a non-measurement element is found (i.e. Y or Z or covariance component),
 		// continue to next element.  Hence, only pointers to the starting element of each
 		// measurement are kept. See declaration of measRecord.measStart for more info.
-		switch (measRecord->measType)
-		{
-		case 'G':
-		case 'X':
-		case 'Y':
-			if (measRecord->measStart != xMeas)
-				continue;
-		}
+		if (!msrView._first)
+			continue;
 
 		// Get all the stations associated with this measurement
-		GetMsrStations(bmsBinaryRecords_, vAssocFreeMsrList_.at(amlIndex).bmsr_index, msrStations);
-
-		totalStations.insert(totalStations.end(), msrStations.begin(), msrStations.end());
+		totalStations.insert(totalStations.end(), 
+			vMsrViewStations_.begin() + msrView._stnOffset,
+			vMsrViewStations_.begin() + msrView._stnOffset + msrView._stnCount);
 	}
 
 	strip_duplicates(totalStations);
@@ -1245,43 +2556,43 @@ void dna_segment::IdentifyLowestStationAssociation(pvUINT32 vStnList, vUINT32& t
 	//TRACE("\n\n");
 }
 
-void dna_segment::SortbyMeasurementCount(pvUINT32 vStnList)
+// Name:				LowestMeasurementCountStation
+// Purpose:				Returns the station on stnHeap with the lowest number of measurements.
+//						If a search level is specified, the first five stations are examined
+//						and the one associated with the fewest stations is returned.
+// Called by:			PrepareSegmentation(), SelectInner(), SelectJunction()
+UINT32 dna_segment::LowestMeasurementCountStation(const stn_heap_t& stnHeap)
 {
-	if (vStnList->size() < 2)
-		return;
-	// sort vStnList by number of measurements to each station (held by vAssocStnList
-	CompareMeasCount<CAStationList, UINT32> msrcountCompareFunc(&vAssocStnList_);
-	std::sort(vStnList->begin(), vStnList->end(), msrcountCompareFunc);
-
 	// Search lower level
-	if (projectSettings_.s.seg_search_level == 0)
-		return;
+	if (projectSettings_.s.seg_search_level == 0 || stnHeap.size() < 2)
+		return stnHeap.top();
 
 	vUINT32 msrStations;
 	vUINT32 stnList, stnCount;
-	stnList.insert(stnList.end(), vStnList->begin(), 
-		(vStnList->begin() + minVal(vUINT32::size_type(5),vStnList->size())));
+	stnHeap.smallest(5, stnList);
 	IdentifyLowestStationAssociation(&stnList, msrStations, 0, projectSettings_.s.seg_search_level, &stnCount);
 
 	UINT32 lowestStnCount(*(min_element(stnCount.begin(), stnCount.end())));
 	
 	if (stnCount.front() == lowestStnCount)
-		return;
+		return stnList.front();
 
-	it_vUINT32 it_stn(vStnList->begin()), it_count;
+	it_vUINT32 it_stn(stnList.begin()), it_count;
 	for (it_count=stnCount.begin(); it_count!=stnCount.end(); ++it_stn, ++it_count)
 	{
 		if (lowestStnCount == *it_count)
 			break;
 	}
 
-	if (vStnList->size() < 2)
-		return;
-
-	lowestStnCount = *it_stn;
-	vStnList->erase(it_stn);
-	vStnList->insert(vStnList->begin(), lowestStnCount);
+	return *it_stn;
+}
+	
 
+void dna_segment::SortbyMeasurementCount(vUINT32& vStnList)
+{
+	// sort vStnList by number of measurements to each station (held by vAssocStnList
+	CompareMeasCount<CAStationList, UINT32> msrcountCompareFunc(&vAssocStnList_);
+	std::sort(vStnList.begin(), vStnList.end(), msrcountCompareFunc);
 }
 	
 
@@ -1315,11 +2626,11 @@ void dna_segment::SetAvailableMsrCount()
 }
 	
 
-void dna_segment::RemoveInvalidFreeStations()
+void dna_segment::RemoveInvalidFreeStations(vUINT32& vfreeStnList)
 {
 	CompareValidity<CAStationList, UINT32> aslValidityCompareFunc(&vAssocStnList_, FALSE);
-	std::sort(vfreeStnList_.begin(), vfreeStnList_.end(), aslValidityCompareFunc);
-	erase_if(vfreeStnList_, aslValidityCompareFunc);
+	std::sort(vfreeStnList.begin(), vfreeStnList.end(), aslValidityCompareFunc);
+	erase_if(vfreeStnList, aslValidityCompareFunc);
 }
 
 
@@ -1329,6 +2640,63 @@ void dna_segment::BuildFreeStationAvailabilityList()
 	seg.build_free_stn_availability(vAssocStnList_, vfreeStnAvailability_);
 }		
 
+
+// Builds a compact view of the binary measurement records, so that the
+// segmentation loops need not copy each measurement record they visit, or
+// collect the stations associated with it (GetMsrStations) each time.
+void dna_segment::BuildMeasurementView()
+{
+	vMsrView_.resize(bmsBinaryRecords_.size());
+	vMsrViewStations_.clear();
+	vMsrViewStations_.reserve(bmsBinaryRecords_.size());
+
+	// The records of a cluster (D, X, Y) share the cluster's first
+	// record and stations, so these are collected once per cluster
+	auto isCluster = [](const measurement_t& msr) {
+		return msr.measType == 'D' || msr.measType == 'X' || msr.measType == 'Y';
+	};
+
+	vUINT32 msrStations;
+	UINT32 bmsIndex(0);
+	it_vmsr_t_const _it_msr;
+	_it_msr_view _it_view;
+
+	for (_it_msr=bmsBinaryRecords_.begin(), _it_view=vMsrView_.begin();
+		_it_msr!=bmsBinaryRecords_.end();
+		++_it_msr, ++_it_view, ++bmsIndex)
+	{
+		_it_view->_ignore = _it_msr->ignore;
+		
+		switch (_it_msr->measType)
+		{
+		case 'G':
+		case 'X':
+		case 'Y':
+			_it_view->_first = (_it_msr->measStart == xMeas);
+			break;
+		default:
+			_it_view->_first = true;
+		}
+
+		if (bmsIndex > 0 && isCluster(*_it_msr) && isCluster(*(_it_msr-1)) &&
+			(_it_msr-1)->clusterID == _it_msr->clusterID)
+		{
+			_it_view->_firstIndex = (_it_view-1)->_firstIndex;
+			_it_view->_stnOffset = (_it_view-1)->_stnOffset;
+			_it_view->_stnCount = (_it_view-1)->_stnCount;
+			continue;
+		}
+
+		_it_view->_firstIndex = GetFirstMsrIndex<UINT32>(bmsBinaryRecords_, bmsIndex);
+		GetMsrStations(bmsBinaryRecords_, bmsIndex, msrStations);
+		_it_view->_stnOffset = static_cast<UINT32>(vMsrViewStations_.size());
+		_it_view->_stnCount = static_cast<UINT32>(msrStations.size());
+		vMsrViewStations_.insert(vMsrViewStations_.end(), msrStations.begin(), msrStations.end());
+	}
+
+	vCurrBlockStns_.assign(bstBinaryRecords_.size(), false);
+}
+
 void dna_segment::RemoveDuplicateStations(pvstring vStations)
 {
 	if (vStations->size() < 2)
@@ -1375,19 +2743,21 @@ void dna_segment::WriteFreeStnListSortedbyASLMsrCount()
 	UINT32 x(0);
 	std::string s;
 	UINT32 u, msrCount, m, amlindex;
-	for (; x<vfreeStnList_.size(); ++x)
+	vUINT32 vfreeStnList(freeStnHeap_.elements());
+	SortbyMeasurementCount(vfreeStnList);
+	for (; x<vfreeStnList.size(); ++x)
 	{
-		u = vfreeStnList_.at(x);
-		s = bstBinaryRecords_.at(vfreeStnList_.at(x)).stationName;
+		u = vfreeStnList.at(x);
+		s = bstBinaryRecords_.at(vfreeStnList.at(x)).stationName;
 		s.insert(0, "'");
 		s += "'";
-		msrCount = vAssocStnList_.at(vfreeStnList_.at(x)).GetAssocMsrCount();
+		msrCount = vAssocStnList_.at(vfreeStnList.at(x)).GetAssocMsrCount();
 		freestnlist << std::left << std::setw(10) << u << std::left << std::setw(14) << s << std::left << std::setw(5) << msrCount;
 
 		for (m=0; m<msrCount; m++)
 		{
 			// get the measurement record (holds other stations tied to this measurement)
-			amlindex = vAssocStnList_.at(vfreeStnList_.at(x)).GetAMLStnIndex() + m;	// get the AML index
+			amlindex = vAssocStnList_.at(vfreeStnList.at(x)).GetAMLStnIndex() + m;	// get the AML index
 			freestnlist << std::left << std::setw(HEADER_20) << amlindex;
 		}
 		freestnlist << std::endl;
@@ -1410,8 +2780,8 @@ void dna_segment::coutCurrentBlockSummary(std::ostream &os)
 		SignalExceptionSerialise(e.what(), 0, NULL);
 	}
 	
-	if (!vfreeStnList_.empty())
-		os << "+ Free stations remaining:     " << std::setw(10) << std::right << vfreeStnList_.size() << std::endl;
+	if (!freeStnHeap_.empty())
+		os << "+ Free stations remaining:     " << std::setw(10) << std::right << freeStnHeap_.size() << std::endl;
 	if (!vfreeMsrList_.empty())
 		os << "+ Free measurements remaining: " << std::setw(10) << std::right << vfreeMsrList_.size() << std::endl;
 }
@@ -1478,12 +2848,76 @@ void dna_segment::coutSummary() const
 
 	std::cout << "+ Stations used:       " << std::setw(10) << std::right << stns << std::endl;
 	std::cout << "+ Measurements used:   " << std::setw(10) << std::right << msrs << std::endl;
-	if (!vfreeStnList_.empty())
-		std::cout << "+ Unused stations:     " << std::setw(10) << std::right << vfreeStnList_.size() << std::endl;
+	if (!freeStnHeap_.empty())
+		std::cout << "+ Unused stations:     " << std::setw(10) << std::right << freeStnHeap_.size() << std::endl;
 	//if (!vfreeMsrList_.empty())
 	//	std::cout << "+ Unused measurements: " << std::setw(10) << std::right << vfreeMsrList_.size() << std::endl;
 }
 	
+void dna_segment::coutAnalysis(std::ostream& os) const
+{
+	vblock_analysis_t blocks;
+	segment_analysis_t network;
+	AnalyseSegmentation(blocks, network);
+
+	const UINT16 FLOPS(13);
+
+	os << "+ Segmentation analysis:" << std::endl << std::endl;
+	os << std::left << "  " <<
+		std::setw(STAT-2) << "Block" <<
+		std::setw(STAT-2) << "Network" <<
+		std::setw(STAT) << "Junctions" <<
+		std::setw(STAT) << "Inners" <<
+		std::setw(STAT) << "Params" <<
+		std::setw(STAT) << "Msrs" <<
+		std::setw(STAT) << "Quantities" <<
+		std::setw(STAT) << "Jn ratio" <<
+		std::setw(FLOPS) << "Forward" <<
+		std::setw(FLOPS) << "Reverse" <<
+		std::setw(FLOPS) << "Combine" << std::endl;
+	os << "  ";
+	for (UINT32 i(0), j(STAT*8 - 4 + FLOPS*3); i<j; ++i)
+		os << "-";
+	os << std::endl;
+
+	UINT32 b(1);
+	vblock_analysis_t::const_iterator _it_blk;
+	for (_it_blk=blocks.begin(); _it_blk!=blocks.end(); ++_it_blk, ++b)
+	{
+		os << "  " << std::left << std::fixed <<
+			std::setw(STAT-2) << b <<
+			std::setw(STAT-2) << _it_blk->_network <<
+			std::setw(STAT) << _it_blk->_junctionStations <<
+			std::setw(STAT) << _it_blk->_innerStations <<
+			std::setw(STAT) << _it_blk->_parameters <<
+			std::setw(STAT) << _it_blk->_measurements <<
+			std::setw(STAT) << _it_blk->_msrQuantities <<
+			std::setw(STAT) << std::setprecision(3) << _it_blk->_junctionRatio <<
+			std::scientific << std::setprecision(3) <<
+			std::setw(FLOPS) << _it_blk->_forwardFlops <<
+			std::setw(FLOPS) << _it_blk->_reverseFlops <<
+			std::setw(FLOPS) << _it_blk->_combineFlops << std::fixed << std::endl;
+	}
+
+	os << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Blocks: " << network._blockCount << 
+		" (" << network._networkCount << " contiguous network" << (network._networkCount == 1 ? "" : "s") << ")" << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Station solutions: " << network._stationSolutions << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Junction stations: " << network._junctionStations << 
+		" (ratio " << std::setprecision(3) << network._junctionRatio << ")" << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Largest block (parameters): " << network._maxParameters << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Measurements: " << network._measurements << 
+		" (" << network._msrQuantities << " quantities)" << std::endl;
+	os << std::scientific << std::setprecision(3);
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Forward pass flops: " << network._forwardFlops << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Reverse pass flops: " << network._reverseFlops << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Combination flops: " << network._combineFlops << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Total flops: " << network._totalFlops << std::endl;
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Critical path flops: " << network._criticalPathFlops << std::endl;
+	os << std::fixed << std::setprecision(2);
+	os << std::setw(PRINT_VAR_PAD) << std::left << "  Parallelism: " << network._parallelism << std::endl << std::endl;
+}
+	
 void dna_segment::WriteSegmentedNetwork(const std::string& segfileName)
 {
 	if (bstBinaryRecords_.empty())
@@ -1504,7 +2938,9 @@ void dna_segment::WriteSegmentedNetwork(const std::string& segfileName)
 			projectSettings_.s.seg_starting_stns, vinitialStns_,
 			projectSettings_.s.command_line_arguments, 
 			vISL_, vJSL_, vCML_,
-			v_ContiguousNetList_, &bstBinaryRecords_, &bmsBinaryRecords_);
+			v_ContiguousNetList_, &bstBinaryRecords_, &bmsBinaryRecords_,
+			(vBlockCosts_.empty() ? NULL : &vBlockCosts_),
+			(resegmentedBlocks_.empty() ? "" : projectSettings_.s.seg_previous_file), resegmentedBlocks_);
 	}
 	catch (const std::runtime_error& e) {
 		SignalExceptionSerialise(e.what(), 0, NULL);
@@ -37,6 +37,7 @@
 #include <vector>
 #include <map>
 #include <cstdarg>
+#include <climits>
 #include <math.h>
 
 #include <boost/shared_ptr.hpp>
@@ -44,6 +45,7 @@
 #include <boost/timer/timer.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
 
 #include <include/config/dnaexports.hpp>
 #include <include/config/dnaversion.hpp>
@@ -52,7 +54,10 @@
 #include <include/functions/dnatemplatestnmsrfuncs.hpp>
 #include <include/functions/dnatemplatedatetimefuncs.hpp>
 #include <include/functions/dnaiostreamfuncs.hpp>
+#include <include/functions/dnafilepathfuncs.hpp>
 #include <include/functions/dnastringfuncs.hpp>
+#include <include/functions/dnaindexedheap.hpp>
+#include <include/functions/dnaparallelfuncs.hpp>
 #include <include/config/dnatypes.hpp>
 #include <include/config/dnaconsts.hpp>
 
@@ -63,6 +68,9 @@
 #include <include/io/dnaiomap.hpp>
 #include <include/io/dnaioseg.hpp>
 
+#include <dynadjust/dnasegment/dnagraphpartition.hpp>
+#include <dynadjust/dnasegment/dnasegmentcost.hpp>
+
 using namespace dynadjust::measurements;
 using namespace dynadjust::exception;
 using namespace dynadjust::iostreams;
@@ -102,8 +110,30 @@ public:
 	inline UINT32 stationSolutionCount() const { return stationSolutionCount_; }
 	inline UINT32 maxBlockSize() const { return maxBlockSize_; }
 	inline UINT32 minBlockSize() const { return minBlockSize_; }
+	UINT32 junctionStationCount() const;
+
+	// Predicts the cost of adjusting each block.  If measure is true, the
+	// matrix kernels of a sample of blocks are also timed on this host.
+	void EstimateBlockCosts(const dna_segment_cost& costModel, bool measure=false);
+	inline const vblockCost_t& BlockCosts() const { return vBlockCosts_; }
+
+	// Computes the size and dense flops of each block, and the totals for
+	// the network (see segment_analysis_t)
+	void AnalyseSegmentation(vblock_analysis_t& blocks, segment_analysis_t& network) const;
+
+	// Segments the network using a range of block size thresholds, and
+	// adopts the threshold with the lowest predicted adjustment time
+	// (on p->s.target_threads threads) within p->s.target_memory.
+	static void SelectBlockSize(project_settings* p, const dna_segment_cost& costModel,
+		vblock_size_trial_t& trials);
+
+	// Outcome of an incremental segmentation (see SegmentNetworkIncremental).
+	// If the previous segmentation could not be used, the warning explains why.
+	inline const std::string& ResegmentedBlocks() const { return resegmentedBlocks_; }
+	inline const std::string& IncrementalWarning() const { return incrementalWarning_; }
 	
 	void coutSummary() const;
+	void coutAnalysis(std::ostream& os) const;
 	void coutCurrentBlockSummary(std::ostream &os);
 
 
@@ -123,21 +153,62 @@ public:
 	inline _SEGMENT_STATUS_ GetStatus() const { return segmentStatus_; }
 
 private:
+	// Station lists ordered by the number of (unconsumed) measurements
+	// connected to each station.  See CompareMeasCount.
+	typedef indexed_min_heap<CompareMeasCount<CAStationList, UINT32> > stn_heap_t;
+
+	// An isolated network, segmented independently of the other
+	// isolated networks.  See SegmentNetworkComponents.
+	typedef struct {
+		vUINT32		_stations;			// network stations, in station order
+		vUINT32		_measurements;		// binary measurement records, in record order
+		boost::shared_ptr<dna_segment>	_segment;
+	} network_component_t;
+
+	typedef std::vector<network_component_t> vnetwork_component_t;
+
+	// Compact view of a binary measurement record, holding what the
+	// segmentation loops need to know about it.  See BuildMeasurementView.
+	typedef struct {
+		UINT32		_firstIndex;		// first record of the measurement (see GetFirstMsrIndex)
+		UINT32		_stnOffset;			// stations associated with the measurement (see GetMsrStations),
+		UINT32		_stnCount;			// held in vMsrViewStations_
+		bool		_first;				// starting element of a measurement (see measStart)
+		bool		_ignore;
+	} msr_view_t;
+
+	typedef std::vector<msr_view_t> vmsr_view_t;
+	typedef vmsr_view_t::iterator _it_msr_view;
+
 	void SignalExceptionSerialise(const std::string& msg, const int& i, const char *streamType, ...);
 	void ParseStartingStations();
 	void BuildFirstBlock();
 	void BuildNextBlock();
 	void FinaliseBlock();
-
-	void SortbyMeasurementCount(pvUINT32 vStnList);
+	void AddCurrentBlock();
+
+	void SegmentNetworkGreedy();
+	void SegmentNetworkMultilevel();
+	bool SegmentNetworkComponents();
+	bool FindNetworkComponents(vnetwork_component_t& vComponents);
+	void SegmentComponent(const dna_segment& network, network_component_t& component);
+	bool SegmentNetworkIncremental();
+	UINT32 ReGrowBlocks(const vvUINT32& vMsrStations, const UINT32& rangeFirst,
+		const UINT32& rangeLast, const UINT32& maxBlockSize, vUINT32& msrBlock);
+	void GetFreeStationMeasurements(vUINT32& vMsrAMLIndex, vvUINT32& vMsrStations);
+	void BuildMeasurementView();
+
+	UINT32 LowestMeasurementCountStation(const stn_heap_t& stnHeap);
+	void SortbyMeasurementCount(vUINT32& vStnList);
 
 	UINT32 SelectInner();
 	void SelectJunction();
 	
-	it_vUINT32 MoveStation(vUINT32& fromList, it_vUINT32 it_from, vUINT32& toList, const UINT32& stn_index);
-	void MoveFreeStn(it_vUINT32 it_freeisl, vUINT32& toList, const UINT32& stn_index, const std::string& type);
-	void MoveFreeStnToInnerList(it_vUINT32 it_freeisl, const UINT32& stn_index);
-	void MoveFreeStnToJunctionList(it_vUINT32 it_freeisl, const UINT32& stn_index);
+	void MoveJunctionStnToInnerList(const UINT32& stn_index);
+	void MoveFreeStn(const UINT32& stn_index, const std::string& type);
+	void MoveFreeStnToInnerList(const UINT32& stn_index);
+	void MoveFreeStnToJunctionList(const UINT32& stn_index);
+	void DecrementMsrCount(const UINT32& stn_index);
 
 	//bool IncrementNextAvailableAMLIndex(UINT32& amlIndex, const UINT32& lastamlIndex);
 	//bool IncrementNextAvailableAMLIndex(it_aml_pair& _it_aml, const it_aml_pair& _it_lastaml);
@@ -145,16 +216,18 @@ private:
 	void IdentifyLowestStationAssociation(pvUINT32 vStnList, vUINT32& totalStations,const int currentLevel, const int maxLevel, pvUINT32 vStnCount);
 	void IdentifyInnerMsrsandAssociatedStns(const UINT32& innerStation, vUINT32& totalStations);
 	void AddtoJunctionStnList(const vUINT32& msrStations);
+	void AddtoJunctionStnList(it_vUINT32_const _it_first, it_vUINT32_const _it_last);
 	//void AddtoJunctionStnList_sortedbyMsrCount(measurement_t* msr, const UINT32& innerStation);
 	//void AddtoJunctionStnList_sortedbyName(measurement_t* msr, const UINT32& innerStation);
 	bool AddtoCurrentMsrList(const UINT32& amlindex, const vUINT32& msrStations);
+	bool AddtoCurrentMsrList(const UINT32& amlindex, it_vUINT32_const _it_first, it_vUINT32_const _it_last);
 	UINT32 GetAvailableMsrCount(const UINT32& stn_index);
 	void FindCommonMeasurements();
 	//void MoveJuncttoInnerStnList();
 	void MoveJunctiontoISL();
 	void SetAvailableMsrCount();
 	void RemoveDuplicateStations(pvstring vStations);
-	void RemoveInvalidFreeStations();
+	void RemoveInvalidFreeStations(vUINT32& vfreeStnList);
 	//void RemoveNonMeasurements();
 	//void RemoveIgnoredMeasurements();
 	void BuildFreeStationAvailabilityList();
@@ -172,6 +245,7 @@ private:
 	bool				isProcessing_;
 	UINT32				currentBlock_;
 	UINT32				currentNetwork_;			// current contiguous network ID
+	bool				componentsFollow_;			// isolated networks are segmented after this one (see SegmentNetworkComponents)
 
 	std::string				network_name_;				// network name
 	UINT16				debug_level_;
@@ -184,7 +258,8 @@ private:
 	// block vectors
 	vstring					vinitialStns_;
 	vUINT32					v_ContiguousNetList_;	// vector of contiguous network IDs (corresponding to each block)
-	vUINT32					vCurrJunctStnList_;
+	stn_heap_t				currJunctStnHeap_;		// junction stations for the current block
+	vUINT32					vCurrJunctStnList_;		// sorted copy of currJunctStnHeap_, created by FinaliseBlock
 	vUINT32					vCurrInnerStnList_;
 	vUINT32					vCurrMeasurementList_;
 	
@@ -194,15 +269,24 @@ private:
 	vUINT32					vASLCount_;
 	vUINT32					vAssocMsrList_;
 	v_aml_pair				vAssocFreeMsrList_;
-	vUINT32					vfreeStnList_;
+	stn_heap_t				freeStnHeap_;			// stations not yet added to a block
+	UINT32					startingStn_;			// station with the lowest measurement count on load
 	vUINT32					vfreeMsrList_;			// vAssocMsrList_, less non-measurements and duplicate measurement references, sorted by ClusterID.
 	v_string_uint32_pair	stnsMap_;
 
 	v_freestn_pair			vfreeStnAvailability_;
+
+	vmsr_view_t				vMsrView_;				// compact view of bmsBinaryRecords_ (see BuildMeasurementView)
+	vUINT32					vMsrViewStations_;		// stations associated with each measurement in vMsrView_
+	vbool					vCurrBlockStns_;		// stations in the current block (see FindCommonMeasurements)
 	
 	vvUINT32				vJSL_;
 	vvUINT32				vISL_;
 	vvUINT32				vCML_;
+	vblockCost_t			vBlockCosts_;			// predicted cost of each block (see EstimateBlockCosts)
+
+	std::string				resegmentedBlocks_;		// blocks re-grown by SegmentNetworkIncremental
+	std::string				incrementalWarning_;	// reason the previous segmentation was not used
 
 	std::ofstream				debug_file;
 	std::ofstream				trace_file;
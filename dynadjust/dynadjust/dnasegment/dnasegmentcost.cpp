@@ -0,0 +1,269 @@
+//============================================================================
+// Name         : dnasegmentcost.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Block cost model for network segmentation
+//============================================================================
+
+#include <dynadjust/dnasegment/dnasegmentcost.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <include/config/dnaconsts.hpp>
+#include <include/math/dnamatrix_backend.hpp>
+
+using namespace dynadjust::math;
+
+namespace dynadjust {
+namespace networksegment {
+
+// Order of the matrices timed by Calibrate
+const UINT32 CALIBRATION_ORDER = 384;
+const UINT32 CALIBRATION_REPEATS = 2;
+// Order of the matrices used to time the fixed overhead of a kernel call
+const UINT32 OVERHEAD_ORDER = 6;
+const UINT32 OVERHEAD_REPEATS = 32;
+// Order of matrix for which each additional kernel thread is of use.
+// Kernels on smaller matrices do not benefit from more threads.
+const UINT32 KERNEL_THREAD_GRAIN = 64;
+
+const double BYTES_PER_MB = 1048576.;
+
+namespace {
+
+// Creates a symmetric, diagonally dominant (and therefore positive
+// definite) matrix of order n
+void FormTestNormals(const UINT32& n, std::vector<double>& a)
+{
+	a.assign(static_cast<std::size_t>(n) * n, 0.);
+	for (UINT32 j(0); j<n; ++j)
+		for (UINT32 i(0); i<n; ++i)
+			a[static_cast<std::size_t>(j) * n + i] = (i == j ? n : 1. / (1. + (i > j ? i - j : j - i)));
+}
+
+// Seconds taken to invert the normals of order n
+double TimeInversion(const UINT32& n)
+{
+	if (n == 0)
+		return 0.;
+
+	std::vector<double> a;
+	FormTestNormals(n, a);
+
+	boost::timer::cpu_timer time;
+	if (matrix_backend::dpotrf('L', n, &a[0], n) != 0 ||
+		matrix_backend::dpotri('L', n, &a[0], n) != 0)
+		throw boost::enable_current_exception(std::runtime_error("TimeInversion(): The test matrix could not be inverted."));
+	return time.elapsed().wall / 1.e9;
+}
+
+// Seconds taken to multiply an m x k matrix by a k x n matrix
+double TimeMultiplication(const UINT32& m, const UINT32& n, const UINT32& k)
+{
+	if (m == 0 || n == 0 || k == 0)
+		return 0.;
+
+	std::vector<double> a(static_cast<std::size_t>(m) * k, 0.5), b(static_cast<std::size_t>(k) * n, 0.25),
+		c(static_cast<std::size_t>(m) * n, 0.);
+
+	boost::timer::cpu_timer time;
+	matrix_backend::dgemm("N", "N", m, n, k, 1., &a[0], m, &b[0], k, 0., &c[0], m);
+	return time.elapsed().wall / 1.e9;
+}
+
+}	// namespace
+
+
+dna_segment_cost::dna_segment_cost()
+	: calibrated_(false)
+	, backendName_("")
+	, backendThreads_(1)
+	, inversionSecondsPerFlop_(0.)
+	, multiplicationSecondsPerFlop_(0.)
+	, kernelOverhead_(0.)
+{
+}
+
+
+void dna_segment_cost::Calibrate()
+{
+	backendName_ = matrix_backend::name();
+	backendThreads_ = matrix_backend::max_threads();
+
+	const double n(CALIBRATION_ORDER);
+	double inversion(0.), multiplication(0.), t;
+
+	// Take the fastest of each, so that the rates are not
+	// affected by first-call overheads (e.g. thread start up)
+	for (UINT32 r(0); r<CALIBRATION_REPEATS; ++r)
+	{
+		t = TimeInversion(CALIBRATION_ORDER);
+		if (r == 0 || t < inversion)
+			inversion = t;
+		t = TimeMultiplication(CALIBRATION_ORDER, CALIBRATION_ORDER, CALIBRATION_ORDER);
+		if (r == 0 || t < multiplication)
+			multiplication = t;
+	}
+
+	// Convert to the time taken by one thread.  dpotrf + dpotri
+	// take n^3 flops, dgemm takes 2n^3 flops.
+	const double threads(EffectiveThreads(CALIBRATION_ORDER, backendThreads_));
+	inversionSecondsPerFlop_ = std::max(inversion, PRECISION_1E15) * threads / (n * n * n);
+	multiplicationSecondsPerFlop_ = std::max(multiplication, PRECISION_1E15) * threads / (2. * n * n * n);
+
+	// Time taken by (dpotrf + dpotri) on a tiny matrix, which
+	// is almost entirely the overhead of calling the kernels
+	kernelOverhead_ = 0.;
+	for (UINT32 r(0); r<OVERHEAD_REPEATS; ++r)
+	{
+		t = TimeInversion(OVERHEAD_ORDER) / 2.;
+		if (r == 0 || t < kernelOverhead_)
+			kernelOverhead_ = t;
+	}
+
+	calibrated_ = true;
+}
+
+
+double dna_segment_cost::InversionRate() const
+{
+	return 1. / inversionSecondsPerFlop_;
+}
+
+
+double dna_segment_cost::MultiplicationRate() const
+{
+	return 1. / multiplicationSecondsPerFlop_;
+}
+
+
+double dna_segment_cost::EffectiveThreads(const UINT32& n, const UINT32& threads) const
+{
+	return static_cast<double>(std::max(1U, std::min(threads, n / KERNEL_THREAD_GRAIN)));
+}
+
+
+// Forward (or reverse) pass: invert the normals, and the variances
+// of the junctions carried to the next block (four kernel calls)
+double dna_segment_cost::PassTime(const blockCost_t& blockCost, const UINT32& threads) const
+{
+	const double p(blockCost._parameters), q(blockCost._junctionParameters);
+	return 4. * kernelOverhead_ + 
+		p * p * p * inversionSecondsPerFlop_ / EffectiveThreads(blockCost._parameters, threads) +
+		q * q * q * inversionSecondsPerFlop_ / EffectiveThreads(blockCost._junctionParameters, threads);
+}
+
+
+// Combination: invert the normals, and update the estimates with
+// the forward and reverse junction estimates (three kernel calls)
+double dna_segment_cost::CombineTime(const blockCost_t& blockCost, const UINT32& threads) const
+{
+	const double p(blockCost._parameters), q(blockCost._junctionParameters);
+	return 3. * kernelOverhead_ + 
+		(p * p * p * inversionSecondsPerFlop_ + 2. * p * p * q * multiplicationSecondsPerFlop_) /
+		EffectiveThreads(blockCost._parameters, threads);
+}
+
+
+void dna_segment_cost::PredictBlock(blockCost_t& blockCost) const
+{
+	const double p(blockCost._parameters), q(blockCost._junctionParameters), r(blockCost._measurements);
+
+	blockCost._predictedTime = 2. * PassTime(blockCost, backendThreads_) + CombineTime(blockCost, backendThreads_);
+	blockCost._memory = sizeof(double) * (2. * p * p + 2. * r * p + 2. * q * q) / BYTES_PER_MB;
+}
+
+
+void dna_segment_cost::MeasureBlock(blockCost_t& blockCost) const
+{
+	// forward and reverse passes
+	blockCost._measuredTime = 2. * (TimeInversion(blockCost._parameters) + 
+		TimeInversion(blockCost._junctionParameters));
+
+	// combination
+	blockCost._measuredTime += TimeInversion(blockCost._parameters);
+	blockCost._measuredTime += TimeMultiplication(blockCost._parameters, blockCost._junctionParameters, blockCost._parameters);
+}
+
+
+double dna_segment_cost::PredictAdjustment(const vblockCost_t& blockCosts, const UINT32& threads,
+	COST_ADJUST_MODE& mode) const
+{
+	double single(0.), pass(0.), combine(0.), maxCombine(0.), t;
+	const UINT32 passThreads(std::max(1U, threads / 2));
+
+	vblockCost_t::const_iterator _it_blk;
+	for (_it_blk=blockCosts.begin(); _it_blk!=blockCosts.end(); ++_it_blk)
+	{
+		// Single thread: forward, reverse and combination run in
+		// sequence, each kernel using all threads
+		single += 2. * PassTime(*_it_blk, threads) + CombineTime(*_it_blk, threads);
+
+		// Multi-thread: the forward and reverse passes run concurrently,
+		// sharing the threads.  Blocks are then combined concurrently,
+		// each on one thread.
+		pass += PassTime(*_it_blk, passThreads);
+		t = CombineTime(*_it_blk, 1);
+		combine += t;
+		maxCombine = std::max(maxCombine, t);
+	}
+
+	mode = COST_SINGLE_THREAD;
+	if (threads < 2)
+		return single;
+
+	const double multi(pass + std::max(maxCombine, combine / threads));
+	if (multi < single)
+	{
+		mode = COST_MULTI_THREAD;
+		return multi;
+	}
+	return single;
+}
+
+
+double dna_segment_cost::PredictMemory(const vblockCost_t& blockCosts) const
+{
+	double memory(0.);
+	vblockCost_t::const_iterator _it_blk;
+	for (_it_blk=blockCosts.begin(); _it_blk!=blockCosts.end(); ++_it_blk)
+		memory += _it_blk->_memory;
+	return memory;
+}
+
+
+double dna_segment_cost::PassFlops(const UINT32& p, const UINT32& q)
+{
+	const double P(p), Q(q);
+	return P * P * P + Q * Q * Q;
+}
+
+
+double dna_segment_cost::CombineFlops(const UINT32& p, const UINT32& q)
+{
+	const double P(p), Q(q);
+	return P * P * P + 2. * P * P * Q;
+}
+
+}	// namespace networksegment
+}	// namespace dynadjust
@@ -0,0 +1,170 @@
+//============================================================================
+// Name         : dnasegmentcost.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Block cost model for network segmentation
+//                Predicts the time and memory required to adjust a block
+//                in a phased adjustment, from the number of parameters (p),
+//                junction parameters (q) and measurements (r) in the block:
+//                  - forward and reverse passes: invert the normals
+//                    (dpotrf + dpotri, p^3 flops) and the variances of the
+//                    junctions carried to the next block (q^3 flops)
+//                  - combination: invert the normals and update the junction
+//                    estimates (dgemm, 2p^2q flops)
+//                  - memory: normals and variances (2p^2), design and AtV-1
+//                    matrices (2rp), forward and reverse junction variances (2q^2)
+//                The rates used by the model, and the fixed overhead of each
+//                kernel call, are calibrated by timing the kernels of the
+//                current matrix backend on this host.
+//============================================================================
+
+#ifndef DNASEGMENTCOST_H_
+#define DNASEGMENTCOST_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <string>
+#include <vector>
+
+#include <include/config/dnatypes.hpp>
+
+namespace dynadjust {
+namespace networksegment {
+
+// Phased adjustment mode for which a prediction was made
+typedef enum _COST_ADJUST_MODE_
+{
+	COST_SINGLE_THREAD = 0,
+	COST_MULTI_THREAD = 1
+} COST_ADJUST_MODE;
+
+// Outcome of segmenting a network with one block size threshold
+typedef struct {
+	UINT32	_maxTotalStations;		// block size threshold
+	UINT32	_minInnerStations;		// minimum inner stations
+	UINT32	_blockCount;
+	UINT32	_junctionCount;
+	double	_predictedTime;			// predicted adjustment time (s)
+	double	_memory;				// predicted memory (MB)
+	COST_ADJUST_MODE	_mode;
+	bool	_withinBudget;
+} block_size_trial_t;
+
+typedef std::vector<block_size_trial_t> vblock_size_trial_t;
+
+// Size and dense flops of a block (see dna_segment::AnalyseSegmentation)
+typedef struct {
+	UINT32	_network;				// contiguous network ID
+	UINT32	_innerStations;
+	UINT32	_junctionStations;
+	UINT32	_parameters;			// three per inner and junction station
+	UINT32	_measurements;			// measurements (and clusters)
+	UINT32	_msrQuantities;			// measurement quantities
+	double	_junctionRatio;			// junction stations / all stations in the block
+	double	_forwardFlops;			// forward pass, carrying the block's junctions
+	double	_reverseFlops;			// reverse pass, carrying the previous block's junctions
+	double	_combineFlops;			// combination
+} block_analysis_t;
+
+typedef std::vector<block_analysis_t> vblock_analysis_t;
+
+// Totals for all blocks of a segmented network.  The critical path is
+// the flops of a multi-thread phased adjustment with unlimited threads: 
+// the forward and reverse passes run concurrently, after which all 
+// blocks are combined concurrently.
+typedef struct {
+	UINT32	_blockCount;
+	UINT32	_networkCount;			// contiguous networks
+	UINT32	_stationSolutions;		// inner and junction stations of all blocks
+	UINT32	_junctionStations;
+	UINT32	_maxParameters;
+	UINT32	_measurements;
+	UINT32	_msrQuantities;
+	double	_junctionRatio;			// junction stations / station solutions
+	double	_forwardFlops;
+	double	_reverseFlops;
+	double	_combineFlops;
+	double	_totalFlops;			// forward, reverse and combination
+	double	_criticalPathFlops;
+	double	_parallelism;			// total flops / critical path flops
+} segment_analysis_t;
+
+class dna_segment_cost {
+public:
+	dna_segment_cost();
+
+private:
+	// Disallow use of compiler generated functions. See dnaadjust.hpp
+	dna_segment_cost(const dna_segment_cost&);
+	dna_segment_cost& operator=(const dna_segment_cost&);
+
+public:
+	// Times dpotrf/dpotri and dgemm using the current matrix backend.
+	void Calibrate();
+
+	inline bool isCalibrated() const { return calibrated_; }
+	inline UINT32 backendThreads() const { return backendThreads_; }
+	inline const std::string& backendName() const { return backendName_; }
+
+	// Rate (flops per second) of each thread during calibration
+	double InversionRate() const;
+	double MultiplicationRate() const;
+	inline double KernelOverhead() const { return kernelOverhead_; }
+
+	// Predicts the cost of a block adjusted (single thread) with the
+	// backend's thread count.  blockCost must hold the block dimensions.
+	void PredictBlock(blockCost_t& blockCost) const;
+
+	// Times the block's matrix kernels at its dimensions on this host
+	void MeasureBlock(blockCost_t& blockCost) const;
+
+	// Predicts the time to adjust all blocks with the given number of
+	// threads.  Returns the lower of the single and multi-thread phased
+	// adjustment times, and the mode to which it applies.
+	double PredictAdjustment(const vblockCost_t& blockCosts, const UINT32& threads,
+		COST_ADJUST_MODE& mode) const;
+
+	// Total memory (MB) required by all blocks held in memory
+	double PredictMemory(const vblockCost_t& blockCosts) const;
+
+	// Dense flops of a forward or reverse pass of a block with p parameters, 
+	// carrying q junction parameters to the next block, and of its combination
+	static double PassFlops(const UINT32& p, const UINT32& q);
+	static double CombineFlops(const UINT32& p, const UINT32& q);
+
+private:
+	double PassTime(const blockCost_t& blockCost, const UINT32& threads) const;
+	double CombineTime(const blockCost_t& blockCost, const UINT32& threads) const;
+	double EffectiveThreads(const UINT32& n, const UINT32& threads) const;
+
+	bool	calibrated_;
+	std::string	backendName_;
+	UINT32	backendThreads_;
+	double	inversionSecondsPerFlop_;		// per thread
+	double	multiplicationSecondsPerFlop_;	// per thread
+	double	kernelOverhead_;				// seconds per kernel call
+};
+
+}	// namespace networksegment
+}	// namespace dynadjust
+
+#endif /* DNASEGMENTCOST_H_ */
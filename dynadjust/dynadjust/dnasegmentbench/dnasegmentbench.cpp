@@ -0,0 +1,405 @@
+//============================================================================
+// Name         : dnasegmentbench.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Network segmentation benchmark
+//                Segments imported networks (e.g. the sample networks, once
+//                imported by dnaimport) and synthetic grid networks at a range
+//                of block size thresholds, and records for each run the time
+//                taken to load and segment the network, and the block
+//                structure metrics of dna_segment::AnalyseSegmentation:
+//                  - blocks, junction stations and junction ratio
+//                  - largest block (parameters)
+//                  - predicted dense flops (forward, reverse and combination)
+//                  - critical path flops of a multi-thread phased adjustment
+//============================================================================
+
+#include <dynadjust/dnasegment/dnasegment.hpp>
+
+#include <cstdio>
+#include <random>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <boost/timer/timer.hpp>
+
+using namespace dynadjust;
+using namespace dynadjust::networksegment;
+
+typedef struct {
+	std::string network;
+	UINT32 stations;
+	UINT32 maxTotalStations;
+	UINT32 minInnerStations;
+	double load_ms;
+	double segment_ms;
+	segment_analysis_t analysis;
+} bench_result;
+
+double elapsed_ms(const boost::timer::cpu_timer& time)
+{
+	return time.elapsed().wall / 1.0e6;
+}
+
+// Writes the binary station, measurement, association and map files of a
+// rows x cols grid network.  Adjacent stations are connected by distances,
+// one in three vertical connections is a GNSS baseline, and one in four
+// grid cells has a diagonal distance.
+void create_grid_network(const std::string& network, const UINT32 rows, const UINT32 cols)
+{
+	const UINT32 stations(rows * cols);
+	vstn_t bstRecords(stations);
+	vmsr_t bmsRecords;
+	std::mt19937 rng(stations);
+
+	UINT32 stn, r, c, cluster(0);
+	char stationName[STN_NAME_WIDTH];
+
+	for (stn=0; stn<stations; ++stn)
+	{
+		snprintf(stationName, STN_NAME_WIDTH, "GRID%07u", stn);
+		strcpy(bstRecords.at(stn).stationName, stationName);
+		bstRecords.at(stn).fileOrder = stn;
+	}
+
+	auto add_measurement = [&](const char type, const UINT32 stn1, const UINT32 stn2) {
+		measurement_t msr;
+		msr.measType = type;
+		msr.station1 = stn1;
+		msr.station2 = stn2;
+		msr.measurementStations = TWO_STATION;
+		msr.clusterID = cluster++;
+
+		if (type != 'G')
+		{
+			msr.measStart = xMeas;
+			msr.fileOrder = static_cast<UINT32>(bmsRecords.size());
+			bmsRecords.push_back(msr);
+			return;
+		}
+
+		// X, Y and Z elements of a GNSS baseline
+		msr.vectorCount1 = 1;
+		for (UINT32 e(xMeas); e<=zMeas; ++e)
+		{
+			msr.measStart = static_cast<char>(e);
+			msr.fileOrder = static_cast<UINT32>(bmsRecords.size());
+			bmsRecords.push_back(msr);
+		}
+	};
+
+	for (r=0; r<rows; ++r)
+	{
+		for (c=0; c<cols; ++c)
+		{
+			stn = r * cols + c;
+			if (c + 1 < cols)
+				add_measurement('S', stn, stn + 1);
+			if (r + 1 < rows)
+				add_measurement(rng() % 3 == 0 ? 'G' : 'S', stn, stn + cols);
+			if (c + 1 < cols && r + 1 < rows && rng() % 4 == 0)
+				add_measurement('S', stn, stn + cols + 1);
+		}
+	}
+
+	// Associated measurements of each station
+	vvUINT32 stnMsrs(stations);
+	UINT32 bmsIndex(0);
+	for (it_vmsr_t_const _it_msr(bmsRecords.begin()); _it_msr!=bmsRecords.end(); ++_it_msr, ++bmsIndex)
+	{
+		if (_it_msr->measStart != xMeas)
+			continue;
+		stnMsrs.at(_it_msr->station1).push_back(bmsIndex);
+		stnMsrs.at(_it_msr->station2).push_back(bmsIndex);
+	}
+
+	vUINT32 vAML;
+	vASLPtr vASL;
+	v_string_uint32_pair vStnMap;
+	for (stn=0; stn<stations; ++stn)
+	{
+		ASLPtr asl(new CAStationList(true));
+		*asl->GetAssocMsrCountPtr() = static_cast<UINT32>(stnMsrs.at(stn).size());
+		*asl->GetAMLStnIndexPtr() = static_cast<UINT32>(vAML.size());
+		*asl->ValidityPtr() = (stnMsrs.at(stn).empty() ? INVALID_STATION : VALID_STATION);
+		vAML.insert(vAML.end(), stnMsrs.at(stn).begin(), stnMsrs.at(stn).end());
+		vASL.push_back(asl);
+		vStnMap.push_back(string_uint32_pair(bstRecords.at(stn).stationName, stn));
+	}
+	std::sort(vStnMap.begin(), vStnMap.end());
+
+	binary_file_meta_t bst_meta("dnasegmentbench"), bms_meta("dnasegmentbench");
+	bst_meta.binCount = stations;
+	bms_meta.binCount = static_cast<UINT32>(bmsRecords.size());
+
+	dna_io_bst bst;
+	bst.write_bst_file(network + ".bst", &bstRecords, bst_meta);
+	dna_io_bms bms;
+	bms.write_bms_file(network + ".bms", &bmsRecords, bms_meta);
+	dna_io_asl asl;
+	asl.write_asl_file(network + ".asl", &vASL);
+	dna_io_aml aml;
+	aml.write_aml_file(network + ".aml", &vAML);
+	dna_io_map map;
+	map.write_map_file(network + ".map", &vStnMap);
+}
+
+// Segments a network, taking the fastest of repeat runs
+bench_result run_benchmark(project_settings& p, const UINT32 repeat)
+{
+	bench_result result;
+	result.network = p.g.network_name;
+	result.maxTotalStations = p.s.max_total_stations;
+	result.minInnerStations = p.s.min_inner_stations;
+
+	vblock_analysis_t blocks;
+
+	for (UINT32 run(0); run<repeat; ++run)
+	{
+		dna_segment netSegment;
+		netSegment.InitialiseSegmentation();
+
+		boost::timer::cpu_timer time;
+		netSegment.PrepareSegmentation(&p);
+		double load_ms(elapsed_ms(time));
+
+		time.start();
+		netSegment.SegmentNetwork(&p);
+		double segment_ms(elapsed_ms(time));
+
+		if (run == 0 || load_ms < result.load_ms)
+			result.load_ms = load_ms;
+		if (run == 0 || segment_ms < result.segment_ms)
+			result.segment_ms = segment_ms;
+
+		if (run == 0)
+			netSegment.AnalyseSegmentation(blocks, result.analysis);
+	}
+
+	// Each station is an inner station of one block
+	result.stations = result.analysis._stationSolutions - result.analysis._junctionStations;
+	return result;
+}
+
+void print_result(std::ostream& os, const bench_result& result)
+{
+	os << std::setw(20) << std::left << result.network <<
+		std::setw(10) << std::right << result.stations <<
+		std::setw(8) << std::right << result.maxTotalStations <<
+		std::setw(8) << std::right << result.minInnerStations <<
+		std::setw(8) << std::right << result.analysis._blockCount <<
+		std::setw(11) << std::right << result.analysis._junctionStations <<
+		std::setw(10) << std::right << std::fixed << std::setprecision(3) << result.analysis._junctionRatio <<
+		std::setw(10) << std::right << result.analysis._maxParameters <<
+		std::setw(12) << std::right << std::scientific << std::setprecision(3) << result.analysis._totalFlops <<
+		std::setw(12) << std::right << result.analysis._criticalPathFlops <<
+		std::setw(9) << std::right << std::fixed << std::setprecision(2) << result.analysis._parallelism <<
+		std::setw(11) << std::right << std::setprecision(1) << result.load_ms <<
+		std::setw(11) << std::right << result.segment_ms << std::endl;
+}
+
+void print_csv_result(std::ostream& os, const bench_result& result)
+{
+	os << result.network << "," << result.stations << "," <<
+		result.maxTotalStations << "," << result.minInnerStations << "," <<
+		result.analysis._blockCount << "," << result.analysis._networkCount << "," <<
+		result.analysis._junctionStations << "," << std::fixed << std::setprecision(4) << result.analysis._junctionRatio << "," <<
+		result.analysis._maxParameters << "," << result.analysis._measurements << "," << result.analysis._msrQuantities << "," <<
+		std::scientific << std::setprecision(6) <<
+		result.analysis._forwardFlops << "," << result.analysis._reverseFlops << "," << result.analysis._combineFlops << "," <<
+		result.analysis._totalFlops << "," << result.analysis._criticalPathFlops << "," <<
+		std::fixed << std::setprecision(4) << result.analysis._parallelism << "," <<
+		std::setprecision(3) << result.load_ms << "," << result.segment_ms << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string networks_str, synthetic_str("100x100,300x300");
+	std::string thresholds_str("50,100,150,300,500");
+	std::string csv_file, partitioner("greedy");
+	std::string input_folder("."), output_folder(".");
+	UINT32 min_inner_stations(0);
+	UINT16 force_contiguous_blocks(1);
+	UINT32 repeat(3);
+
+	boost::program_options::options_description options("Options");
+	options.add_options()
+		("help,h", "Show this help message.")
+		("networks,n", boost::program_options::value<std::string>(&networks_str),
+			"Comma delimited list of imported networks to segment.  The binary, association and map files of each network must exist in the input folder.")
+		("synthetic,g", boost::program_options::value<std::string>(&synthetic_str),
+			(std::string("Comma delimited list of synthetic grid networks (rows x columns) to create and segment.  Default is ") +
+			synthetic_str + std::string(".")).c_str())
+		("max-block-stns,m", boost::program_options::value<std::string>(&thresholds_str),
+			(std::string("Comma delimited list of block size thresholds.  Default is ") +
+			thresholds_str + std::string(".")).c_str())
+		("min-inner-stns", boost::program_options::value<UINT32>(&min_inner_stations),
+			"Minimum number of inner stations within each block.  Default is the block size threshold.")
+		("partitioner", boost::program_options::value<std::string>(&partitioner),
+			"Segmentation strategy (greedy or multilevel).  Default is greedy.")
+		("contiguous-blocks", boost::program_options::value<UINT16>(&force_contiguous_blocks),
+			"Treatment of isolated networks (0: individual blocks, 1: contiguous blocks).  Default is 1.")
+		("input-folder,i", boost::program_options::value<std::string>(&input_folder),
+			"Path containing the imported networks.")
+		("output-folder,o", boost::program_options::value<std::string>(&output_folder),
+			"Path for the synthetic networks.")
+		("repeat,r", boost::program_options::value<UINT32>(&repeat),
+			"Number of times each network is segmented.  The fastest time is reported.  Default is 3.")
+		("csv", boost::program_options::value<std::string>(&csv_file),
+			"Also record the results (and all metrics) in the csv file arg.")
+		;
+
+	boost::program_options::variables_map vm;
+
+	try {
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, options), vm);
+		boost::program_options::notify(vm);
+	}
+	catch (const std::exception& e) {
+		std::cout << "- Error: " << e.what() << std::endl << options << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (vm.count("help"))
+	{
+		std::cout << "Usage: dnasegmentbench [options]" << std::endl << options << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	if (repeat < 1)
+		repeat = 1;
+
+	std::vector<std::string> network_list, synthetic_list, threshold_list;
+	if (!networks_str.empty())
+		boost::split(network_list, networks_str, boost::is_any_of(","), boost::token_compress_on);
+	if (!synthetic_str.empty())
+		boost::split(synthetic_list, synthetic_str, boost::is_any_of(","), boost::token_compress_on);
+	boost::split(threshold_list, thresholds_str, boost::is_any_of(","), boost::token_compress_on);
+
+	std::vector<std::pair<std::string, std::string> > networks;		// name, folder
+	std::vector<std::string>::const_iterator _it_str;
+
+	try {
+		for (_it_str=network_list.begin(); _it_str!=network_list.end(); ++_it_str)
+			networks.push_back(std::make_pair(boost::trim_copy(*_it_str), input_folder));
+
+		// Create the synthetic networks
+		std::vector<std::string> dimensions;
+		for (_it_str=synthetic_list.begin(); _it_str!=synthetic_list.end(); ++_it_str)
+		{
+			boost::split(dimensions, *_it_str, boost::is_any_of("xX"), boost::token_compress_on);
+			if (dimensions.size() != 2)
+			{
+				std::cout << "- Error: " << *_it_str << " is not a valid grid size (rows x columns)." << std::endl;
+				return EXIT_FAILURE;
+			}
+
+			UINT32 rows(boost::lexical_cast<UINT32>(boost::trim_copy(dimensions.at(0))));
+			UINT32 cols(boost::lexical_cast<UINT32>(boost::trim_copy(dimensions.at(1))));
+			std::string network("segbench_" + StringFromT(rows) + "x" + StringFromT(cols));
+
+			std::cout << "+ Creating synthetic network " << network << "... ";
+			create_grid_network(formPath<std::string>(output_folder, network), rows, cols);
+			std::cout << "done." << std::endl;
+
+			networks.push_back(std::make_pair(network, output_folder));
+		}
+	}
+	catch (const std::exception& e) {
+		std::cout << std::endl << "- Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream csv;
+	if (!csv_file.empty())
+	{
+		try {
+			file_opener(csv, csv_file);
+		}
+		catch (const std::runtime_error& e) {
+			std::cout << "- Error: " << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+		csv << "network,stations,max_block_stns,min_inner_stns,blocks,contiguous_networks,junctions,junction_ratio," <<
+			"max_parameters,measurements,msr_quantities,forward_flops,reverse_flops,combine_flops,total_flops," <<
+			"critical_path_flops,parallelism,load_ms,segment_ms" << std::endl;
+	}
+
+	std::cout << std::endl << "+ Segmentation benchmark (" << partitioner << ", " << repeat << " repeats, times in ms)" << std::endl << std::endl;
+	std::cout << std::setw(20) << std::left << "Network" <<
+		std::setw(10) << std::right << "Stations" <<
+		std::setw(8) << std::right << "Max" <<
+		std::setw(8) << std::right << "Min" <<
+		std::setw(8) << std::right << "Blocks" <<
+		std::setw(11) << std::right << "Junctions" <<
+		std::setw(10) << std::right << "Jn ratio" <<
+		std::setw(10) << std::right << "Max par" <<
+		std::setw(12) << std::right << "Flops" <<
+		std::setw(12) << std::right << "Crit path" <<
+		std::setw(9) << std::right << "Par" <<
+		std::setw(11) << std::right << "Load" <<
+		std::setw(11) << std::right << "Segment" << std::endl;
+	std::cout << std::string(140, '-') << std::endl;
+
+	std::vector<std::pair<std::string, std::string> >::const_iterator _it_net;
+
+	try {
+		for (_it_net=networks.begin(); _it_net!=networks.end(); ++_it_net)
+		{
+			project_settings p;
+			p.g.network_name = _it_net->first;
+			p.g.input_folder = _it_net->second;
+			p.g.output_folder = _it_net->second;
+			p.g.verbose = 0;
+			p.s.bst_file = formPath<std::string>(_it_net->second, _it_net->first, "bst");
+			p.s.bms_file = formPath<std::string>(_it_net->second, _it_net->first, "bms");
+			p.s.asl_file = formPath<std::string>(_it_net->second, _it_net->first, "asl");
+			p.s.aml_file = formPath<std::string>(_it_net->second, _it_net->first, "aml");
+			p.s.map_file = formPath<std::string>(_it_net->second, _it_net->first, "map");
+			p.s.seg_file = formPath<std::string>(_it_net->second, _it_net->first, "seg");
+			p.s.seg_partitioner = partitioner;
+			p.s.force_contiguous_blocks = force_contiguous_blocks;
+
+			for (_it_str=threshold_list.begin(); _it_str!=threshold_list.end(); ++_it_str)
+			{
+				p.s.max_total_stations = boost::lexical_cast<UINT32>(boost::trim_copy(*_it_str));
+				p.s.min_inner_stations = (min_inner_stations > 0 ? min_inner_stations : p.s.max_total_stations);
+
+				bench_result result(run_benchmark(p, repeat));
+				print_result(std::cout, result);
+				if (csv.is_open())
+					print_csv_result(csv, result);
+			}
+		}
+	}
+	catch (const NetSegmentException& e) {
+		std::cout << std::endl << "- Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch (const std::exception& e) {
+		std::cout << std::endl << "- Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (csv.is_open())
+		csv.close();
+
+	std::cout << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -121,6 +121,36 @@ int ParseCommandLineOptions(const int& argc, char* argv[], const boost::program_
 	if (vm.count(TEST_INTEGRITY))
 		p.i.test_integrity = 1;
 
+	if (vm.count(SEG_ANALYSE))
+		p.s.seg_analyse = 1;
+
+	if (!boost::iequals(p.s.seg_partitioner, "greedy") &&
+		!boost::iequals(p.s.seg_partitioner, "multilevel"))
+	{
+		std::cout << std::endl << "- Error: " << p.s.seg_partitioner << " is not a valid partitioner." << std::endl <<
+			"  Valid partitioners are greedy and multilevel." << std::endl << std::endl;
+		return EXIT_FAILURE;
+	}
+	boost::algorithm::to_lower(p.s.seg_partitioner);
+
+	// Previous segmentation file
+	if (vm.count(SEG_INCREMENTAL))
+	{
+		// Does it exist?
+		if (!boost::filesystem::exists(p.s.seg_previous_file))
+		{
+			// Look for it in the input folder
+			p.s.seg_previous_file = formPath<std::string>(p.g.input_folder, leafStr<std::string>(p.s.seg_previous_file));
+
+			if (!boost::filesystem::exists(p.s.seg_previous_file))
+			{
+				std::cout << std::endl << "- Error: " <<
+					"Segmentation file " << leafStr<std::string>(p.s.seg_previous_file) << " does not exist." << std::endl << std::endl;  
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
 	//if (vm.count(SEG_FORCE_CONTIGUOUS))
 	//	p.s.force_contiguous_blocks = 1;
 
@@ -191,6 +221,18 @@ int main(int argc, char* argv[])
 				).c_str())
 			(SEG_SEARCH_LEVEL, boost::program_options::value<UINT16>(&p.s.seg_search_level),
 				"Level to which searches should be conducted to find stations with the lowest measurement count. Default is 0.")
+			(SEG_PARTITIONER, boost::program_options::value<std::string>(&p.s.seg_partitioner),
+				"Segmentation strategy:\n  greedy: Grow each block outward from the previous block's junctions (default)\n  multilevel: Partition the station graph by multilevel recursive bisection, minimising the number of junction stations")
+			(SEG_TARGET_MEMORY, boost::program_options::value<UINT32>(&p.s.target_memory),
+				"Memory (MB) available to the adjustment.  Selects the block size threshold with the lowest predicted adjustment time, such that the matrices of all blocks fit within arg.")
+			(SEG_TARGET_THREADS, boost::program_options::value<UINT32>(&p.s.target_threads),
+				"Number of threads available to the adjustment.  Selects the block size threshold with the lowest predicted (single or multi-thread) adjustment time on arg threads.  Default is the matrix backend's thread count.")
+			(SEG_THREADS, boost::program_options::value<UINT32>(&p.s.segment_threads),
+				"Number of threads used to segment isolated networks concurrently.  1 segments the networks one after the other.  Default is the number of hardware threads.")
+			(SEG_INCREMENTAL, boost::program_options::value<std::string>(&p.s.seg_previous_file),
+				"Update the segmentation file arg, created from an earlier version of this network.  Only the blocks touched by new or removed measurements, and their neighbours, are segmented again.  The binary segmentation file (arg.bin) created with arg is required.")
+			(SEG_ANALYSE,
+				"Print the size, junction ratio and predicted dense flops (forward, reverse and combination) of each block, and the critical path of a multi-thread phased adjustment.")
 			(TEST_INTEGRITY,
 				"Test the integrity of all output files.")
 			;
@@ -297,6 +339,15 @@ int main(int argc, char* argv[])
 			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Block 1 stations file: " << p.s.net_file << std::endl;
 		std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Minimum inner stations: " <<  p.s.min_inner_stations << std::endl;
 		std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Block size threshold: " <<  p.s.max_total_stations << std::endl;
+		std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Partitioner: " <<  p.s.seg_partitioner << std::endl;
+		if (p.s.target_memory > 0)
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Target memory (MB): " <<  p.s.target_memory << std::endl;
+		if (p.s.target_threads > 0)
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Target threads: " <<  p.s.target_threads << std::endl;
+		if (p.s.segment_threads > 0)
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Segmentation threads: " <<  p.s.segment_threads << std::endl;
+		if (!p.s.seg_previous_file.empty())
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Previous segmentation file: " <<  p.s.seg_previous_file << std::endl;
 		if (!p.s.seg_starting_stns.empty())
 			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Additional Block 1 stations: " << p.s.seg_starting_stns << std::endl;
 		else if (p.s.net_file.empty())
@@ -324,7 +375,67 @@ int main(int argc, char* argv[])
 	_SEGMENT_STATUS_ segmentStatus;
 	std::string status_msg;
 
+	// Choose the block size from the cost model?
+	dna_segment_cost costModel;
+	bool selectBlockSize(p.s.target_memory > 0 || p.s.target_threads > 0);
+
 	try {
+		if (selectBlockSize)
+		{
+			if (!p.g.quiet)
+				std::cout << "+ Calibrating block cost model... ";
+			costModel.Calibrate();
+			if (!p.g.quiet)
+			{
+				std::cout << "done." << std::endl;
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Matrix backend: " << costModel.backendName() << 
+					" (" << costModel.backendThreads() << " threads)" << std::endl;
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Inversion rate: " << std::fixed << std::setprecision(2) <<
+					costModel.InversionRate() / 1.e9 << " GFLOP/s per thread" << std::endl;
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Multiplication rate: " << 
+					costModel.MultiplicationRate() / 1.e9 << " GFLOP/s per thread" << std::endl;
+				std::cout << "+ Selecting block size... ";
+			}
+
+			vblock_size_trial_t trials;
+			dna_segment::SelectBlockSize(&p, costModel, trials);
+
+			if (!p.g.quiet)
+			{
+				std::cout << "done." << std::endl << std::endl << std::left << "  " <<
+					std::setw(STAT) << "Threshold" <<
+					std::setw(STAT) << "Min inner" <<
+					std::setw(STAT) << "Blocks" <<
+					std::setw(STAT) << "Junctions" <<
+					std::setw(STAT+2) << "Memory (MB)" <<
+					std::setw(STAT+2) << "Time (s)" << "Mode" << std::endl;
+				std::cout << "  ";
+				for (UINT32 i(0), j(STAT*6 + 4 + 12); i<j; ++i)
+					std::cout << "-";
+				std::cout << std::endl;
+				for (vblock_size_trial_t::const_iterator _it_trial(trials.begin()); _it_trial!=trials.end(); ++_it_trial)
+				{
+					std::cout << "  " << std::left <<
+						std::setw(STAT) << _it_trial->_maxTotalStations <<
+						std::setw(STAT) << _it_trial->_minInnerStations <<
+						std::setw(STAT) << _it_trial->_blockCount <<
+						std::setw(STAT) << _it_trial->_junctionCount <<
+						std::setw(STAT+2) << std::fixed << std::setprecision(1) << _it_trial->_memory <<
+						std::setw(STAT+2) << std::setprecision(3) << _it_trial->_predictedTime <<
+						(_it_trial->_mode == COST_MULTI_THREAD ? "multi-thread" : "single thread");
+					if (!_it_trial->_withinBudget)
+						std::cout << " (exceeds memory)";
+					if (_it_trial->_maxTotalStations == p.s.max_total_stations)
+						std::cout << " *";
+					std::cout << std::endl;
+				}
+				std::cout << std::endl;
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Minimum inner stations: " <<  p.s.min_inner_stations << std::endl;
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Block size threshold: " <<  p.s.max_total_stations << std::endl;
+				std::cout << std::endl;
+			}
+		}
+
 		netSegment.InitialiseSegmentation();
 		running = true;
 
@@ -357,6 +468,15 @@ int main(int argc, char* argv[])
 		if (segmentStatus != SEGMENT_SUCCESS)
 			std::cout << status_msg << std::endl;
 
+		if (!p.s.seg_previous_file.empty() && !p.g.quiet)
+		{
+			if (!netSegment.IncrementalWarning().empty())
+				std::cout << std::endl << "- Warning: " << netSegment.IncrementalWarning() << std::endl <<
+					"  The network has been segmented afresh." << std::endl << std::endl;
+			else
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "+ Re-segmented blocks: " << netSegment.ResegmentedBlocks() << std::endl;
+		}
+
 		if (!p.g.quiet)
 		{
 			std::cout << "+ Segmentation statistics:" << std::endl;
@@ -377,7 +497,50 @@ int main(int argc, char* argv[])
 				std::setw(STATION) << std::setprecision(0) << netSegment.stationSolutionCount() << std::endl;
 
 			std::cout << std::endl;
-		
+			std::cout << std::setw(PRINT_VAR_PAD) << std::left << "+ Total junction stations: " << netSegment.junctionStationCount() << std::endl;
+
+			if (p.s.seg_partitioner == "multilevel")
+			{
+				// Segment the network again using the greedy strategy, so
+				// that the junction totals of each strategy can be compared
+				project_settings greedy_settings(p);
+				greedy_settings.g.verbose = 0;
+				greedy_settings.s.seg_partitioner = "greedy";
+
+				dna_segment greedySegment;
+				greedySegment.InitialiseSegmentation();
+				greedySegment.PrepareSegmentation(&greedy_settings);
+				greedySegment.SegmentNetwork(&greedy_settings);
+
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Greedy junction stations: " << greedySegment.junctionStationCount() <<
+					" (" << greedySegment.blockCount() << " blocks)" << std::endl;
+			}
+
+			std::cout << std::endl;
+		}
+
+		if (p.s.seg_analyse && !p.g.quiet)
+			netSegment.coutAnalysis(std::cout);
+
+		if (selectBlockSize)
+		{
+			// Predict the cost of each block, and time the 
+			// kernels of a sample of blocks on this host
+			if (!p.g.quiet)
+				std::cout << "+ Estimating block costs... ";
+			netSegment.EstimateBlockCosts(costModel, true);
+
+			COST_ADJUST_MODE mode;
+			double predicted(costModel.PredictAdjustment(netSegment.BlockCosts(),
+				(p.s.target_threads > 0 ? p.s.target_threads : costModel.backendThreads()), mode));
+			if (!p.g.quiet)
+			{
+				std::cout << "done." << std::endl;
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Predicted adjustment time: " << std::fixed << std::setprecision(3) <<
+					predicted << "s per iteration (" << (mode == COST_MULTI_THREAD ? "multi-thread" : "single thread") << ")" << std::endl;
+				std::cout << std::setw(PRINT_VAR_PAD) << std::left << "  Predicted memory: " << std::setprecision(1) <<
+					costModel.PredictMemory(netSegment.BlockCosts()) << " MB" << std::endl << std::endl;
+			}
 		}
 
 		if (!p.g.quiet)
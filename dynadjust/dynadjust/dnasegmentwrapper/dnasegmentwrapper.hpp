@@ -104,7 +104,7 @@ public:
 			cout_mutex.lock();
 			std::cout << " done." << std::endl;
 
-			if (_dnaSeg->StartingStations().empty())
+			if (_dnaSeg->StartingStations().empty() && _p->s.seg_partitioner != "multilevel")
 			{
 				std::string startStn(_dnaSeg->DefaultStartingStation());
 				if (startStn == "")
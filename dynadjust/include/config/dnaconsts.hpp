@@ -109,6 +109,18 @@ const double E4_SEC_DEFLECTION(0.0001 * SEC_TO_RAD);
 const double STN_SEARCH_RADIUS(0.3);
 const std::string STN_SEARCH_RADIUS_STR("0.3");
 
+// The minimum size (in bytes) of the chunks into which a 
+// DNA file is split when parsed concurrently
+const UINT32 DNA_CHUNK_SIZE_MIN(16777216);
+
+// The minimum number of stations sorted by each thread when 
+// the station map is created
+const UINT32 STN_SORT_CHUNK_SIZE_MIN(4096);
+
+// The minimum number of measurements in the chunks into which 
+// the measurements are split when the AML is formed
+const UINT32 AML_CHUNK_SIZE_MIN(65536);
+
 const double TOLERANCE_SEC_MIN(1.);
 const double TOLERANCE_SEC_MAX(7200.);		// 120 minutes (or 2 degrees)
 const double TOLERANCE_ZERO(0.00001);
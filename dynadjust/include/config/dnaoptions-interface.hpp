@@ -38,6 +38,7 @@ const char* const IMPORT_MODULE_FRAME = "Reference frame options";
 const char* const IMPORT_MODULE_SCREEN = "Data screening options";
 const char* const IMPORT_MODULE_GNSS_VAR = "GNSS variance matrix scaling options";
 const char* const IMPORT_MODULE_SIMULATE = "Network simulation options";
+const char* const IMPORT_MODULE_CONCURRENCY = "Concurrency options";
 
 const char* const ADJUST_MODULE_MODE = "Adjustment mode options";
 const char* const ADJUST_MODULE_PHASED = "Phased adjustment options";
@@ -149,6 +150,7 @@ const char* const OUTPUT_ANGULAR_TYPE_STN = "angular-stn-type";
 //const char* const MVAR_INVERSE_METHOD = "msr-inverse-method";
 const char* const LSQ_INVERSE_METHOD = "inversion-method";
 const char* const SCALE_NORMAL_UNITY = "scale-normals-to-unity";
+const char* const MATRIX_BACKEND = "matrix-backend";
 const char* const PURGE_STAGE_FILES = "purge-stage-files";
 const char* const RECREATE_STAGE_FILES = "create-stage-files";
 const char* const UPDATE_ORIGINAL_STN_FILE = "update-orig-stn-file";
@@ -163,6 +165,12 @@ const char* const SEG_SHOW_SUMMARY = "show-segment-summary";
 const char* const SEG_DISP_BLK_NET = "display-block-network";
 const char* const SEG_FORCE_CONTIGUOUS = "contiguous-blocks";
 const char* const SEG_SEARCH_LEVEL = "search-level";
+const char* const SEG_PARTITIONER = "partitioner";
+const char* const SEG_TARGET_MEMORY = "target-memory";
+const char* const SEG_TARGET_THREADS = "target-threads";
+const char* const SEG_THREADS = "segment-threads";
+const char* const SEG_INCREMENTAL = "incremental";
+const char* const SEG_ANALYSE = "analyse";
 
 const char* const GEOID_PATH = "geoid-file";
 const char* const INTERPOLATE_ALWAYS = "interpolate-heights-always";
@@ -206,6 +214,11 @@ const char* const EXPORT_DISCONT_FILE = "export-discont-file";
 const char* const SIMULATE_MSR_FILE = "simulate-msr-file";
 const char* const STATION_RENAMING_FILE = "stn-renaming-file";
 const char* const STATION_DISCONTINUITY_FILE = "discontinuity-file";
+const char* const IMPORT_CACHE_FOLDER = "import-cache-folder";
+const char* const IMPORT_THREADS = "import-threads";
+const char* const PARSE_CHUNK_SIZE = "parse-chunk-size";
+const char* const STN_SORT_CHUNK_SIZE = "stn-sort-chunk-size";
+const char* const AML_CHUNK_SIZE = "aml-chunk-size";
 const char* const TEST_INTEGRITY = "test-integrity";
 const char* const VERIFY_COORDS = "verify-coordinates";
 const char* const INCLUDE_MSRS = "include-msr-types";
@@ -188,12 +188,13 @@ public:
 		, apply_scaling(0), map_file(""), asl_file(""), aml_file(""), bst_file(""), bms_file("")
 		, dst_file(""), dms_file(""), imp_file(""), geo_file(""), seg_file(""), dbid_file("")
 		, xml_outfile(""), xml_stnfile(""), xml_msrfile(""), dna_stnfile(""), dna_msrfile(""), stn_renamingfile("")
-		, stn_discontinuityfile(""), simulate_msrfile("")
+		, stn_discontinuityfile(""), simulate_msrfile(""), import_cache_folder("")
 		, include_msrs(""), exclude_msrs(""), bounding_box(""), stn_associated_msr_include(""), stn_associated_msr_exclude("")
 		, rename_stations(0), apply_discontinuities(0), search_nearby_stn(0)
 		, search_similar_msr(0), search_similar_msr_gx(0), ignore_similar_msr(0), remove_ignored_msr(0)
 		, flag_unused_stn(0), ignore_insufficient_msrs(0), import_block(0), import_block_number(0), import_network(0), import_network_number(0)
-		, cluster_id(0), msr_id(0), search_stn_radius(STN_SEARCH_RADIUS)
+		, cluster_id(0), msr_id(0), import_threads(0), parse_chunk_size(DNA_CHUNK_SIZE_MIN)
+		, stn_sort_chunk_size(STN_SORT_CHUNK_SIZE_MIN), aml_chunk_size(AML_CHUNK_SIZE_MIN), search_stn_radius(STN_SEARCH_RADIUS)
 		, vscale(1.), pscale(1.), lscale(1.), hscale(1.), scalar_file("")
 		, command_line_arguments("") 
 	{
@@ -267,6 +268,7 @@ public:
 	std::string		stn_renamingfile;			// Station renaming file
 	std::string		stn_discontinuityfile;		// Station discontinuity file (SINEX format)
 	std::string		simulate_msrfile;			// Simulation control file
+	std::string		import_cache_folder;		// Folder of parsed input file images (see dna_io_imc)
 	std::string		include_msrs;				// Import the measurements corresponding to the user-supplied string of measurement types
 	std::string		exclude_msrs;				// Exclude the measurements corresponding to the user-supplied string of measurement types
 	std::string		bounding_box;				// Import stations and measurements within bounding box using comma delimited string \"lat1,lon1,lat2,lon2\" to define upper-left and lower-right limits.
@@ -287,6 +289,10 @@ public:
 	UINT32		import_network_number;		// Import from this network ID (i.e. a contiguous network)
 	UINT32		cluster_id;					// Index of the first available cluster id 
 	UINT32		msr_id;						// Index of the first available measurement id
+	UINT32		import_threads;				// Threads used to import. Zero uses the number of concurrent threads the CPU supports
+	UINT32		parse_chunk_size;			// Minimum size (in bytes) of the chunks of a DNA file parsed concurrently
+	UINT32		stn_sort_chunk_size;		// Minimum number of stations sorted by each thread
+	UINT32		aml_chunk_size;				// Minimum number of measurements in each chunk of the AML formed concurrently
 	double		search_stn_radius;			// Radius of the circle within which to search for nearby stations
 	double		vscale;						// global matrix scalar
 	double		pscale;						// phi scalar
@@ -376,7 +382,7 @@ public:
 		, display_block_network(1), view_block_on_segment(1), show_segment_summary(0), print_segment_debug(0)
 		, force_contiguous_blocks(1), map_file(""), asl_file(""), aml_file("")
 		, bst_file(""), bms_file(""), seg_file(""), sap_file(""), net_file(""), seg_starting_stns("")
-		, command_line_arguments("") {}
+		, seg_partitioner("greedy"), target_memory(0), target_threads(0), segment_threads(0), seg_previous_file(""), seg_analyse(0), command_line_arguments("") {}
 
 private:
 	// Disallow use of compiler generated equality operator.
@@ -411,6 +417,12 @@ public:
 	std::string		sap_file;					// Station appearance list file
 	std::string		net_file;					// Starting stations output file
 	std::string		seg_starting_stns;			// Stations to be incorporated within the first block.
+	std::string		seg_partitioner;			// Segmentation strategy (greedy or multilevel)
+	UINT32		target_memory;				// Memory (MB) available to the adjustment. Selects the block size if non-zero
+	UINT32		target_threads;				// Threads available to the adjustment. Selects the block size if non-zero
+	UINT32		segment_threads;			// Threads used to segment isolated networks (0: hardware concurrency, 1: serial)
+	std::string		seg_previous_file;			// Previous segmentation file, to be updated incrementally
+	UINT16		seg_analyse;				// Print the size and dense flops of each block
 	std::string		command_line_arguments;
 };
 
@@ -425,7 +437,7 @@ public:
 		, iteration_threshold((float)0.0005), free_std_dev(10.0), fixed_std_dev(PRECISION_1E6), station_constraints("")
 		, map_file(""), bst_file(""), bms_file(""), seg_file(""), comments("") 
 		, command_line_arguments("")
-		, type_b_global (""), type_b_file ("") {}
+		, type_b_global (""), type_b_file (""), matrix_backend("") {}
 
 private:
 	// Disallow use of compiler generated equality operator.
@@ -478,6 +490,7 @@ public:
 	std::string		command_line_arguments;
 	std::string      type_b_global;          // Comma delimited string containing Type b uncertainties to be applied to all uncertainties computed from an adjustment
 	std::string      type_b_file;            // File path to Type b uncertainties to be applied to specific site uncertainties computed from an adjustment
+	std::string		matrix_backend;			// BLAS/LAPACK backend for matrix operations.  Empty selects the build default.
 };
 
 // datum and geoid settings
@@ -1245,6 +1245,30 @@ void CDnaProjectFile::LoadSettingSegment(const std::string& var, std::string& va
 			return;
 		settings_.s.seg_search_level = boost::lexical_cast<UINT16, std::string>(val);
 	}
+	else if (boost::iequals(var, SEG_PARTITIONER))
+	{
+		if (val.empty())
+			return;
+		settings_.s.seg_partitioner = val;
+	}
+	else if (boost::iequals(var, SEG_TARGET_MEMORY))
+	{
+		if (val.empty())
+			return;
+		settings_.s.target_memory = boost::lexical_cast<UINT32, std::string>(val);
+	}
+	else if (boost::iequals(var, SEG_TARGET_THREADS))
+	{
+		if (val.empty())
+			return;
+		settings_.s.target_threads = boost::lexical_cast<UINT32, std::string>(val);
+	}
+	else if (boost::iequals(var, SEG_THREADS))
+	{
+		if (val.empty())
+			return;
+		settings_.s.segment_threads = boost::lexical_cast<UINT32, std::string>(val);
+	}
 }
 	
 void CDnaProjectFile::LoadSettingAdjust(const std::string& var, std::string& val)
@@ -1373,6 +1397,12 @@ void CDnaProjectFile::LoadSettingAdjust(const std::string& var, std::string& val
 			return;
 		settings_.a.scale_normals_to_unity = yesno_uint<UINT16, std::string>(val);
 	}
+	else if (boost::iequals(var, MATRIX_BACKEND))
+	{
+		if (val.empty())
+			return;
+		settings_.a.matrix_backend = val;
+	}
 	else if (boost::iequals(var, RECREATE_STAGE_FILES))
 	{
 		if (val.empty())
@@ -1875,6 +1905,10 @@ void CDnaProjectFile::PrintProjectFile()
 	PrintRecord(dnaproj_file, SEG_THRESHOLD_STNS, settings_.s.max_total_stations);			// Maximum number of total stations per block
 	PrintRecord(dnaproj_file, SEG_FORCE_CONTIGUOUS,
 		yesno_string(settings_.s.force_contiguous_blocks));
+	PrintRecord(dnaproj_file, SEG_PARTITIONER, settings_.s.seg_partitioner);				// Segmentation strategy
+	PrintRecord(dnaproj_file, SEG_TARGET_MEMORY, settings_.s.target_memory);				// Memory available to the adjustment
+	PrintRecord(dnaproj_file, SEG_TARGET_THREADS, settings_.s.target_threads);				// Threads available to the adjustment
+	PrintRecord(dnaproj_file, SEG_THREADS, settings_.s.segment_threads);					// Threads used to segment isolated networks
 
 	// Stations to be incorporated within the first block.
 	PrintRecord(dnaproj_file, SEG_STARTING_STN, settings_.s.seg_starting_stns);	
@@ -1914,6 +1948,7 @@ void CDnaProjectFile::PrintProjectFile()
 
 	PrintRecord(dnaproj_file, SCALE_NORMAL_UNITY, 
 		yesno_string(settings_.a.scale_normals_to_unity));									// Scale normals to unity before inversion
+	PrintRecord(dnaproj_file, MATRIX_BACKEND, settings_.a.matrix_backend);					// BLAS/LAPACK backend
 	PrintRecord(dnaproj_file, RECREATE_STAGE_FILES, 
 		yesno_string(settings_.a.recreate_stage_files));									// Recreate stage files
 	PrintRecord(dnaproj_file, PURGE_STAGE_FILES, 
@@ -530,6 +530,20 @@ typedef struct block_meta {
 	bool	_blockIntermediate;	// Not the first or last, but an intermediate block of a list of three or more
 } blockMeta_t;
 
+typedef struct block_cost {
+	block_cost() : _parameters(0), _junctionParameters(0), _measurements(0)
+		, _predictedTime(0.), _measuredTime(-1.), _memory(0.) {}
+
+	UINT32	_parameters;			// Unknowns (three per junction and inner station)
+	UINT32	_junctionParameters;	// Unknowns carried to the next block (three per junction station)
+	UINT32	_measurements;			// Measurement quantities
+	double	_predictedTime;			// Predicted time (s) to adjust the block
+	double	_measuredTime;			// Time (s) taken by the block's matrix kernels on this host (-1 if not measured)
+	double	_memory;				// Memory (MB) required for the block's matrices
+} blockCost_t;
+
+typedef std::vector<blockCost_t> vblockCost_t, *pvblockCost_t;
+
 const UINT16 STN_NAME_WIDTH(31);
 const UINT16 STN_NAME_ORIG_WIDTH(40);
 const UINT16 STN_DESC_WIDTH(129);
@@ -542,21 +556,16 @@ const UINT16 STN_PLATE_WIDTH(3);
 // data struct for storing station information to binary station file
 typedef struct stn_t {
 	stn_t(const short& u=0)	
-		: suppliedStationType(LLH_type_i), initialLatitude(0.), currentLatitude(0.), initialLongitude(0.), currentLongitude(0.)
-		, initialHeight(0.), currentHeight(0.), suppliedHeightRefFrame(ELLIPSOIDAL_type_i)
-		, geoidSep(0.), meridianDef(0.), verticalDef(0.), zone(u)
-		, fileOrder(0), nameOrder(0), clusterID(0), unusedStation(FALSE) 
 	{
-		memset(stationName, '\0', sizeof(stationName));
-		memset(stationNameOrig, '\0', sizeof(stationNameOrig));
-		memset(stationConst, '\0', sizeof(stationConst));
-		memset(stationType, '\0', sizeof(stationType));
-		memset(description, '\0', sizeof(description));
+		// Zero all members, and the padding between them, so that the 
+		// records written to a binary station file are reproducible
+		memset(this, '\0', sizeof(stn_t));
+		suppliedStationType = LLH_type_i;
+		suppliedHeightRefFrame = ELLIPSOIDAL_type_i;
+		zone = u;
+		unusedStation = FALSE;
 		// GDA2020, lat, long, height
-		memset(epsgCode, '\0', sizeof(epsgCode));
 		sprintf(epsgCode, "7843");
-		memset(epoch, '\0', sizeof(epoch));
-		memset(plate, '\0', sizeof(plate));
 	}
 
 	char	stationName[STN_NAME_WIDTH];			// 30 characters
@@ -0,0 +1,231 @@
+//============================================================================
+// Name         : dnaindexedheap.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Indexed binary min-heap of UINT32 keys (e.g. station indices)
+//                The position of each key in the heap is held in a lookup
+//                table, so that membership tests are O(1) and the priority
+//                of any key can be changed (or the key removed) in O(log n).
+//                Keys are ordered by Compare.  Keys which Compare considers
+//                equivalent are ordered by value, so the order is total and
+//                does not depend upon the order in which keys were added.
+//                (std::sort, by contrast, leaves the order of equivalent
+//                keys unspecified.)
+//============================================================================
+
+#ifndef DNAINDEXEDHEAP_H_
+#define DNAINDEXEDHEAP_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include <include/config/dnatypes.hpp>
+
+template<typename Compare>
+class indexed_min_heap
+{
+public:
+	explicit indexed_min_heap(const Compare& comp)
+		: comp_(comp) {}
+
+	inline bool empty() const { return heap_.empty(); }
+	inline std::size_t size() const { return heap_.size(); }
+
+	// O(1) membership test
+	inline bool contains(const UINT32& key) const {
+		return key < position_.size() && position_[key] != npos;
+	}
+
+	// Key with the lowest priority
+	inline UINT32 top() const { return heap_.front(); }
+
+	// Keys in heap (not sorted) order
+	inline const std::vector<UINT32>& elements() const { return heap_; }
+
+	void clear()
+	{
+		heap_.clear();
+		position_.clear();
+	}
+
+	// Replaces the contents of the heap with keys
+	void assign(const std::vector<UINT32>& keys)
+	{
+		clear();
+		heap_ = keys;
+
+		UINT32 max_key(0);
+		for (std::size_t i(0); i<heap_.size(); ++i)
+			max_key = std::max(max_key, heap_[i]);
+		if (!heap_.empty())
+			position_.assign(max_key + 1, npos);
+
+		for (std::size_t i(0); i<heap_.size(); ++i)
+			position_[heap_[i]] = i;
+
+		// heapify
+		for (std::size_t i(heap_.size() / 2); i-- > 0; )
+			sift_down(i);
+	}
+
+	// Adds key to the heap.  key must not already be in the heap.
+	void push(const UINT32& key)
+	{
+		if (key >= position_.size())
+			position_.resize(key + 1, npos);
+		position_[key] = heap_.size();
+		heap_.push_back(key);
+		sift_up(heap_.size() - 1);
+	}
+
+	UINT32 pop()
+	{
+		UINT32 key(heap_.front());
+		erase(key);
+		return key;
+	}
+
+	// Removes key from the heap, if present
+	void erase(const UINT32& key)
+	{
+		if (!contains(key))
+			return;
+
+		std::size_t pos(position_[key]), last(heap_.size() - 1);
+		position_[key] = npos;
+
+		if (pos != last)
+		{
+			heap_[pos] = heap_[last];
+			position_[heap_[pos]] = pos;
+			heap_.pop_back();
+
+			// restore the heap property in whichever
+			// direction the moved key requires
+			if (pos > 0 && less(heap_[pos], heap_[parent(pos)]))
+				sift_up(pos);
+			else
+				sift_down(pos);
+		}
+		else
+			heap_.pop_back();
+	}
+
+	// Restores the position of key after its priority has been
+	// lowered (i.e. it now compares less than it did before)
+	void decrease(const UINT32& key)
+	{
+		if (contains(key))
+			sift_up(position_[key]);
+	}
+
+	// True if lhs would leave the heap before rhs
+	inline bool precedes(const UINT32& lhs, const UINT32& rhs) const { return less(lhs, rhs); }
+
+	// Retrieves up to n keys with the lowest priority, in
+	// ascending order, without modifying the heap
+	void smallest(const std::size_t& n, std::vector<UINT32>& keys) const
+	{
+		keys.clear();
+		if (heap_.empty())
+			return;
+
+		std::vector<std::size_t> frontier(1, 0);
+		std::vector<std::size_t>::iterator _it_best;
+		std::size_t pos;
+
+		while (keys.size() < n && !frontier.empty())
+		{
+			// frontier holds at most n + 1 positions
+			_it_best = frontier.begin();
+			for (std::vector<std::size_t>::iterator _it_pos(frontier.begin() + 1); _it_pos!=frontier.end(); ++_it_pos)
+				if (less(heap_[*_it_pos], heap_[*_it_best]))
+					_it_best = _it_pos;
+
+			pos = *_it_best;
+			frontier.erase(_it_best);
+			keys.push_back(heap_[pos]);
+
+			if (left(pos) < heap_.size())
+				frontier.push_back(left(pos));
+			if (right(pos) < heap_.size())
+				frontier.push_back(right(pos));
+		}
+	}
+
+private:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	static inline std::size_t parent(const std::size_t& pos) { return (pos - 1) / 2; }
+	static inline std::size_t left(const std::size_t& pos) { return 2 * pos + 1; }
+	static inline std::size_t right(const std::size_t& pos) { return 2 * pos + 2; }
+
+	inline bool less(const UINT32& lhs, const UINT32& rhs) const
+	{
+		if (comp_(lhs, rhs))
+			return true;
+		if (comp_(rhs, lhs))
+			return false;
+		return lhs < rhs;
+	}
+
+	inline void swap_positions(const std::size_t& a, const std::size_t& b)
+	{
+		std::swap(heap_[a], heap_[b]);
+		position_[heap_[a]] = a;
+		position_[heap_[b]] = b;
+	}
+
+	void sift_up(std::size_t pos)
+	{
+		while (pos > 0 && less(heap_[pos], heap_[parent(pos)]))
+		{
+			swap_positions(pos, parent(pos));
+			pos = parent(pos);
+		}
+	}
+
+	void sift_down(std::size_t pos)
+	{
+		std::size_t lowest;
+		while (true)
+		{
+			lowest = pos;
+			if (left(pos) < heap_.size() && less(heap_[left(pos)], heap_[lowest]))
+				lowest = left(pos);
+			if (right(pos) < heap_.size() && less(heap_[right(pos)], heap_[lowest]))
+				lowest = right(pos);
+			if (lowest == pos)
+				return;
+			swap_positions(pos, lowest);
+			pos = lowest;
+		}
+	}
+
+	mutable Compare				comp_;
+	std::vector<UINT32>			heap_;
+	std::vector<std::size_t>	position_;		// position of each key in heap_, or npos
+};
+
+#endif /* DNAINDEXEDHEAP_H_ */
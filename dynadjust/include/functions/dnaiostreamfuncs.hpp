@@ -30,6 +30,7 @@
 #endif
 
 #include <iostream>
+#include <streambuf>
 #include <string>
 
 using std::ostringstream;
@@ -140,4 +141,41 @@ void print_file_header(
 }
 
 
+// A read only stream buffer over a block of memory (such as a memory 
+// mapped file), enabling the block to be read by a std::istream
+class memory_streambuf : public std::streambuf
+{
+public:
+	memory_streambuf(const char* begin, const char* end)
+	{
+		char* first(const_cast<char*>(begin));
+		setg(first, first, const_cast<char*>(end));
+	}
+
+protected:
+	// Enables tellg and seekg
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, 
+		std::ios_base::openmode which = std::ios_base::in)
+	{
+		char* pos(gptr());
+		if (dir == std::ios_base::beg)
+			pos = eback();
+		else if (dir == std::ios_base::end)
+			pos = egptr();
+
+		pos += off;
+		if (pos < eback() || pos > egptr())
+			return pos_type(off_type(-1));
+
+		setg(eback(), pos, egptr());
+		return pos_type(pos - eback());
+	}
+
+	pos_type seekpos(pos_type sp, std::ios_base::openmode which = std::ios_base::in)
+	{
+		return seekoff(off_type(sp), std::ios_base::beg, which);
+	}
+};
+
+
 #endif // DNAIOSTREAMFUNCS_HPP_
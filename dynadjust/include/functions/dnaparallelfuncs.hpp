@@ -31,19 +31,18 @@
 
 #include <algorithm>
 #include <functional>
-
-#include <boost/thread.hpp>
-#include <boost/thread/future.hpp>
+#include <future>
 
 #include <include/config/dnatypes.hpp>
 
+// Applies f to each element in [first, last), halving the range across
+// threads until a range holds fewer than 2 * min_per_thread elements
 template<typename Iterator, typename Func>
-void parallel_for_each(Iterator first, Iterator last, Func f)
+void parallel_for_each(Iterator first, Iterator last, Func f, const UINT32 min_per_thread=25)
 {
 	const UINT32 length(std::distance(first, last));
 	if (!length)
 		return;
-	const UINT32 min_per_thread=25;
 
 	if (length < (2 * min_per_thread))
 	{
@@ -52,11 +51,33 @@ void parallel_for_each(Iterator first, Iterator last, Func f)
 	else
 	{
 		Iterator const mid_point(first + length / 2);
-		boost::future<void> first_half(boost::async(&parallel_for_each<Iterator, Func>, first, mid_point, f));
-		parallel_for_each(mid_point, last, f);
+		std::future<void> first_half(std::async(std::launch::async, &parallel_for_each<Iterator, Func>, first, mid_point, f, min_per_thread));
+		parallel_for_each(mid_point, last, f, min_per_thread);
 		first_half.get();
 	}
 }
 
+// Sorts [first, last) by comp, sorting the two halves of the range 
+// concurrently (until a range holds fewer than 2 * min_per_thread elements)
+// and then merging them.  As for std::sort, the order of equivalent 
+// elements is unspecified.
+template<typename Iterator, typename Compare>
+void parallel_sort(Iterator first, Iterator last, Compare comp, const UINT32 min_per_thread=8192)
+{
+	const UINT32 length(std::distance(first, last));
+	
+	if (length < (2 * min_per_thread))
+	{
+		std::sort(first, last, comp);
+		return;
+	}
+	
+	Iterator const mid_point(first + length / 2);
+	std::future<void> first_half(std::async(std::launch::async, &parallel_sort<Iterator, Compare>, first, mid_point, comp, min_per_thread));
+	parallel_sort(mid_point, last, comp, min_per_thread);
+	first_half.get();
+	std::inplace_merge(first, mid_point, last, comp);
+}
+
 
 #endif /* DNAPARALLELFUNCS_H_ */
@@ -0,0 +1,174 @@
+//============================================================================
+// Name         : dnastationgrid.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Uniform grid index of station positions
+//                Each station is placed in a cubic cell of the cartesian
+//                coordinates of its position on a sphere.  Since the chord
+//                between two positions is never longer than the distance
+//                over the sphere, the stations within the cell size (over
+//                the sphere) of a station all lie in the 27 cells
+//                surrounding its cell.  The cells are held in sorted order,
+//                and the stations of each cell are held contiguously.
+//============================================================================
+
+#ifndef DNASTATIONGRID_H_
+#define DNASTATIONGRID_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <include/config/dnatypes.hpp>
+
+typedef struct grid_cell {
+	std::int64_t	x, y, z;
+	UINT32			begin, end;		// range of the cell's stations in station_grid_index::stations()
+
+	bool operator<(const grid_cell& rhs) const {
+		if (x != rhs.x) return x < rhs.x;
+		if (y != rhs.y) return y < rhs.y;
+		return z < rhs.z;
+	}
+} grid_cell_t;
+
+typedef std::vector<grid_cell_t> v_grid_cell;
+
+class station_grid_index
+{
+public:
+	station_grid_index()
+		: cell_size_(0.) {}
+
+	inline bool empty() const { return cells_.empty(); }
+
+	inline const v_grid_cell& cells() const { return cells_; }
+
+	// Station indices in cell order
+	inline const vUINT32& stations() const { return stations_; }
+
+	void clear()
+	{
+		cells_.clear();
+		stations_.clear();
+		station_cell_.clear();
+	}
+
+	// Indexes the positions of stns (latitude and longitude in radians) in
+	// cells of cell_size metres.  Stations are identified by their position
+	// in stns.
+	template<typename T>
+	void build(const std::vector<T>& stns, const double& cell_size)
+	{
+		clear();
+		if (stns.empty() || cell_size <= 0.)
+			return;
+
+		cell_size_ = cell_size;
+
+		const UINT32 stnCount(static_cast<UINT32>(stns.size()));
+		v_grid_cell stn_cells(stnCount);
+		UINT32 stn;
+		double cos_lat;
+
+		for (stn=0; stn<stnCount; ++stn)
+		{
+			cos_lat = cos(stns.at(stn)->GetLatitude());
+			stn_cells.at(stn).x = cell(GRID_RADIUS * cos_lat * cos(stns.at(stn)->GetLongitude()));
+			stn_cells.at(stn).y = cell(GRID_RADIUS * cos_lat * sin(stns.at(stn)->GetLongitude()));
+			stn_cells.at(stn).z = cell(GRID_RADIUS * sin(stns.at(stn)->GetLatitude()));
+		}
+
+		// order the stations by cell, then by index
+		stations_.resize(stnCount);
+		for (stn=0; stn<stnCount; ++stn)
+			stations_.at(stn) = stn;
+		std::sort(stations_.begin(), stations_.end(),
+			[&stn_cells](const UINT32& lhs, const UINT32& rhs) {
+				if (stn_cells.at(lhs) < stn_cells.at(rhs))
+					return true;
+				if (stn_cells.at(rhs) < stn_cells.at(lhs))
+					return false;
+				return lhs < rhs;
+			});
+
+		// form the cells
+		station_cell_.resize(stnCount);
+		for (stn=0; stn<stnCount; ++stn)
+		{
+			const grid_cell_t& stn_cell(stn_cells.at(stations_.at(stn)));
+			if (cells_.empty() || cells_.back() < stn_cell)
+			{
+				cells_.push_back(stn_cell);
+				cells_.back().begin = stn;
+			}
+			cells_.back().end = stn + 1;
+			station_cell_.at(stations_.at(stn)) = static_cast<UINT32>(cells_.size() - 1);
+		}
+	}
+
+	// Calls f(other) for each station other in the cells surrounding the
+	// cell of station stn (including stn itself).  These are all of the
+	// stations which may lie within cell_size of stn.
+	template<typename Func>
+	void for_each_neighbour(const UINT32& stn, Func f) const
+	{
+		const grid_cell_t& stn_cell(cells_.at(station_cell_.at(stn)));
+		grid_cell_t neighbour;
+		v_grid_cell::const_iterator _it_cell;
+		UINT32 other;
+
+		for (neighbour.x=stn_cell.x-1; neighbour.x<=stn_cell.x+1; ++neighbour.x)
+		{
+			for (neighbour.y=stn_cell.y-1; neighbour.y<=stn_cell.y+1; ++neighbour.y)
+			{
+				for (neighbour.z=stn_cell.z-1; neighbour.z<=stn_cell.z+1; ++neighbour.z)
+				{
+					_it_cell = std::lower_bound(cells_.begin(), cells_.end(), neighbour);
+					if (_it_cell == cells_.end() || neighbour < *_it_cell)
+						continue;
+					for (other=_it_cell->begin; other<_it_cell->end; ++other)
+						f(stations_.at(other));
+				}
+			}
+		}
+	}
+
+private:
+	// Radius of the sphere on which the positions are placed (the GRS80
+	// semi-major axis)
+	static constexpr double GRID_RADIUS = 6378137.;
+
+	inline std::int64_t cell(const double& coordinate) const {
+		return static_cast<std::int64_t>(floor(coordinate / cell_size_));
+	}
+
+	double			cell_size_;
+	v_grid_cell		cells_;				// sorted
+	vUINT32			stations_;			// station indices in cell order
+	vUINT32			station_cell_;		// cell of each station
+};
+
+#endif /* DNASTATIONGRID_H_ */
@@ -0,0 +1,256 @@
+//============================================================================
+// Name         : dnastationindex.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Immutable hash index of station names (e.g. the station map)
+//                The names are held once, in a single block, and are found
+//                by an open addressing (linear probing) hash table, so that
+//                a lookup is O(1) and does not copy the name.  The index is
+//                held in the same form in memory as in the index file, so
+//                the file can be memory mapped and used without parsing.
+//============================================================================
+
+#ifndef DNASTATIONINDEX_H_
+#define DNASTATIONINDEX_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <include/config/dnatypes.hpp>
+
+const char* const STN_INDEX_IDENTIFIER = "DNASIDX";
+const UINT32 STN_INDEX_VERSION = 1;
+
+// Header of a station name index, which is followed by:
+//   station_index_slot_t[slotCount]      hash table,
+//   station_index_entry_t[stationCount]  name and station index of each entry, and
+//   char[namesSize]                      null terminated names of all entries.
+typedef struct {
+	char	identifier[8];			// STN_INDEX_IDENTIFIER
+	UINT32	version;				// STN_INDEX_VERSION
+	UINT32	stationCount;
+	UINT32	slotCount;				// power of two, at least twice stationCount
+	UINT32	namesSize;
+} station_index_header_t;
+
+typedef struct {
+	UINT32	hash;					// hash of the entry's name
+	UINT32	entry;					// entry, or station_name_index::npos if the slot is empty
+} station_index_slot_t;
+
+typedef struct {
+	UINT32	nameOffset;				// offset of the name from the start of the names
+	UINT32	nameLength;
+	UINT32	stationIndex;
+} station_index_entry_t;
+
+class station_name_index
+{
+public:
+	static constexpr UINT32 npos = static_cast<UINT32>(-1);
+
+	station_name_index()
+		: header_(0), slots_(0), entries_(0), names_(0), size_(0) {}
+
+	inline bool empty() const { return size() == 0; }
+	inline UINT32 size() const { return header_ ? header_->stationCount : 0; }
+
+	// The index as written to (and mapped from) the index file
+	inline const char* data() const { return reinterpret_cast<const char*>(header_); }
+	inline std::size_t data_size() const { return size_; }
+
+	void clear()
+	{
+		header_ = 0;
+		slots_ = 0;
+		entries_ = 0;
+		names_ = 0;
+		size_ = 0;
+		owner_.reset();
+	}
+
+	// Index of the station named name, or npos if there is no such station
+	UINT32 find(std::string_view name) const
+	{
+		if (header_ == 0)
+			return npos;
+
+		const UINT32 h(hash(name));
+		const UINT32 mask(header_->slotCount - 1);
+
+		// slotCount > stationCount, so there is always an empty slot
+		for (UINT32 s(h & mask); slots_[s].entry != npos; s = (s + 1) & mask)
+		{
+			if (slots_[s].hash != h)
+				continue;
+			const station_index_entry_t& entry(entries_[slots_[s].entry]);
+			if (entry.nameLength == name.length() &&
+				memcmp(names_ + entry.nameOffset, name.data(), name.length()) == 0)
+				return entry.stationIndex;
+		}
+		return npos;
+	}
+
+	inline bool contains(std::string_view name) const {
+		return find(name) != npos;
+	}
+
+	// Builds the index of a station map.  Where a name appears more than
+	// once, the first is indexed.
+	template<typename T>
+	void build(const std::vector<std::pair<std::string, T> >& stnsMap)
+	{
+		UINT32 slotCount(2);
+		while (slotCount < 2 * stnsMap.size())
+			slotCount <<= 1;
+
+		std::size_t namesSize(0);
+		typename std::vector<std::pair<std::string, T> >::const_iterator _it_stn;
+		for (_it_stn=stnsMap.begin(); _it_stn!=stnsMap.end(); ++_it_stn)
+			namesSize += _it_stn->first.length() + 1;
+
+		// slots and entries are sized for every name, and the unused
+		// entries trimmed once the duplicates are known
+		boost::shared_ptr<std::vector<char> > buffer(new std::vector<char>(
+			sizeof(station_index_header_t) +
+			slotCount * sizeof(station_index_slot_t) +
+			stnsMap.size() * sizeof(station_index_entry_t)));
+
+		station_index_header_t* header(reinterpret_cast<station_index_header_t*>(&(*buffer)[0]));
+		station_index_slot_t* slots(reinterpret_cast<station_index_slot_t*>(header + 1));
+		station_index_entry_t* entries(reinterpret_cast<station_index_entry_t*>(slots + slotCount));
+
+		std::vector<char> names;
+		names.reserve(namesSize);
+
+		UINT32 s, h, stationCount(0);
+		const UINT32 mask(slotCount - 1);
+		for (s=0; s<slotCount; ++s)
+			slots[s].entry = npos;
+
+		for (_it_stn=stnsMap.begin(); _it_stn!=stnsMap.end(); ++_it_stn)
+		{
+			h = hash(_it_stn->first);
+			for (s = h & mask; slots[s].entry != npos; s = (s + 1) & mask)
+				if (slots[s].hash == h &&
+					entries[slots[s].entry].nameLength == _it_stn->first.length() &&
+					_it_stn->first.compare(0, std::string::npos, &names[entries[slots[s].entry].nameOffset],
+						entries[slots[s].entry].nameLength) == 0)
+					break;
+
+			// duplicate?
+			if (slots[s].entry != npos)
+				continue;
+
+			slots[s].hash = h;
+			slots[s].entry = stationCount;
+			entries[stationCount].nameOffset = static_cast<UINT32>(names.size());
+			entries[stationCount].nameLength = static_cast<UINT32>(_it_stn->first.length());
+			entries[stationCount].stationIndex = static_cast<UINT32>(_it_stn->second);
+			names.insert(names.end(), _it_stn->first.begin(), _it_stn->first.end());
+			names.push_back('\0');
+			stationCount++;
+		}
+
+		memset(header, '\0', sizeof(station_index_header_t));
+		strncpy(header->identifier, STN_INDEX_IDENTIFIER, sizeof(header->identifier));
+		header->version = STN_INDEX_VERSION;
+		header->stationCount = stationCount;
+		header->slotCount = slotCount;
+		header->namesSize = static_cast<UINT32>(names.size());
+
+		buffer->resize(reinterpret_cast<char*>(entries + stationCount) - &(*buffer)[0]);
+		buffer->insert(buffer->end(), names.begin(), names.end());
+
+		attach(&(*buffer)[0], buffer->size(), buffer);
+	}
+
+	// Uses an index held in memory owned by owner (e.g. a mapped index
+	// file).  Returns false if data does not hold a valid index.
+	bool attach(const char* data, const std::size_t size, const boost::shared_ptr<const void>& owner)
+	{
+		clear();
+
+		if (size < sizeof(station_index_header_t))
+			return false;
+
+		const station_index_header_t* header(reinterpret_cast<const station_index_header_t*>(data));
+		if (strncmp(header->identifier, STN_INDEX_IDENTIFIER, sizeof(header->identifier)) != 0 ||
+			header->version != STN_INDEX_VERSION ||
+			header->slotCount == 0 ||
+			(header->slotCount & (header->slotCount - 1)) != 0 ||
+			header->slotCount <= header->stationCount)
+			return false;
+
+		if (size != sizeof(station_index_header_t) +
+			static_cast<std::size_t>(header->slotCount) * sizeof(station_index_slot_t) +
+			static_cast<std::size_t>(header->stationCount) * sizeof(station_index_entry_t) +
+			header->namesSize)
+			return false;
+
+		const station_index_slot_t* slots(reinterpret_cast<const station_index_slot_t*>(header + 1));
+		const station_index_entry_t* entries(reinterpret_cast<const station_index_entry_t*>(slots + header->slotCount));
+
+		UINT32 i;
+		for (i=0; i<header->slotCount; ++i)
+			if (slots[i].entry != npos && slots[i].entry >= header->stationCount)
+				return false;
+		for (i=0; i<header->stationCount; ++i)
+			if (static_cast<std::size_t>(entries[i].nameOffset) + entries[i].nameLength >= header->namesSize)
+				return false;
+
+		header_ = header;
+		slots_ = slots;
+		entries_ = entries;
+		names_ = reinterpret_cast<const char*>(entries + header->stationCount);
+		size_ = size;
+		owner_ = owner;
+		return true;
+	}
+
+	// FNV-1a
+	static inline UINT32 hash(std::string_view name)
+	{
+		UINT32 h(2166136261U);
+		for (std::string_view::const_iterator _it_chr=name.begin(); _it_chr!=name.end(); ++_it_chr)
+		{
+			h ^= static_cast<unsigned char>(*_it_chr);
+			h *= 16777619U;
+		}
+		return h;
+	}
+
+private:
+	const station_index_header_t*	header_;
+	const station_index_slot_t*		slots_;
+	const station_index_entry_t*	entries_;
+	const char*						names_;
+	std::size_t						size_;
+	boost::shared_ptr<const void>	owner_;			// memory holding the index
+};
+
+#endif /* DNASTATIONINDEX_H_ */
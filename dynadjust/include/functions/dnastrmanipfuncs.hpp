@@ -32,6 +32,8 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <string>
+#include <string_view>
+#include <charconv>
 
 #include <algorithm>
 #include <functional>
@@ -142,7 +144,7 @@ T trimstr_(const T& Src, const T& c)
 {
 	size_t p2 = Src.find_last_not_of(c);
 	if (p2 == std::string::npos)
-		return std::string();
+		return T();
 	size_t p1 = Src.find_first_not_of(c);
 	if (p1 == std::string::npos)
 		p1 = 0;
@@ -164,7 +166,7 @@ T trimstrright_(const T& Src, const T& c)
 {
 	size_t p2 = Src.find_last_not_of(c);
 	if (p2 == std::string::npos)
-		return std::string();
+		return T();
 	return Src.substr(0, p2+1);
 }
 
@@ -185,6 +187,21 @@ T trimstrright(const T& Src) {
 	return trimstrright_(Src, static_cast<T>(" \r\n"));
 }
 
+// Trims a string_view in place, i.e. without copying the characters
+inline std::string_view trimstr_view(std::string_view Src) {
+	return trimstr_(Src, std::string_view(" \r\n"));
+}
+
+// Returns the (trimmed) fixed width field of a record beginning at
+// pos.  Like std::string::substr, throws std::out_of_range if pos 
+// lies beyond the end of the record, and truncates the field if 
+// the record ends before pos + width.
+// The returned view refers to the characters in record, so it is
+// only valid for as long as record is.
+inline std::string_view fixed_field(std::string_view record, const size_t pos, const size_t width = std::string_view::npos) {
+	return trimstr_view(record.substr(pos, width));
+}
+
 template <class T, class U>
 std::string StringFromTW(const T& t, const U& width, const U& precision=0)
 {
@@ -265,77 +282,92 @@ S double_string_width(const T value, const U& width)
 
 
 
-// See here for boost::lexical_cast vs sscanf performance 
-// http://www.boost.org/doc/libs/1_48_0/doc/html/boost_lexical_cast/performance.html
-//
-// An interesting article on conversion speeds
-// http://tinodidriksen.com/2011/05/28/cpp-convert-string-to-double-speed/
-
+// Converts the leading decimal number in [first, last) to T, and returns a
+// pointer to the first character not converted.  If no number could be 
+// converted, t is left unchanged and first is returned.
+// std::from_chars does not allocate, is locale independent and gives the
+// correctly rounded (nearest) value.  Unlike from_chars, a leading '+' 
+// is accepted, as per boost::spirit's double_ parser.
 template <class T>
-T DoubleFromString(const std::string& str)
+const char* NumberFromChars(T& t, const char* first, const char* last)
 {
-	T t(0.);
-	parse(str.begin(), str.end(), double_, t);
-	return t;
+	const char* p(first);
+	if (p != last && *p == '+')
+	{
+		++p;
+		if (p != last && *p == '-')
+			return first;
+	}
+
+	T value;
+	std::from_chars_result result(std::from_chars(p, last, value));
+	if (result.ec != std::errc())
+		return first;
+	
+	t = value;
+	return result.ptr;
 }
 
 template <class T>
-T FloatFromString(const std::string& str)
+T DoubleFromString(std::string_view str)
 {
-	T t(0.);
-	parse(str.begin(), str.end(), float_, t);
-	return t;
+	double t(0.);
+	NumberFromChars(t, str.data(), str.data() + str.length());
+	return static_cast<T>(t);
 }
 
 template <class T>
-void DoubleFromString(T& t, const std::string& str)
+T FloatFromString(std::string_view str)
 {
-	parse(str.begin(), str.end(), double_, t);
+	float t(0.);
+	NumberFromChars(t, str.data(), str.data() + str.length());
+	return static_cast<T>(t);
 }
 
 template <class T>
-void FloatFromString(T& t, const std::string& str)
+void DoubleFromString(T& t, std::string_view str)
 {
-	parse(str.begin(), str.end(), float_, t);
+	double d;
+	if (NumberFromChars(d, str.data(), str.data() + str.length()) != str.data())
+		t = static_cast<T>(d);
 }
 
 template <class T>
-bool DoubleFromString_ZeroCheck(T& t, const std::string& str)
+void FloatFromString(T& t, std::string_view str)
 {
-	parse(str.begin(), str.end(), double_, t);
-	if (fabs(t) < PRECISION_1E35)
-		return true;
-	return false;
+	float f;
+	if (NumberFromChars(f, str.data(), str.data() + str.length()) != str.data())
+		t = static_cast<T>(f);
 }
 
 template <class T>
-// signed
-typename std::enable_if<std::is_signed<T>::value, T>::type LongFromString(const std::string& str)
+bool DoubleFromString_ZeroCheck(T& t, std::string_view str)
 {
-	char* end(NULL);
-	T t(strtol(str.c_str(), &end,  10));
-	
-	if (*end)
-	{
-		std::stringstream ss;
-		ss << "String to long conversion error: non-convertible part: " << end;
-		throw boost::enable_current_exception(std::runtime_error(ss.str()));
-	}
-
-	return t;
+	DoubleFromString(t, str);
+	if (fabs(t) < PRECISION_1E35)
+		return true;
+	return false;
 }
 
 template <class T>
-// unsigned
-typename std::enable_if<std::is_unsigned<T>::value, T>::type LongFromString(const std::string& str)
+T LongFromString(std::string_view str)
 {
-	char* end(NULL);
-	T t(strtoul(str.c_str(), &end,  10));
+	// skip leading white space, as per strtol
+	const char* p(str.data());
+	const char* last(str.data() + str.length());
+	while (p != last && isspace(static_cast<unsigned char>(*p)))
+		++p;
+	if (p != last && *p == '+')
+		++p;
+
+	T t(0);
+	std::from_chars_result result(std::from_chars(p, last, t, 10));
 	
-	if (*end)
+	if (result.ptr != last || result.ec == std::errc::result_out_of_range)
 	{
 		std::stringstream ss;
-		ss << "String to long conversion error: non-convertible part: " << end;
+		ss << "String to long conversion error: non-convertible part: " << 
+			std::string_view(result.ptr, last - result.ptr);
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
 
@@ -381,28 +413,28 @@ typename std::enable_if<std::is_unsigned<T>::value, T>::type LongFromString(cons
 //}
 //
 template <class T>
-void FromDmsString(T *d, const std::string& str)
+void FromDmsString(T *d, std::string_view str)
 {
-	DmstoDeg(atof(str.c_str()), d);
+	DmstoDeg(DoubleFromString<double>(str), d);
 }
 
 template <class T>
-T FromDmsString(const std::string& str)
+T FromDmsString(std::string_view str)
 {
-	return DmstoDeg(atof(str.c_str()));
+	return DmstoDeg(DoubleFromString<double>(str));
 }
 
 template <class T>
-void RadFromDmsString(T *d, const std::string& str)
+void RadFromDmsString(T *d, std::string_view str)
 {
-	DmstoDeg(atof(str.c_str()), d);
+	DmstoDeg(DoubleFromString<double>(str), d);
 	Radians(d);
 }
 
 template <class T>
-void RadFromSecondsString(T *d, const std::string& str)
+void RadFromSecondsString(T *d, std::string_view str)
 {
-	*d = SecondstoRadians(atof(str.c_str()));
+	*d = SecondstoRadians(DoubleFromString<double>(str));
 }
 
 template <class T>
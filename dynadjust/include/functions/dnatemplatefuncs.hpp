@@ -1425,18 +1425,18 @@ private:
 };
 
 
-// S = station_t, U = UINT32
-template<typename S, typename U>
+// S = station_t, U = UINT32, R = std::vector<S> or mapped records (see mapped_records)
+template<typename S, typename U, typename R = std::vector<S> >
 class CompareStnFileOrder
 {
 public:
-	CompareStnFileOrder(std::vector<S>* s)
+	CompareStnFileOrder(const R* s)
 		:  _s(s) {}
 	bool operator()(const U& lhs, const U& rhs) {
 		return _s->at(lhs).fileOrder < _s->at(rhs).fileOrder;
 	}
 private:
-	std::vector<S>*	_s;
+	const R*	_s;
 };
 
 
@@ -1534,12 +1534,12 @@ public:
 };
 
 
-// S = station_t, U = UINT32
-template<typename S, typename U>
+// S = station_t, U = UINT32, R = std::vector<S> or mapped records (see mapped_records)
+template<typename S, typename U, typename R = std::vector<S> >
 class CompareStnLongitude
 {
 public:
-	CompareStnLongitude(std::vector<S>* s, bool leftToRight=true)
+	CompareStnLongitude(const R* s, bool leftToRight=true)
 		:  _s(s)
 		, _leftToRight(leftToRight) {}
 	bool operator()(const U& lhs, const U& rhs) {
@@ -1549,7 +1549,7 @@ public:
 			return _s->at(lhs).initialLongitude > _s->at(rhs).initialLongitude;
 	}
 private:
-	std::vector<S>*	_s;
+	const R*	_s;
 	bool		_leftToRight;
 };
 
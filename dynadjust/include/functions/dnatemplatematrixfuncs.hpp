@@ -43,6 +43,7 @@
 #include <include/parameters/dnaellipsoid.hpp>
 #include <include/config/dnatypes.hpp>
 #include <include/math/dnamatrix_contiguous.hpp>
+#include <include/math/dnamatrix_fixed.hpp>
 #include <include/measurement_types/dnameasurement.hpp>
 
 using namespace dynadjust::datum_parameters;
@@ -259,7 +260,7 @@ void Precision_Adjusted_GNSS_bsl(const matrix_2d& mvariances,
 	const UINT32& stn1, const UINT32& stn2,
 	matrix_2d* mvariances_mod, bool FILLLOWER=true)
 {
-	matrix_2d tmp(3, 6);
+	matrix_fixed<T, 3, 6> tmp;
 	mvariances_mod->zero();
 	UINT32 i, j, k;
 
@@ -443,10 +444,8 @@ void ScaleGPSVCV_Cluster(const matrix_2d& mvariances, matrix_2d* mvariances_mod,
 
 template <class T>
 void FormLocaltoCartRotationMatrix(const T& latitude, const T& longitude,
-	matrix_2d& mrotations, bool LOCAL_TO_CART=true)
+	matrix_fixed<T, 3, 3>& mrotations, bool LOCAL_TO_CART=true)
 {
-	mrotations.redim(3, 3);
-
 	T coslat(cos(latitude));
 	T sinlat(sin(latitude));
 	T coslon(cos(longitude));
@@ -483,10 +482,8 @@ void FormLocaltoCartRotationMatrix(const T& latitude, const T& longitude,
 	
 template <class T>
 void FormLocaltoPolarRotationMatrix(const T& azimuth, const T& elevation, const T& distance,
-	matrix_2d& mrotations, bool LOCAL_TO_POLAR=true)
+	matrix_fixed<T, 3, 3>& mrotations, bool LOCAL_TO_POLAR=true)
 {
-	mrotations.redim(3, 3);
-
 	T cos_azimuth(cos(azimuth));
 	T sin_azimuth(sin(azimuth));
 	T cos_elevation(cos(elevation));
@@ -521,24 +518,21 @@ void FormLocaltoPolarRotationMatrix(const T& azimuth, const T& elevation, const
 	}
 }
 
-template <class T>
-void PropagateVariances_CartLocal_Diagonal(const matrix_2d& mvariances, matrix_2d& mvariances_mod, 
+// M is matrix_2d or matrix_fixed<T, 3, 3>
+template <class T, class M>
+void PropagateVariances_CartLocal_Diagonal(const M& mvariances, M& mvariances_mod, 
 								  const T& latitude, const T& longitude,
-								  matrix_2d& mrotations, bool CALCULATE_ROTATIONS=false)
+								  matrix_fixed<T, 3, 3>& mrotations, bool CALCULATE_ROTATIONS=false)
 {
 	if (CALCULATE_ROTATIONS)
 		FormLocaltoCartRotationMatrix<T>(latitude, longitude, mrotations);
 
-	//matrix_2d mrotations_T(mrotations.rows(), mrotations.columns());
-	matrix_2d rtv(mrotations.rows(), mrotations.columns());
-
-	//mrotations_T.transpose(mrotations);
+	matrix_fixed<T, 3, 3> mvar(mvariances), rtv;
 	
 	mvariances_mod.redim(3, 3);
 	
 	// RtV
-	//rtv.multiply(mrotations_T, mvariances);
-	rtv.multiply_mkl(mrotations, "T", mvariances, "N");
+	rtv.multiply_tn(mrotations, mvar);
 	
 	UINT32 row, col, i;
 	
@@ -556,24 +550,21 @@ void PropagateVariances_CartLocal_Diagonal(const matrix_2d& mvariances, matrix_2
 }
 
 
-template <class T>
-void PropagateVariances_LocalPolar_Diagonal(const matrix_2d& mvariances, matrix_2d& mvariances_mod, 
+// M is matrix_2d or matrix_fixed<T, 3, 3>
+template <class T, class M>
+void PropagateVariances_LocalPolar_Diagonal(const M& mvariances, M& mvariances_mod, 
 								  const T& azimuth, const T& elevation, const T& distance,
-								  matrix_2d& mrotations, bool CALCULATE_ROTATIONS=false)
+								  matrix_fixed<T, 3, 3>& mrotations, bool CALCULATE_ROTATIONS=false)
 {
 	if (CALCULATE_ROTATIONS)
 		FormLocaltoPolarRotationMatrix<T>(azimuth, elevation, distance, mrotations);
 
-	matrix_2d mrotations_T(mrotations.rows(), mrotations.columns());
-	matrix_2d rtv(mrotations.rows(), mrotations.columns());
-
-	mrotations_T.transpose(mrotations);
+	matrix_fixed<T, 3, 3> mvar(mvariances), rtv;
 	
 	mvariances_mod.redim(3, 3);
 	
 	// RtV
-	//rtv.multiply(mrotations, mvariances);
-	rtv.multiply_mkl(mrotations, "N", mvariances, "N");
+	rtv.multiply(mrotations, mvar);
 
 	UINT32 row, col, i;
 	
@@ -585,69 +576,72 @@ void PropagateVariances_LocalPolar_Diagonal(const matrix_2d& mvariances, matrix_
 			if (row != col)
 				continue;
 			for (i=0; i<3; ++i)
-				mvariances_mod.elementadd(row, col, rtv.get(row, i) * mrotations_T.get(i, col));
+				mvariances_mod.elementadd(row, col, rtv.get(row, i) * mrotations.get(col, i));
 		}
 	}
 }
 
 
-template <class T>
-void PropagateVariances_LocalCart(const matrix_2d& mvariances, matrix_2d& mvariances_mod, 
+// M is matrix_2d or matrix_fixed<T, 3, 3>
+template <class T, class M>
+void PropagateVariances_LocalCart(const M& mvariances, M& mvariances_mod, 
 								  const T& latitude, const T& longitude, bool LOCAL_TO_CART,
-								  matrix_2d& mrotations, bool CALCULATE_ROTATIONS=false)
+								  matrix_fixed<T, 3, 3>& mrotations, bool CALCULATE_ROTATIONS=false)
 {
 	if (CALCULATE_ROTATIONS)
 		FormLocaltoCartRotationMatrix<T>(latitude, longitude, mrotations);
 
-	// form transpose, from either passed in matrix or newly formed matrix
-	matrix_2d mrotations_T(mrotations.rows(), mrotations.columns());
-	mrotations_T.transpose(mrotations);
+	matrix_fixed<T, 3, 3> mvar(mvariances), mV;
 
 	// the rotation matrix is in the direction local to cart (forward)
 	if (LOCAL_TO_CART)
 	{
 		// Vc = R * Vl * RT
-		//matrix_2d mV(mvariances_mod.multiply(mrotations, mvariances));
-		matrix_2d mV(mvariances_mod.multiply_mkl(mrotations, "N", mvariances, "N"));
-		//mvariances_mod.multiply_square(mV, mrotations_T);
-		mvariances_mod.multiply_mkl(mV, "N", mrotations, "T");
+		mV.multiply(mrotations, mvar);
+		mvar.multiply_nt(mV, mrotations);
 	}
 	else
 	{
 		// Vc = R-1 * Vc * [R-1]T
 		//    = RT * Vc * R (since R is orthogonal)
-		//matrix_2d mV(mvariances_mod.multiply(mrotations_T, mvariances));
-		matrix_2d mV(mvariances_mod.multiply_mkl(mrotations, "T", mvariances, "N"));
-		//mvariances_mod.multiply_square(mV, mrotations);
-		mvariances_mod.multiply_mkl(mV, "N", mrotations, "N");
+		mV.multiply_tn(mrotations, mvar);
+		mvar.multiply(mV, mrotations);
 	}
+
+	mvariances_mod.redim(3, 3);
+	mvar.copyto(mvariances_mod);
 }
 
-template <class T>
-void PropagateVariances_LocalCart(const matrix_2d& mvariances, matrix_2d& mvariances_mod, 
+// M is matrix_2d or matrix_fixed<T, 3, 3>
+template <class T, class M>
+void PropagateVariances_LocalCart(const M& mvariances, M& mvariances_mod, 
 								  const T& latitude, const T& longitude, bool LOCAL_TO_CART)
 {
-	matrix_2d mrotations;
+	matrix_fixed<T, 3, 3> mrotations;
 
 	PropagateVariances_LocalCart<T>(mvariances, mvariances_mod, 
 		latitude, longitude, LOCAL_TO_CART,
 		mrotations, true);	// calculate rotations
 }
 
-template <class T>
-void Rotate_LocalCart(const matrix_2d mvector, matrix_2d* mvector_mod, 
+// M is matrix_2d or matrix_fixed<T, 3, 1>
+template <class T, class M>
+void Rotate_LocalCart(const M& mvector, M* mvector_mod, 
 								  const T& latitude, const T& longitude)
 {
-	matrix_2d mrotations(3, 3);
+	matrix_fixed<T, 3, 3> mrotations;
 	FormLocaltoCartRotationMatrix<T>(latitude, longitude, mrotations);
 
+	matrix_fixed<T, 3, 1> mvec(mvector), mvec_mod;
+	mvec_mod.multiply(mrotations, mvec);
+
 	mvector_mod->redim(3, 1);
-	//mvector_mod->multiply(mrotations, mvector);
-	mvector_mod->multiply_mkl(mrotations, "N", mvector, "N");
+	mvec_mod.copyto(*mvector_mod);
 }
 
-template <class T>
-void Rotate_CartLocal(const matrix_2d mvector, matrix_2d* mvector_mod, 
+// M is matrix_2d or matrix_fixed<T, 3, 1>
+template <class T, class M>
+void Rotate_CartLocal(const M& mvector, M* mvector_mod, 
 								  const T& latitude, const T& longitude)
 {
 	// Helps
@@ -656,20 +650,24 @@ void Rotate_CartLocal(const matrix_2d mvector, matrix_2d* mvector_mod,
 	T sin_long(sin(longitude));
 	T cos_long(cos(longitude));
 
+	// mvector and mvector_mod may be the same matrix
+	T x(mvector.get(0,0)), y(mvector.get(1,0)), z(mvector.get(2,0));
+
 	mvector_mod->redim(3, 1);
 	
-	mvector_mod->put(0, 0, -sin_long * mvector.get(0,0) + cos_long * mvector.get(1,0));
-	mvector_mod->put(1, 0, -sin_lat * cos_long * mvector.get(0,0) -
-		sin_lat * sin_long * mvector.get(1,0) +
-		cos_lat * mvector.get(2,0));
-	mvector_mod->put(2, 0, cos_lat * cos_long * mvector.get(0,0) +
-		cos_lat * sin_long * mvector.get(1,0) +
-		sin_lat * mvector.get(2,0));
+	mvector_mod->put(0, 0, -sin_long * x + cos_long * y);
+	mvector_mod->put(1, 0, -sin_lat * cos_long * x -
+		sin_lat * sin_long * y +
+		cos_lat * z);
+	mvector_mod->put(2, 0, cos_lat * cos_long * x +
+		cos_lat * sin_long * y +
+		sin_lat * z);
 }
 
 
-template <class T>
-void Rotate_LocalPolar(const matrix_2d mvector, matrix_2d* mvector_mod, 
+// M is matrix_2d or matrix_fixed<T, 3, 1>
+template <class T, class M>
+void Rotate_LocalPolar(const M& mvector, M* mvector_mod, 
 								  const T& azimuth, const T& elevation, const T& distance)
 {
 	// Helps
@@ -677,16 +675,19 @@ void Rotate_LocalPolar(const matrix_2d mvector, matrix_2d* mvector_mod,
 	T cos_azimuth(cos(azimuth));
 	T sin_elevation(sin(elevation));
 	T cos_elevation(cos(elevation));
+
+	// mvector and mvector_mod may be the same matrix
+	T x(mvector.get(0,0)), y(mvector.get(1,0)), z(mvector.get(2,0));
 	
 	mvector_mod->redim(3, 1);
 	
-	mvector_mod->put(0, 0, -cos_azimuth * mvector.get(0,0) - sin_azimuth * mvector.get(1,0));
-	mvector_mod->put(1, 0, -sin_elevation * sin_azimuth * mvector.get(0,0) -
-		sin_elevation * cos_azimuth * mvector.get(1,0) +
-		cos_elevation * mvector.get(2,0));
-	mvector_mod->put(2, 0, cos_elevation * sin_azimuth * mvector.get(0,0) +
-		cos_elevation * cos_azimuth * mvector.get(1,0) +
-		sin_elevation * mvector.get(2,0));
+	mvector_mod->put(0, 0, -cos_azimuth * x - sin_azimuth * y);
+	mvector_mod->put(1, 0, -sin_elevation * sin_azimuth * x -
+		sin_elevation * cos_azimuth * y +
+		cos_elevation * z);
+	mvector_mod->put(2, 0, cos_elevation * sin_azimuth * x +
+		cos_elevation * cos_azimuth * y +
+		sin_elevation * z);
 }
 
 
@@ -694,10 +695,8 @@ template <class T>
 // rotx is x rotation in radians
 // roty is y rotation in radians
 // rotz is z rotation in radians
-void FormHelmertRotationMatrix(const T& rotx, const T& roty, const T& rotz, matrix_2d& mrotations, bool RIGOROUS=false)
+void FormHelmertRotationMatrix(const T& rotx, const T& roty, const T& rotz, matrix_fixed<T, 3, 3>& mrotations, bool RIGOROUS=false)
 {
-	mrotations.redim(3, 3);
-
 	// Which rotation matrix is required?
 	// Convert to seconds for the test
 	if (RIGOROUS)
@@ -762,10 +761,11 @@ void ReduceParameters(const T* parameters, T* reduced_parameters, const T& elaps
 	reduced_parameters[6] = SecondstoRadians(reduced_parameters[6]) / 1000.; 
 }
 
-template <class T>
+template <class T, class M>
 // No check or safe guard in place to test if mcoordinates_mod is a reference to mcoordinates
-void TransformCartesian(const matrix_2d& mcoordinates, matrix_2d& mcoordinates_mod, 
-	const matrix_2d& parameters, const matrix_2d& mrotations)
+// M is matrix_2d or matrix_fixed<T, 3, 1>
+void TransformCartesian(const M& mcoordinates, M& mcoordinates_mod, 
+	const matrix_fixed<T, 4, 1>& parameters, const matrix_fixed<T, 3, 3>& mrotations)
 {
 	// Add rotation and scale contributions
 	for (UINT16 i(0), j; i<3; ++i)
@@ -784,8 +784,9 @@ void TransformCartesian(const matrix_2d& mcoordinates, matrix_2d& mcoordinates_m
 	}
 }
 
-template <class T>
-void Transform_7parameter(const matrix_2d& mcoordinates, matrix_2d& mcoordinates_mod, const T parameters[])
+// M is matrix_2d or matrix_fixed<T, 3, 1>
+template <class T, class M>
+void Transform_7parameter(const M& mcoordinates, M& mcoordinates_mod, const T parameters[])
 {
 	mcoordinates_mod.redim(3, 1);
 
@@ -794,11 +795,13 @@ void Transform_7parameter(const matrix_2d& mcoordinates, matrix_2d& mcoordinates
 		RIGOROUS = true;
 
 	// Form rotation matrix
-	matrix_2d mrotations(3, 3);
+	matrix_fixed<T, 3, 3> mrotations;
 	FormHelmertRotationMatrix<T>(parameters[4], parameters[5], parameters[6], mrotations, RIGOROUS);
 	
 	// Put translations and scale into reducedParameters
-	matrix_2d mtrans_scale(4, 1, parameters, 4);
+	matrix_fixed<T, 4, 1> mtrans_scale;
+	for (UINT16 i(0); i<4; ++i)
+		mtrans_scale[i] = parameters[i];
 
 	// Transform
 	TransformCartesian<T>(mcoordinates, mcoordinates_mod, 
@@ -828,8 +831,9 @@ void PositionalUncertainty(const T& semimajor, const T& semiminor, const T& sdHt
 	vtPosU_Radius = sdHt * 1.96;
 }
 
-template <typename T>
-T PedalVariance(const matrix_2d& mvariance, const T& direction)
+// M is matrix_2d or matrix_fixed<T, 3, 3>
+template <typename T, class M>
+T PedalVariance(const M& mvariance, const T& direction)
 {
 	T cos_theta(cos(direction));
 	T sin_theta(sin(direction));
@@ -839,8 +843,9 @@ T PedalVariance(const matrix_2d& mvariance, const T& direction)
 }
 	
 
-template <typename T>
-void ErrorEllipseParameters(const matrix_2d& mvariance, T& semimajor, T& semiminor, T& azimuth)
+// M is matrix_2d or matrix_fixed<T, 3, 3>
+template <typename T, class M>
+void ErrorEllipseParameters(const M& mvariance, T& semimajor, T& semiminor, T& azimuth)
 {
 	semimajor = semiminor = azimuth = -1.;
 
@@ -134,11 +134,12 @@ void GetMsrStations(const vmsr_t& binaryMsrs, const T& bmsIndex, std::vector<T>&
 	strip_duplicates(msrStations);
 }
 
-template <typename T>
+template <typename T, typename MsrRecords>
 // Get all the binary measurement indices involved in a measurement
 // On return, msrIndices will contain only one index.  For clusters
 // and directions, msrIndices will be more than one.
-void GetMsrIndices(const vmsr_t& binaryMsrs, const T& bmsIndex, std::vector<T>& msrIndices)
+// MsrRecords may be vmsr_t, or mapped records (see mapped_records)
+void GetMsrIndices(const MsrRecords& binaryMsrs, const T& bmsIndex, std::vector<T>& msrIndices)
 {
 	msrIndices.clear();
 
@@ -160,8 +161,8 @@ void GetMsrIndices(const vmsr_t& binaryMsrs, const T& bmsIndex, std::vector<T>&
 	// Ok, now deal with cluster measurements
 	UINT32 clusterID(binaryMsrs.at(bmsIndex).clusterID);
 
-	it_vmsr_t_const _it_msr_start(binaryMsrs.begin() + bmsIndex);
-	it_vmsr_t_const _it_msr_prev(_it_msr_start);
+	typename MsrRecords::const_iterator _it_msr_start(binaryMsrs.begin() + bmsIndex);
+	typename MsrRecords::const_iterator _it_msr_prev(_it_msr_start);
 	
 	// move to the beginning of the cluster
 	while (_it_msr_start != binaryMsrs.begin())
@@ -813,7 +814,7 @@ public:
 template <typename M = CDnaMeasurement>
 class CompareMsr {
 public:
-	bool operator()(const boost::shared_ptr<M> left, const boost::shared_ptr<M> right) {
+	bool operator()(const boost::shared_ptr<M>& left, const boost::shared_ptr<M>& right) {
 		if (left->GetIgnore() == right->GetIgnore()) {
 			if (boost::iequals(left->GetType(), right->GetType()))
 			{
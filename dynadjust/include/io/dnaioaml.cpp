@@ -28,6 +28,17 @@ namespace dynadjust {
 namespace iostreams {
 
 void dna_io_aml::load_aml_file(const std::string& aml_filename, v_aml_pair* vbinary_aml, pvmsr_t bmsRecords)
+{
+	load_aml_records(aml_filename, vbinary_aml, *bmsRecords);
+}
+
+void dna_io_aml::load_aml_file(const std::string& aml_filename, v_aml_pair* vbinary_aml, const mapped_msr_t& bmsRecords)
+{
+	load_aml_records(aml_filename, vbinary_aml, bmsRecords);
+}
+
+template <typename MsrRecords>
+void dna_io_aml::load_aml_records(const std::string& aml_filename, v_aml_pair* vbinary_aml, const MsrRecords& bmsRecords)
 {	
 	std::ifstream aml_file;
 	std::stringstream ss;
@@ -69,7 +80,7 @@ void dna_io_aml::load_aml_file(const std::string& aml_filename, v_aml_pair* vbin
 			aml_file.read(reinterpret_cast<char *>(&msrValue), sizeof(UINT32));
 			// Ignored measurements are retained in the AML, so consume them!
 			_it_aml->bmsr_index = msrValue;
-			if (bmsRecords->at(msrValue).ignore)
+			if (bmsRecords.at(msrValue).ignore)
 				_it_aml->consume();
 		}
 
@@ -144,7 +155,7 @@ void dna_io_aml::write_aml_file(const std::string& aml_filename, pvUINT32 vbinar
 }
 
 void dna_io_aml::create_msr_to_stn_tally(const pvASLPtr vAssocStnList, v_aml_pair& vAssocMsrList, 
-	vmsrtally& stnmsrTally, vmsr_t& bmsBinaryRecords)
+	vmsrtally& stnmsrTally, const mapped_msr_t& bmsBinaryRecords)
 {	
 	stnmsrTally.clear();
 	stnmsrTally.resize(vAssocStnList->size());
@@ -171,7 +182,7 @@ void dna_io_aml::create_msr_to_stn_tally(const pvASLPtr vAssocStnList, v_aml_pai
 }
 	
 	
-void dna_io_aml::write_msr_to_stn(std::ostream &os, pvstn_t bstBinaryRecords, 
+void dna_io_aml::write_msr_to_stn(std::ostream &os, const mapped_stn_t& bstBinaryRecords, 
 	pvUINT32 vStationList, vmsrtally& v_stnmsrTally, MsrTally* parsemsrTally)
 {
 	// Print measurement to station summary header
@@ -186,7 +197,7 @@ void dna_io_aml::write_msr_to_stn(std::ostream &os, pvstn_t bstBinaryRecords,
 	// Print measurements to each station and the total count for each station
 	for (_it_stn=vStationList->begin(); _it_stn != vStationList->end(); ++_it_stn)
 	{
-		v_stnmsrTally.at(*_it_stn).coutSummaryMsrToStn(os, bstBinaryRecords->at(*_it_stn).stationName);
+		v_stnmsrTally.at(*_it_stn).coutSummaryMsrToStn(os, bstBinaryRecords.at(*_it_stn).stationName);
 
 		// Test for possible redundancies
 		if ((v_stnmsrTally.at(*_it_stn).MeasurementCount('G') ||
@@ -201,7 +212,7 @@ void dna_io_aml::write_msr_to_stn(std::ostream &os, pvstn_t bstBinaryRecords,
 			v_stnmsrTally.at(*_it_stn).MeasurementCount('J')))
 		{
 			msrRedundancies++;
-			stationRedundantMsrs.push_back(bstBinaryRecords->at(*_it_stn).stationName);
+			stationRedundantMsrs.push_back(bstBinaryRecords.at(*_it_stn).stationName);
 		}
 	}
 	
@@ -242,7 +253,7 @@ void dna_io_aml::write_msr_to_stn(std::ostream &os, pvstn_t bstBinaryRecords,
 				v_stnmsrTally.at(*_it_stn).MeasurementCount('I') ||
 				v_stnmsrTally.at(*_it_stn).MeasurementCount('J')))
 			{
-				v_stnmsrTally.at(*_it_stn).coutSummaryMsrToStn_Compressed(os, bstBinaryRecords->at(*_it_stn).stationName);
+				v_stnmsrTally.at(*_it_stn).coutSummaryMsrToStn_Compressed(os, bstBinaryRecords.at(*_it_stn).stationName);
 			}
 		}	
 	}
@@ -251,15 +262,15 @@ void dna_io_aml::write_msr_to_stn(std::ostream &os, pvstn_t bstBinaryRecords,
 
 void dna_io_aml::write_aml_file_txt(const std::string& bms_filename, const std::string& aml_filename, pvUINT32 vbinary_aml, const pvASLPtr vAssocStnList, vdnaStnPtr* vStations)
 {	
-	vmsr_t binaryMsrRecords;
+	mapped_msr_t binaryMsrRecords;
 	std::stringstream ss;
 	ss << "write_aml_file(): An error was encountered when opening " << bms_filename << "." << std::endl;
 
 	binary_file_meta_t bms_meta;
 	try {
 		dna_io_bms bms;
-		// Load binary stations data.  Throws runtime_error on failure.
-		bms.load_bms_file(bms_filename, &binaryMsrRecords, bms_meta);
+		// Map binary measurements data.  Throws runtime_error on failure.
+		bms.map_bms_file(bms_filename, binaryMsrRecords, bms_meta);
 	}
 	catch (const std::runtime_error& e) {
 		ss << e.what();
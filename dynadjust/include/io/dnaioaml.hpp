@@ -31,6 +31,7 @@
 
 #include <include/io/dnaiobase.hpp>
 #include <include/io/dnaiobms.hpp>
+#include <include/io/dnaiomapped.hpp>
 
 namespace dynadjust {
 namespace iostreams {
@@ -45,16 +46,20 @@ public:
 	dna_io_aml& operator=(const dna_io_aml& rhs);
 
 	void load_aml_file(const std::string& aml_filename, v_aml_pair* vbinary_aml, pvmsr_t bmsRecords);
+	void load_aml_file(const std::string& aml_filename, v_aml_pair* vbinary_aml, const mapped_msr_t& bmsRecords);
 	void write_aml_file(const std::string& aml_filename, pvUINT32 vbinary_aml);
 	void write_aml_file_txt(const std::string& bms_filename, const std::string& aml_filename, pvUINT32 vbinary_aml, const pvASLPtr vAssocStnList, vdnaStnPtr* vStations);
 
 	void create_msr_to_stn_tally(const pvASLPtr vAssocStnList, v_aml_pair& vAssocMsrList, 
-		vmsrtally& stnmsrTally, vmsr_t& bmsBinaryRecords);
+		vmsrtally& stnmsrTally, const mapped_msr_t& bmsBinaryRecords);
 
-	void write_msr_to_stn(std::ostream &os, pvstn_t bstBinaryRecords, 
+	void write_msr_to_stn(std::ostream &os, const mapped_stn_t& bstBinaryRecords, 
 		pvUINT32 vStationList, vmsrtally& v_stnmsrTally, MsrTally* parsemsrTally);
 	
 protected:
+	// MsrRecords may be vmsr_t or mapped_msr_t
+	template <typename MsrRecords>
+	void load_aml_records(const std::string& aml_filename, v_aml_pair* vbinary_aml, const MsrRecords& bmsRecords);
 
 };
 
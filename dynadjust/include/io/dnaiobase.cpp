@@ -102,6 +102,15 @@ void dna_io_base::writeFileMetadata(std::ofstream& file_stream, binary_file_meta
 		file_stream.write(reinterpret_cast<char *>(&file_meta.inputFileMeta[i].filetype), sizeof(UINT16)); 
 		file_stream.write(reinterpret_cast<char *>(&file_meta.inputFileMeta[i].datatype), sizeof(UINT16)); 
 	}
+
+	// Pad the metadata so that the records which follow are aligned
+	if (alignedRecords())
+	{
+		const char padding[binary_record_alignment] = { '\0' };
+		std::streamoff offset(file_stream.tellp() % binary_record_alignment);
+		if (offset > 0)
+			file_stream.write(padding, binary_record_alignment - offset);
+	}
 }
 	
 
@@ -134,6 +143,14 @@ void dna_io_base::readFileMetadata(std::ifstream& file_stream, binary_file_meta_
 		file_stream.read(reinterpret_cast<char *>(&file_meta.inputFileMeta[i].filetype), sizeof(UINT16)); 
 		file_stream.read(reinterpret_cast<char *>(&file_meta.inputFileMeta[i].datatype), sizeof(UINT16)); 
 	}
+
+	// Skip the padding which aligns the records
+	if (alignedRecords())
+	{
+		std::streamoff offset(file_stream.tellg() % binary_record_alignment);
+		if (offset > 0)
+			file_stream.seekg(binary_record_alignment - offset, std::ios::cur);
+	}
 }
 	
 
@@ -29,6 +29,7 @@
 	#endif
 #endif
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <iomanip>
@@ -36,6 +37,11 @@
 
 #define __FILE_VERSION__ "1.0"
 
+// Binary station and measurement files of this version and later pad the
+// metadata so that the records which follow are aligned, and so may be
+// used in place when mapped (see mapped_records)
+#define __ALIGNED_RECORDS_FILE_VERSION__ "1.1"
+
 namespace dynadjust {
 namespace iostreams {
 
@@ -54,10 +60,15 @@ namespace iostreams {
 //  "VERSION          0.1CREATED ON2013-03-01CREATED BY   THE_APP"
 
 const UINT16 identifier_field_width(10);
+const UINT16 binary_record_alignment(8);
 const char* const version_header     = "VERSION   ";	// 10 characters
 const char* const create_date_header = "CREATED ON";	// 10 characters
 const char* const create_by_header   = "CREATED BY";	// 10 characters
 
+// FNV-1a (64 bit) offset basis and prime
+const std::uint64_t FNV_HASH_BASIS = 14695981039346656037ULL;
+const std::uint64_t FNV_HASH_PRIME = 1099511628211ULL;
+
 class dna_io_base
 {
 public:
@@ -76,6 +87,9 @@ public:
 	void writeFileMetadata(std::ofstream& file_stream, binary_file_meta_t& file_meta);
 	void readFileMetadata(std::ifstream& file_stream, binary_file_meta_t& file_meta);
 
+	// Are the records of the file read (or to be written) aligned?
+	inline bool alignedRecords() const { return m_strVersion >= __ALIGNED_RECORDS_FILE_VERSION__; }
+
 protected:
 
 	void writeVersion(std::ofstream& file_stream);
@@ -85,6 +99,16 @@ protected:
 	void writeApp(std::ofstream& file_stream);
 	void readApp(std::ifstream& file_stream);
 
+	// Adds size bytes of data to an FNV-1a hash (begun with FNV_HASH_BASIS)
+	static inline void hash_bytes(std::uint64_t& hash, const char* data, const std::size_t size)
+	{
+		for (std::size_t i(0); i<size; ++i)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= FNV_HASH_PRIME;
+		}
+	}
+
 	std::string	m_strVersion;
 	std::string	m_strDate;
 	std::string	m_strApp;
@@ -64,10 +64,11 @@ UINT16 dna_io_bms::create_msr_input_file_meta(vifm_t& vinput_file_meta, input_fi
 	return msr_file_count;
 }
 
-void dna_io_bms::load_bms_file_meta(const std::string& bms_filename, binary_file_meta_t& bms_meta) 
+std::size_t dna_io_bms::load_bms_file_meta(const std::string& bms_filename, binary_file_meta_t& bms_meta) 
 {
 	std::ifstream bms_file;
 	std::stringstream ss;
+	std::size_t offset(0);
 	ss << "load_bms_file(): An error was encountered when opening " << bms_filename << "." << std::endl;
 
 	try {
@@ -91,6 +92,9 @@ void dna_io_bms::load_bms_file_meta(const std::string& bms_filename, binary_file
 		
 		// read the metadata
 		readFileMetadata(bms_file, bms_meta);
+
+		// the records follow the metadata
+		offset = static_cast<std::size_t>(bms_file.tellg());
 	}
 	catch (const std::ios_base::failure& f) {
 		ss << f.what();
@@ -105,17 +109,89 @@ void dna_io_bms::load_bms_file_meta(const std::string& bms_filename, binary_file
 	}
 	
 	bms_file.close();
+
+	return offset;
 }
 	
 UINT32 dna_io_bms::load_bms_file(const std::string& bms_filename, pvmsr_t vbinary_msr, binary_file_meta_t& bms_meta) 
 {	
-	std::ifstream bms_file;
+	// Map the records, then copy them in one block
+	mapped_msr_t mapped_msr;
+	map_bms_file(bms_filename, mapped_msr, bms_meta);
+	vbinary_msr->insert(vbinary_msr->end(), mapped_msr.begin(), mapped_msr.end());
+
+	return bms_meta.binCount;
+}
+
+UINT32 dna_io_bms::map_bms_file(const std::string& bms_filename, mapped_msr_t& mapped_msr, binary_file_meta_t& bms_meta,
+	const boost::interprocess::mode_t mode)
+{
+	// read the file information and metadata
+	std::size_t offset(load_bms_file_meta(bms_filename, bms_meta));
+
 	std::stringstream ss;
-	ss << "load_bms_file(): An error was encountered when opening " << bms_filename << "." << std::endl;
+	ss << "map_bms_file(): An error was encountered when mapping " << bms_filename << "." << std::endl;
 
 	try {
-		// open binary measurements file.  Throws runtime_error on failure.
-		file_opener(bms_file, bms_filename, std::ios::in | std::ios::binary, binary, true);
+		if (boost::filesystem::file_size(bms_filename) < offset + bms_meta.binCount * sizeof(measurement_t))
+			throw boost::enable_current_exception(std::runtime_error("  The file does not hold all of its records."));
+		
+		mapped_msr.map(bms_filename, offset, bms_meta.binCount, mode);
+	}
+	catch (const boost::interprocess::interprocess_exception& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	catch (const std::runtime_error& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	return bms_meta.binCount;
+}
+
+void dna_io_bms::update_bms_file(const std::string& bms_filename, pvmsr_t vbinary_msr, binary_file_meta_t& bms_meta)
+{
+	// binary files are written with aligned records
+	setVersion(__ALIGNED_RECORDS_FILE_VERSION__);
+
+	// Can the file be updated in place?  Only if the file information and
+	// metadata occupy the same length, and the file holds the same number 
+	// of records
+	std::size_t offset(0);
+	bool inPlace(false);
+	
+	try {
+		if (boost::filesystem::exists(bms_filename))
+		{
+			dna_io_bms bms;
+			binary_file_meta_t file_meta;
+			offset = bms.load_bms_file_meta(bms_filename, file_meta);
+			inPlace = bms.getVersion() == getVersion() &&
+				file_meta.inputFileCount == bms_meta.inputFileCount &&
+				file_meta.binCount == vbinary_msr->size() &&
+				boost::filesystem::file_size(bms_filename) == offset + vbinary_msr->size() * sizeof(measurement_t);
+		}
+	}
+	catch (const std::runtime_error&) {
+		// An unreadable file is replaced
+		inPlace = false;
+	}
+
+	if (!inPlace)
+	{
+		write_bms_file(bms_filename, vbinary_msr, bms_meta);
+		return;
+	}
+
+	std::ofstream bms_file;
+	std::stringstream ss;
+	ss << "update_bms_file(): An error was encountered when opening " << bms_filename << "." << std::endl;
+
+	try {
+		// open binary measurements file without truncating it.  Throws runtime_error on failure.
+		file_opener(bms_file, bms_filename,
+			std::ios::in | std::ios::out | std::ios::binary, binary, true);
 	}
 	catch (const std::runtime_error& e) {
 		ss << e.what();
@@ -124,43 +200,40 @@ UINT32 dna_io_bms::load_bms_file(const std::string& bms_filename, pvmsr_t vbinar
 	catch (...) {
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	
-	measurement_t measRecord;
-	UINT32 msr;
 
 	ss.str("");
-	ss << "load_bms_file(): An error was encountered when reading from " << bms_filename << "." << std::endl;
+	ss << "update_bms_file(): An error was encountered when writing to " << bms_filename << "." << std::endl;
 
 	try {
-		// read the file information 
-		readFileInfo(bms_file);
+		// write the file information
+		writeFileInfo(bms_file);
 		
-		// read the metadata
-		readFileMetadata(bms_file, bms_meta);
+		// write the metadata
+		writeFileMetadata(bms_file, bms_meta);
 
-		// read the bms data
-		vbinary_msr->reserve(bms_meta.binCount);
-		for (msr=0; msr<bms_meta.binCount; msr++)
+		bms_file.close();
+
+		// write the bms data through a mapping of the records
+		if (!vbinary_msr->empty())
 		{
-			bms_file.read(reinterpret_cast<char *>(&measRecord), sizeof(measurement_t));
-			vbinary_msr->push_back(measRecord);
+			mapped_msr_t mapped_msr;
+			mapped_msr.map(bms_filename, offset, vbinary_msr->size(), boost::interprocess::read_write);
+			memcpy(mapped_msr.data(), &(*vbinary_msr)[0], vbinary_msr->size() * sizeof(measurement_t));
+			mapped_msr.flush();
 		}
 	}
 	catch (const std::ios_base::failure& f) {
 		ss << f.what();
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	catch (const std::runtime_error& e) {
+	catch (const boost::interprocess::interprocess_exception& e) {
 		ss << e.what();
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	catch (...) {
+	catch (const std::runtime_error& e) {
+		ss << e.what();
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	
-	bms_file.close();
-
-	return bms_meta.binCount;
 }
 
 void dna_io_bms::write_bms_file(const std::string& bms_filename, pvmsr_t vbinary_msr, binary_file_meta_t& bms_meta)
@@ -185,6 +258,9 @@ void dna_io_bms::write_bms_file(const std::string& bms_filename, pvmsr_t vbinary
 	ss.str("");
 	ss << "write_bms_file(): An error was encountered when writing to " << bms_filename << "." << std::endl;
 
+	// binary files are written with aligned records
+	setVersion(__ALIGNED_RECORDS_FILE_VERSION__);
+
 	try {
 		// write the file information
 		writeFileInfo(bms_file);
@@ -237,6 +313,9 @@ void dna_io_bms::write_bms_file(const std::string& bms_filename, vdnaMsrPtr* vMe
 	_it_vdnamsrptr _it_msr;
 	UINT32 msrIndex(0);
 
+	// binary files are written with aligned records
+	setVersion(__ALIGNED_RECORDS_FILE_VERSION__);
+
 	try {
 		// write the file information
 		writeFileInfo(bms_file);
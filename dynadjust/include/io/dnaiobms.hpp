@@ -30,6 +30,7 @@
 #endif
 
 #include <include/io/dnaiobase.hpp>
+#include <include/io/dnaiomapped.hpp>
 #include <include/config/dnatypes.hpp>
 #include <include/measurement_types/dnameasurement.hpp>
 
@@ -48,8 +49,16 @@ public:
 	dna_io_bms& operator=(const dna_io_bms& rhs);
 
 	UINT16 create_msr_input_file_meta(vifm_t& vinput_file_meta, input_file_meta_t** input_file_meta);
-	void load_bms_file_meta(const std::string& bms_filename, binary_file_meta_t& bms_meta);
+	std::size_t load_bms_file_meta(const std::string& bms_filename, binary_file_meta_t& bms_meta);
 	UINT32 load_bms_file(const std::string& bms_filename, pvmsr_t vbinary_msr, binary_file_meta_t& bms_meta);
+
+	// Maps the records of a binary measurements file into memory (see mapped_records)
+	UINT32 map_bms_file(const std::string& bms_filename, mapped_msr_t& mapped_msr, binary_file_meta_t& bms_meta,
+		const boost::interprocess::mode_t mode=boost::interprocess::read_only);
+	
+	// Writes the metadata and records back to a binary measurements file in place, 
+	// or writes a new file if the file does not hold the same number of records
+	void update_bms_file(const std::string& bms_filename, pvmsr_t vbinary_msr, binary_file_meta_t& bms_meta);
 	void write_bms_file(const std::string& bms_filename, pvmsr_t vbinary_msr, binary_file_meta_t& bms_meta);
 	void write_bms_file(const std::string& bms_filename, vdnaMsrPtr* vMeasurements, binary_file_meta_t& bms_meta);
 
@@ -64,10 +64,11 @@ UINT16 dna_io_bst::create_stn_input_file_meta(vifm_t& vinput_file_meta, input_fi
 	return stn_file_count;
 }
 
-void dna_io_bst::load_bst_file_meta(const std::string& bst_filename, binary_file_meta_t& bst_meta) 
+std::size_t dna_io_bst::load_bst_file_meta(const std::string& bst_filename, binary_file_meta_t& bst_meta) 
 {
 	std::ifstream bst_file;
 	std::stringstream ss;
+	std::size_t offset(0);
 	ss << "load_bst_file(): An error was encountered when opening " << bst_filename << "." << std::endl;
 
 	try {
@@ -91,6 +92,9 @@ void dna_io_bst::load_bst_file_meta(const std::string& bst_filename, binary_file
 		
 		// read the metadata
 		readFileMetadata(bst_file, bst_meta);
+
+		// the records follow the metadata
+		offset = static_cast<std::size_t>(bst_file.tellg());
 	}
 	catch (const std::ios_base::failure& f) {
 		ss << f.what();
@@ -105,18 +109,90 @@ void dna_io_bst::load_bst_file_meta(const std::string& bst_filename, binary_file
 	}
 	
 	bst_file.close();
+
+	return offset;
 }
 	
 
 UINT32 dna_io_bst::load_bst_file(const std::string& bst_filename, pvstn_t vbinary_stn, binary_file_meta_t& bst_meta) 
 {	
-	std::ifstream bst_file;
+	// Map the records, then copy them in one block
+	mapped_stn_t mapped_stn;
+	map_bst_file(bst_filename, mapped_stn, bst_meta);
+	vbinary_stn->insert(vbinary_stn->end(), mapped_stn.begin(), mapped_stn.end());
+
+	return bst_meta.binCount;
+}
+
+UINT32 dna_io_bst::map_bst_file(const std::string& bst_filename, mapped_stn_t& mapped_stn, binary_file_meta_t& bst_meta,
+	const boost::interprocess::mode_t mode)
+{
+	// read the file information and metadata
+	std::size_t offset(load_bst_file_meta(bst_filename, bst_meta));
+
 	std::stringstream ss;
-	ss << "load_bst_file(): An error was encountered when opening " << bst_filename << "." << std::endl;
+	ss << "map_bst_file(): An error was encountered when mapping " << bst_filename << "." << std::endl;
 
 	try {
-		// open binary stations file.  Throws runtime_error on failure.
-		file_opener(bst_file, bst_filename, std::ios::in | std::ios::binary, binary, true);
+		if (boost::filesystem::file_size(bst_filename) < offset + bst_meta.binCount * sizeof(station_t))
+			throw boost::enable_current_exception(std::runtime_error("  The file does not hold all of its records."));
+		
+		mapped_stn.map(bst_filename, offset, bst_meta.binCount, mode);
+	}
+	catch (const boost::interprocess::interprocess_exception& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	catch (const std::runtime_error& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	return bst_meta.binCount;
+}
+
+void dna_io_bst::update_bst_file(const std::string& bst_filename, pvstn_t vbinary_stn, binary_file_meta_t& bst_meta)
+{
+	// binary files are written with aligned records
+	setVersion(__ALIGNED_RECORDS_FILE_VERSION__);
+
+	// Can the file be updated in place?  Only if the file information and
+	// metadata occupy the same length, and the file holds the same number 
+	// of records
+	std::size_t offset(0);
+	bool inPlace(false);
+	
+	try {
+		if (boost::filesystem::exists(bst_filename))
+		{
+			dna_io_bst bst;
+			binary_file_meta_t file_meta;
+			offset = bst.load_bst_file_meta(bst_filename, file_meta);
+			inPlace = bst.getVersion() == getVersion() &&
+				file_meta.inputFileCount == bst_meta.inputFileCount &&
+				file_meta.binCount == vbinary_stn->size() &&
+				boost::filesystem::file_size(bst_filename) == offset + vbinary_stn->size() * sizeof(station_t);
+		}
+	}
+	catch (const std::runtime_error&) {
+		// An unreadable file is replaced
+		inPlace = false;
+	}
+
+	if (!inPlace)
+	{
+		write_bst_file(bst_filename, vbinary_stn, bst_meta);
+		return;
+	}
+
+	std::ofstream bst_file;
+	std::stringstream ss;
+	ss << "update_bst_file(): An error was encountered when opening " << bst_filename << "." << std::endl;
+
+	try {
+		// open binary stations file without truncating it.  Throws runtime_error on failure.
+		file_opener(bst_file, bst_filename,
+			std::ios::in | std::ios::out | std::ios::binary, binary, true);
 	}
 	catch (const std::runtime_error& e) {
 		ss << e.what();
@@ -125,43 +201,40 @@ UINT32 dna_io_bst::load_bst_file(const std::string& bst_filename, pvstn_t vbinar
 	catch (...) {
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	
-	station_t stationRecord;
-	UINT32 stn;
 
 	ss.str("");
-	ss << "load_bst_file(): An error was encountered when reading from " << bst_filename << "." << std::endl;
+	ss << "update_bst_file(): An error was encountered when writing to " << bst_filename << "." << std::endl;
 
 	try {
-		// read the file information
-		readFileInfo(bst_file);
-		
-		// read the metadata
-		readFileMetadata(bst_file, bst_meta);
+		// write the file information
+		writeFileInfo(bst_file);
 		
-		// read the bms data
-		vbinary_stn->reserve(bst_meta.binCount);
-		for (stn=0; stn<bst_meta.binCount; stn++)
+		// write the metadata
+		writeFileMetadata(bst_file, bst_meta);
+
+		bst_file.close();
+
+		// write the bst data through a mapping of the records
+		if (!vbinary_stn->empty())
 		{
-			bst_file.read(reinterpret_cast<char *>(&stationRecord), sizeof(station_t));
-			vbinary_stn->push_back(stationRecord);
+			mapped_stn_t mapped_stn;
+			mapped_stn.map(bst_filename, offset, vbinary_stn->size(), boost::interprocess::read_write);
+			memcpy(mapped_stn.data(), &(*vbinary_stn)[0], vbinary_stn->size() * sizeof(station_t));
+			mapped_stn.flush();
 		}
 	}
 	catch (const std::ios_base::failure& f) {
 		ss << f.what();
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	catch (const std::runtime_error& e) {
+	catch (const boost::interprocess::interprocess_exception& e) {
 		ss << e.what();
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	catch (...) {
+	catch (const std::runtime_error& e) {
+		ss << e.what();
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-	
-	bst_file.close();
-
-	return bst_meta.binCount;
 }
 
 void dna_io_bst::write_bst_file(const std::string& bst_filename, pvstn_t vbinary_stn, binary_file_meta_t& bst_meta)
@@ -186,6 +259,9 @@ void dna_io_bst::write_bst_file(const std::string& bst_filename, pvstn_t vbinary
 	ss.str("");
 	ss << "write_bst_file(): An error was encountered when writing to " << bst_filename << "." << std::endl;
 
+	// binary files are written with aligned records
+	setVersion(__ALIGNED_RECORDS_FILE_VERSION__);
+
 	try {
 		// write version
 		writeFileInfo(bst_file);
@@ -237,6 +313,9 @@ bool dna_io_bst::write_bst_file(const std::string& bst_filename, vdnaStnPtr* vSt
 
 	_it_vdnastnptr _it_stn;
 	
+	// binary files are written with aligned records
+	setVersion(__ALIGNED_RECORDS_FILE_VERSION__);
+
 	try {
 		// write version
 		writeFileInfo(bst_file);		
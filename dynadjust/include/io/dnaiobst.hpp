@@ -30,6 +30,7 @@
 #endif
 
 #include <include/io/dnaiobase.hpp>
+#include <include/io/dnaiomapped.hpp>
 #include <include/config/dnatypes.hpp>
 #include <include/measurement_types/dnameasurement.hpp>
 
@@ -48,8 +49,16 @@ public:
 	dna_io_bst& operator=(const dna_io_bst& rhs);
 
 	UINT16 create_stn_input_file_meta(vifm_t& vinput_file_meta, input_file_meta_t** input_file_meta);
-	void load_bst_file_meta(const std::string& bst_filename, binary_file_meta_t& bst_meta);
+	std::size_t load_bst_file_meta(const std::string& bst_filename, binary_file_meta_t& bst_meta);
 	UINT32 load_bst_file(const std::string& bst_filename, pvstn_t vbinary_stn, binary_file_meta_t& bst_meta);
+
+	// Maps the records of a binary stations file into memory (see mapped_records)
+	UINT32 map_bst_file(const std::string& bst_filename, mapped_stn_t& mapped_stn, binary_file_meta_t& bst_meta,
+		const boost::interprocess::mode_t mode=boost::interprocess::read_only);
+	
+	// Writes the metadata and records back to a binary stations file in place, 
+	// or writes a new file if the file does not hold the same number of records
+	void update_bst_file(const std::string& bst_filename, pvstn_t vbinary_stn, binary_file_meta_t& bst_meta);
 	void write_bst_file(const std::string& bst_filename, pvstn_t vbinary_stn, binary_file_meta_t& bst_meta);
 	bool write_bst_file(const std::string& bst_filename, vdnaStnPtr* vStations, pvstring vUnusedStns, binary_file_meta_t& bst_meta, bool flagUnused);
 
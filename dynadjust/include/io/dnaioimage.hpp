@@ -0,0 +1,169 @@
+//============================================================================
+// Name         : dnaioimage.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Binary image of station and measurement objects
+//                An image_archive either saves values to, or loads values
+//                from, a buffer.  Each class that can be imaged has a single
+//                SerialiseImage(image_archive&) member which passes each of
+//                its members to the archive in turn, so the same function
+//                both saves and loads the object.  An image holds objects
+//                exactly as they are in memory (unlike the binary station
+//                and measurement records), but is only meaningful to the
+//                build that wrote it.
+//============================================================================
+
+#ifndef DNAIOIMAGE_H_
+#define DNAIOIMAGE_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <include/config/dnatypes.hpp>
+#include <include/measurement_types/dnameasurement.hpp>
+
+namespace dynadjust {
+namespace iostreams {
+
+class image_archive
+{
+public:
+	// Saves values to the end of buffer
+	explicit image_archive(std::vector<char>* buffer)
+		: buffer_(buffer), data_(0), size_(0), position_(0) {}
+
+	// Loads values from data
+	image_archive(const char* data, const std::size_t size)
+		: buffer_(0), data_(data), size_(size), position_(0) {}
+
+	inline bool loading() const { return buffer_ == 0; }
+
+	// Bytes loaded so far
+	inline std::size_t position() const { return position_; }
+
+	// Numbers, chars, bools, enums and structs of the same
+	template<typename T>
+	image_archive& operator&(T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "image_archive: T must be trivially copyable");
+		bytes(&value, sizeof(T));
+		return *this;
+	}
+
+	image_archive& operator&(std::string& value)
+	{
+		UINT32 length(static_cast<UINT32>(value.length()));
+		*this & length;
+		if (loading())
+		{
+			available(length);
+			value.assign(data_ + position_, length);
+			position_ += length;
+		}
+		else
+			buffer_->insert(buffer_->end(), value.begin(), value.end());
+		return *this;
+	}
+
+	// Station names are imaged by name, and interned on loading
+	image_archive& operator&(measurements::station_name& name)
+	{
+		if (loading())
+		{
+			UINT32 length;
+			*this & length;
+			available(length);
+			name = std::string_view(data_ + position_, length);
+			position_ += length;
+		}
+		else
+		{
+			std::string value(name.str());
+			*this & value;
+		}
+		return *this;
+	}
+
+	// Vectors of trivially copyable values are imaged as a block, and
+	// vectors of objects by each object's SerialiseImage
+	template<typename T>
+	image_archive& operator&(std::vector<T>& values)
+	{
+		UINT32 count(static_cast<UINT32>(values.size()));
+		*this & count;
+		if (loading())
+		{
+			// every element takes at least one byte
+			available(count);
+			values.clear();
+			values.resize(count);
+		}
+
+		if constexpr (std::is_trivially_copyable<T>::value)
+		{
+			if (count > 0)
+				bytes(&values[0], count * sizeof(T));
+		}
+		else
+		{
+			typename std::vector<T>::iterator _it_value;
+			for (_it_value=values.begin(); _it_value!=values.end(); ++_it_value)
+				_it_value->SerialiseImage(*this);
+		}
+		return *this;
+	}
+
+private:
+	void bytes(void* value, const std::size_t size)
+	{
+		if (loading())
+		{
+			available(size);
+			memcpy(value, data_ + position_, size);
+			position_ += size;
+		}
+		else
+			buffer_->insert(buffer_->end(), static_cast<const char*>(value), static_cast<const char*>(value) + size);
+	}
+
+	// Throws if an image is shorter than its contents require
+	inline void available(const std::size_t size) const
+	{
+		if (size > size_ - position_)
+			throw std::runtime_error("image_archive: the image is incomplete.");
+	}
+
+	std::vector<char>*	buffer_;		// saving
+	const char*			data_;			// loading
+	std::size_t			size_;
+	std::size_t			position_;
+};
+
+}	// namespace iostreams
+}	// namespace dynadjust
+
+#endif
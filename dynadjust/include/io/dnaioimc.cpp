@@ -0,0 +1,263 @@
+//============================================================================
+// Name         : dnaioimc.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : DynAdjust import cache file io operations
+//============================================================================
+
+#include <include/io/dnaioimc.hpp>
+#include <include/io/dnaioimage.hpp>
+#include <include/functions/dnaiostreamfuncs.hpp>
+#include <include/functions/dnafilepathfuncs.hpp>
+#include <include/functions/dnatemplatestnmsrfuncs.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace dynadjust {
+namespace iostreams {
+
+std::string dna_io_imc::imc_filename(const std::string& cache_folder, const std::string& input_filename)
+{
+	std::string input_path(boost::filesystem::absolute(input_filename).string());
+	std::uint64_t path_hash(FNV_HASH_BASIS);
+	hash_bytes(path_hash, input_path.c_str(), input_path.length());
+
+	std::stringstream ss;
+	ss << leafStr<std::string>(input_filename) << "." <<
+		std::hex << std::setfill('0') << std::setw(16) << path_hash;
+	return formPath<std::string>(cache_folder, ss.str(), "imc");
+}
+
+
+void dna_io_imc::hash_file(const std::string& filename, std::uint64_t& size, std::uint64_t& hash)
+{
+	std::ifstream input_file;
+	std::stringstream ss;
+	ss << "hash_file(): An error was encountered when opening " << filename << "." << std::endl;
+
+	try {
+		// open input file.  Throws runtime_error on failure.
+		file_opener(input_file, filename, std::ios::in | std::ios::binary, binary, true);
+	}
+	catch (const std::runtime_error& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	catch (...) {
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	ss.str("");
+	ss << "hash_file(): An error was encountered when reading from " << filename << "." << std::endl;
+
+	std::vector<char> block(1048576);
+	size = 0;
+	hash = FNV_HASH_BASIS;
+
+	try {
+		// Read whole blocks, then the remainder.  Since file_opener sets the
+		// stream to throw on failure, stop throwing at the end of the file.
+		input_file.exceptions(std::ios::badbit);
+		while (input_file.read(&block[0], block.size()) || input_file.gcount() > 0)
+		{
+			hash_bytes(hash, &block[0], static_cast<std::size_t>(input_file.gcount()));
+			size += static_cast<std::uint64_t>(input_file.gcount());
+		}
+	}
+	catch (const std::ios_base::failure& f) {
+		ss << f.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	input_file.close();
+}
+
+
+void dna_io_imc::serialise_state(image_archive& ar, imc_parse_state_t& state)
+{
+	ar & state.input_file_meta & state.stn_tally & state.msr_tally
+		& state.stnCount & state.msrCount
+		& state.clusterIDBegin & state.clusterIDEnd
+		& state.fileOrderBegin & state.fileOrderEnd
+		& state.datatype & state.filespecifiedreferenceframe & state.filespecifiedepoch
+		& state.epoch & state.success_msg;
+}
+
+
+bool dna_io_imc::load_imc_file(const std::string& imc_filename, const std::string& settings,
+	const std::uint64_t& inputSize, const std::uint64_t& inputHash,
+	imc_parse_state_t& state, vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements)
+{
+	if (!boost::filesystem::exists(imc_filename))
+		return false;
+
+	const std::size_t stnsBegin(vStations->size()), msrsBegin(vMeasurements->size());
+
+	try {
+		boost::interprocess::file_mapping imc_map(imc_filename.c_str(), boost::interprocess::read_only);
+		boost::interprocess::mapped_region imc_region(imc_map, boost::interprocess::read_only);
+
+		const char* imc_data(static_cast<const char*>(imc_region.get_address()));
+		const std::size_t imc_size(imc_region.get_size());
+
+		if (imc_size < sizeof(imc_header_t))
+			return false;
+
+		// Was the cache file created by this version from the same input?
+		const imc_header_t* header(reinterpret_cast<const imc_header_t*>(imc_data));
+		if (strncmp(header->identifier, IMC_IDENTIFIER, sizeof(header->identifier)) != 0 ||
+			header->version != IMC_VERSION ||
+			header->inputSize != inputSize ||
+			header->inputHash != inputHash)
+			return false;
+
+		image_archive ar(imc_data + sizeof(imc_header_t), imc_size - sizeof(imc_header_t));
+
+		// Was the input parsed with the same settings?
+		std::string imc_settings;
+		ar & imc_settings;
+		if (imc_settings != settings)
+			return false;
+
+		serialise_state(ar, state);
+
+		UINT32 i, count;
+		char msrType;
+
+		// stations
+		ar & count;
+		dnaStnPtr stn_ptr;
+		for (i=0; i<count; ++i)
+		{
+			stn_ptr.reset(new CDnaStation(DEFAULT_DATUM, DEFAULT_EPOCH));
+			stn_ptr->SerialiseImage(ar);
+			vStations->push_back(stn_ptr);
+		}
+
+		// measurements
+		ar & count;
+		dnaMsrPtr msr_ptr;
+		for (i=0; i<count; ++i)
+		{
+			ar & msrType;
+			msr_ptr.reset();
+			ResetMeasurementPtr<char>(&msr_ptr, msrType);
+			if (!msr_ptr)
+				throw std::runtime_error("load_imc_file(): Unknown measurement type.");
+			msr_ptr->SerialiseImage(ar);
+			vMeasurements->push_back(msr_ptr);
+		}
+
+		if (ar.position() != imc_size - sizeof(imc_header_t))
+			throw std::runtime_error("load_imc_file(): The cache file is longer than its contents.");
+	}
+	catch (...) {
+		// An unreadable cache file is not an error.  The input file
+		// is simply parsed again.
+		vStations->resize(stnsBegin);
+		vMeasurements->resize(msrsBegin);
+		return false;
+	}
+
+	return true;
+}
+
+
+void dna_io_imc::write_imc_file(const std::string& imc_filename, const std::string& settings,
+	const std::uint64_t& inputSize, const std::uint64_t& inputHash,
+	imc_parse_state_t& state, vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements)
+{
+	std::vector<char> imc_buffer(sizeof(imc_header_t));
+
+	imc_header_t* header(reinterpret_cast<imc_header_t*>(&imc_buffer[0]));
+	memset(header, '\0', sizeof(imc_header_t));
+	strncpy(header->identifier, IMC_IDENTIFIER, sizeof(header->identifier));
+	header->version = IMC_VERSION;
+	header->inputSize = inputSize;
+	header->inputHash = inputHash;
+
+	// Form the image.  Since the image is appended to imc_buffer, header
+	// is not used from here on.
+	image_archive ar(&imc_buffer);
+
+	std::string imc_settings(settings);
+	ar & imc_settings;
+
+	serialise_state(ar, state);
+
+	UINT32 count(static_cast<UINT32>(vStations->size()));
+	char msrType;
+
+	// stations
+	ar & count;
+	_it_vdnastnptr _it_stn;
+	for (_it_stn=vStations->begin(); _it_stn!=vStations->end(); ++_it_stn)
+		_it_stn->get()->SerialiseImage(ar);
+
+	// measurements
+	count = static_cast<UINT32>(vMeasurements->size());
+	ar & count;
+	_it_vdnamsrptr _it_msr;
+	for (_it_msr=vMeasurements->begin(); _it_msr!=vMeasurements->end(); ++_it_msr)
+	{
+		msrType = _it_msr->get()->GetTypeC();
+		ar & msrType;
+		_it_msr->get()->SerialiseImage(ar);
+	}
+
+	// Write the image to a temporary file, then rename it, so that
+	// a cache file is never seen part written
+	std::string imc_tmp_filename(imc_filename + ".tmp");
+	std::ofstream imc_file;
+	std::stringstream ss;
+	ss << "write_imc_file(): An error was encountered when opening " << imc_tmp_filename << "." << std::endl;
+
+	try {
+		// create import cache file.  Throws runtime_error on failure.
+		file_opener(imc_file, imc_tmp_filename,
+			std::ios::out | std::ios::binary, binary);
+	}
+	catch (const std::runtime_error& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	catch (...) {
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	ss.str("");
+	ss << "write_imc_file(): An error was encountered when writing to " << imc_filename << "." << std::endl;
+
+	try {
+		imc_file.write(&imc_buffer[0], imc_buffer.size());
+		imc_file.close();
+		boost::filesystem::rename(imc_tmp_filename, imc_filename);
+	}
+	catch (const std::ios_base::failure& f) {
+		ss << f.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	catch (const boost::filesystem::filesystem_error& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+}
+
+}	// namespace iostreams
+}	// namespace dynadjust
@@ -0,0 +1,122 @@
+//============================================================================
+// Name         : dnaioimc.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : DynAdjust import cache file io operations
+//                An import cache file holds the stations and measurements
+//                parsed from one input file, together with the hash of the
+//                input file's contents and the settings it was parsed with.
+//============================================================================
+
+#ifndef DNAIOIMC_H_
+#define DNAIOIMC_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <cstdint>
+
+#include <include/io/dnaiobase.hpp>
+#include <include/measurement_types/dnameasurement_types.hpp>
+#include <include/measurement_types/dnastntally.hpp>
+
+using namespace dynadjust::measurements;
+
+namespace dynadjust {
+namespace iostreams {
+
+class image_archive;
+
+const char* const IMC_IDENTIFIER = "DNAIMC";
+const UINT32 IMC_VERSION = 1;
+
+// Header of an import cache file, which is followed by the image (see
+// dnaioimage.hpp) of the parse settings, the parse state and the stations
+// and measurements parsed from the input file.
+typedef struct {
+	char			identifier[8];		// IMC_IDENTIFIER
+	UINT32			version;			// IMC_VERSION
+	UINT32			reserved;
+	std::uint64_t	inputSize;			// size of the input file
+	std::uint64_t	inputHash;			// hash of the input file's contents
+} imc_header_t;
+
+// State of a parser after parsing an input file, other than the stations
+// and measurements parsed
+typedef struct imc_parse_state {
+	imc_parse_state()
+		: stnCount(0), msrCount(0), clusterIDBegin(0), clusterIDEnd(0)
+		, fileOrderBegin(0), fileOrderEnd(0), datatype(0)
+		, filespecifiedreferenceframe(false), filespecifiedepoch(false)
+		, epoch(""), success_msg("") {
+		memset(&input_file_meta, '\0', sizeof(input_file_meta_t));
+	}
+
+	input_file_meta_t	input_file_meta;
+	StnTally		stn_tally;
+	MsrTally		msr_tally;
+	UINT32			stnCount;
+	UINT32			msrCount;
+	UINT32			clusterIDBegin;			// cluster ID before parsing
+	UINT32			clusterIDEnd;			// cluster ID after parsing
+	UINT32			fileOrderBegin;			// file order of the next station before parsing
+	UINT32			fileOrderEnd;			// file order of the next station after parsing
+	UINT16			datatype;				// stations, measurements or both
+	bool			filespecifiedreferenceframe;
+	bool			filespecifiedepoch;
+	std::string		epoch;					// project epoch after parsing (which a SINEX file sets)
+	std::string		success_msg;
+} imc_parse_state_t;
+
+class dna_io_imc : public dna_io_base
+{
+public:
+	dna_io_imc(void) {};
+	dna_io_imc(const dna_io_imc& imc) : dna_io_base(imc) {};
+	virtual ~dna_io_imc(void) {};
+
+	dna_io_imc& operator=(const dna_io_imc& rhs);
+
+	// Name of the cache file of input_filename in cache_folder.  Input files
+	// of the same name in different folders have different cache files.
+	std::string imc_filename(const std::string& cache_folder, const std::string& input_filename);
+
+	// Size and FNV-1a hash of the contents of a file
+	void hash_file(const std::string& filename, std::uint64_t& size, std::uint64_t& hash);
+
+	// Returns false if the cache file does not exist, is not of this version,
+	// or was not created from an input file of the same contents parsed with
+	// the same settings.
+	bool load_imc_file(const std::string& imc_filename, const std::string& settings,
+		const std::uint64_t& inputSize, const std::uint64_t& inputHash,
+		imc_parse_state_t& state, vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements);
+	void write_imc_file(const std::string& imc_filename, const std::string& settings,
+		const std::uint64_t& inputSize, const std::uint64_t& inputHash,
+		imc_parse_state_t& state, vdnaStnPtr* vStations, vdnaMsrPtr* vMeasurements);
+
+protected:
+	void serialise_state(image_archive& ar, imc_parse_state_t& state);
+};
+
+}	// namespace iostreams
+}	// namespace dynadjust
+
+#endif
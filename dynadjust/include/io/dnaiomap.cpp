@@ -22,6 +22,9 @@
 
 #include <fstream>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #include <include/io/dnaiomap.hpp>
 #include <include/functions/dnaiostreamfuncs.hpp>
 #include <include/functions/dnastrmanipfuncs.hpp>
@@ -196,6 +199,83 @@ void dna_io_map::write_map_file_txt(const std::string& map_filename, pv_string_u
 	map_file.close();
 }
 
+std::string dna_io_map::map_index_filename(const std::string& map_filename)
+{
+	return map_filename + ".idx";
+}
+	
+
+bool dna_io_map::load_map_index_file(const std::string& map_filename, station_name_index& stnsIndex)
+{
+	std::string idx_filename(map_index_filename(map_filename));
+
+	// Has the map file been modified since the index file was written?
+	if (!boost::filesystem::exists(idx_filename) ||
+		!boost::filesystem::exists(map_filename) ||
+		boost::filesystem::last_write_time(idx_filename) < boost::filesystem::last_write_time(map_filename))
+		return false;
+
+	try {
+		boost::interprocess::file_mapping idx_map(idx_filename.c_str(), boost::interprocess::read_only);
+		boost::shared_ptr<boost::interprocess::mapped_region> idx_region(
+			new boost::interprocess::mapped_region(idx_map, boost::interprocess::read_only));
+
+		// The index refers to the mapped region, which is released with the index
+		return stnsIndex.attach(static_cast<const char*>(idx_region->get_address()),
+			idx_region->get_size(), idx_region);
+	}
+	catch (const boost::interprocess::interprocess_exception&) {
+		// Fall back to the map file
+		return false;
+	}
+}
+	
+
+void dna_io_map::load_map_index(const std::string& map_filename, station_name_index& stnsIndex)
+{
+	if (load_map_index_file(map_filename, stnsIndex))
+		return;
+
+	v_string_uint32_pair stnsMap;
+	load_map_file(map_filename, &stnsMap);
+	stnsIndex.build(stnsMap);
+}
+	
+
+void dna_io_map::write_map_index_file(const std::string& map_filename, const station_name_index& stnsIndex)
+{
+	std::string idx_filename(map_index_filename(map_filename));
+	std::ofstream idx_file;
+	std::stringstream ss;
+	ss << "write_map_index_file(): An error was encountered when opening " << idx_filename << "." << std::endl;
+
+	try {
+		// Create station name index file.  Throws runtime_error on failure.
+		file_opener(idx_file, idx_filename, std::ios::out | std::ios::binary, binary);
+	}
+	catch (const std::runtime_error& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	catch (...) {
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	ss.str("");
+	ss << "write_map_index_file(): An error was encountered when writing to " << idx_filename << "." << std::endl;
+
+	try {
+		idx_file.write(stnsIndex.data(), stnsIndex.data_size());
+	}
+	catch (const std::ios_base::failure& f) {
+		ss << f.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	idx_file.close();
+}
+	
+
 //void dna_io_map::load_renaming_file(const std::string& renaming_filename, pv_string_string_pair stnRenaming)
 //{
 //	std::ifstream renaming_file;
@@ -31,6 +31,7 @@
 
 #include <include/io/dnaiobase.hpp>
 #include <include/config/dnatypes.hpp>
+#include <include/functions/dnastationindex.hpp>
 
 namespace dynadjust {
 namespace iostreams {
@@ -48,6 +49,20 @@ public:
 	void write_map_file(const std::string& map_filename, pv_string_uint32_pair stnsMap);
 	void write_map_file_txt(const std::string& map_filename, pv_string_uint32_pair stnsMap);
 
+	// Name of the station name index file written with map_filename
+	static std::string map_index_filename(const std::string& map_filename);
+
+	// Maps the station name index file into memory.  Returns false if the 
+	// file does not exist, was not written with the map file (i.e. is older), 
+	// or is not a valid index.
+	bool load_map_index_file(const std::string& map_filename, station_name_index& stnsIndex);
+
+	// Loads the station name index of a map file, from the index file if it 
+	// is up to date, otherwise from the map file.
+	void load_map_index(const std::string& map_filename, station_name_index& stnsIndex);
+
+	void write_map_index_file(const std::string& map_filename, const station_name_index& stnsIndex);
+
 	//void load_renaming_file(const std::string& map_filename, pv_string_string_pair stnRenaming);
 	
 protected:
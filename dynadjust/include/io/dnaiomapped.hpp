@@ -0,0 +1,171 @@
+//============================================================================
+// Name         : dnaiomapped.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Records of a binary station or measurement file, mapped
+//                into memory rather than read.  How the records may be used
+//                depends upon the mode of the mapping:
+//                 - read_only:     the records may be read only
+//                 - copy_on_write: the records may be changed, but changes
+//                                  are private to the mapping and are never
+//                                  written to the file
+//                 - read_write:    changes to the records are written to
+//                                  the file (see flush)
+//                The records of files written before records were aligned
+//                (see dna_io_base::alignedRecords) cannot be used in place,
+//                so are copied from the mapping once.
+//                The import's measurement to station summary, AML text file
+//                and integrity test, and plot, read the mapped records in
+//                place (plot maps the stations copy_on_write).  Adjust,
+//                segment, reftran and geoid hold their records in vectors,
+//                filled from the mapping by one block copy (see 
+//                load_bst_file and load_bms_file).
+//============================================================================
+
+#ifndef DNAIOMAPPED_H_
+#define DNAIOMAPPED_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// <sys/mman.h> defines MAP_FILE, which clashes with the map-file option name
+#if defined(MAP_FILE)
+	#undef MAP_FILE
+#endif
+
+#include <include/config/dnatypes.hpp>
+#include <include/measurement_types/dnameasurement.hpp>
+
+namespace dynadjust {
+namespace iostreams {
+
+typedef boost::shared_ptr<boost::interprocess::mapped_region> mapped_region_ptr;
+
+template <typename T>
+class mapped_records
+{
+public:
+	typedef T value_type;
+	typedef T* iterator;
+	typedef const T* const_iterator;
+
+	mapped_records()
+		: records_(0), count_(0), mode_(boost::interprocess::read_only) {}
+
+	// Maps count records from offset in filename
+	void map(const std::string& filename, const std::size_t offset, const std::size_t count,
+		const boost::interprocess::mode_t mode)
+	{
+		release();
+
+		mode_ = mode;
+		if (count == 0)
+			return;
+
+		boost::interprocess::file_mapping file_map(filename.c_str(),
+			mode == boost::interprocess::read_write ? boost::interprocess::read_write : boost::interprocess::read_only);
+		region_.reset(new boost::interprocess::mapped_region(file_map, mode, offset, count * sizeof(T)));
+
+		T* records(static_cast<T*>(region_->get_address()));
+		if (reinterpret_cast<std::uintptr_t>(records) % alignof(T) == 0)
+			records_ = records;
+		else
+		{
+			// The records cannot be used in place.  Changes made to the
+			// copy are written to the file by flush.
+			copy_.resize(count);
+			memcpy(&copy_[0], region_->get_address(), count * sizeof(T));
+			records_ = &copy_[0];
+		}
+		count_ = count;
+	}
+
+	void release()
+	{
+		region_.reset();
+		copy_.clear();
+		records_ = 0;
+		count_ = 0;
+	}
+
+	// Writes changes to a read_write mapping to the file
+	void flush()
+	{
+		if (!region_ || mode_ != boost::interprocess::read_write)
+			return;
+		if (!copy_.empty())
+			memcpy(region_->get_address(), &copy_[0], count_ * sizeof(T));
+		if (!region_->flush())
+			throw std::runtime_error("mapped_records::flush(): The mapped records could not be written to the file.");
+	}
+
+	// true if the records are used in place, rather than copied from the mapping
+	inline bool in_place() const { return copy_.empty(); }
+
+	inline std::size_t size() const { return count_; }
+	inline bool empty() const { return count_ == 0; }
+
+	inline T* data() { return records_; }
+	inline const T* data() const { return records_; }
+
+	inline iterator begin() { return records_; }
+	inline iterator end() { return records_ + count_; }
+	inline const_iterator begin() const { return records_; }
+	inline const_iterator end() const { return records_ + count_; }
+
+	inline T& operator[](const std::size_t i) { return records_[i]; }
+	inline const T& operator[](const std::size_t i) const { return records_[i]; }
+
+	T& at(const std::size_t i) {
+		if (i >= count_)
+			throw std::out_of_range("mapped_records::at(): index out of range.");
+		return records_[i];
+	}
+	const T& at(const std::size_t i) const {
+		if (i >= count_)
+			throw std::out_of_range("mapped_records::at(): index out of range.");
+		return records_[i];
+	}
+
+private:
+	mapped_region_ptr		region_;
+	std::vector<T>			copy_;			// records of an unaligned mapping
+	T*						records_;
+	std::size_t				count_;
+	boost::interprocess::mode_t	mode_;
+};
+
+typedef mapped_records<station_t> mapped_stn_t;
+typedef mapped_records<measurements::measurement_t> mapped_msr_t;
+
+}	// namespace iostreams
+}	// namespace dynadjust
+
+#endif
@@ -23,6 +23,10 @@
 #include <include/io/dnaioseg.hpp>
 #include <include/functions/dnaiostreamfuncs.hpp>
 #include <include/functions/dnatemplatestnmsrfuncs.hpp>
+#include <include/functions/dnastrmanipfuncs.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 namespace dynadjust { 
 namespace iostreams {
@@ -121,6 +125,35 @@ void dna_io_seg::load_seg_file(const std::string& seg_filename, UINT32& blockCou
 	pvmsr_t bmsBinaryRecords, pvUINT32 v_measurementCount, 
 	pvUINT32 v_unknownsCount, pvUINT32 v_ContiguousNetList,
 	pvUINT32 v_parameterStationCount) 
+{
+	load_seg_records(seg_filename, blockCount, blockThreshold, minInnerStns,
+		v_ISL, v_JSL, v_CML, loadMetrics, 
+		static_cast<const vmsr_t*>(bmsBinaryRecords), v_measurementCount, 
+		v_unknownsCount, v_ContiguousNetList, v_parameterStationCount);
+}
+
+void dna_io_seg::load_seg_file(const std::string& seg_filename, UINT32& blockCount, 
+	UINT32& blockThreshold, UINT32& minInnerStns,
+	vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML,
+	bool loadMetrics,
+	const mapped_msr_t* bmsBinaryRecords, pvUINT32 v_measurementCount, 
+	pvUINT32 v_unknownsCount, pvUINT32 v_ContiguousNetList,
+	pvUINT32 v_parameterStationCount) 
+{
+	load_seg_records(seg_filename, blockCount, blockThreshold, minInnerStns,
+		v_ISL, v_JSL, v_CML, loadMetrics, 
+		bmsBinaryRecords, v_measurementCount, 
+		v_unknownsCount, v_ContiguousNetList, v_parameterStationCount);
+}
+
+template <typename MsrRecords>
+void dna_io_seg::load_seg_records(const std::string& seg_filename, UINT32& blockCount, 
+	UINT32& blockThreshold, UINT32& minInnerStns,
+	vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML,
+	bool loadMetrics,
+	const MsrRecords* bmsBinaryRecords, pvUINT32 v_measurementCount, 
+	pvUINT32 v_unknownsCount, pvUINT32 v_ContiguousNetList,
+	pvUINT32 v_parameterStationCount) 
 {	
 	std::ifstream seg_file;
 	std::stringstream ss_err;
@@ -153,6 +186,33 @@ void dna_io_seg::load_seg_file(const std::string& seg_filename, UINT32& blockCou
 		
 		load_seg_file_header(seg_filename, seg_file, blockCount, 
 			blockThreshold, minInnerStns);
+
+		// Use the binary segmentation file if it is up to date
+		vUINT32 v_netID;
+		if (load_seg_binary_file(seg_filename, blockCount, blockThreshold, minInnerStns,
+			v_ISL, v_JSL, v_CML, v_netID))
+		{
+			seg_file.close();
+
+			if (!loadMetrics)
+				return;
+
+			*v_ContiguousNetList = v_netID;
+			v_measurementCount->assign(blockCount, 0);
+			v_unknownsCount->resize(blockCount);
+			v_parameterStationCount->resize(blockCount);
+
+			it_vUINT32_const _it_msr;
+			for (b=0; b<blockCount; ++b)
+			{
+				stnCount = static_cast<UINT32>(v_ISL.at(b).size() + v_JSL.at(b).size());
+				v_parameterStationCount->at(b) = stnCount;
+				v_unknownsCount->at(b) = stnCount * 3;
+				for (_it_msr=v_CML.at(b).begin(); _it_msr!=v_CML.at(b).end(); ++_it_msr)
+					v_measurementCount->at(b) += measurement_quantities(bmsBinaryRecords->at(*_it_msr));
+			}
+			return;
+		}
 		
 		// Resize vectors based upon block count
 		v_ISL.resize(blockCount);
@@ -294,10 +354,12 @@ void dna_io_seg::load_seg_file(const std::string& seg_filename, UINT32& blockCou
 		if (blkCount != blockCount)
 			throw boost::enable_current_exception(std::runtime_error("load_seg_file(): Segmentation file is corrupt."));
 
-		// skip header info
-		seg_file.ignore(PRINT_LINE_LENGTH, '\n');			// ------------------------
-		seg_file.ignore(PRINT_LINE_LENGTH, '\n');			// 
-		seg_file.ignore(PRINT_LINE_LENGTH, '\n');			// Individual block data (ASL and AML indices):
+		// skip header info, and the block cost summary (if present)
+		do {
+			if (seg_file.eof())
+				throw boost::enable_current_exception(std::runtime_error("load_seg_file(): Segmentation file is corrupt."));
+			getline(seg_file, sBuf);						// INDIVIDUAL BLOCK DATA
+		} while (sBuf.compare(0, 21, "INDIVIDUAL BLOCK DATA") != 0);
 		seg_file.ignore(PRINT_LINE_LENGTH, '\n');			// ------------------------
 		
 		// initialise block ID
@@ -350,43 +412,7 @@ void dna_io_seg::load_seg_file(const std::string& seg_filename, UINT32& blockCou
 					v_CML.at(b).at(c) = m;
 
 					if (loadMetrics)
-					{
-						// Calculate number of 'measurements' in this measurement
-						// No need to check for ignored measurement since the segmentation 
-						// algorithm only includes measurements with the ignore flag cleared
-						switch (bmsBinaryRecords->at(m).measType)
-						{
-						case 'G':	// GPS Baseline
-							v_measurementCount->at(b) += 3;		// three measurements (x, y, z)
-							break;
-						case 'X':	// GPS Baseline cluster
-						case 'Y':	// GPS point cluster
-							v_measurementCount->at(b) += bmsBinaryRecords->at(m).vectorCount1 * 3;
-							break;
-						case 'D':	// Direction set	
-							v_measurementCount->at(b) += bmsBinaryRecords->at(m).vectorCount2 - 1;
-							break;
-						case 'A':	// Horizontal angle
-						case 'B':	// Geodetic azimuth
-						case 'C':	// Chord dist
-						case 'E':	// Ellipsoid arc
-						case 'H':	// Orthometric height
-						case 'I':	// Astronomic latitude
-						case 'J':	// Astronomic longitude
-						case 'K':	// Astronomic azimuth
-						case 'L':	// Level difference
-						case 'P':	// Geodetic latitude
-						case 'Q':	// Geodetic longitude
-						case 'R':	// Ellipsoidal height
-						case 'M':	// MSL arc
-						case 'S':	// Slope distance
-						case 'V':	// Zenith distance
-						case 'Z':	// Vertical angle
-						default:
-							v_measurementCount->at(b)++;		// single measurement quantity
-							break;
-						}
-					}
+						v_measurementCount->at(b) += measurement_quantities(bmsBinaryRecords->at(m));
 				}
 				c++;
 				seg_file.getline(line, PRINT_LINE_LENGTH);		// get more data
@@ -409,6 +435,278 @@ void dna_io_seg::load_seg_file(const std::string& seg_filename, UINT32& blockCou
 
 }
 
+
+UINT32 dna_io_seg::measurement_quantities(const measurement_t& msr)
+{
+	// Calculate number of 'measurements' in this measurement
+	// No need to check for ignored measurement since the segmentation 
+	// algorithm only includes measurements with the ignore flag cleared
+	switch (msr.measType)
+	{
+	case 'G':	// GPS Baseline
+		return 3;		// three measurements (x, y, z)
+	case 'X':	// GPS Baseline cluster
+	case 'Y':	// GPS point cluster
+		return msr.vectorCount1 * 3;
+	case 'D':	// Direction set	
+		return msr.vectorCount2 - 1;
+	case 'A':	// Horizontal angle
+	case 'B':	// Geodetic azimuth
+	case 'C':	// Chord dist
+	case 'E':	// Ellipsoid arc
+	case 'H':	// Orthometric height
+	case 'I':	// Astronomic latitude
+	case 'J':	// Astronomic longitude
+	case 'K':	// Astronomic azimuth
+	case 'L':	// Level difference
+	case 'P':	// Geodetic latitude
+	case 'Q':	// Geodetic longitude
+	case 'R':	// Ellipsoidal height
+	case 'M':	// MSL arc
+	case 'S':	// Slope distance
+	case 'V':	// Zenith distance
+	case 'Z':	// Vertical angle
+	default:
+		return 1;		// single measurement quantity
+	}
+}
+
+
+std::string dna_io_seg::seg_binary_filename(const std::string& seg_filename)
+{
+	return seg_filename + ".bin";
+}
+	
+
+bool dna_io_seg::load_seg_binary_file(const std::string& seg_filename, const UINT32& blockCount, 
+	const UINT32& blockThreshold, const UINT32& minInnerStns,
+	vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML, vUINT32& v_ContiguousNetList,
+	std::vector<std::uint64_t>* msrSignatures, vstring* innerStnNames)
+{
+	std::string segb_filename(seg_binary_filename(seg_filename));
+
+	// Has the segmentation file been modified since the binary file was written?
+	if (!boost::filesystem::exists(segb_filename) ||
+		boost::filesystem::last_write_time(segb_filename) < boost::filesystem::last_write_time(seg_filename))
+		return false;
+
+	try {
+		boost::interprocess::file_mapping segb_map(segb_filename.c_str(), boost::interprocess::read_only);
+		boost::interprocess::mapped_region segb_region(segb_map, boost::interprocess::read_only);
+
+		const char* segb_data(static_cast<const char*>(segb_region.get_address()));
+		const std::size_t segb_size(segb_region.get_size());
+
+		if (segb_size < sizeof(seg_binary_header_t))
+			return false;
+
+		const seg_binary_header_t* header(reinterpret_cast<const seg_binary_header_t*>(segb_data));
+		if (strncmp(header->identifier, SEG_BINARY_IDENTIFIER, sizeof(header->identifier)) != 0 ||
+			header->version != SEG_BINARY_VERSION ||
+			header->blockCount != blockCount ||
+			header->blockThreshold != blockThreshold ||
+			header->minInnerStns != minInnerStns)
+			return false;
+
+		// Offset tables
+		const std::size_t tables(4 * static_cast<std::size_t>(blockCount) + 3);
+		if (segb_size < sizeof(seg_binary_header_t) + tables * sizeof(UINT32))
+			return false;
+
+		const UINT32* islOffset(reinterpret_cast<const UINT32*>(segb_data + sizeof(seg_binary_header_t)));
+		const UINT32* jslOffset(islOffset + blockCount + 1);
+		const UINT32* cmlOffset(jslOffset + blockCount + 1);
+		const UINT32* netID(cmlOffset + blockCount + 1);
+
+		UINT32 b;
+		for (b=0; b<blockCount; ++b)
+			if (islOffset[b] > islOffset[b+1] || jslOffset[b] > jslOffset[b+1] || cmlOffset[b] > cmlOffset[b+1])
+				return false;
+
+		const std::size_t elements(static_cast<std::size_t>(islOffset[blockCount]) + 
+			jslOffset[blockCount] + cmlOffset[blockCount]);
+		const std::size_t listsSize(sizeof(seg_binary_header_t) + (tables + elements) * sizeof(UINT32));
+		if (islOffset[0] != 0 || jslOffset[0] != 0 || cmlOffset[0] != 0 ||
+			segb_size != listsSize + 
+				static_cast<std::size_t>(cmlOffset[blockCount]) * sizeof(std::uint64_t) +
+				static_cast<std::size_t>(islOffset[blockCount]) * STN_NAME_WIDTH)
+			return false;
+
+		// Lists
+		const UINT32* isl(netID + blockCount);
+		const UINT32* jsl(isl + islOffset[blockCount]);
+		const UINT32* cml(jsl + jslOffset[blockCount]);
+
+		v_ISL.resize(blockCount);
+		v_JSL.resize(blockCount);
+		v_CML.resize(blockCount);
+		v_ContiguousNetList.assign(netID, netID + blockCount);
+
+		for (b=0; b<blockCount; ++b)
+		{
+			v_ISL.at(b).assign(isl + islOffset[b], isl + islOffset[b+1]);
+			v_JSL.at(b).assign(jsl + jslOffset[b], jsl + jslOffset[b+1]);
+			v_CML.at(b).assign(cml + cmlOffset[b], cml + cmlOffset[b+1]);
+		}
+
+		// Signatures and names.  The signatures follow an odd number of 
+		// UINT32 values when there are an odd number of elements, so are copied.
+		const char* signatures(segb_data + listsSize);
+		const char* names(signatures + static_cast<std::size_t>(cmlOffset[blockCount]) * sizeof(std::uint64_t));
+
+		if (msrSignatures != NULL)
+		{
+			msrSignatures->resize(cmlOffset[blockCount]);
+			if (!msrSignatures->empty())
+				memcpy(&msrSignatures->at(0), signatures, msrSignatures->size() * sizeof(std::uint64_t));
+		}
+
+		if (innerStnNames != NULL)
+		{
+			innerStnNames->resize(islOffset[blockCount]);
+			for (vstring::iterator _it_name(innerStnNames->begin()); _it_name!=innerStnNames->end(); ++_it_name, names+=STN_NAME_WIDTH)
+				_it_name->assign(names, strnlen(names, STN_NAME_WIDTH));
+		}
+	}
+	catch (const boost::interprocess::interprocess_exception&) {
+		// Fall back to the segmentation file
+		return false;
+	}
+
+	return true;
+}
+	
+
+void dna_io_seg::write_seg_binary_file(const std::string& seg_filename, 
+	const UINT32& min_inner_stns, const UINT32& max_block_stns,
+	const vvUINT32& v_ISL, const vvUINT32& v_JSL, const vvUINT32& v_CML,
+	const vUINT32& v_ContiguousNetList, 
+	const vstn_t& bstBinaryRecords, const vmsr_t& bmsBinaryRecords)
+{
+	std::string segb_filename(seg_binary_filename(seg_filename));
+	std::ofstream segb_file;
+	std::stringstream ss;
+	ss << "write_seg_binary_file(): An error was encountered when opening " << segb_filename << "." << std::endl;
+
+	try {
+		// Create binary segmentation file.  Throws runtime_error on failure.
+		file_opener(segb_file, segb_filename, std::ios::out | std::ios::binary, binary);
+	}
+	catch (const std::runtime_error& e) {
+		ss << e.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	catch (...) {
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	ss.str("");
+	ss << "write_seg_binary_file(): An error was encountered when writing to " << segb_filename << "." << std::endl;
+
+	seg_binary_header_t header;
+	memset(&header, '\0', sizeof(seg_binary_header_t));
+	strncpy(header.identifier, SEG_BINARY_IDENTIFIER, sizeof(header.identifier));
+	header.version = SEG_BINARY_VERSION;
+	header.blockCount = static_cast<UINT32>(v_ISL.size());
+	header.blockThreshold = max_block_stns;
+	header.minInnerStns = min_inner_stns;
+
+	// Offset of each block's lists
+	vUINT32 islOffset(1, 0), jslOffset(1, 0), cmlOffset(1, 0);
+	islOffset.reserve(header.blockCount + 1);
+	jslOffset.reserve(header.blockCount + 1);
+	cmlOffset.reserve(header.blockCount + 1);
+
+	UINT32 b;
+	for (b=0; b<header.blockCount; ++b)
+	{
+		islOffset.push_back(islOffset.back() + static_cast<UINT32>(v_ISL.at(b).size()));
+		jslOffset.push_back(jslOffset.back() + static_cast<UINT32>(v_JSL.at(b).size()));
+		cmlOffset.push_back(cmlOffset.back() + static_cast<UINT32>(v_CML.at(b).size()));
+	}
+
+	try {
+		segb_file.write(reinterpret_cast<const char*>(&header), sizeof(seg_binary_header_t));
+		segb_file.write(reinterpret_cast<const char*>(&islOffset[0]), islOffset.size() * sizeof(UINT32));
+		segb_file.write(reinterpret_cast<const char*>(&jslOffset[0]), jslOffset.size() * sizeof(UINT32));
+		segb_file.write(reinterpret_cast<const char*>(&cmlOffset[0]), cmlOffset.size() * sizeof(UINT32));
+		if (header.blockCount > 0)
+			segb_file.write(reinterpret_cast<const char*>(&v_ContiguousNetList[0]), header.blockCount * sizeof(UINT32));
+
+		for (b=0; b<header.blockCount; ++b)
+			if (!v_ISL.at(b).empty())
+				segb_file.write(reinterpret_cast<const char*>(&v_ISL.at(b)[0]), v_ISL.at(b).size() * sizeof(UINT32));
+		for (b=0; b<header.blockCount; ++b)
+			if (!v_JSL.at(b).empty())
+				segb_file.write(reinterpret_cast<const char*>(&v_JSL.at(b)[0]), v_JSL.at(b).size() * sizeof(UINT32));
+		for (b=0; b<header.blockCount; ++b)
+			if (!v_CML.at(b).empty())
+				segb_file.write(reinterpret_cast<const char*>(&v_CML.at(b)[0]), v_CML.at(b).size() * sizeof(UINT32));
+
+		// Signature of each measurement
+		std::uint64_t signature;
+		it_vUINT32_const _it_list;
+		for (b=0; b<header.blockCount; ++b)
+		{
+			for (_it_list=v_CML.at(b).begin(); _it_list!=v_CML.at(b).end(); ++_it_list)
+			{
+				signature = measurement_signature(bmsBinaryRecords, bstBinaryRecords, *_it_list);
+				segb_file.write(reinterpret_cast<const char*>(&signature), sizeof(std::uint64_t));
+			}
+		}
+
+		// Name of each inner station
+		for (b=0; b<header.blockCount; ++b)
+			for (_it_list=v_ISL.at(b).begin(); _it_list!=v_ISL.at(b).end(); ++_it_list)
+				segb_file.write(bstBinaryRecords.at(*_it_list).stationName, STN_NAME_WIDTH);
+	}
+	catch (const std::ios_base::failure& f) {
+		ss << f.what();
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	segb_file.close();
+}
+	
+
+// Identifies a measurement (or cluster) by its type, the names of its
+// stations and its values, so that it can be found in a later version
+// of the binary measurements file.
+std::uint64_t dna_io_seg::measurement_signature(const vmsr_t& bmsBinaryRecords, const vstn_t& bstBinaryRecords, 
+	const UINT32& firstIndex) const
+{
+	std::ostringstream ss;
+	ss << std::setprecision(17) << bmsBinaryRecords.at(firstIndex).measType;
+
+	vUINT32 msrStations;
+	GetMsrStations(bmsBinaryRecords, firstIndex, msrStations);
+
+	it_vUINT32_const _it_stn;
+	for (_it_stn=msrStations.begin(); _it_stn!=msrStations.end(); ++_it_stn)
+		ss << "|" << bstBinaryRecords.at(*_it_stn).stationName;
+
+	const UINT32 clusterID(bmsBinaryRecords.at(firstIndex).clusterID);
+	it_vmsr_t_const _it_msr(bmsBinaryRecords.begin() + firstIndex);
+
+	for (; _it_msr!=bmsBinaryRecords.end() && _it_msr->clusterID == clusterID; ++_it_msr)
+	{
+		// Every record of a D, X or Y cluster belongs to the measurement.  Any 
+		// other measurement ends where the next one sharing its cluster ID begins.
+		if (_it_msr != bmsBinaryRecords.begin() + firstIndex && _it_msr->measStart == xMeas &&
+			_it_msr->measType != 'D' && _it_msr->measType != 'X' && _it_msr->measType != 'Y')
+			break;
+
+		ss << "|" << static_cast<int>(_it_msr->measStart) << "," << _it_msr->ignore << "," <<
+			_it_msr->term1 << "," << _it_msr->term2 << "," << _it_msr->term3 << "," << _it_msr->term4;
+	}
+
+	const std::string signature(ss.str());
+	std::uint64_t hash(FNV_HASH_BASIS);
+	hash_bytes(hash, signature.c_str(), signature.length());
+	return hash;
+}
+	
+
 void dna_io_seg::build_free_stn_availability(vASL& assocStnList, v_freestn_pair& freeStnList)
 {
 	freeStnList.clear();
@@ -594,7 +892,9 @@ void dna_io_seg::write_seg_file(const std::string& seg_filename, const std::stri
 	const std::string& seg_starting_stns, const vstring& vinitialStns,
 	const std::string& command_line_arguments,
 	vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML,
-	vUINT32& v_ContiguousNetList, const pvstn_t bstBinaryRecords, const pvmsr_t bmsBinaryRecords)
+	vUINT32& v_ContiguousNetList, const pvstn_t bstBinaryRecords, const pvmsr_t bmsBinaryRecords,
+	const vblockCost_t* blockCosts,
+	const std::string& previous_seg_filename, const std::string& resegmented_blocks)
 {
 	std::ofstream seg_file;
 	std::stringstream ss;
@@ -643,6 +943,14 @@ void dna_io_seg::write_seg_file(const std::string& seg_filename, const std::stri
 		seg_file << std::endl;
 	}
 
+	// Incremental segmentation
+	if (!previous_seg_filename.empty())
+	{
+		seg_file << std::setw(PRINT_VAR_PAD) << std::left << "Previous segmentation file" << 
+			boost::filesystem::system_complete(previous_seg_filename).string() << std::endl;
+		seg_file << std::setw(PRINT_VAR_PAD) << std::left << "Re-segmented blocks" << resegmented_blocks << std::endl;
+	}
+
 	seg_file << OUTPUTLINE << std::endl << std::endl;
 	seg_file << std::setw(PRINT_VAR_PAD) << std::left << "SEGMENTATION SUMMARY" << std::endl << std::endl;
 	seg_file << std::setw(PRINT_VAR_PAD) << std::left << "No. blocks produced" << v_ISL.size() << std::endl;
@@ -700,7 +1008,12 @@ void dna_io_seg::write_seg_file(const std::string& seg_filename, const std::stri
 
 	for (dash=BLOCK+NETID+INNER+JUNCT+TOTAL+MEASR; dash>2; dash--)
 		seg_file << "-";
-	seg_file << std::endl << std::endl << "INDIVIDUAL BLOCK DATA" << std::endl;
+	seg_file << std::endl;
+
+	if (blockCosts != NULL && !blockCosts->empty())
+		write_seg_block_costs(seg_file, *blockCosts);
+
+	seg_file << std::endl << "INDIVIDUAL BLOCK DATA" << std::endl;
 	for (dash=BLOCK+NETID+INNER+JUNCT+TOTAL+MEASR; dash>2; dash--)
 		seg_file << "-";
 	seg_file << std::endl;
@@ -720,6 +1033,53 @@ void dna_io_seg::write_seg_file(const std::string& seg_filename, const std::stri
 	seg_file << std::endl;
 
 	seg_file.close();
+
+	// Write the block lists to the binary segmentation file, which is
+	// loaded in preference to this file whilst it is up to date
+	write_seg_binary_file(seg_filename, min_inner_stns, max_block_stns, 
+		v_ISL, v_JSL, v_CML, v_ContiguousNetList, *bstBinaryRecords, *bmsBinaryRecords);
+}
+
+void dna_io_seg::write_seg_block_costs(std::ostream &os, const vblockCost_t& blockCosts)
+{
+	char dash;
+	
+	os << std::endl << "BLOCK COST SUMMARY" << std::endl;
+	for (dash=BLOCK+NETID+INNER+JUNCT+TOTAL+MEASR; dash>2; dash--)
+		os << "-";
+	os << std::endl;
+	os << std::setw(BLOCK) << std::left << "  Block" << std::setw(NETID) << std::left << "Parameters" 
+		<< std::setw(JUNCT) << std::left << "Junction params" << std::setw(MEASR) << std::left << "Measurements" 
+		<< std::setw(TOTAL) << std::left << "Memory (MB)" << std::setw(MEASR) << std::left << "Predicted (s)" 
+		<< "Measured (s)" << std::endl;
+
+	double memory(0.), predicted(0.);
+	UINT32 b(1);
+	
+	for (vblockCost_t::const_iterator _it_cost(blockCosts.begin()); _it_cost!=blockCosts.end(); ++_it_cost, ++b)
+	{
+		os << "  " << std::setw(BLOCK-2) << std::left << b <<
+			std::setw(NETID) << std::left << _it_cost->_parameters <<
+			std::setw(JUNCT) << std::left << _it_cost->_junctionParameters <<
+			std::setw(MEASR) << std::left << _it_cost->_measurements <<
+			std::setw(TOTAL) << std::left << std::fixed << std::setprecision(2) << _it_cost->_memory <<
+			std::setw(MEASR) << std::left << std::setprecision(4) << _it_cost->_predictedTime;
+		if (_it_cost->_measuredTime < 0.)
+			os << "-";
+		else
+			os << std::setprecision(4) << _it_cost->_measuredTime;
+		os << std::endl;
+
+		memory += _it_cost->_memory;
+		predicted += _it_cost->_predictedTime;
+	}
+
+	for (dash=BLOCK+NETID+INNER+JUNCT+TOTAL+MEASR; dash>2; dash--)
+		os << "-";
+	os << std::endl;
+	os << std::setw(BLOCK+NETID+JUNCT+MEASR) << std::left << "  Total" <<
+		std::setw(TOTAL) << std::left << std::setprecision(2) << memory <<
+		std::setprecision(4) << predicted << std::endl;
 }
 
 void dna_io_seg::write_stn_appearance(const std::string& sap_filename, const v_stn_block_map& stnAppearance)
@@ -29,7 +29,10 @@
 	#endif
 #endif
 
+#include <cstdint>
+
 #include <include/io/dnaiobase.hpp>
+#include <include/io/dnaiomapped.hpp>
 #include <include/config/dnatypes.hpp>
 #include <include/measurement_types/dnameasurement.hpp>
 
@@ -38,6 +41,33 @@ using namespace dynadjust::measurements;
 namespace dynadjust {
 namespace iostreams {
 
+const char* const SEG_BINARY_IDENTIFIER = "DNASEGB";
+const UINT32 SEG_BINARY_VERSION = 2;
+
+// Header of the binary segmentation file, which holds the block lists of a
+// segmentation file in a form that can be memory mapped and loaded without 
+// parsing.  The header is followed by:
+//   UINT32[blockCount+1]  offset of each block's inner stations,
+//   UINT32[blockCount+1]  offset of each block's junction stations,
+//   UINT32[blockCount+1]  offset of each block's measurements,
+//   UINT32[blockCount]    network ID of each block,
+//   UINT32[]              inner stations of all blocks, then the junction
+//                         stations and measurements of all blocks,
+//   UINT64[]              signature of each measurement of all blocks (see
+//                         measurement_signature), and
+//   char[][STN_NAME_WIDTH] name of each inner station of all blocks.
+// Offsets are counted from the start of each list.  The signatures and
+// names allow a segmentation of a later version of the network to be
+// matched to this one (see dna_segment::SegmentNetworkIncremental) after
+// the binary files from which it was produced have been replaced.
+typedef struct {
+	char	identifier[8];			// SEG_BINARY_IDENTIFIER
+	UINT32	version;				// SEG_BINARY_VERSION
+	UINT32	blockCount;
+	UINT32	blockThreshold;
+	UINT32	minInnerStns;
+} seg_binary_header_t;
+
 class dna_io_seg : public dna_io_base
 {
 public:
@@ -53,6 +83,8 @@ public:
 	void load_seg_file_header_f(const std::string& seg_filename, UINT32& blockCount, 
 		UINT32& blockThreshold, UINT32& minInnerStns);
 
+	// Loads the block lists from the binary segmentation file if it is
+	// up to date, otherwise from the segmentation file.
 	void load_seg_file(const std::string& seg_filename, UINT32& blockCount, 
 		UINT32& blockThreshold, UINT32& minInnerStns,
 		vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML,
@@ -60,6 +92,39 @@ public:
 		pvmsr_t bmsBinaryRecords, pvUINT32 v_measurementCount, 
 		pvUINT32 v_unknownsCount, pvUINT32 v_ContiguousNetList,
 		pvUINT32 v_parameterStationCount);
+	void load_seg_file(const std::string& seg_filename, UINT32& blockCount, 
+		UINT32& blockThreshold, UINT32& minInnerStns,
+		vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML,
+		bool loadMetrics,
+		const mapped_msr_t* bmsBinaryRecords, pvUINT32 v_measurementCount, 
+		pvUINT32 v_unknownsCount, pvUINT32 v_ContiguousNetList,
+		pvUINT32 v_parameterStationCount);
+
+	// Name of the binary segmentation file written with seg_filename
+	static std::string seg_binary_filename(const std::string& seg_filename);
+
+	// Loads the block lists from the binary segmentation file, and optionally
+	// the signature of each measurement and the name of each inner station
+	// (in the order of the measurement and inner station lists).  Returns false 
+	// if the file does not exist, was not written with the segmentation file 
+	// (i.e. is older), or does not match the segmentation file's header.
+	bool load_seg_binary_file(const std::string& seg_filename, const UINT32& blockCount, 
+		const UINT32& blockThreshold, const UINT32& minInnerStns,
+		vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML, vUINT32& v_ContiguousNetList,
+		std::vector<std::uint64_t>* msrSignatures=NULL, vstring* innerStnNames=NULL);
+
+	void write_seg_binary_file(const std::string& seg_filename, 
+		const UINT32& min_inner_stns, const UINT32& max_block_stns,
+		const vvUINT32& v_ISL, const vvUINT32& v_JSL, const vvUINT32& v_CML,
+		const vUINT32& v_ContiguousNetList, 
+		const vstn_t& bstBinaryRecords, const vmsr_t& bmsBinaryRecords);
+
+	// Identifies a measurement (or cluster) by its type, the names of its
+	// stations and its values, so that it can be found in another version
+	// of the binary measurement file.  firstIndex is the measurement's
+	// first binary record.
+	std::uint64_t measurement_signature(const vmsr_t& bmsBinaryRecords, const vstn_t& bstBinaryRecords, 
+		const UINT32& firstIndex) const;
 
 	void create_stn_appearance_list(vv_stn_appear& v_paramStnAppearance,
 		const vvUINT32& paramStationList,
@@ -76,15 +141,30 @@ public:
 		const std::string& seg_starting_stns, const vstring& vinitialStns,
 		const std::string& command_line_arguments,
 		vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML,
-		vUINT32& v_ContiguousNetList, const pvstn_t bstBinaryRecords, const pvmsr_t bmsBinaryRecords);
+		vUINT32& v_ContiguousNetList, const pvstn_t bstBinaryRecords, const pvmsr_t bmsBinaryRecords,
+		const vblockCost_t* blockCosts=NULL,
+		const std::string& previous_seg_filename="", const std::string& resegmented_blocks="");
+
+	void write_seg_block_costs(std::ostream &os, const vblockCost_t& blockCosts);
 
 	void build_free_stn_availability(vASL& assocStnList, v_freestn_pair& freeStnList);
 
 	void write_stn_appearance(const std::string& sap_filename, const v_stn_block_map& stnAppearance);
 	void load_stn_appearance(const std::string& sap_filename, v_stn_block_map& stnAppearance);
 
-protected:
+	// Number of measurement quantities in a measurement (e.g. three for a GNSS baseline)
+	static UINT32 measurement_quantities(const measurement_t& msr);
 
+protected:
+	// MsrRecords may be vmsr_t or mapped_msr_t
+	template <typename MsrRecords>
+	void load_seg_records(const std::string& seg_filename, UINT32& blockCount, 
+		UINT32& blockThreshold, UINT32& minInnerStns,
+		vvUINT32& v_ISL, vvUINT32& v_JSL, vvUINT32& v_CML,
+		bool loadMetrics,
+		const MsrRecords* bmsBinaryRecords, pvUINT32 v_measurementCount, 
+		pvUINT32 v_unknownsCount, pvUINT32 v_ContiguousNetList,
+		pvUINT32 v_parameterStationCount);
 };
 
 }	// namespace measurements
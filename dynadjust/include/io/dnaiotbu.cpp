@@ -178,26 +178,20 @@ void dna_io_tbu::load_tbu_argument(const std::string& argument, type_b_uncertain
 }
 	
 
-void dna_io_tbu::identify_station_id(const std::string& stn_str, UINT32& stn_id, v_string_uint32_pair& vStnsMap)
+void dna_io_tbu::identify_station_id(std::string_view stn_str, UINT32& stn_id, const station_name_index& stnsIndex)
 {
-	it_pair_string_vUINT32 it_stnmap_range;
-	std::stringstream ss;
-
 	// find this station in the station map
-	it_stnmap_range = equal_range(vStnsMap.begin(), vStnsMap.end(), stn_str, StationNameIDCompareName());
-	if (it_stnmap_range.first == it_stnmap_range.second)
+	if ((stn_id = stnsIndex.find(stn_str)) == station_name_index::npos)
 	{
+		std::stringstream ss;
 		ss << "  Station '" << stn_str <<
 			"' is not included in the network." << std::endl;
 		throw boost::enable_current_exception(std::runtime_error(ss.str()));
 	}
-
-	stn_id = it_stnmap_range.first->second;
-
 }
 	
 
-void dna_io_tbu::load_tbu_file(const std::string& tbu_filename, v_type_b_uncertainty& type_b_uncertainties, v_string_uint32_pair& vStnsMap)
+void dna_io_tbu::load_tbu_file(const std::string& tbu_filename, v_type_b_uncertainty& type_b_uncertainties, const station_name_index& stnsIndex)
 {
 	// Type B uncertainty file structure is as follows.
 	// Note - uncertainties are in metres, in the local reference frame (e,n,u)
@@ -267,7 +261,7 @@ void dna_io_tbu::load_tbu_file(const std::string& tbu_filename, v_type_b_uncerta
 			// obtain station name and unique ID
 			stn_str = trimstr(record.substr(0, STATION));
 			try {
-				identify_station_id(stn_str, stn_id, vStnsMap);
+				identify_station_id(stn_str, stn_id, stnsIndex);
 			}
 			catch (const std::runtime_error&) {
 				// Can't find the station, ignore.
@@ -36,6 +36,7 @@
 #include <include/functions/dnatemplatestnmsrfuncs.hpp>
 #include <include/functions/dnatemplatematrixfuncs.hpp>
 #include <include/functions/dnaiostreamfuncs.hpp>
+#include <include/functions/dnastationindex.hpp>
 #include <include/math/dnamatrix_contiguous.hpp>
 
 using namespace dynadjust::math;
@@ -148,10 +149,10 @@ public:
 
 	void read_tbu_header(std::ifstream* ptr, std::string& version, INPUT_DATA_TYPE& idt);
 
-	void load_tbu_file(const std::string& tbu_filename, v_type_b_uncertainty& type_b_uncertainties, v_string_uint32_pair& vStnsMap);
+	void load_tbu_file(const std::string& tbu_filename, v_type_b_uncertainty& type_b_uncertainties, const station_name_index& stnsIndex);
 	void load_tbu_argument(const std::string& argument, type_b_uncertainty& type_b_uncertainties);
 
-	void identify_station_id(const std::string& stn_str, UINT32& stn_id, v_string_uint32_pair& vStnsMap);
+	void identify_station_id(std::string_view stn_str, UINT32& stn_id, const station_name_index& stnsIndex);
 
 	void validate_typeb_values(const std::string& argument, vstring& typeBUncertainties);
 	void assign_typeb_values_global(const vstring& typeBUncertainties, type_b_uncertainty& type_b);
@@ -0,0 +1,493 @@
+//============================================================================
+// Name         : dnamatrix_backend.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : DynAdjust BLAS/LAPACK backends
+//============================================================================
+
+#include <include/math/dnamatrix_backend.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <math.h>
+#include <string.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/exception_ptr.hpp>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#if defined(DNA_MATRIX_BACKEND_MKL)
+#include <mkl.h>
+#elif defined(DNA_MATRIX_BACKEND_OPENBLAS) || defined(DNA_MATRIX_BACKEND_BLIS)
+// Fortran BLAS/LAPACK interface, as exported by OpenBLAS, BLIS (BLAS
+// compatibility layer) and reference LAPACK
+#if defined(DNA_BLAS_ILP64)
+typedef long long blas_int;
+#else
+typedef int blas_int;
+#endif
+extern "C" {
+void dgemm_(const char* transa, const char* transb, const blas_int* m, const blas_int* n, const blas_int* k,
+	const double* alpha, const double* a, const blas_int* lda, const double* b, const blas_int* ldb,
+	const double* beta, double* c, const blas_int* ldc);
+void dpotrf_(const char* uplo, const blas_int* n, double* a, const blas_int* lda, blas_int* info);
+void dpotri_(const char* uplo, const blas_int* n, double* a, const blas_int* lda, blas_int* info);
+#if defined(DNA_MATRIX_BACKEND_OPENBLAS)
+int openblas_get_num_threads(void);
+#endif
+}
+#endif
+
+namespace dynadjust { namespace math {
+
+namespace {
+
+// column * lda + row
+#define REF_ELEMENT(A, lda, row, column) A[static_cast<std::size_t>(column) * lda + row]
+
+// Minimum number of multiply-adds for which the reference dgemm
+// distributes columns of the result across threads
+const double REF_DGEMM_PARALLEL_OPS = 262144.;
+
+////////////////////////////////////////////////////////////////////////////
+// Reference implementation
+//
+// Loop orders follow the reference BLAS/LAPACK routines, so that the
+// innermost loop always runs down a (contiguous) column.
+
+void reference_dgemm(const char* transa, const char* transb,
+	const UINT32& m, const UINT32& n, const UINT32& k,
+	const double& alpha, const double* a, const UINT32& lda,
+	const double* b, const UINT32& ldb,
+	const double& beta, double* c, const UINT32& ldc)
+{
+	const bool trans_a(toupper(transa[0]) == 'T');
+	const bool trans_b(toupper(transb[0]) == 'T');
+
+	if (m == 0 || n == 0)
+		return;
+
+	const bool parallel(static_cast<double>(m) * n * k > REF_DGEMM_PARALLEL_OPS);
+
+	// Each column of C is independent
+#pragma omp parallel for schedule(static) if (parallel)
+	for (long long jl=0; jl<static_cast<long long>(n); ++jl)
+	{
+		const UINT32 j(static_cast<UINT32>(jl));
+		UINT32 i, l;
+		double temp;
+
+		if (trans_a)
+		{
+			// C(i,j) = alpha * A(:,i)' * op(B)(:,j) + beta * C(i,j)
+			for (i=0; i<m; ++i)
+			{
+				temp = 0.;
+				if (trans_b)
+					for (l=0; l<k; ++l)
+						temp += REF_ELEMENT(a, lda, l, i) * REF_ELEMENT(b, ldb, j, l);
+				else
+				{
+					const double* a_col(&REF_ELEMENT(a, lda, 0, i));
+					const double* b_col(&REF_ELEMENT(b, ldb, 0, j));
+#pragma omp simd reduction(+:temp)
+					for (l=0; l<k; ++l)
+						temp += a_col[l] * b_col[l];
+				}
+
+				if (beta == 0.)
+					REF_ELEMENT(c, ldc, i, j) = alpha * temp;
+				else
+					REF_ELEMENT(c, ldc, i, j) = alpha * temp + beta * REF_ELEMENT(c, ldc, i, j);
+			}
+			continue;
+		}
+
+		// C(:,j) = beta * C(:,j) + sum(alpha * op(B)(l,j) * A(:,l))
+		double* c_col(&REF_ELEMENT(c, ldc, 0, j));
+		if (beta == 0.)
+			memset(c_col, 0, m * sizeof(double));
+		else if (beta != 1.)
+			for (i=0; i<m; ++i)
+				c_col[i] *= beta;
+
+		for (l=0; l<k; ++l)
+		{
+			temp = alpha * (trans_b ? REF_ELEMENT(b, ldb, j, l) : REF_ELEMENT(b, ldb, l, j));
+			if (temp == 0.)
+				continue;
+			const double* a_col(&REF_ELEMENT(a, lda, 0, l));
+#pragma omp simd
+			for (i=0; i<m; ++i)
+				c_col[i] += temp * a_col[i];
+		}
+	}
+}
+
+// Cholesky factorisation (unblocked).
+//  'L': A = L * L'
+//  'U': A = U' * U
+long reference_dpotrf(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	UINT32 i, j, p;
+	double ajj;
+
+	if (toupper(uplo) == 'U')
+	{
+		for (j=0; j<n; ++j)
+		{
+			double* a_colj(&REF_ELEMENT(a, lda, 0, j));
+
+			// U(j,j)
+			ajj = a_colj[j];
+			for (p=0; p<j; ++p)
+				ajj -= a_colj[p] * a_colj[p];
+			if (ajj <= 0. || isnan(ajj))
+				return j + 1;
+			ajj = sqrt(ajj);
+			a_colj[j] = ajj;
+
+			// Row j of U
+			for (i=j+1; i<n; ++i)
+			{
+				double* a_coli(&REF_ELEMENT(a, lda, 0, i));
+				double temp(a_coli[j]);
+				for (p=0; p<j; ++p)
+					temp -= a_colj[p] * a_coli[p];
+				a_coli[j] = temp / ajj;
+			}
+		}
+		return 0;
+	}
+
+	for (j=0; j<n; ++j)
+	{
+		double* a_colj(&REF_ELEMENT(a, lda, 0, j));
+
+		// Update column j with the columns to its left
+		for (p=0; p<j; ++p)
+		{
+			const double* a_colp(&REF_ELEMENT(a, lda, 0, p));
+			const double ajp(a_colp[j]);
+#pragma omp simd
+			for (i=j; i<n; ++i)
+				a_colj[i] -= ajp * a_colp[i];
+		}
+
+		// L(j,j)
+		ajj = a_colj[j];
+		if (ajj <= 0. || isnan(ajj))
+			return j + 1;
+		ajj = sqrt(ajj);
+		a_colj[j] = ajj;
+
+		// Column j of L
+		for (i=j+1; i<n; ++i)
+			a_colj[i] /= ajj;
+	}
+	return 0;
+}
+
+// Inverse of a triangular matrix (non-unit diagonal), in place
+long reference_dtrtri(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	UINT32 i, j, jj;
+	double ajj, temp;
+
+	for (j=0; j<n; ++j)
+		if (REF_ELEMENT(a, lda, j, j) == 0.)
+			return j + 1;
+
+	if (toupper(uplo) == 'U')
+	{
+		for (j=0; j<n; ++j)
+		{
+			REF_ELEMENT(a, lda, j, j) = 1. / REF_ELEMENT(a, lda, j, j);
+			ajj = -REF_ELEMENT(a, lda, j, j);
+
+			// Elements 0..j-1 of column j: x = inv(U(0:j,0:j)) * U(0:j,j)
+			double* x(&REF_ELEMENT(a, lda, 0, j));
+			for (jj=0; jj<j; ++jj)
+			{
+				temp = x[jj];
+				if (temp == 0.)
+					continue;
+				for (i=0; i<jj; ++i)
+					x[i] += temp * REF_ELEMENT(a, lda, i, jj);
+				x[jj] = temp * REF_ELEMENT(a, lda, jj, jj);
+			}
+			for (i=0; i<j; ++i)
+				x[i] *= ajj;
+		}
+		return 0;
+	}
+
+	for (j=n; j-->0; )
+	{
+		REF_ELEMENT(a, lda, j, j) = 1. / REF_ELEMENT(a, lda, j, j);
+		ajj = -REF_ELEMENT(a, lda, j, j);
+
+		// Elements j+1..n-1 of column j: x = inv(L(j+1:n,j+1:n)) * L(j+1:n,j)
+		double* x(&REF_ELEMENT(a, lda, 0, j));
+		for (jj=n; jj-->j+1; )
+		{
+			temp = x[jj];
+			if (temp == 0.)
+				continue;
+			for (i=n; i-->jj+1; )
+				x[i] += temp * REF_ELEMENT(a, lda, i, jj);
+			x[jj] = temp * REF_ELEMENT(a, lda, jj, jj);
+		}
+		for (i=j+1; i<n; ++i)
+			x[i] *= ajj;
+	}
+	return 0;
+}
+
+// Inverse of a positive definite matrix from its Cholesky factor
+//  'L': inv(A) = inv(L)' * inv(L)
+//  'U': inv(A) = inv(U) * inv(U)'
+long reference_dpotri(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	long info(reference_dtrtri(uplo, n, a, lda));
+	if (info != 0)
+		return info;
+
+	UINT32 i, r, p;
+	double aii, temp;
+
+	if (toupper(uplo) == 'U')
+	{
+		// A = U * U'
+		for (i=0; i<n; ++i)
+		{
+			aii = REF_ELEMENT(a, lda, i, i);
+			for (r=0; r<=i; ++r)
+			{
+				temp = aii * REF_ELEMENT(a, lda, r, i);
+				for (p=i+1; p<n; ++p)
+					temp += REF_ELEMENT(a, lda, r, p) * REF_ELEMENT(a, lda, i, p);
+				REF_ELEMENT(a, lda, r, i) = temp;
+			}
+		}
+		return 0;
+	}
+
+	// A = L' * L
+	for (i=0; i<n; ++i)
+	{
+		aii = REF_ELEMENT(a, lda, i, i);
+		const double* a_coli(&REF_ELEMENT(a, lda, 0, i));
+		for (r=0; r<=i; ++r)
+		{
+			const double* a_colr(&REF_ELEMENT(a, lda, 0, r));
+			temp = aii * a_colr[i];
+			for (p=i+1; p<n; ++p)
+				temp += a_coli[p] * a_colr[p];
+			REF_ELEMENT(a, lda, i, r) = temp;
+		}
+	}
+	return 0;
+}
+
+const matrix_backend_t reference_backend = {
+	"reference", reference_dgemm, reference_dpotrf, reference_dpotri
+};
+
+
+////////////////////////////////////////////////////////////////////////////
+// Optimised library chosen at build time
+
+#if defined(DNA_MATRIX_BACKEND_MKL)
+
+void mkl_dgemm(const char* transa, const char* transb,
+	const UINT32& m, const UINT32& n, const UINT32& k,
+	const double& alpha, const double* a, const UINT32& lda,
+	const double* b, const UINT32& ldb,
+	const double& beta, double* c, const UINT32& ldc)
+{
+	MKL_INT m_(m), n_(n), k_(k), lda_(lda), ldb_(ldb), ldc_(ldc);
+	dgemm(transa, transb, &m_, &n_, &k_, &alpha, a, &lda_, b, &ldb_, &beta, c, &ldc_);
+}
+
+long mkl_dpotrf(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	MKL_INT n_(n), lda_(lda), info(0);
+	dpotrf(&uplo, &n_, a, &lda_, &info);
+	return static_cast<long>(info);
+}
+
+long mkl_dpotri(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	MKL_INT n_(n), lda_(lda), info(0);
+	dpotri(&uplo, &n_, a, &lda_, &info);
+	return static_cast<long>(info);
+}
+
+const matrix_backend_t library_backend = {
+	"mkl", mkl_dgemm, mkl_dpotrf, mkl_dpotri
+};
+
+#elif defined(DNA_MATRIX_BACKEND_OPENBLAS) || defined(DNA_MATRIX_BACKEND_BLIS)
+
+void fortran_dgemm(const char* transa, const char* transb,
+	const UINT32& m, const UINT32& n, const UINT32& k,
+	const double& alpha, const double* a, const UINT32& lda,
+	const double* b, const UINT32& ldb,
+	const double& beta, double* c, const UINT32& ldc)
+{
+	blas_int m_(m), n_(n), k_(k), lda_(lda), ldb_(ldb), ldc_(ldc);
+	dgemm_(transa, transb, &m_, &n_, &k_, &alpha, a, &lda_, b, &ldb_, &beta, c, &ldc_);
+}
+
+long fortran_dpotrf(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	blas_int n_(n), lda_(lda), info(0);
+	dpotrf_(&uplo, &n_, a, &lda_, &info);
+	return static_cast<long>(info);
+}
+
+long fortran_dpotri(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	blas_int n_(n), lda_(lda), info(0);
+	dpotri_(&uplo, &n_, a, &lda_, &info);
+	return static_cast<long>(info);
+}
+
+const matrix_backend_t library_backend = {
+#if defined(DNA_MATRIX_BACKEND_BLIS)
+	"blis",
+#else
+	"openblas",
+#endif
+	fortran_dgemm, fortran_dpotrf, fortran_dpotri
+};
+
+#endif
+
+// Available backends, default first
+const matrix_backend_t* const backends[] = {
+#if defined(DNA_MATRIX_BACKEND_MKL) || defined(DNA_MATRIX_BACKEND_OPENBLAS) || defined(DNA_MATRIX_BACKEND_BLIS)
+	&library_backend,
+#endif
+	&reference_backend
+};
+
+const std::size_t backend_count(sizeof(backends) / sizeof(backends[0]));
+
+std::atomic<const matrix_backend_t*> current_backend_(backends[0]);
+
+}	// namespace
+
+
+void matrix_backend::dgemm(const char* transa, const char* transb,
+	const UINT32& m, const UINT32& n, const UINT32& k,
+	const double& alpha, const double* a, const UINT32& lda,
+	const double* b, const UINT32& ldb,
+	const double& beta, double* c, const UINT32& ldc)
+{
+	current_backend_.load()->dgemm_(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+
+long matrix_backend::dpotrf(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	return current_backend_.load()->dpotrf_(uplo, n, a, lda);
+}
+
+
+long matrix_backend::dpotri(const char& uplo, const UINT32& n, double* a, const UINT32& lda)
+{
+	return current_backend_.load()->dpotri_(uplo, n, a, lda);
+}
+
+
+const matrix_backend_t* matrix_backend::backend(const std::string& name)
+{
+	if (name.empty() || boost::iequals(name, "default"))
+		return backends[0];
+
+	for (std::size_t b(0); b<backend_count; ++b)
+		if (boost::iequals(name, backends[b]->name_))
+			return backends[b];
+	return 0;
+}
+
+
+void matrix_backend::select(const std::string& name)
+{
+	const matrix_backend_t* b(backend(name));
+	if (b == 0)
+	{
+		std::stringstream ss;
+		ss << "select(): The matrix backend \"" << name << "\" is not available in this build." << std::endl <<
+			"  Available backends: " << available_list() << ".";
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+	current_backend_ = b;
+}
+
+
+std::string matrix_backend::name()
+{
+	return current_backend_.load()->name_;
+}
+
+
+UINT32 matrix_backend::max_threads()
+{
+	int threads(1);
+
+#if defined(DNA_MATRIX_BACKEND_MKL)
+	if (current_backend_.load() == &library_backend)
+		return static_cast<UINT32>(std::max(1, mkl_get_max_threads()));
+#elif defined(DNA_MATRIX_BACKEND_OPENBLAS)
+	if (current_backend_.load() == &library_backend)
+		return static_cast<UINT32>(std::max(1, openblas_get_num_threads()));
+#endif
+
+	// The reference backend, and BLIS (when built with OpenMP
+	// and BLIS_NUM_THREADS is not set), follow OMP_NUM_THREADS
+#if defined(_OPENMP)
+	threads = omp_get_max_threads();
+#endif
+	return static_cast<UINT32>(std::max(1, threads));
+}
+
+
+std::vector<std::string> matrix_backend::available()
+{
+	std::vector<std::string> names;
+	for (std::size_t b(0); b<backend_count; ++b)
+		names.push_back(backends[b]->name_);
+	return names;
+}
+
+
+std::string matrix_backend::available_list()
+{
+	return boost::algorithm::join(available(), ", ");
+}
+
+}	// namespace math
+}	// namespace dynadjust
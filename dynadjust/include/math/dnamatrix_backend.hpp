@@ -0,0 +1,99 @@
+//===========================================================================
+// Name         : dnamatrix_backend.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Interface for DynAdjust BLAS/LAPACK backends
+//                The dense matrix kernels used by matrix_2d (dgemm, dpotrf and
+//                dpotri) are dispatched through a table of function pointers,
+//                so that the library used can be chosen at run time.  Two
+//                backends are available in every build:
+//                  - the optimised library selected when DynAdjust is built
+//                    (DNA_MATRIX_BACKEND = MKL, OPENBLAS or BLIS), and
+//                  - a portable reference implementation, which has no
+//                    external dependencies.
+//                All matrices are column-major (see DNAMATRIX_INDEX).
+//============================================================================
+
+#ifndef DNAMATRIX_BACKEND_H_
+#define DNAMATRIX_BACKEND_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <string>
+#include <vector>
+#include <include/config/dnatypes.hpp>
+
+namespace dynadjust { namespace math {
+
+// Kernel signatures.  Transpose and triangle flags follow the BLAS
+// conventions ("N"/"T" and 'L'/'U').  dpotrf and dpotri return the
+// LAPACK info value (0 on success).
+typedef void (*dgemm_kernel)(const char* transa, const char* transb,
+	const UINT32& m, const UINT32& n, const UINT32& k,
+	const double& alpha, const double* a, const UINT32& lda,
+	const double* b, const UINT32& ldb,
+	const double& beta, double* c, const UINT32& ldc);
+typedef long (*dpotrf_kernel)(const char& uplo, const UINT32& n, double* a, const UINT32& lda);
+typedef long (*dpotri_kernel)(const char& uplo, const UINT32& n, double* a, const UINT32& lda);
+
+struct matrix_backend_t
+{
+	const char*		name_;
+	dgemm_kernel	dgemm_;
+	dpotrf_kernel	dpotrf_;
+	dpotri_kernel	dpotri_;
+};
+
+class matrix_backend
+{
+public:
+	// Kernels of the current backend
+	static void dgemm(const char* transa, const char* transb,
+		const UINT32& m, const UINT32& n, const UINT32& k,
+		const double& alpha, const double* a, const UINT32& lda,
+		const double* b, const UINT32& ldb,
+		const double& beta, double* c, const UINT32& ldc);
+	static long dpotrf(const char& uplo, const UINT32& n, double* a, const UINT32& lda);
+	static long dpotri(const char& uplo, const UINT32& n, double* a, const UINT32& lda);
+
+	// Selects the backend by name (e.g. "mkl", "openblas", "reference").
+	// An empty string or "default" selects the build default.  Throws
+	// std::runtime_error if the backend is not available in this build.
+	static void select(const std::string& name);
+
+	// Name of the current backend
+	static std::string name();
+
+	// Number of threads the current backend uses for each kernel
+	static UINT32 max_threads();
+
+	// Names of all backends available in this build, default first
+	static std::vector<std::string> available();
+	static std::string available_list();
+
+	static const matrix_backend_t* backend(const std::string& name);
+};
+
+}	// namespace math
+}	// namespace dynadjust
+
+#endif	// DNAMATRIX_BACKEND_H_
@@ -235,6 +235,42 @@ std::ostream& operator<< (std::ostream& os, const matrix_2d& rhs)
 //}
 
 	
+// Prints the elements of a view in ASCII.  Views are not intended for
+// serialisation, so the binary stream flag is ignored.
+std::ostream& operator<< (std::ostream& os, const matrix_view& rhs)
+{
+	os << rhs._rows << " " << rhs._cols << std::endl;
+	
+	for (UINT32 c, r=0; r<rhs._rows; ++r)  
+	{
+		for (c=0; c<rhs._cols; ++c) 
+			os << std::scientific << std::setprecision(16) << rhs.get(r,c) << " ";
+		os << std::endl;
+	}
+	os << std::endl;
+	
+	return os;
+}
+	
+
+matrix_view::matrix_view(const matrix_2d& mat, const UINT32& row_begin, const UINT32& col_begin,
+	const UINT32& rows, const UINT32& columns)
+	: _mem_cols(mat.memColumns())
+	, _mem_rows(mat.memRows())
+	, _cols(columns)
+	, _rows(rows)
+	, _buffer(0)
+{
+	if (row_begin + rows > mat.rows() || col_begin + columns > mat.columns()) {
+		std::stringstream ss;
+		ss << row_begin + rows << ", " << col_begin + columns << " lies outside the range of the matrix (" << mat.rows() << ", " << mat.columns() << ").";
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	_buffer = mat.getbuffer(row_begin, col_begin);
+}
+	
+
 UINT32 __row__;
 UINT32 __col__;
 //string _method_;
@@ -265,6 +301,7 @@ matrix_2d::matrix_2d()
 	, _cols(0)
 	, _rows(0)
 	, _buffer(0)
+	, _buffer_bytes(0)
 	, _maxvalCol(0)
 	, _maxvalRow(0)
 	, _matrixType(mtx_full)
@@ -285,6 +322,7 @@ matrix_2d::matrix_2d(const UINT32& rows, const UINT32& columns)
 	, _cols(columns)
 	, _rows(rows)
 	, _buffer(0)
+	, _buffer_bytes(0)
 	, _maxvalCol(0)
 	, _maxvalRow(0)
 	, _matrixType(mtx_full)
@@ -301,6 +339,7 @@ matrix_2d::matrix_2d(const UINT32& rows, const UINT32& columns,
 	, _cols(columns)
 	, _rows(rows)
 	, _buffer(0)
+	, _buffer_bytes(0)
 	, _maxvalCol(0)
 	, _maxvalRow(0)
 	, _matrixType(matrix_type)
@@ -365,6 +404,7 @@ matrix_2d::matrix_2d(const matrix_2d& newmat)
 	, _cols(newmat.columns())
 	, _rows(newmat.rows())
 	, _buffer(0)
+	, _buffer_bytes(0)
 	, _maxvalCol(newmat.maxvalueCol())
 	, _maxvalRow(newmat.maxvalueRow())
 	, _matrixType(newmat.matrixType())
@@ -616,6 +656,7 @@ void matrix_2d::allocate(const UINT32& rows, const UINT32& columns)
 	// an exception will be thrown by out_of_memory_handler
 	// if memory cannot be allocated
 	buy(rows, columns, &_buffer);
+	_buffer_bytes = byteSize<double>(rows * columns);
 }
 	
 
@@ -628,9 +669,9 @@ void matrix_2d::buy(const UINT32& rows, const UINT32& columns, double** mem_spac
 	__row__ = rows;
 	__col__ = columns;
 
-	// an exception will be thrown by out_of_memory_handler
-	// if memory cannot be allocated
-	(*mem_space) = new double[rows * columns];
+	// Buffers are 64-byte aligned and recycled from the
+	// calling thread's buffer pool where possible
+	(*mem_space) = static_cast<double*>(buffer_pool::allocate(byteSize<double>(rows * columns)));
 	
 	if ((*mem_space) == NULL)	
 	{
@@ -648,8 +689,9 @@ void matrix_2d::deallocate()
 {
 	if (_buffer != NULL)
 	{
-		delete [] _buffer;
+		buffer_pool::deallocate(_buffer, _buffer_bytes);
 		_buffer = 0;
+		_buffer_bytes = 0;
 	}
 }
 	
@@ -892,6 +934,13 @@ void matrix_2d::copybuffer(const UINT32& rowstart, const UINT32& columnstart, co
 
 void matrix_2d::copyelements(const UINT32& row_dest, const UINT32& column_dest, 
 	const matrix_2d& src, const UINT32& row_src, const UINT32& column_src, const UINT32& rows, const UINT32& columns)
+{
+	copyelements(row_dest, column_dest, matrix_view(src), row_src, column_src, rows, columns);
+}
+	
+
+void matrix_2d::copyelements(const UINT32& row_dest, const UINT32& column_dest, 
+	const matrix_view& src, const UINT32& row_src, const UINT32& column_src, const UINT32& rows, const UINT32& columns)
 {
 #if defined(DNAMATRIX_ROW_WISE)
 
@@ -910,6 +959,12 @@ void matrix_2d::copyelements(const UINT32& row_dest, const UINT32& column_dest,
 }
 	
 
+void matrix_2d::copyelements(const UINT32& row_dest, const UINT32& column_dest, const matrix_view& src)
+{
+	copyelements(row_dest, column_dest, src, 0, 0, src.rows(), src.columns());
+}
+	
+
 void matrix_2d::copyelements(const UINT32& row_dest, const UINT32& column_dest, 
 	const matrix_2d* src, const UINT32& row_src, const UINT32& column_src, const UINT32& rows, const UINT32& columns)
 {
@@ -1226,7 +1281,7 @@ void matrix_2d::sweep(UINT32 k1, UINT32 k2)
 }																					
 	
 
-matrix_2d matrix_2d::sweepinverse()
+matrix_2d& matrix_2d::sweepinverse()
 {
 	if (_rows != _cols)
 		throw boost::enable_current_exception(std::runtime_error("sweepinverse(): Matrix is not square."));
@@ -1305,7 +1360,8 @@ matrix_2d matrix_2d::sweepinverse()
 
 // choleskyinverse_mkl()
 //
-// Inverts the calling matrix using MKL's implementation of the Cholesky method.
+// Inverts the calling matrix using the Cholesky method (dpotrf/dpotri) of
+// the selected matrix backend (see dnamatrix_backend.hpp).
 // The following assumptions are made:
 //	 - matrix is symmetric, and
 //	 - matrix is upper triangular (or a full matrix). 
@@ -1313,7 +1369,7 @@ matrix_2d matrix_2d::sweepinverse()
 // The inversion does not destroy the contents of the matrix 
 // passed to the function, instead it operates on a copy.
 // Index pointers use UINT32
-matrix_2d matrix_2d::choleskyinverse_mkl(bool LOWER_IS_CLEARED /*=false*/)
+matrix_2d& matrix_2d::choleskyinverse_mkl(bool LOWER_IS_CLEARED /*=false*/)
 {
 	if (_rows < 1)
 		return *this;
@@ -1327,20 +1383,12 @@ matrix_2d matrix_2d::choleskyinverse_mkl(bool LOWER_IS_CLEARED /*=false*/)
 	if (LOWER_IS_CLEARED)
 		uplo = UPPER_TRIANGLE;
 
-#if defined(_WIN64) || defined(__linux) || defined(sun) || defined(__unix__) || defined(__APPLE__)
-	long long info, n = _rows;
-#else // defined(_WIN32) || defined(__WIN32__)
-	int info, n = _rows;
-#endif	
-
 	// Perform Cholesky factorisation
-	dpotrf(&uplo, &n, _buffer, &n, &info);
-	if(info != 0)
+	if (matrix_backend::dpotrf(uplo, _rows, _buffer, _rows) != 0)
 		throw boost::enable_current_exception(std::runtime_error("choleskyinverse_mkl(): Cholesky factorisation failed."));
 	
 	// Perform Cholesky inverse
-	dpotri(&uplo, &n, _buffer, &n, &info); 
-	if(info != 0)
+	if (matrix_backend::dpotri(uplo, _rows, _buffer, _rows) != 0)
 		throw boost::enable_current_exception(std::runtime_error("choleskyinverse_mkl(): Cholesky inversion failed."));
 
 	// Copy empty triangle part
@@ -1494,7 +1542,7 @@ matrix_2d matrix_2d::choleskyinverse_mkl(bool LOWER_IS_CLEARED /*=false*/)
 
 // scale()
 //
-matrix_2d matrix_2d::scale(const double& scalar)
+matrix_2d& matrix_2d::scale(const double& scalar)
 {
 	UINT32 i, j;
 	for (i=0; i<_rows; ++i)
@@ -1505,6 +1553,13 @@ matrix_2d matrix_2d::scale(const double& scalar)
 			
 void matrix_2d::blockadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_2d& mat_src, 
 						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols)
+{
+	blockadd(row_dest, col_dest, matrix_view(mat_src), row_src, col_src, rows, cols);
+}
+	
+
+void matrix_2d::blockadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src, 
+						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols)
 {
 	UINT32 i_dest, j_dest, i_src, j_src;
 	UINT32 i_dest_end(row_dest+rows), j_dest_end(col_dest+cols);
@@ -1516,9 +1571,22 @@ void matrix_2d::blockadd(const UINT32& row_dest, const UINT32& col_dest, const m
 	
 
 
+void matrix_2d::blockadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src)
+{
+	blockadd(row_dest, col_dest, mat_src, 0, 0, mat_src.rows(), mat_src.columns());
+}
+	
+
 // Same as blockadd, but adds transpose.  mat_src must be square.
 void matrix_2d::blockTadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_2d& mat_src, 
 						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols)
+{
+	blockTadd(row_dest, col_dest, matrix_view(mat_src), row_src, col_src, rows, cols);
+}
+	
+
+void matrix_2d::blockTadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src, 
+						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols)
 {
 	UINT32 i_dest, j_dest, i_src, j_src;
 	UINT32 i_dest_end(row_dest+rows), j_dest_end(col_dest+cols);
@@ -1531,6 +1599,13 @@ void matrix_2d::blockTadd(const UINT32& row_dest, const UINT32& col_dest, const
 
 void matrix_2d::blocksubtract(const UINT32& row_dest, const UINT32& col_dest, const matrix_2d& mat_src, 
 						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols)
+{
+	blocksubtract(row_dest, col_dest, matrix_view(mat_src), row_src, col_src, rows, cols);
+}
+	
+
+void matrix_2d::blocksubtract(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src, 
+						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols)
 {
 	UINT32 i_dest, j_dest, i_src, j_src;
 	UINT32 i_dest_end(row_dest+rows), j_dest_end(col_dest+cols);
@@ -1680,7 +1755,7 @@ void matrix_2d::zero(const UINT32& row_begin, const UINT32& col_begin,
 //} // coutMatrix()
 	
 
-matrix_2d matrix_2d::operator=(const matrix_2d& rhs)
+matrix_2d& matrix_2d::operator=(const matrix_2d& rhs)
 {
 	// Overloaded assignment operator
 	if (this == &rhs)
@@ -1845,7 +1920,7 @@ matrix_2d matrix_2d::operator*(const double& rhs) const
 //	return *this;
 //}
 
-matrix_2d matrix_2d::add(const matrix_2d& rhs)
+matrix_2d& matrix_2d::add(const matrix_2d& rhs)
 {
 	if (_rows != rhs.rows() || _cols != rhs.columns())
 		throw boost::enable_current_exception(std::runtime_error("add(): Result matrix dimensions are incompatible."));
@@ -1899,27 +1974,19 @@ matrix_2d matrix_2d::add(const matrix_2d& rhs)
 //}
 	
 // multiplies this matrix by rhs and stores the result in a new matrix
-// Uses Intel MKL dgemm
-matrix_2d matrix_2d::multiply_mkl(const char* lhs_trans, const matrix_2d& rhs, const char* rhs_trans)
+// Uses dgemm of the selected matrix backend
+matrix_2d& matrix_2d::multiply_mkl(const char* lhs_trans, const matrix_2d& rhs, const char* rhs_trans)
 {
 	matrix_2d m(_rows, rhs.columns());
 	
 	const double one = 1.0;
 	const double zero = 0.0;
 
-#if defined(_WIN64) || defined(__linux) || defined(sun) || defined(__unix__) || defined(__APPLE__)
-	long long lhs_rows(rows()), rhs_cols(rhs.columns());
-	long long lhs_cols(columns()), rhs_rows(rhs.rows());
-	long long new_mem_rows(memRows());
-	long long lhs_mem_rows(memRows());
-	long long rhs_mem_rows(memRows());
-#else // defined(_WIN32) || defined(__WIN32__)
-	int lhs_rows(rows()), rhs_cols(rhs.columns());
-	int lhs_cols(columns()), rhs_rows(rhs.rows());
-	int new_mem_rows(memRows());
-	int lhs_mem_rows(memRows());
-	int rhs_mem_rows(memRows());
-#endif	
+	UINT32 lhs_rows(rows()), rhs_cols(rhs.columns());
+	UINT32 lhs_cols(columns()), rhs_rows(rhs.rows());
+	UINT32 new_mem_rows(memRows());
+	UINT32 lhs_mem_rows(memRows());
+	UINT32 rhs_mem_rows(memRows());
 
 	if (strcmp(lhs_trans, "T") == 0)
 	{
@@ -1939,18 +2006,18 @@ matrix_2d matrix_2d::multiply_mkl(const char* lhs_trans, const matrix_2d& rhs, c
 	else if (_rows != lhs_rows || _cols != rhs_cols)
 		throw boost::enable_current_exception(std::runtime_error("multiply_mkl(): Result matrix dimensions are incompatible."));
 
-	dgemm(lhs_trans, rhs_trans,         // Type of matrices  
-		&lhs_rows,                      // rows of A
-		&rhs_cols, 						// columns of B
-		&lhs_cols,						// columns of A = rows of B
-		&one,							// scalar: 1 (one)
+	matrix_backend::dgemm(lhs_trans, rhs_trans,         // Type of matrices  
+		lhs_rows,                      // rows of A
+		rhs_cols, 						// columns of B
+		lhs_cols,						// columns of A = rows of B
+		one,							// scalar: 1 (one)
 		_buffer,						// A matrix (this)
-		&lhs_mem_rows,					// rows of A
+		lhs_mem_rows,					// rows of A
 		rhs.getbuffer(),				// the B matrix
-		&rhs_mem_rows,					// same as rhs_rows	(columns of A = rows of B)
-		&zero,							// scalar: 0 (zero)
+		rhs_mem_rows,					// same as rhs_rows	(columns of A = rows of B)
+		zero,							// scalar: 0 (zero)
 		m.getbuffer(),					// the resultant matrix
-		&new_mem_rows);					// rows of the resultant matrix
+		new_mem_rows);					// rows of the resultant matrix
 	
 	return (*this = m);
 }
@@ -1978,26 +2045,29 @@ matrix_2d matrix_2d::multiply_mkl(const char* lhs_trans, const matrix_2d& rhs, c
 	
 
 // Multiplies lhs by rhs and stores the result in this.
-// Uses Intel MKL dgemm
-matrix_2d matrix_2d::multiply_mkl(const matrix_2d& lhs, const char* lhs_trans, 
+// Uses dgemm of the selected matrix backend
+matrix_2d& matrix_2d::multiply_mkl(const matrix_2d& lhs, const char* lhs_trans, 
 	const matrix_2d& rhs, const char* rhs_trans)
+{
+	return multiply_mkl(matrix_view(lhs), lhs_trans, matrix_view(rhs), rhs_trans);
+} // Multiply()
+	
+
+// Multiplies lhs by rhs and stores the result in this.  lhs and rhs may
+// be views of sub-matrices, in which case the memory rows of the parent 
+// matrices are passed to dgemm as the leading dimensions.
+// Uses dgemm of the selected matrix backend
+matrix_2d& matrix_2d::multiply_mkl(const matrix_view& lhs, const char* lhs_trans, 
+	const matrix_view& rhs, const char* rhs_trans)
 {
 	const double one = 1.0;
 	const double zero = 0.0;
 
-#if defined(_WIN64) || defined(__linux) || defined(sun) || defined(__unix__) || defined(__APPLE__)
-	long long lhs_rows(lhs.rows()), rhs_cols(rhs.columns());
-	long long lhs_cols(lhs.columns()), rhs_rows(rhs.rows());
-	long long new_mem_rows(memRows());
-	long long lhs_mem_rows(lhs.memRows());
-	long long rhs_mem_rows(rhs.memRows());
-#else // defined(_WIN32) || defined(__WIN32__)
-	int lhs_rows(lhs.rows()), rhs_cols(rhs.columns());
-	int lhs_cols(lhs.columns()), rhs_rows(rhs.rows());
-	int new_mem_rows(memRows());
-	int lhs_mem_rows(lhs.memRows());
-	int rhs_mem_rows(rhs.memRows());
-#endif	
+	UINT32 lhs_rows(lhs.rows()), rhs_cols(rhs.columns());
+	UINT32 lhs_cols(lhs.columns()), rhs_rows(rhs.rows());
+	UINT32 new_mem_rows(memRows());
+	UINT32 lhs_mem_rows(lhs.memRows());
+	UINT32 rhs_mem_rows(rhs.memRows());
 
 	if (strncmp(lhs_trans, "T", 1) == 0)
 	{
@@ -2016,18 +2086,18 @@ matrix_2d matrix_2d::multiply_mkl(const matrix_2d& lhs, const char* lhs_trans,
 	else if (_rows != lhs_rows || _cols != rhs_cols)
 		throw boost::enable_current_exception(std::runtime_error("multiply_mkl(): Result matrix dimensions are incompatible."));
 
-	dgemm(lhs_trans, rhs_trans,         // Type of matrices  
-		&lhs_rows,                      // rows of A
-		&rhs_cols, 						// columns of B
-		&lhs_cols,						// columns of A = rows of B
-		&one,							// scalar: 1 (one)
+	matrix_backend::dgemm(lhs_trans, rhs_trans,         // Type of matrices  
+		lhs_rows,                      // rows of A
+		rhs_cols, 						// columns of B
+		lhs_cols,						// columns of A = rows of B
+		one,							// scalar: 1 (one)
 		lhs.getbuffer(),				// A matrix
-		&lhs_mem_rows,					// rows of A
+		lhs_mem_rows,					// rows of A
 		rhs.getbuffer(),				// the B matrix
-		&rhs_mem_rows,					// same as rhs_rows	(columns of A = rows of B)
-		&zero,							// scalar: 0 (zero)
+		rhs_mem_rows,					// same as rhs_rows	(columns of A = rows of B)
+		zero,							// scalar: 0 (zero)
 		_buffer,						// the resultant matrix (this)
-		&new_mem_rows);					// rows of the resultant matrix
+		new_mem_rows);					// rows of the resultant matrix
 
 	return *this;
 } // Multiply()
@@ -2116,7 +2186,7 @@ matrix_2d matrix_2d::multiply_mkl(const matrix_2d& lhs, const char* lhs_trans,
 	
 
 // Transpose()
-matrix_2d matrix_2d::transpose(const matrix_2d& matA)
+matrix_2d& matrix_2d::transpose(const matrix_2d& matA)
 {
 	if ((matA.columns() != _rows) || (matA.rows() != _cols))
 		throw boost::enable_current_exception(std::runtime_error("transpose(): Matrix dimensions are incompatible."));
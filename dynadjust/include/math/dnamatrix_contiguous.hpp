@@ -39,8 +39,6 @@
 	#endif
 #endif
 
-#include <mkl.h>
-
 #include <exception>
 #include <stdexcept>
 #include <iostream>
@@ -49,10 +47,12 @@
 #include <string>
 #include <vector>
 #include <include/config/dnatypes.hpp>
+#include <include/math/dnamatrix_backend.hpp>
 #include <include/config/dnaversion.hpp>
 #include <include/config/dnaconsts.hpp>
 #include <include/exception/dnaexception.hpp>
 #include <include/memory/dnamemory_handler.hpp>
+#include <include/memory/dnamemory_pool.hpp>
 #include <include/functions/dnatemplatecalcfuncs.hpp>
 
 #ifdef _MSDEBUG
@@ -72,6 +72,7 @@ using namespace dynadjust::exception;
 namespace dynadjust { namespace math {
 
 class matrix_2d;
+class matrix_view;
 typedef std::vector<matrix_2d> v_mat_2d, *pv_mat_2d;
 typedef v_mat_2d::iterator _it_v_mat_2d;
 typedef v_mat_2d::const_iterator _it_v_mat_2d_const;
@@ -158,6 +159,8 @@ public:
 	// Matrix functions
 	void copyelements(const UINT32& row_dest, const UINT32& column_dest, const matrix_2d& src, const UINT32& row_src, const UINT32& column_src, const UINT32& rows, const UINT32& columns);
 	void copyelements(const UINT32& row_dest, const UINT32& column_dest, const matrix_2d* src, const UINT32& row_src, const UINT32& column_src, const UINT32& rows, const UINT32& columns);
+	void copyelements(const UINT32& row_dest, const UINT32& column_dest, const matrix_view& src, const UINT32& row_src, const UINT32& column_src, const UINT32& rows, const UINT32& columns);
+	void copyelements(const UINT32& row_dest, const UINT32& column_dest, const matrix_view& src);	// copies the whole view
 	
 	inline void elementadd(const UINT32& row, const UINT32& column, const double& increment) {
 		*getelementref(row, column) += increment;
@@ -195,18 +198,29 @@ public:
 						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols);
 	void blocksubtract(const UINT32& row_dest, const UINT32& col_dest, const matrix_2d& mat_src, 
 						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols);
+
+	// matrix_view overloads (no copy of the source elements is made)
+	void blockadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src, 
+						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols);
+	void blockTadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src, 
+						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols);
+	void blocksubtract(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src, 
+						 const UINT32& row_src, const UINT32& col_src, const UINT32& rows, const UINT32& cols);
+	void blockadd(const UINT32& row_dest, const UINT32& col_dest, const matrix_view& mat_src);	// adds the whole view
 	
-	matrix_2d add(const matrix_2d& rhs);
+	matrix_2d& add(const matrix_2d& rhs);
 	matrix_2d add(const matrix_2d& lhs, const matrix_2d& rhs);
 	
 	//matrix_2d multiply(const matrix_2d& rhs);			// multiplication
 	//matrix_2d multiply(const matrix_2d& lhs, 
 	//	const matrix_2d& rhs);							// multiplication
 
-	matrix_2d multiply_mkl(const char* lhs_trans, 
+	matrix_2d& multiply_mkl(const char* lhs_trans, 
 		const matrix_2d& rhs, const char* rhs_trans);			// multiplication
-	matrix_2d multiply_mkl(const matrix_2d& lhs, const char* lhs_trans, 
+	matrix_2d& multiply_mkl(const matrix_2d& lhs, const char* lhs_trans, 
 		const matrix_2d& rhs, const char* rhs_trans);			// multiplication
+	matrix_2d& multiply_mkl(const matrix_view& lhs, const char* lhs_trans, 
+		const matrix_view& rhs, const char* rhs_trans);			// multiplication of sub-matrices
 
 	//matrix_2d multiply_square(const matrix_2d& lhs,		// multiplication, calculate upper triangle only, then copy to lower
 	//	const matrix_2d& rhs);							
@@ -214,16 +228,16 @@ public:
 	//	const matrix_2d& rhs);							
 	//matrix_2d multiply_square_t(const matrix_2d& lhs,	// same as multiply_square, except lhs is multiplied by transpose of rhs.
 	//	const matrix_2d& rhs);							
-	matrix_2d sweepinverse();							// Sweep inverse (good for rotation matrices)
+	matrix_2d& sweepinverse();							// Sweep inverse (good for rotation matrices)
 	//matrix_2d gaussianinverse();						// Gaussian inverse
 	//matrix_2d choleskyinverse(bool LOWER_IS_CLEARED=false);				// Cholesky inverse
 	//void decomposeupper();								// Cholesky decomposition 
 	
-	matrix_2d choleskyinverse_mkl(bool LOWER_IS_CLEARED=false);	// Cholesky inverse using MKL
+	matrix_2d& choleskyinverse_mkl(bool LOWER_IS_CLEARED=false);	// Cholesky inverse using the matrix backend
 
-	matrix_2d transpose(const matrix_2d&);				// Transpose
+	matrix_2d& transpose(const matrix_2d&);				// Transpose
 	matrix_2d transpose();								//  ''
-	matrix_2d scale(const double& scalar);				// scale
+	matrix_2d& scale(const double& scalar);				// scale
 	
 	// overloaded operators
 	// equality
@@ -268,7 +282,7 @@ public:
 		return true;
 	}
 
-	matrix_2d operator=(const matrix_2d& rhs);
+	matrix_2d& operator=(const matrix_2d& rhs);
 	matrix_2d operator*(const double& rhs) const;
 	//matrix_2d operator*(const matrix_2d& rhs) const;
 	//matrix_2d operator+(const matrix_2d& rhs) const;
@@ -356,12 +370,69 @@ private:
 	UINT32		_cols;		// number of actual cols
 	UINT32		_rows;			// number of actual rows
 	double*		_buffer;		// matrix buffer elements
+	std::size_t	_buffer_bytes;	// size of the buffer obtained from the pool
 
 	UINT32		_maxvalCol;		// col of max value
 	UINT32		_maxvalRow;		// row of max value
 
 	UINT32		_matrixType;	// full, upper/lower, sparse
 };
+
+
+// Non-owning view of a rectangular region of a matrix_2d buffer.
+// A view holds a pointer to the first element of the region and the 
+// memory dimensions (leading dimension) of the parent matrix, so
+// sub-matrices can be passed to MKL and the block functions without
+// being copied.  The parent must outlive the view and must not be 
+// reallocated (e.g. via redim or allocate) while the view is in use.
+class matrix_view
+{
+public:
+	matrix_view(double* buffer, const UINT32& mem_rows, const UINT32& mem_cols, 
+		const UINT32& rows, const UINT32& columns)
+		: _mem_cols(mem_cols)
+		, _mem_rows(mem_rows)
+		, _cols(columns)
+		, _rows(rows)
+		, _buffer(buffer) {}
+	
+	// view of the entire matrix
+	matrix_view(const matrix_2d& mat)
+		: _mem_cols(mat.memColumns())
+		, _mem_rows(mat.memRows())
+		, _cols(mat.columns())
+		, _rows(mat.rows())
+		, _buffer(mat.getbuffer()) {}
+
+	// view of the sub-matrix commencing at row_begin, col_begin
+	matrix_view(const matrix_2d& mat, const UINT32& row_begin, const UINT32& col_begin,
+		const UINT32& rows, const UINT32& columns);
+
+	///////////////////////////////////////////////////////////////////////
+	// Get
+	inline UINT32 memRows() const { return _mem_rows; }
+	inline UINT32 memColumns() const { return _mem_cols; }
+	inline UINT32 rows() const { return _rows; }
+	inline UINT32 columns() const { return _cols; }
+	inline double* getbuffer() const { return _buffer; }
+
+	// element retrieval
+	// see DNAMATRIX_ROW_WISE
+	inline double& get(const UINT32& row, const UINT32& column) const { return DNAMATRIX_ELEMENT(_buffer, _mem_rows, _mem_cols, row, column); }
+	inline double* getbuffer(const UINT32& row, const UINT32& column) const { 
+		return _buffer + DNAMATRIX_INDEX(_mem_rows, _mem_cols, row, column);
+	}
+
+	// Printing
+	friend std::ostream& operator<< (std::ostream& os, const matrix_view& rhs);
+
+private:
+	UINT32		_mem_cols;		// buffer size of the parent matrix (cols)
+	UINT32		_mem_rows;		// buffer size of the parent matrix (rows)
+	UINT32		_cols;			// number of cols in the view
+	UINT32		_rows;			// number of rows in the view
+	double*		_buffer;		// first element of the view (not owned)
+};
 	
 }	// namespace math 
 }	// namespace dynadjust 
@@ -0,0 +1,387 @@
+//===========================================================================
+// Name         : dnamatrix_fixed.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : DynAdjust fixed-size matrix library
+//                Compile-time sized matrices held on the stack, for the small
+//                per-station and per-measurement shapes (3x1 coordinates, 3x3
+//                rotations and variance matrices, 6x6 station pair variances)
+//                which would otherwise require a heap allocation per matrix_2d.
+//                Storage is row wise.  The element interface (get, put,
+//                elementadd, rows, columns, etc) mirrors matrix_2d, so that
+//                templates may be instantiated for either type.
+//============================================================================
+
+#ifndef DNAMATRIX_FIXED_H_
+#define DNAMATRIX_FIXED_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <exception>
+#include <stdexcept>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <math.h>
+#include <include/config/dnatypes.hpp>
+
+#ifdef _MSDEBUG
+#include <include/ide/trace.hpp>
+#endif
+
+#include <boost/exception_ptr.hpp>
+
+namespace dynadjust { namespace math {
+
+// Align buffers of four or more elements for AVX loads and stores
+template <typename T, UINT32 N>
+struct fixed_alignment
+{
+	static constexpr std::size_t value = (N * sizeof(T) >= 32 ? 32 : alignof(T));
+};
+
+template <typename T, UINT32 R, UINT32 C>
+class matrix_fixed;
+
+// Product kernels.  The general case is a row wise triple loop with
+// compile-time bounds, in which the innermost loop runs over a contiguous
+// row of the result and the right hand side and is vectorised.  The 3x3
+// shapes are specialised below as fully unrolled expressions, which is
+// faster than any vector form for three elements.
+template <typename T, UINT32 R, UINT32 K, UINT32 C>
+struct fixed_product
+{
+	// result = lhs * rhs
+	static inline void nn(T* result, const T* lhs, const T* rhs)
+	{
+		for (UINT32 i(0); i<R*C; ++i)
+			result[i] = T(0);
+		for (UINT32 i(0); i<R; ++i)
+			for (UINT32 k(0); k<K; ++k)
+			{
+				const T a(lhs[i * K + k]);
+#pragma omp simd
+				for (UINT32 j=0; j<C; ++j)
+					result[i * C + j] += a * rhs[k * C + j];
+			}
+	}
+
+	// result = lhs^T * rhs, where lhs is K x R
+	static inline void tn(T* result, const T* lhs, const T* rhs)
+	{
+		for (UINT32 i(0); i<R*C; ++i)
+			result[i] = T(0);
+		for (UINT32 k(0); k<K; ++k)
+			for (UINT32 i(0); i<R; ++i)
+			{
+				const T a(lhs[k * R + i]);
+#pragma omp simd
+				for (UINT32 j=0; j<C; ++j)
+					result[i * C + j] += a * rhs[k * C + j];
+			}
+	}
+
+	// result = lhs * rhs^T, where rhs is C x K
+	static inline void nt(T* result, const T* lhs, const T* rhs)
+	{
+		for (UINT32 i(0); i<R; ++i)
+			for (UINT32 j(0); j<C; ++j)
+			{
+				T sum(0);
+#pragma omp simd reduction(+:sum)
+				for (UINT32 k=0; k<K; ++k)
+					sum += lhs[i * K + k] * rhs[j * K + k];
+				result[i * C + j] = sum;
+			}
+	}
+};
+
+// 3x3 * 3x3
+template <typename T>
+struct fixed_product<T, 3, 3, 3>
+{
+	static inline void nn(T* r, const T* a, const T* b)
+	{
+		r[0] = a[0]*b[0] + a[1]*b[3] + a[2]*b[6];
+		r[1] = a[0]*b[1] + a[1]*b[4] + a[2]*b[7];
+		r[2] = a[0]*b[2] + a[1]*b[5] + a[2]*b[8];
+		r[3] = a[3]*b[0] + a[4]*b[3] + a[5]*b[6];
+		r[4] = a[3]*b[1] + a[4]*b[4] + a[5]*b[7];
+		r[5] = a[3]*b[2] + a[4]*b[5] + a[5]*b[8];
+		r[6] = a[6]*b[0] + a[7]*b[3] + a[8]*b[6];
+		r[7] = a[6]*b[1] + a[7]*b[4] + a[8]*b[7];
+		r[8] = a[6]*b[2] + a[7]*b[5] + a[8]*b[8];
+	}
+
+	static inline void tn(T* r, const T* a, const T* b)
+	{
+		r[0] = a[0]*b[0] + a[3]*b[3] + a[6]*b[6];
+		r[1] = a[0]*b[1] + a[3]*b[4] + a[6]*b[7];
+		r[2] = a[0]*b[2] + a[3]*b[5] + a[6]*b[8];
+		r[3] = a[1]*b[0] + a[4]*b[3] + a[7]*b[6];
+		r[4] = a[1]*b[1] + a[4]*b[4] + a[7]*b[7];
+		r[5] = a[1]*b[2] + a[4]*b[5] + a[7]*b[8];
+		r[6] = a[2]*b[0] + a[5]*b[3] + a[8]*b[6];
+		r[7] = a[2]*b[1] + a[5]*b[4] + a[8]*b[7];
+		r[8] = a[2]*b[2] + a[5]*b[5] + a[8]*b[8];
+	}
+
+	static inline void nt(T* r, const T* a, const T* b)
+	{
+		r[0] = a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+		r[1] = a[0]*b[3] + a[1]*b[4] + a[2]*b[5];
+		r[2] = a[0]*b[6] + a[1]*b[7] + a[2]*b[8];
+		r[3] = a[3]*b[0] + a[4]*b[1] + a[5]*b[2];
+		r[4] = a[3]*b[3] + a[4]*b[4] + a[5]*b[5];
+		r[5] = a[3]*b[6] + a[4]*b[7] + a[5]*b[8];
+		r[6] = a[6]*b[0] + a[7]*b[1] + a[8]*b[2];
+		r[7] = a[6]*b[3] + a[7]*b[4] + a[8]*b[5];
+		r[8] = a[6]*b[6] + a[7]*b[7] + a[8]*b[8];
+	}
+};
+
+// 3x3 * 3x1
+template <typename T>
+struct fixed_product<T, 3, 3, 1>
+{
+	static inline void nn(T* r, const T* a, const T* b)
+	{
+		r[0] = a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+		r[1] = a[3]*b[0] + a[4]*b[1] + a[5]*b[2];
+		r[2] = a[6]*b[0] + a[7]*b[1] + a[8]*b[2];
+	}
+
+	static inline void tn(T* r, const T* a, const T* b)
+	{
+		r[0] = a[0]*b[0] + a[3]*b[1] + a[6]*b[2];
+		r[1] = a[1]*b[0] + a[4]*b[1] + a[7]*b[2];
+		r[2] = a[2]*b[0] + a[5]*b[1] + a[8]*b[2];
+	}
+
+	static inline void nt(T* r, const T* a, const T* b)
+	{
+		nn(r, a, b);
+	}
+};
+
+
+template <typename T, UINT32 R, UINT32 C>
+class matrix_fixed
+{
+public:
+	// Constructors
+	constexpr matrix_fixed() : _buffer() {}
+
+	// Loads a rows() x columns() block from any matrix providing
+	// get(row, column), such as matrix_2d or matrix_view
+	template <class M>
+	explicit matrix_fixed(const M& src, const UINT32& row_begin=0, const UINT32& col_begin=0)
+		: _buffer()
+	{
+		for (UINT32 i(0); i<R; ++i)
+			for (UINT32 j(0); j<C; ++j)
+				_buffer[i * C + j] = src.get(row_begin + i, col_begin + j);
+	}
+
+	static constexpr matrix_fixed identity()
+	{
+		static_assert(R == C, "identity() requires a square matrix");
+		matrix_fixed m;
+		for (UINT32 i(0); i<R; ++i)
+			m._buffer[i * C + i] = T(1);
+		return m;
+	}
+
+	///////////////////////////////////////////////////////////////////////
+	// Get
+	static constexpr UINT32 rows() { return R; }
+	static constexpr UINT32 columns() { return C; }
+	inline T* getbuffer() { return _buffer; }
+	inline const T* getbuffer() const { return _buffer; }
+
+	constexpr const T& get(const UINT32& row, const UINT32& column) const { return _buffer[row * C + column]; }
+	constexpr T& get(const UINT32& row, const UINT32& column) { return _buffer[row * C + column]; }
+	constexpr T* getelementref(const UINT32& row, const UINT32& column) { return &_buffer[row * C + column]; }
+	constexpr const T* getelementref(const UINT32& row, const UINT32& column) const { return &_buffer[row * C + column]; }
+
+	// Vector access
+	constexpr const T& operator[](const UINT32& i) const { return _buffer[i]; }
+	constexpr T& operator[](const UINT32& i) { return _buffer[i]; }
+
+	///////////////////////////////////////////////////////////////////////
+	// Set
+	constexpr void put(const UINT32& row, const UINT32& column, const T& value) { _buffer[row * C + column] = value; }
+	constexpr void elementadd(const UINT32& row, const UINT32& column, const T& increment) { _buffer[row * C + column] += increment; }
+	constexpr void elementsubtract(const UINT32& row, const UINT32& column, const T& decrement) { _buffer[row * C + column] -= decrement; }
+	constexpr void elementmultiply(const UINT32& row, const UINT32& column, const T& scale) { _buffer[row * C + column] *= scale; }
+
+	// Fixed-size matrices cannot be resized.  redim is provided so that
+	// templates written for matrix_2d may be used with this type.
+	void redim(const UINT32& rows, const UINT32& columns)
+	{
+		if (rows == R && columns == C)
+			return;
+		std::stringstream ss;
+		ss << "redim(): Cannot resize a " << R << "x" << C << " fixed-size matrix to " <<
+			rows << "x" << columns << ".";
+		throw boost::enable_current_exception(std::runtime_error(ss.str()));
+	}
+
+	// Copies all elements to a block of any matrix providing put(row, column, value)
+	template <class M>
+	void copyto(M& dest, const UINT32& row_begin=0, const UINT32& col_begin=0) const
+	{
+		for (UINT32 i(0); i<R; ++i)
+			for (UINT32 j(0); j<C; ++j)
+				dest.put(row_begin + i, col_begin + j, _buffer[i * C + j]);
+	}
+
+	///////////////////////////////////////////////////////////////////////
+	// Matrix functions
+	constexpr void zero()
+	{
+		for (UINT32 i(0); i<R*C; ++i)
+			_buffer[i] = T(0);
+	}
+
+	// copies upper triangle to lower triangle
+	constexpr void filllower()
+	{
+		for (UINT32 i(1); i<R; ++i)
+			for (UINT32 j(0); j<i; ++j)
+				_buffer[i * C + j] = _buffer[j * C + i];
+	}
+
+	// this = lhs * rhs
+	template <UINT32 K>
+	inline matrix_fixed& multiply(const matrix_fixed<T, R, K>& lhs, const matrix_fixed<T, K, C>& rhs)
+	{
+		fixed_product<T, R, K, C>::nn(_buffer, lhs.getbuffer(), rhs.getbuffer());
+		return *this;
+	}
+
+	// this = lhs^T * rhs
+	template <UINT32 K>
+	inline matrix_fixed& multiply_tn(const matrix_fixed<T, K, R>& lhs, const matrix_fixed<T, K, C>& rhs)
+	{
+		fixed_product<T, R, K, C>::tn(_buffer, lhs.getbuffer(), rhs.getbuffer());
+		return *this;
+	}
+
+	// this = lhs * rhs^T
+	template <UINT32 K>
+	inline matrix_fixed& multiply_nt(const matrix_fixed<T, R, K>& lhs, const matrix_fixed<T, C, K>& rhs)
+	{
+		fixed_product<T, R, K, C>::nt(_buffer, lhs.getbuffer(), rhs.getbuffer());
+		return *this;
+	}
+
+	constexpr matrix_fixed& transpose(const matrix_fixed<T, C, R>& src)
+	{
+		for (UINT32 i(0); i<R; ++i)
+			for (UINT32 j(0); j<C; ++j)
+				_buffer[i * C + j] = src.get(j, i);
+		return *this;
+	}
+
+	inline matrix_fixed& add(const matrix_fixed& rhs)
+	{
+#pragma omp simd
+		for (UINT32 i=0; i<R*C; ++i)
+			_buffer[i] += rhs._buffer[i];
+		return *this;
+	}
+
+	inline matrix_fixed& subtract(const matrix_fixed& rhs)
+	{
+#pragma omp simd
+		for (UINT32 i=0; i<R*C; ++i)
+			_buffer[i] -= rhs._buffer[i];
+		return *this;
+	}
+
+	inline matrix_fixed& scale(const T& scalar)
+	{
+#pragma omp simd
+		for (UINT32 i=0; i<R*C; ++i)
+			_buffer[i] *= scalar;
+		return *this;
+	}
+
+	friend std::ostream& operator<< (std::ostream& os, const matrix_fixed& rhs)
+	{
+		os << R << " " << C << std::endl;
+		for (UINT32 i(0); i<R; ++i)
+		{
+			for (UINT32 j(0); j<C; ++j)
+				os << std::setw(18) << std::setprecision(9) << std::scientific << std::right << rhs.get(i, j) << " ";
+			os << std::endl;
+		}
+		os << std::endl;
+		return os;
+	}
+
+#ifdef _MSDEBUG
+	void trace(const std::string& comment, const std::string& format) const
+	{
+		if (comment.empty())
+			TRACE("%d %d\n", R, C);
+		else
+			TRACE("%s (%d, %d):\n", comment.c_str(), R, C);
+		for (UINT32 i(0); i<R; ++i) {
+			for (UINT32 j(0); j<C; ++j)
+				TRACE(format.c_str(), get(i, j));
+			TRACE("\n");
+		} TRACE("\n");
+	}
+#endif
+
+private:
+	alignas(fixed_alignment<T, R * C>::value) T _buffer[R * C];
+};
+
+// Vector operations
+template <typename T>
+constexpr T dot(const matrix_fixed<T, 3, 1>& lhs, const matrix_fixed<T, 3, 1>& rhs)
+{
+	return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+}
+
+template <typename T>
+constexpr matrix_fixed<T, 3, 1> cross(const matrix_fixed<T, 3, 1>& lhs, const matrix_fixed<T, 3, 1>& rhs)
+{
+	matrix_fixed<T, 3, 1> v;
+	v[0] = lhs[1] * rhs[2] - lhs[2] * rhs[1];
+	v[1] = lhs[2] * rhs[0] - lhs[0] * rhs[2];
+	v[2] = lhs[0] * rhs[1] - lhs[1] * rhs[0];
+	return v;
+}
+
+typedef matrix_fixed<double, 3, 1> Vec3;		// coordinates, vectors
+typedef matrix_fixed<double, 3, 3> Mat3;		// rotations, station variances
+typedef matrix_fixed<double, 6, 6> Mat6;		// station pair variances
+
+}	// namespace math
+}	// namespace dynadjust
+
+#endif	// DNAMATRIX_FIXED_H_
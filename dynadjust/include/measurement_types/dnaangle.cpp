@@ -21,6 +21,7 @@
 //============================================================================
 
 #include <include/measurement_types/dnaangle.hpp>
+#include <include/io/dnaioimage.hpp>
 
 namespace dynadjust {
 namespace measurements {
@@ -280,17 +281,23 @@ void CDnaAngle::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrIndex) c
 	binary_stream->write(reinterpret_cast<char *>(&measRecord), sizeof(measurement_t));
 }
 
-void CDnaAngle::SetValue(const std::string& str)
+void CDnaAngle::SetValue(std::string_view str)
 {
 	// convert to radians
 	RadFromDmsString(&m_drValue, trimstr(str));
 }
 
-void CDnaAngle::SetStdDev(const std::string& str)
+void CDnaAngle::SetStdDev(std::string_view str)
 {
 	// convert seconds to radians
 	RadFromSecondsString(&m_dStdDev, trimstr(str));
 }
 
+void CDnaAngle::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_strTarget & m_strTarget2 & m_drValue & m_dStdDev;
+}
+
 }	// namespace measurements
 }	// namespace dynadjust
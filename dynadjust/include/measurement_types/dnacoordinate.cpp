@@ -21,6 +21,7 @@
 //============================================================================
 
 #include <include/measurement_types/dnacoordinate.hpp>
+#include <include/io/dnaioimage.hpp>
 
 namespace dynadjust {
 namespace measurements {
@@ -232,16 +233,21 @@ void CDnaCoordinate::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrInd
 }
 
 
-void CDnaCoordinate::SetValue(const std::string& str)
+void CDnaCoordinate::SetValue(std::string_view str)
 {
 	RadFromDmsString(&m_drValue, trimstr(str));
 }
 
-void CDnaCoordinate::SetStdDev(const std::string& str)
+void CDnaCoordinate::SetStdDev(std::string_view str)
 {
 	RadFromSecondsString(&m_dStdDev, trimstr(str));			// convert to radians
 }
 
+void CDnaCoordinate::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_drValue & m_dStdDev;
+}
 
 }	// namespace measurements
 }	// namespace dynadjust
@@ -62,8 +62,8 @@ public:
 	inline double GetValue() const { return m_drValue; }
 	inline double GetStdDev() const { return m_dStdDev; }
 
-	void SetValue(const std::string& str);
-	void SetStdDev(const std::string& str);
+	void SetValue(std::string_view str);
+	void SetStdDev(std::string_view str);
 
 	inline virtual UINT32 CalcBinaryRecordCount() const { return 1; }
 	virtual void WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrIndex) const;
@@ -71,6 +71,7 @@ public:
 	virtual void WriteDynaMLMsr(std::ofstream* dynaml_stream, const std::string& comment, bool) const;
 	virtual void WriteDNAMsr(std::ofstream* dna_stream, const dna_msr_fields& dmw, const dna_msr_fields& dml, bool) const;
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 protected:
 	double m_drValue;		// Lat, Long
@@ -22,6 +22,7 @@
 
 #include <include/exception/dnaexception.hpp>
 #include <include/measurement_types/dnadirection.hpp>
+#include <include/io/dnaioimage.hpp>
 
 using namespace dynadjust::exception;
 
@@ -658,12 +659,12 @@ void CDnaDirection::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrInde
 //	os << std::endl;
 //}
 
-void CDnaDirection::SetValue(const std::string& str)
+void CDnaDirection::SetValue(std::string_view str)
 {
 	RadFromDmsString(&m_drValue, trimstr(str));
 }
 
-void CDnaDirection::SetStdDev(const std::string& str)
+void CDnaDirection::SetStdDev(std::string_view str)
 {
 	// convert seconds to radians
 	RadFromSecondsString(&m_dStdDev, trimstr(str));
@@ -674,12 +675,12 @@ void CDnaDirection::SetStdDev(const std::string& str)
 // Note: vertical angles and zenith distances are derived
 // from CDnaDirection, so these methods are provided here,
 // but don't need instrument height for 'D' measurements.
-void CDnaDirection::SetInstrumentHeight(const std::string& str)
+void CDnaDirection::SetInstrumentHeight(std::string_view str)
 {
 	FloatFromString<float>(m_fInstHeight, trimstr(str));
 }
 
-void CDnaDirection::SetTargetHeight(const std::string& str)
+void CDnaDirection::SetTargetHeight(std::string_view str)
 {
 	FloatFromString<float>(m_fTargHeight, trimstr(str));
 }
@@ -767,5 +768,12 @@ bool CDnaAzimuth::operator== (const CDnaAzimuth& rhs) const
 		);
 }
 
+void CDnaDirection::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_strTarget & m_drValue & m_dStdDev & m_fInstHeight & m_fTargHeight
+		& m_lRecordedTotal & m_lsetID;
+}
+
 }	// namespace measurements
 }	// namespace dynadjust
@@ -60,7 +60,7 @@ public:
 
 	//inline CDnaDirection& operator[](int iIndex) { return this[iIndex]; }
 
-	inline std::string GetTarget() const { return m_strTarget; }
+	inline const std::string& GetTarget() const { return m_strTarget; }
 	inline double GetValue() const { return m_drValue; }
 	inline double GetStdDev() const { return m_dStdDev; }
 	inline float GetInstrHeight() const { return m_fInstHeight; }
@@ -68,11 +68,11 @@ public:
 
 	inline void SetRecordedTotal(const UINT32& l) { m_lRecordedTotal = l; }
 	inline void SetClusterID(const UINT32& id) { m_lsetID = id; }
-	inline void SetTarget(const std::string& str) { m_strTarget = trimstr(str); }
-	void SetValue(const std::string& str);
-	void SetStdDev(const std::string& str);
-	void SetInstrumentHeight(const std::string& str);
-	void SetTargetHeight(const std::string& str);
+	inline void SetTarget(std::string_view str) { m_strTarget = trimstr(str); }
+	void SetValue(std::string_view str);
+	void SetStdDev(std::string_view str);
+	void SetInstrumentHeight(std::string_view str);
+	void SetTargetHeight(std::string_view str);
 
 	inline virtual UINT32 CalcBinaryRecordCount() const { return 1; }
 	//void coutDirectionData(std::ostream &os) const;
@@ -81,10 +81,11 @@ public:
 	virtual void WriteDynaMLMsr(std::ofstream* dynaml_stream, const std::string& comment, bool bSubMeasurement = false) const;
 	virtual void WriteDNAMsr(std::ofstream* dna_stream, const dna_msr_fields& dmw, const dna_msr_fields& dml, bool bSubMeasurement = false) const;
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 	//virtual inline void SetDatabaseMap_bmsIndex(const UINT32& bmsIndex) { m_msr_db_map.bms_index = bmsIndex; }
 public:
-	std::string	m_strTarget;
+	station_name	m_strTarget;
 
 protected:
 	double	m_drValue;
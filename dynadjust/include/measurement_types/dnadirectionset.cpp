@@ -23,6 +23,7 @@
 #include <include/functions/dnatemplatefuncs.hpp>
 #include <include/measurement_types/dnadirection.hpp>
 #include <include/measurement_types/dnadirectionset.hpp>
+#include <include/io/dnaioimage.hpp>
 
 namespace dynadjust {
 namespace measurements {
@@ -453,24 +454,28 @@ void CDnaDirectionSet::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrI
 		_it_dir->WriteBinaryMsr(binary_stream, msrIndex);
 }
 
-void CDnaDirectionSet::SetValue(const std::string& str)
+void CDnaDirectionSet::SetValue(std::string_view str)
 {
 	RadFromDmsString(&m_drValue, trimstr(str));
 }
 
-void CDnaDirectionSet::SetStdDev(const std::string& str)
+void CDnaDirectionSet::SetStdDev(std::string_view str)
 {
 	RadFromSecondsString(&m_dStdDev, trimstr(str));
 }
 
-void CDnaDirectionSet::SetTotal(const std::string& str)
+void CDnaDirectionSet::SetTotal(std::string_view str)
 {
 	m_lRecordedTotal = LongFromString<UINT32>(trimstr(str));
 	m_vTargetDirections.reserve(m_lRecordedTotal);
 }
 
-
-
+void CDnaDirectionSet::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_strTarget & m_drValue & m_dStdDev & m_lRecordedTotal & m_lNonIgnoredDirns
+		& m_vTargetDirections & m_lsetID;
+}
 
 }	// namespace measurements
 }	// namespace dynadjust
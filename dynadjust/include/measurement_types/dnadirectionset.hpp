@@ -70,7 +70,7 @@ public:
 	void LoadDirectionSet(const char* const, const int&, const std::string&, const std::string&, bool, const int&);
 
 	inline UINT32 GetClusterID() const { return m_lsetID; }
-	inline std::string GetTarget() const { return m_strTarget; }
+	inline const std::string& GetTarget() const { return m_strTarget; }
 	inline UINT32 GetTotal() const { return m_lRecordedTotal; }
 	inline double GetValue() const { return m_drValue; }
 	inline double GetStdDev() const { return m_dStdDev; }
@@ -79,13 +79,13 @@ public:
 	inline std::vector<CDnaDirection>* GetDirections_ptr() { return &m_vTargetDirections; }
 
 	inline void SetClusterID(const UINT32& id) { m_lsetID = id; }
-	inline void SetTarget(const std::string& str) { m_strTarget = trimstr(str); }
+	inline void SetTarget(std::string_view str) { m_strTarget = trimstr(str); }
 	inline void SetTotal(const UINT32& l) { m_lRecordedTotal = l; }
 	inline void SetNonIgnoredDirns(const UINT32& n) { m_lNonIgnoredDirns = n; }
 
-	void SetTotal(const std::string& str);
-	void SetValue(const std::string& str);
-	void SetStdDev(const std::string& str);
+	void SetTotal(std::string_view str);
+	void SetValue(std::string_view str);
+	void SetStdDev(std::string_view str);
 	
 	void AddDirection(const CDnaMeasurement* pDirection);
 	void ClearDirections();
@@ -99,10 +99,11 @@ public:
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
 
 	virtual void SerialiseDatabaseMap(std::ofstream* os);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 	void SetDatabaseMaps(it_vdbid_t& dbidmap);
 
-	std::string m_strTarget;
+	station_name m_strTarget;
 
 protected:
 	double m_drValue;
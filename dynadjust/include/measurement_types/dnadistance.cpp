@@ -21,6 +21,7 @@
 //============================================================================
 
 #include <include/measurement_types/dnadistance.hpp>
+#include <include/io/dnaioimage.hpp>
 
 namespace dynadjust {
 namespace measurements {
@@ -316,12 +317,12 @@ void CDnaDistance::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrIndex
 }
 
 
-void CDnaDistance::SetValue(const std::string& str)
+void CDnaDistance::SetValue(std::string_view str)
 {
 	DoubleFromString(m_dValue, trimstr(str));
 }
 
-void CDnaDistance::SetStdDev(const std::string& str)
+void CDnaDistance::SetStdDev(std::string_view str)
 {
 	DoubleFromString(m_dStdDev, trimstr(str));
 }
@@ -331,16 +332,21 @@ void CDnaDistance::SetStdDev(const std::string& str)
 // Note: slope distances are derived from CDnaDistance, so
 // these methods are provided here, but don't need 
 // instrument height for 'C', 'E' and 'M'  measurements.
-void CDnaDistance::SetInstrumentHeight(const std::string& str)
+void CDnaDistance::SetInstrumentHeight(std::string_view str)
 {
 	FloatFromString(m_fInstHeight, trimstr(str));
 }
 
-void CDnaDistance::SetTargetHeight(const std::string& str)
+void CDnaDistance::SetTargetHeight(std::string_view str)
 {
 	DoubleFromString(m_fTargHeight, trimstr(str));
 }
 
+void CDnaDistance::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_strTarget & m_dValue & m_dStdDev & m_fInstHeight & m_fTargHeight;
+}
 
 }	// namespace measurements
 }	// namespace dynadjust
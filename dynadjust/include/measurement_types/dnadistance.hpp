@@ -53,18 +53,18 @@ public:
 
 	//inline CDnaDistance& operator[](int iIndex) { return this[iIndex]; }
 
-	inline std::string GetTarget() const { return m_strTarget; }
+	inline const std::string& GetTarget() const { return m_strTarget; }
 	inline double GetValue() const { return m_dValue; }
 	inline double GetStdDev() const { return m_dStdDev; }
 	inline float GetInstrHeight() const { return m_fInstHeight; }
 	inline float GetTargetHeight() const { return m_fTargHeight; }
 
 
-	inline void SetTarget(const std::string& str) { m_strTarget = trimstr(str); }
-	void SetValue(const std::string& str);
-	void SetStdDev(const std::string& str);
-	void SetInstrumentHeight(const std::string& str);
-	void SetTargetHeight(const std::string& str);
+	inline void SetTarget(std::string_view str) { m_strTarget = trimstr(str); }
+	void SetValue(std::string_view str);
+	void SetStdDev(std::string_view str);
+	void SetInstrumentHeight(std::string_view str);
+	void SetTargetHeight(std::string_view str);
 
 	inline virtual UINT32 CalcBinaryRecordCount() const { return 1; }
 	virtual void WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrIndex) const;
@@ -72,9 +72,10 @@ public:
 	virtual void WriteDynaMLMsr(std::ofstream* dynaml_stream, const std::string& comment, bool) const;
 	virtual void WriteDNAMsr(std::ofstream* dna_stream, const dna_msr_fields& dmw, const dna_msr_fields& dml, bool) const;
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 protected:
-	std::string m_strTarget;
+	station_name m_strTarget;
 	double m_dValue;
 	double	m_dStdDev;
 	float	m_fInstHeight;
@@ -23,6 +23,7 @@
 #include <include/exception/dnaexception.hpp>
 #include <include/parameters/dnaepsg.hpp>
 #include <include/measurement_types/dnagpsbaseline.hpp>
+#include <include/io/dnaioimage.hpp>
 
 using namespace dynadjust::exception;
 using namespace dynadjust::epsg;
@@ -504,22 +505,22 @@ void CDnaGpsBaseline::SerialiseDatabaseMap(std::ofstream* os)
 
 
 
-void CDnaGpsBaseline::SetX(const std::string& str)
+void CDnaGpsBaseline::SetX(std::string_view str)
 {
 	DoubleFromString(m_dX, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetY(const std::string& str)
+void CDnaGpsBaseline::SetY(std::string_view str)
 {
 	DoubleFromString(m_dY, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetZ(const std::string& str)
+void CDnaGpsBaseline::SetZ(std::string_view str)
 {
 	DoubleFromString(m_dZ, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetSigmaXX(const std::string& str)
+void CDnaGpsBaseline::SetSigmaXX(std::string_view str)
 {
 	if (DoubleFromString_ZeroCheck(m_dSigmaXX, trimstr(str)))
 	{
@@ -529,17 +530,17 @@ void CDnaGpsBaseline::SetSigmaXX(const std::string& str)
 	}
 }
 
-void CDnaGpsBaseline::SetSigmaXY(const std::string& str)
+void CDnaGpsBaseline::SetSigmaXY(std::string_view str)
 {
 	DoubleFromString(m_dSigmaXY, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetSigmaXZ(const std::string& str)
+void CDnaGpsBaseline::SetSigmaXZ(std::string_view str)
 {
 	DoubleFromString(m_dSigmaXZ, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetSigmaYY(const std::string& str)
+void CDnaGpsBaseline::SetSigmaYY(std::string_view str)
 {
 	if (DoubleFromString_ZeroCheck(m_dSigmaYY, trimstr(str)))
 	{
@@ -549,12 +550,12 @@ void CDnaGpsBaseline::SetSigmaYY(const std::string& str)
 	}
 }
 
-void CDnaGpsBaseline::SetSigmaYZ(const std::string& str)
+void CDnaGpsBaseline::SetSigmaYZ(std::string_view str)
 {
 	DoubleFromString(m_dSigmaYZ, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetSigmaZZ(const std::string& str)
+void CDnaGpsBaseline::SetSigmaZZ(std::string_view str)
 {
 	if (DoubleFromString_ZeroCheck(m_dSigmaZZ, trimstr(str)))
 	{
@@ -565,35 +566,35 @@ void CDnaGpsBaseline::SetSigmaZZ(const std::string& str)
 }
 	
 
-void CDnaGpsBaseline::SetEpsg(const std::string& epsg) 
+void CDnaGpsBaseline::SetEpsg(std::string_view epsg) 
 {
 	m_epsgCode = epsg;
 }
 
 
-void CDnaGpsBaseline::SetReferenceFrame(const std::string& refFrame) 
+void CDnaGpsBaseline::SetReferenceFrame(std::string_view refFrame) 
 {
 	m_referenceFrame = refFrame;
-	SetEpsg(epsgStringFromName<std::string>(refFrame));
+	SetEpsg(epsgStringFromName<std::string>(m_referenceFrame));
 }
 
 
-void CDnaGpsBaseline::SetPscale(const std::string& str)
+void CDnaGpsBaseline::SetPscale(std::string_view str)
 {
 	DoubleFromString(m_dPscale, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetLscale(const std::string& str)
+void CDnaGpsBaseline::SetLscale(std::string_view str)
 {
 	DoubleFromString(m_dLscale, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetHscale(const std::string& str)
+void CDnaGpsBaseline::SetHscale(std::string_view str)
 {
 	DoubleFromString(m_dHscale, trimstr(str));
 }
 
-void CDnaGpsBaseline::SetVscale(const std::string& str)
+void CDnaGpsBaseline::SetVscale(std::string_view str)
 {
 	DoubleFromString(m_dVscale, trimstr(str));
 }
@@ -924,49 +925,63 @@ void CDnaGpsBaselineCluster::WriteBinaryMsr(std::ofstream* binary_stream, PUINT3
 }
 
 
-void CDnaGpsBaselineCluster::SetEpsg(const std::string& epsg) 
+void CDnaGpsBaselineCluster::SetEpsg(std::string_view epsg) 
 {
 	// m_epsgCode is a member of CDnaMeasurement
 	m_epsgCode = epsg;
 }
 
 
-void CDnaGpsBaselineCluster::SetReferenceFrame(const std::string& refFrame) 
+void CDnaGpsBaselineCluster::SetReferenceFrame(std::string_view refFrame) 
 {
 	// m_referenceFrame is a member of CDnaGpsBaselineCluster
 	m_referenceFrame = refFrame;
-	SetEpsg(epsgStringFromName<std::string>(refFrame));
+	SetEpsg(epsgStringFromName<std::string>(m_referenceFrame));
 }
 
 
-void CDnaGpsBaselineCluster::SetTotal(const std::string& str)
+void CDnaGpsBaselineCluster::SetTotal(std::string_view str)
 {
 	m_lRecordedTotal = LongFromString<UINT32>(trimstr(str));
 	m_vGpsBaselines.reserve(m_lRecordedTotal);
 }
 
-void CDnaGpsBaselineCluster::SetPscale(const std::string& str)
+void CDnaGpsBaselineCluster::SetPscale(std::string_view str)
 {
 	DoubleFromString(m_dPscale, trimstr(str));
 }
 
-void CDnaGpsBaselineCluster::SetLscale(const std::string& str)
+void CDnaGpsBaselineCluster::SetLscale(std::string_view str)
 {
 	DoubleFromString(m_dLscale, trimstr(str));
 }
 
-void CDnaGpsBaselineCluster::SetHscale(const std::string& str)
+void CDnaGpsBaselineCluster::SetHscale(std::string_view str)
 {
 	DoubleFromString(m_dHscale, trimstr(str));
 }
 
-void CDnaGpsBaselineCluster::SetVscale(const std::string& str)
+void CDnaGpsBaselineCluster::SetVscale(std::string_view str)
 {
 	DoubleFromString(m_dVscale, trimstr(str));
 }
 
+void CDnaGpsBaseline::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_strTarget & m_lRecordedTotal & m_dX & m_dY & m_dZ
+		& m_dSigmaXX & m_dSigmaXY & m_dSigmaXZ & m_dSigmaYY & m_dSigmaYZ & m_dSigmaZZ
+		& m_dPscale & m_dLscale & m_dHscale & m_dVscale
+		& m_referenceFrame & m_lclusterID & m_vGpsCovariances;
+}
 
-
+void CDnaGpsBaselineCluster::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_strTarget & m_lRecordedTotal
+		& m_dPscale & m_dLscale & m_dHscale & m_dVscale
+		& m_vGpsBaselines & m_referenceFrame & m_lclusterID;
+}
 
 }	// namespace measurements
 }	// namespace dynadjust
@@ -60,7 +60,7 @@ public:
 	//inline CDnaGpsBaseline& operator[](int iIndex) { return this[iIndex]; }
 
 	inline UINT32 GetClusterID() const { return m_lclusterID; }
-	inline std::string GetTarget() const { return m_strTarget; }
+	inline const std::string& GetTarget() const { return m_strTarget; }
 	inline std::vector<CDnaCovariance>* GetCovariances_ptr() { return &m_vGpsCovariances; }
 
 	void AddGpsCovariance(const CDnaCovariance* pGpsCovariance);
@@ -69,27 +69,27 @@ public:
 	void ResizeGpsCovariancesCount(const UINT32& size = 0);
 
 	inline void SetClusterID(const UINT32& id) { m_lclusterID = id; }
-	inline void SetTarget(const std::string& str) { m_strTarget = trimstr(str); }
-	void SetX(const std::string& str);
-	void SetY(const std::string& str);
-	void SetZ(const std::string& str);
-	void SetSigmaXX(const std::string& str);
-	void SetSigmaXY(const std::string& str);
-	void SetSigmaXZ(const std::string& str);
-	void SetSigmaYY(const std::string& str);
-	void SetSigmaYZ(const std::string& str);
-	void SetSigmaZZ(const std::string& str);
+	inline void SetTarget(std::string_view str) { m_strTarget = trimstr(str); }
+	void SetX(std::string_view str);
+	void SetY(std::string_view str);
+	void SetZ(std::string_view str);
+	void SetSigmaXX(std::string_view str);
+	void SetSigmaXY(std::string_view str);
+	void SetSigmaXZ(std::string_view str);
+	void SetSigmaYY(std::string_view str);
+	void SetSigmaYZ(std::string_view str);
+	void SetSigmaZZ(std::string_view str);
 	
-	void SetReferenceFrame(const std::string& refFrame);
-	//void SetEpoch(const std::string& epoch); //moved to CDnaMeasurement
-	void SetEpsg(const std::string& epsg);	
+	void SetReferenceFrame(std::string_view refFrame);
+	//void SetEpoch(std::string_view epoch); //moved to CDnaMeasurement
+	void SetEpsg(std::string_view epsg);	
 	inline std::string GetReferenceFrame() const { return m_referenceFrame; }
 	//inline std::string GetEpoch() const { return m_epoch; } // moved to CDnaMeasurement
 		
-	void SetPscale(const std::string& str);
-	void SetLscale(const std::string& str);
-	void SetHscale(const std::string& str);
-	void SetVscale(const std::string& str);
+	void SetPscale(std::string_view str);
+	void SetLscale(std::string_view str);
+	void SetHscale(std::string_view str);
+	void SetVscale(std::string_view str);
 
 	inline void SetPscale(const double& dbl) { m_dPscale = dbl; }
 	inline void SetLscale(const double& dbl) { m_dLscale = dbl; }
@@ -108,8 +108,9 @@ public:
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
 
 	virtual void SerialiseDatabaseMap(std::ofstream* os);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
-	std::string m_strTarget;
+	station_name m_strTarget;
 
 	inline double GetVscale() const { return m_dVscale; }
 	inline double GetPscale() const { return m_dPscale; }
@@ -176,27 +177,28 @@ public:
 	inline std::vector<CDnaGpsBaseline>* GetBaselines_ptr() { return &m_vGpsBaselines; }
 
 	inline UINT32 GetClusterID() const { return m_lclusterID; }
-	inline std::string GetTarget() const { return m_strTarget; }
+	inline const std::string& GetTarget() const { return m_strTarget; }
 	inline UINT32 GetTotal() const { return m_lRecordedTotal; }
 	inline double GetPscale() const { return m_dPscale; }
 	inline double GetLscale() const { return m_dLscale; }
 	inline double GetHscale() const { return m_dHscale; }
 	inline double GetVscale() const { return m_dVscale; }
 
-	void SetReferenceFrame(const std::string& refFrame);
-	//void SetEpoch(const std::string& epoch);
-	void SetEpsg(const std::string& epsg);	
+	void SetReferenceFrame(std::string_view refFrame);
+	//void SetEpoch(std::string_view epoch);
+	void SetEpsg(std::string_view epsg);	
 	inline std::string GetReferenceFrame() const { return m_referenceFrame; }
 	//inline std::string GetEpoch() const { return m_epoch; } 
 		
-	inline void SetTarget(const std::string& str) { m_strTarget = trimstr(str); }
+	inline void SetClusterID(const UINT32& id) { m_lclusterID = id; }
+	inline void SetTarget(std::string_view str) { m_strTarget = trimstr(str); }
 	inline void SetTotal(const UINT32& l) { m_lRecordedTotal = l; }
 
-	void SetTotal(const std::string& str);
-	void SetPscale(const std::string& str);
-	void SetLscale(const std::string& str);
-	void SetHscale(const std::string& str);
-	void SetVscale(const std::string& str);
+	void SetTotal(std::string_view str);
+	void SetPscale(std::string_view str);
+	void SetLscale(std::string_view str);
+	void SetHscale(std::string_view str);
+	void SetVscale(std::string_view str);
 	
 	inline void SetPscale(const double& dbl) { m_dPscale = dbl; }
 	inline void SetLscale(const double& dbl) { m_dLscale = dbl; }
@@ -217,12 +219,13 @@ public:
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
 
 	virtual void SerialiseDatabaseMap(std::ofstream* os);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 	void SetDatabaseMaps(it_vdbid_t& dbidmap);
 
 protected:
 
-	std::string m_strTarget;
+	station_name m_strTarget;
 	UINT32 m_lRecordedTotal;
 	double m_dPscale;
 	double m_dLscale;
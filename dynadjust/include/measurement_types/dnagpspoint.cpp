@@ -23,6 +23,7 @@
 #include <include/exception/dnaexception.hpp>
 #include <include/parameters/dnaepsg.hpp>
 #include <include/measurement_types/dnagpspoint.hpp>
+#include <include/io/dnaioimage.hpp>
 
 using namespace dynadjust::exception;
 using namespace dynadjust::epsg;
@@ -198,7 +199,7 @@ void CDnaGpsPoint::ResizeGpsCovariancesCount(const UINT32& size)
 }
 
 
-void CDnaGpsPoint::SetCoordType(const std::string& sType) {
+void CDnaGpsPoint::SetCoordType(std::string_view sType) {
 	m_strCoordType = trimstr(sType);
 	m_ctType = GetMyCoordTypeC();
 }
@@ -615,20 +616,20 @@ void CDnaGpsPoint::SerialiseDatabaseMap(std::ofstream* os)
 }
 	
 
-void CDnaGpsPoint::SetEpsg(const std::string& epsg) 
+void CDnaGpsPoint::SetEpsg(std::string_view epsg) 
 {
 	m_epsgCode = epsg;
 }
 
 
-void CDnaGpsPoint::SetReferenceFrame(const std::string& refFrame) 
+void CDnaGpsPoint::SetReferenceFrame(std::string_view refFrame) 
 {
 	m_referenceFrame = refFrame;
-	SetEpsg(epsgStringFromName<std::string>(refFrame));
+	SetEpsg(epsgStringFromName<std::string>(m_referenceFrame));
 }
 	
 
-void CDnaGpsPoint::SetX(const std::string& str)
+void CDnaGpsPoint::SetX(std::string_view str)
 {
 	if (m_ctType == LLH_type_i || m_ctType == LLh_type_i)
 	{
@@ -640,7 +641,7 @@ void CDnaGpsPoint::SetX(const std::string& str)
 		DoubleFromString(m_dX, trimstr(str));
 }
 
-void CDnaGpsPoint::SetY(const std::string& str)
+void CDnaGpsPoint::SetY(std::string_view str)
 {
 	if (m_ctType == LLH_type_i || m_ctType == LLh_type_i)
 	{
@@ -652,14 +653,14 @@ void CDnaGpsPoint::SetY(const std::string& str)
 		DoubleFromString(m_dY, trimstr(str));
 }
 	
-void CDnaGpsPoint::SetZ(const std::string& str)
+void CDnaGpsPoint::SetZ(std::string_view str)
 {
 	// if (m_ctType == LLH_type_i)
 	// then height should be ellipsoid height (but input files show height to be orthometric!)
 	DoubleFromString(m_dZ, trimstr(str));
 }
 	
-void CDnaGpsPoint::SetSigmaXX(const std::string& str)
+void CDnaGpsPoint::SetSigmaXX(std::string_view str)
 {
 	// if <Coords>LLH</Coords>, then SigmaXX is in radians^2
 	// if <Coords>XYZ</Coords>, then SigmaXX is in metres^2
@@ -667,17 +668,17 @@ void CDnaGpsPoint::SetSigmaXX(const std::string& str)
 		throw XMLInteropException("SetSigmaXX(): Variances cannot be zero.", 0);
 }
 
-void CDnaGpsPoint::SetSigmaXY(const std::string& str)
+void CDnaGpsPoint::SetSigmaXY(std::string_view str)
 {
 	DoubleFromString(m_dSigmaXY, trimstr(str));
 }
 
-void CDnaGpsPoint::SetSigmaXZ(const std::string& str)
+void CDnaGpsPoint::SetSigmaXZ(std::string_view str)
 {
 	DoubleFromString(m_dSigmaXZ, trimstr(str));
 }
 
-void CDnaGpsPoint::SetSigmaYY(const std::string& str)
+void CDnaGpsPoint::SetSigmaYY(std::string_view str)
 {
 	// if <Coords>LLH</Coords>, then SigmaYY is in radians^2
 	// if <Coords>XYZ</Coords>, then SigmaYY is in metres^2
@@ -685,12 +686,12 @@ void CDnaGpsPoint::SetSigmaYY(const std::string& str)
 		throw XMLInteropException("SetSigmaYY(): Variances cannot be zero.", 0);
 }
 
-void CDnaGpsPoint::SetSigmaYZ(const std::string& str)
+void CDnaGpsPoint::SetSigmaYZ(std::string_view str)
 {
 	DoubleFromString(m_dSigmaYZ, trimstr(str));
 }
 
-void CDnaGpsPoint::SetSigmaZZ(const std::string& str)
+void CDnaGpsPoint::SetSigmaZZ(std::string_view str)
 {
 	// if <Coords>LLH</Coords>, then SigmaZZ is in radians^2
 	// if <Coords>XYZ</Coords>, then SigmaZZ is in metres^2
@@ -851,7 +852,7 @@ bool CDnaGpsPointCluster::operator< (const CDnaGpsPointCluster& rhs) const
 		return m_strFirst < rhs.m_strFirst;
 }
 
-void CDnaGpsPointCluster::SetCoordType(const std::string& sType) {
+void CDnaGpsPointCluster::SetCoordType(std::string_view sType) {
 	m_strCoordType = trimstr(sType);
 	m_ctType = GetMyCoordTypeC();
 }
@@ -1054,46 +1055,62 @@ void CDnaGpsPointCluster::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 m
 }
 	
 
-void CDnaGpsPointCluster::SetEpsg(const std::string& epsg) 
+void CDnaGpsPointCluster::SetEpsg(std::string_view epsg) 
 {
 	m_epsgCode = epsg;
 }
 
 
-void CDnaGpsPointCluster::SetReferenceFrame(const std::string& refFrame) 
+void CDnaGpsPointCluster::SetReferenceFrame(std::string_view refFrame) 
 {
 	m_referenceFrame = refFrame;
-	SetEpsg(epsgStringFromName<std::string>(refFrame));
+	SetEpsg(epsgStringFromName<std::string>(m_referenceFrame));
 }
 
 
-void CDnaGpsPointCluster::SetTotal(const std::string& str)
+void CDnaGpsPointCluster::SetTotal(std::string_view str)
 {
 	m_lRecordedTotal = LongFromString<UINT32>(trimstr(str));
 	m_vGpsPoints.reserve(m_lRecordedTotal);
 }
 
 
-void CDnaGpsPointCluster::SetPscale(const std::string& str)
+void CDnaGpsPointCluster::SetPscale(std::string_view str)
 {
 	DoubleFromString(m_dPscale, trimstr(str));
 }
 
-void CDnaGpsPointCluster::SetLscale(const std::string& str)
+void CDnaGpsPointCluster::SetLscale(std::string_view str)
 {
 	DoubleFromString(m_dLscale, trimstr(str));
 }
 
-void CDnaGpsPointCluster::SetHscale(const std::string& str)
+void CDnaGpsPointCluster::SetHscale(std::string_view str)
 {
 	DoubleFromString(m_dHscale, trimstr(str));
 }
 
-void CDnaGpsPointCluster::SetVscale(const std::string& str)
+void CDnaGpsPointCluster::SetVscale(std::string_view str)
 {
 	DoubleFromString(m_dVscale, trimstr(str));
 }
 
+void CDnaGpsPoint::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_lRecordedTotal & m_dX & m_dY & m_dZ
+		& m_dSigmaXX & m_dSigmaXY & m_dSigmaXZ & m_dSigmaYY & m_dSigmaYZ & m_dSigmaZZ
+		& m_dPscale & m_dLscale & m_dHscale & m_dVscale & m_strCoordType & m_ctType
+		& m_referenceFrame & m_lclusterID & m_vPointCovariances;
+}
+
+void CDnaGpsPointCluster::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_lRecordedTotal
+		& m_dPscale & m_dLscale & m_dHscale & m_dVscale & m_strCoordType & m_ctType
+		& m_vGpsPoints & m_referenceFrame & m_lclusterID;
+}
 
 }	// namespace measurements
 }	// namespace dynadjust
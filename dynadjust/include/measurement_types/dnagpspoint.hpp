@@ -67,26 +67,26 @@ public:
 	inline std::vector<CDnaCovariance>* GetCovariances_ptr() { return &m_vPointCovariances; }
 
 	inline void SetClusterID(const UINT32& id) { m_lclusterID = id; }
-	void SetX(const std::string& str);
-	void SetY(const std::string& str);
-	void SetZ(const std::string& str);
-	void SetSigmaXX(const std::string& str);
-	void SetSigmaXY(const std::string& str);
-	void SetSigmaXZ(const std::string& str);
-	void SetSigmaYY(const std::string& str);
-	void SetSigmaYZ(const std::string& str);
-	void SetSigmaZZ(const std::string& str);
+	void SetX(std::string_view str);
+	void SetY(std::string_view str);
+	void SetZ(std::string_view str);
+	void SetSigmaXX(std::string_view str);
+	void SetSigmaXY(std::string_view str);
+	void SetSigmaXZ(std::string_view str);
+	void SetSigmaYY(std::string_view str);
+	void SetSigmaYZ(std::string_view str);
+	void SetSigmaZZ(std::string_view str);
 	
-	void SetReferenceFrame(const std::string& refFrame);
-	//void SetEpoch(const std::string& epoch);
-	void SetEpsg(const std::string& epsg);	
+	void SetReferenceFrame(std::string_view refFrame);
+	//void SetEpoch(std::string_view epoch);
+	void SetEpsg(std::string_view epsg);	
 	inline std::string GetReferenceFrame() const { return m_referenceFrame; }
 	//inline std::string GetEpoch() const { return m_epoch; }
 		
-	//void SetPscale(const std::string& str);
-	//void SetLscale(const std::string& str);
-	//void SetHscale(const std::string& str);
-	//void SetVscale(const std::string& str);
+	//void SetPscale(std::string_view str);
+	//void SetLscale(std::string_view str);
+	//void SetHscale(std::string_view str);
+	//void SetVscale(std::string_view str);
 
 	inline void SetTotal(const UINT32& l) { m_lRecordedTotal = l; }
 
@@ -105,7 +105,7 @@ public:
 	inline void SetLscale(const double& dbl) { m_dLscale = dbl; }
 	inline void SetHscale(const double& dbl) { m_dHscale = dbl; }
 	inline void SetVscale(const double& dbl) { m_dVscale = dbl; }
-	void SetCoordType(const std::string& str);
+	void SetCoordType(std::string_view str);
 
 	inline void SetRecordedTotal(const UINT32& total) { m_lRecordedTotal = total; }
 
@@ -125,6 +125,7 @@ public:
 		const UINT32& stn, const CDnaDatum* datum, math::matrix_2d* estimates, math::matrix_2d* variances);
 
 	virtual void SerialiseDatabaseMap(std::ofstream* os);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 	inline double GetVscale() const { return m_dVscale; }
 	inline double GetPscale() const { return m_dPscale; }
@@ -203,22 +204,23 @@ public:
 	inline double GetHscale() const { return m_dHscale; }
 	inline double GetVscale() const { return m_dVscale; }
 
-	void SetCoordType(const std::string& str);
+	inline void SetClusterID(const UINT32& id) { m_lclusterID = id; }
+	void SetCoordType(std::string_view str);
 
 	_COORD_TYPE_ GetMyCoordTypeC();
 
-	void SetReferenceFrame(const std::string& refFrame);
-	//void SetEpoch(const std::string& epoch);
-	void SetEpsg(const std::string& epsg);	
+	void SetReferenceFrame(std::string_view refFrame);
+	//void SetEpoch(std::string_view epoch);
+	void SetEpsg(std::string_view epsg);	
 	inline std::string GetReferenceFrame() const { return m_referenceFrame; }
 	//inline std::string GetEpoch() const { return m_epoch; }
 	
 	//inline void SetPoints(const std::vector<CDnaGpsPoint>& d) { m_vGpsPoints = d; }
-	void SetTotal(const std::string& str);
-	void SetPscale(const std::string& str);
-	void SetLscale(const std::string& str);
-	void SetHscale(const std::string& str);
-	void SetVscale(const std::string& str);
+	void SetTotal(std::string_view str);
+	void SetPscale(std::string_view str);
+	void SetLscale(std::string_view str);
+	void SetHscale(std::string_view str);
+	void SetVscale(std::string_view str);
 
 	inline void SetTotal(const UINT32& u) { m_lRecordedTotal = u; }
 
@@ -240,6 +242,7 @@ public:
 		const UINT32& block, const CDnaDatum* datum, math::matrix_2d* estimates, math::matrix_2d* variances);
 
 	virtual void SerialiseDatabaseMap(std::ofstream* os);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 	
 	void SetDatabaseMaps(it_vdbid_t& dbidmap);
 
@@ -21,6 +21,7 @@
 //============================================================================
 
 #include <include/measurement_types/dnaheight.hpp>
+#include <include/io/dnaioimage.hpp>
 
 namespace dynadjust {
 namespace measurements {
@@ -216,16 +217,21 @@ void CDnaHeight::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrIndex)
 }
 
 
-void CDnaHeight::SetValue(const std::string& str)
+void CDnaHeight::SetValue(std::string_view str)
 {
 	DoubleFromString(m_dValue, trimstr(str));
 }
 
-void CDnaHeight::SetStdDev(const std::string& str)
+void CDnaHeight::SetStdDev(std::string_view str)
 {
 	DoubleFromString(m_dStdDev, trimstr(str));
 }
 
+void CDnaHeight::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaMeasurement::SerialiseImage(ar);
+	ar & m_dValue & m_dStdDev;
+}
 
 }	// namespace measurements
 }	// namespace dynadjust
@@ -56,8 +56,8 @@ public:
 	inline double GetValue() const { return m_dValue; }
 	inline double GetStdDev() const { return m_dStdDev; }
 
-	void SetValue(const std::string& str);
-	void SetStdDev(const std::string& str);
+	void SetValue(std::string_view str);
+	void SetStdDev(std::string_view str);
 
 
 	inline virtual UINT32 CalcBinaryRecordCount() const { return 1; }
@@ -66,6 +66,7 @@ public:
 	virtual void WriteDynaMLMsr(std::ofstream* dynaml_stream, const std::string& comment, bool) const;
 	virtual void WriteDNAMsr(std::ofstream* dna_stream, const dna_msr_fields& dmw, const dna_msr_fields& dml, bool) const;
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 protected:
 	double m_dValue;
@@ -21,6 +21,7 @@
 //============================================================================
 
 #include <include/measurement_types/dnaheightdifference.hpp>
+#include <include/io/dnaioimage.hpp>
 
 //extern boost::random::mt19937 rng;
 //extern boost::random::uniform_real_distribution<double> stdev;
@@ -251,15 +252,21 @@ void CDnaHeightDifference::WriteBinaryMsr(std::ofstream* binary_stream, PUINT32
 }
 
 
-void CDnaHeightDifference::SetValue(const std::string& str)
+void CDnaHeightDifference::SetValue(std::string_view str)
 {
 	DoubleFromString(m_dValue, trimstr(str));
 }
 
-void CDnaHeightDifference::SetStdDev(const std::string& str)
+void CDnaHeightDifference::SetStdDev(std::string_view str)
 {
 	DoubleFromString(m_dStdDev, trimstr(str));
 }
 
+void CDnaHeightDifference::SerialiseImage(iostreams::image_archive& ar)
+{
+	CDnaHeight::SerialiseImage(ar);
+	ar & m_strTarget & m_dValue & m_dStdDev;
+}
+
 }	// namespace measurements
 }	// namespace dynadjust
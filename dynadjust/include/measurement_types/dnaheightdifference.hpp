@@ -54,14 +54,14 @@ public:
 
 	//inline CDnaHeightDifference& operator[](int iIndex) { return this[iIndex]; }
 
-	inline std::string GetTarget() const { return m_strTarget; }
+	inline const std::string& GetTarget() const { return m_strTarget; }
 	inline double GetValue() const { return m_dValue; }
 	inline double GetStdDev() const { return m_dStdDev; }
 	
-	inline void SetTarget(const std::string& str) { m_strTarget = trimstr(str); }
+	inline void SetTarget(std::string_view str) { m_strTarget = trimstr(str); }
 
-	void SetValue(const std::string& str);
-	void SetStdDev(const std::string& str);
+	void SetValue(std::string_view str);
+	void SetStdDev(std::string_view str);
 	
 	inline virtual UINT32 CalcBinaryRecordCount() const { return 1; }
 	virtual void WriteBinaryMsr(std::ofstream* binary_stream, PUINT32 msrIndex) const;
@@ -69,9 +69,10 @@ public:
 	virtual void WriteDynaMLMsr(std::ofstream* dynaml_stream, const std::string& comment, bool) const;
 	virtual void WriteDNAMsr(std::ofstream* dna_stream, const dna_msr_fields& dmw, const dna_msr_fields& dml, bool) const;
 	virtual void SimulateMsr(vdnaStnPtr* vStations, const CDnaEllipsoid* ellipsoid);
+	virtual void SerialiseImage(iostreams::image_archive& ar);
 
 public:
-	std::string 	m_strTarget;
+	station_name 	m_strTarget;
 	double 	m_dValue;
 	double 	m_dStdDev;
 };
@@ -22,6 +22,15 @@
 
 #include <include/exception/dnaexception.hpp>
 #include <include/measurement_types/dnameasurement.hpp>
+#include <include/io/dnaioimage.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 using namespace dynadjust::exception;
 using namespace dynadjust::math;
@@ -29,6 +38,91 @@ using namespace dynadjust::math;
 namespace dynadjust {
 namespace measurements {
 
+namespace {
+
+// The station names interned by this library.  The names are held in a
+// deque, which does not move its elements, so the pooled names (and the
+// views of them used as keys) remain valid until the pool is cleared.
+struct station_name_pool
+{
+	typedef std::unordered_map<std::string_view, const std::string*> station_name_map;
+
+	std::deque<std::string> names;
+	station_name_map names_map;
+	std::shared_mutex names_mutex;
+	// Incremented each time the pool is cleared, so that each thread 
+	// knows to discard the names in its cache
+	std::atomic<UINT32> generation{0};
+};
+
+station_name_pool& name_pool()
+{
+	static station_name_pool pool;
+	return pool;
+}
+
+}
+
+const std::string& station_name::intern(std::string_view name)
+{
+	if (name.empty())
+		return empty_name();
+
+	station_name_pool& pool(name_pool());
+
+	// Each thread keeps the names it last interned in a small cache, so 
+	// that names which recur (as they do from one record to the next) 
+	// are found without locking the pool
+	const std::size_t cache_size(1024);
+	static thread_local const std::string* cached_names[cache_size] = {};
+	static thread_local UINT32 cached_generation(0);
+
+	const UINT32 generation(pool.generation.load(std::memory_order_acquire));
+	if (cached_generation != generation)
+	{
+		std::fill(cached_names, cached_names + cache_size, nullptr);
+		cached_generation = generation;
+	}
+	
+	const std::size_t hash(std::hash<std::string_view>()(name));
+	const std::string*& cached(cached_names[hash & (cache_size - 1)]);
+	if (cached != 0 && *cached == name)
+		return *cached;
+
+	{
+		std::shared_lock<std::shared_mutex> lock(pool.names_mutex);
+		station_name_pool::station_name_map::const_iterator _it_name(pool.names_map.find(name));
+		if (_it_name != pool.names_map.end())
+			return *(cached = _it_name->second);
+	}
+
+	std::unique_lock<std::shared_mutex> lock(pool.names_mutex);
+	station_name_pool::station_name_map::const_iterator _it_name(pool.names_map.find(name));
+	if (_it_name == pool.names_map.end())
+	{
+		pool.names.push_back(std::string(name));
+		_it_name = pool.names_map.insert(station_name_pool::station_name_map::value_type(pool.names.back(), &pool.names.back())).first;
+	}
+	return *(cached = _it_name->second);
+}
+
+void station_name::clear_pool()
+{
+	station_name_pool& pool(name_pool());
+
+	std::unique_lock<std::shared_mutex> lock(pool.names_mutex);
+	pool.names_map.clear();
+	std::deque<std::string>().swap(pool.names);
+	pool.generation.fetch_add(1, std::memory_order_release);
+}
+
+const std::string& station_name::empty_name()
+{
+	static const std::string empty;
+	return empty;
+}
+
+
 CDnaCovariance::CDnaCovariance(void)
 	: m_bIgnore(false)
 	, m_lstn1Index(0)
@@ -283,47 +377,47 @@ void CDnaCovariance::SerialiseDatabaseMap(std::ofstream* os, const msr_database_
 	os->write(reinterpret_cast<const char *>(&cls), sizeof(UINT16));
 }
 
-void CDnaCovariance::SetM11(const std::string& str)
+void CDnaCovariance::SetM11(std::string_view str)
 {
 	DoubleFromString(m_dM11, trimstr(str));
 }
 
-void CDnaCovariance::SetM12(const std::string& str)
+void CDnaCovariance::SetM12(std::string_view str)
 {
 	DoubleFromString(m_dM12, trimstr(str));
 }
 
-void CDnaCovariance::SetM13(const std::string& str)
+void CDnaCovariance::SetM13(std::string_view str)
 {
 	DoubleFromString(m_dM13, trimstr(str));
 }
 
-void CDnaCovariance::SetM21(const std::string& str)
+void CDnaCovariance::SetM21(std::string_view str)
 {
 	DoubleFromString(m_dM21, trimstr(str));
 }
 
-void CDnaCovariance::SetM22(const std::string& str)
+void CDnaCovariance::SetM22(std::string_view str)
 {
 	DoubleFromString(m_dM22, trimstr(str));
 }
 
-void CDnaCovariance::SetM23(const std::string& str)
+void CDnaCovariance::SetM23(std::string_view str)
 {
 	DoubleFromString(m_dM23, trimstr(str));
 }
 
-void CDnaCovariance::SetM31(const std::string& str)
+void CDnaCovariance::SetM31(std::string_view str)
 {
 	DoubleFromString(m_dM31, trimstr(str));
 }
 
-void CDnaCovariance::SetM32(const std::string& str)
+void CDnaCovariance::SetM32(std::string_view str)
 {
 	DoubleFromString(m_dM32, trimstr(str));
 }
 
-void CDnaCovariance::SetM33(const std::string& str)
+void CDnaCovariance::SetM33(std::string_view str)
 {
 	DoubleFromString(m_dM33, trimstr(str));
 }
@@ -432,7 +526,7 @@ void CDnaMeasurement::coutMeasurement(std::ostream& os) const
 	os << std::setw(2) << std::left << "+ " << std::setw(2) << m_strType;
 }
 
-void CDnaMeasurement::SetMeasurementDBID(const std::string& str)
+void CDnaMeasurement::SetMeasurementDBID(std::string_view str)
 {
 	if (str.empty())
 	{
@@ -446,7 +540,7 @@ void CDnaMeasurement::SetMeasurementDBID(const std::string& str)
 	}
 }
 
-void CDnaMeasurement::SetClusterDBID(const std::string& str)
+void CDnaMeasurement::SetClusterDBID(std::string_view str)
 {
 	if (str.empty())
 	{
@@ -466,7 +560,7 @@ void CDnaMeasurement::SetClusterDBID(const UINT32& u, bool s)
 	m_msr_db_map.is_cls_id_set = s;
 }
 
-void CDnaMeasurement::SetType(const std::string& str)
+void CDnaMeasurement::SetType(std::string_view str)
 { 
 	m_strType = trimstr(str);
 	str_toupper<int>(m_strType);
@@ -495,11 +589,26 @@ void CDnaMeasurement::SerialiseDatabaseMap(std::ofstream* os)
 	os->write(reinterpret_cast<const char*>(&val), sizeof(UINT16));
 }
 
-void CDnaMeasurement::SetEpoch(const std::string& epoch)
+void CDnaMeasurement::SetEpoch(std::string_view epoch)
 {
 	m_epoch = epoch;
 }
 
+void CDnaCovariance::SerialiseImage(iostreams::image_archive& ar)
+{
+	ar & m_bIgnore & m_lstn1Index & m_lstn2Index & m_strType
+		& m_dM11 & m_dM12 & m_dM13 & m_dM21 & m_dM22 & m_dM23 & m_dM31 & m_dM32 & m_dM33
+		& m_lclusterID;
+}
+
+void CDnaMeasurement::SerialiseImage(iostreams::image_archive& ar)
+{
+	ar & m_strFirst & m_MSmeasurementStations & m_strType & m_bIgnore
+		& m_lmeasurementIndex & m_lstn1Index & m_lstn2Index & m_lstn3Index
+		& m_measAdj & m_measCorr & m_measAdjPrec & m_residualPrec & m_preAdjCorr
+		& m_epsgCode & m_sourceFile & m_epoch & m_msr_db_map & m_bInsufficient;
+}
+
 }	// namespace measurements
 }	// namespace dynadjust
 
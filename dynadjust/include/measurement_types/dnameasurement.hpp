@@ -17,7 +17,7 @@
 //                See the License for the specific language governing permissions and
 //                limitations under the License.
 //
-// Description  : Interface for the msr_t struct and CDnaMeasurement, 
+// Description  : Interface for the msr_t struct and station_name, CDnaMeasurement,
 //                CDnaCovariance and MsrTally classes
 //============================================================================
 
@@ -38,6 +38,7 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <include/functions/dnastrmanipfuncs.hpp>
 #include <include/config/dnatypes.hpp>
@@ -111,6 +112,54 @@ S measurement_name(const C& type)
 }
 
 
+// Name of a station held by a measurement.  Names are interned in a pool,
+// so that a name is held once however many measurements refer to it,
+// copying a name copies a pointer, and two names are equal only if they
+// are the same entry of the pool.
+class station_name
+{
+public:
+	station_name() : name_(&empty_name()) {}
+	station_name(std::string_view name) : name_(&intern(name)) {}
+
+	inline station_name& operator=(std::string_view name) {
+		name_ = &intern(name);
+		return *this;
+	}
+
+	inline const std::string& str() const { return *name_; }
+	inline operator const std::string&() const { return *name_; }
+
+	inline bool operator==(const station_name& rhs) const { return name_ == rhs.name_; }
+	inline bool operator!=(const station_name& rhs) const { return name_ != rhs.name_; }
+	inline bool operator<(const station_name& rhs) const {
+		return name_ != rhs.name_ && *name_ < *rhs.name_;
+	}
+
+	// Returns the pooled copy of name.
+	// The pool is a static of dnameasurement.cpp, so each DynAdjust library
+	// that compiles it (import, reftran and adjust) has a pool of its own.
+	// A name is only compared with names created by the same library, as
+	// each library creates and releases its own measurements.  Ordering
+	// compares the strings, so sorting by name does not depend on the pool.
+	static const std::string& intern(std::string_view name);
+	static const std::string& empty_name();
+
+	// Removes all names from the pool of the calling library.  The names
+	// created by that library become invalid, so the pool may only be
+	// cleared once the measurements holding them have been destroyed, and
+	// while no other thread is creating names.
+	static void clear_pool();
+
+private:
+	const std::string* name_;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const station_name& name)
+{
+	return os << name.str();
+}
+
 // forward declarations
 class CDnaGpsBaseline;
 class CDnaGpsPoint;
@@ -130,18 +179,14 @@ typedef boost::shared_ptr< std::vector<CDnaCovariance> > vecCovariancePtr;
 // data struct for storing measurement information to binary measurement file
 typedef struct msr_t {
 	msr_t()
-		: measType('\0'), measStart(0), measurementStations(1), ignore(false), station1(0), station2(0)
-		, station3(0), vectorCount1(0), vectorCount2(0), clusterID(0), fileOrder(0)
-		, term1(0.), term2(0.), term3(0.), term4(0.), scale1(1.), scale2(1.), scale3(1.), scale4(1.)
-		, measAdj(0.), measCorr(0.), measAdjPrec(0.), residualPrec(0.)
-		, NStat(0.), TStat(0.), PelzerRel(0.)
-		, preAdjCorr(0.), preAdjMeas(0.) 
 	{
-			memset(coordType, '\0', sizeof(coordType));
+			// Zero all members, and the padding between them, so that the 
+			// records written to a binary measurement file are reproducible
+			memset(this, '\0', sizeof(msr_t));
+			measurementStations = 1;
+			scale1 = scale2 = scale3 = scale4 = 1.;
 			// GDA94, lat, long, height
-			memset(epsgCode, '\0', sizeof(epsgCode));
 			sprintf(epsgCode, DEFAULT_EPSG_S);
-			memset(epoch, '\0', sizeof(epoch));
 	}
 
 	char	measType;				// 'A', 'S', 'X', ... , etc.
@@ -229,7 +274,7 @@ public:
 
 	//inline CDnaCovariance& operator[](int iIndex) { return this[iIndex]; }
 
-	inline void SetType(const std::string& str) { m_strType = trimstr(str); }
+	inline void SetType(std::string_view str) { m_strType = trimstr(str); }
 	inline char GetTypeC() const { return (m_strType.c_str())[0]; }
 
 	// m_bIgnore used only to 'split' cluster measurements
@@ -245,19 +290,20 @@ public:
 	virtual void SimulateMsr(vdnaStnPtr*, const CDnaEllipsoid*);
 	
 	void SerialiseDatabaseMap(std::ofstream* os, const msr_database_id_map& dbid);
+	void SerialiseImage(iostreams::image_archive& ar);
 
 	inline void SetClusterID(const UINT32& id) { m_lclusterID = id; }
 	inline void SetStn1Index(const UINT32& stn) { m_lstn1Index = stn; }
 	inline void SetStn2Index(const UINT32& stn) { m_lstn2Index = stn; }
-	void SetM11(const std::string& str);
-	void SetM12(const std::string& str);
-	void SetM13(const std::string& str);
-	void SetM21(const std::string& str);
-	void SetM22(const std::string& str);
-	void SetM23(const std::string& str);
-	void SetM31(const std::string& str);
-	void SetM32(const std::string& str);
-	void SetM33(const std::string& str);
+	void SetM11(std::string_view str);
+	void SetM12(std::string_view str);
+	void SetM13(std::string_view str);
+	void SetM21(std::string_view str);
+	void SetM22(std::string_view str);
+	void SetM23(std::string_view str);
+	void SetM31(std::string_view str);
+	void SetM32(std::string_view str);
+	void SetM33(std::string_view str);
 
 	inline void SetM11(const double& dbl) { m_dM11 = dbl; }
 	inline void SetM12(const double& dbl) { m_dM12 = dbl; }
@@ -324,7 +370,7 @@ public:
 	inline char GetTypeC() const { return (m_strType.c_str())[0]; }
 	inline bool GetIgnore() const { return m_bIgnore; }
 	inline bool NotIgnored() const { return m_bIgnore == false; }
-	inline std::string GetFirst() const { return m_strFirst; }
+	inline const std::string& GetFirst() const { return m_strFirst; }
 	inline MEASUREMENT_STATIONS GetMsrStnCount() const { return m_MSmeasurementStations; }
 
 	inline std::string GetEpsg() const { return m_epsgCode; }
@@ -332,12 +378,13 @@ public:
 
 	inline bool GetInsufficient() const { return m_bInsufficient; }
 
-	void SetType(const std::string& str);
+	void SetType(std::string_view str);
 	inline void SetIgnore(const bool bval) { m_bIgnore = bval; }
-	inline void SetFirst(const std::string& str) { m_strFirst = trimstr(str); }
+	inline void SetFirst(std::string_view str) { m_strFirst = trimstr(str); }
+	inline void SetFirst(const station_name& name) { m_strFirst = name; }
 	
-	inline void SetEpsg(const std::string& e) { m_epsgCode = trimstr(e); }
-	inline void SetSource(const std::string& source) { m_sourceFile = source; }
+	inline void SetEpsg(std::string_view e) { m_epsgCode = trimstr(e); }
+	inline void SetSource(std::string_view source) { m_sourceFile = source; }
 	
 	inline void SetInsufficient(const bool bval) { m_bInsufficient = bval; }
 
@@ -380,8 +427,8 @@ public:
 	virtual inline double GetLscale() const { return 0; }
 	virtual inline double GetHscale() const { return 0; }
 	virtual inline double GetStdDev() const { return 0; }
-	virtual inline std::string GetTarget() const { return ""; }
-	virtual inline std::string GetTarget2() const { return ""; }
+	virtual inline const std::string& GetTarget() const { return station_name::empty_name(); }
+	virtual inline const std::string& GetTarget2() const { return station_name::empty_name(); }
 	virtual inline float GetTargetHeight() const { return 0; }
 	virtual inline UINT32 GetTotal() const { return 0; }
 	virtual inline double GetValue() const { return 0; }
@@ -409,35 +456,35 @@ public:
 	virtual void SetRecordedTotal(const UINT32&) {}
 	virtual void SetNonIgnoredDirns(const UINT32&) {}
 	virtual void SetClusterID(const UINT32&) {}
-	virtual void SetCoordType(const std::string&) {}
-	virtual void SetHscale(const std::string&) {}
+	virtual void SetCoordType(std::string_view) {}
+	virtual void SetHscale(std::string_view) {}
 	virtual void SetHscale(const double&) {}
-	virtual void SetInstrumentHeight(const std::string&) {}
+	virtual void SetInstrumentHeight(std::string_view) {}
 	
-	virtual void SetReferenceFrame(const std::string&) {}
-	void SetEpoch(const std::string& epoch);
+	virtual void SetReferenceFrame(std::string_view) {}
+	void SetEpoch(std::string_view epoch);
 	
-	virtual void SetLscale(const std::string&) {}
+	virtual void SetLscale(std::string_view) {}
 	virtual void SetLscale(const double&) {}
-	virtual void SetPscale(const std::string&) {}
+	virtual void SetPscale(std::string_view) {}
 	virtual void SetPscale(const double&) {}
-	virtual void SetSigmaXX(const std::string&) {}
-	virtual void SetSigmaXY(const std::string&) {}
-	virtual void SetSigmaXZ(const std::string&) {}
-	virtual void SetSigmaYY(const std::string&) {}
-	virtual void SetSigmaYZ(const std::string&) {}
-	virtual void SetSigmaZZ(const std::string&) {}
-	virtual void SetStdDev(const std::string&) {}
-	virtual void SetTarget(const std::string&) {}
-	virtual void SetTarget2(const std::string&) {}
-	virtual void SetTargetHeight(const std::string&) {}
-	virtual void SetTotal(const std::string&) {}
-	virtual void SetValue(const std::string&) {}
-	virtual void SetVscale(const std::string&) {}
+	virtual void SetSigmaXX(std::string_view) {}
+	virtual void SetSigmaXY(std::string_view) {}
+	virtual void SetSigmaXZ(std::string_view) {}
+	virtual void SetSigmaYY(std::string_view) {}
+	virtual void SetSigmaYZ(std::string_view) {}
+	virtual void SetSigmaZZ(std::string_view) {}
+	virtual void SetStdDev(std::string_view) {}
+	virtual void SetTarget(std::string_view) {}
+	virtual void SetTarget2(std::string_view) {}
+	virtual void SetTargetHeight(std::string_view) {}
+	virtual void SetTotal(std::string_view) {}
+	virtual void SetValue(std::string_view) {}
+	virtual void SetVscale(std::string_view) {}
 	virtual void SetVscale(const double&) {}
-	virtual void SetX(const std::string&) {}
-	virtual void SetY(const std::string&) {}
-	virtual void SetZ(const std::string&) {}
+	virtual void SetX(std::string_view) {}
+	virtual void SetY(std::string_view) {}
+	virtual void SetZ(std::string_view) {}
 
 	virtual void SetXAxis(const double&) {}
 	virtual void SetYAxis(const double&) {}
@@ -454,8 +501,8 @@ public:
 
 	//virtual void coutBaselineData(std::ostream &os, const int& pad, const UINT16& uType = 0) {}
 
-	void SetMeasurementDBID(const std::string& str);
-	void SetClusterDBID(const std::string& str);
+	void SetMeasurementDBID(std::string_view str);
+	void SetClusterDBID(std::string_view str);
 	
 	void SetClusterDBID(const UINT32& u, bool s);
 
@@ -467,11 +514,14 @@ public:
 
 	virtual void SerialiseDatabaseMap(std::ofstream* os);
 
+	// Saves or loads the measurement to or from an image (see dnaioimage.hpp)
+	virtual void SerialiseImage(iostreams::image_archive& ar);
+
 protected:
 	void coutMeasurement(std::ostream &os) const;
 
 public:
-	std::string	m_strFirst;
+	station_name	m_strFirst;
 	MEASUREMENT_STATIONS m_MSmeasurementStations;
 	
 protected:
@@ -23,6 +23,7 @@
 #include <include/measurement_types/dnastation.hpp>
 #include <include/parameters/dnaepsg.hpp>
 #include <include/exception/dnaexception.hpp>
+#include <include/io/dnaioimage.hpp>
 
 using namespace dynadjust::epsg;
 using namespace dynadjust::datum_parameters;
@@ -263,7 +264,7 @@ CDnaStation& CDnaStation::operator =(const CDnaStation& rhs)
 }
 
 
-void CDnaStation::SetConstraints(const std::string& sConstraints)
+void CDnaStation::SetConstraints(std::string_view sConstraints)
 {
 	// capture string, trim whitespace
 	m_strConstraints = trimstr(sConstraints);
@@ -301,13 +302,13 @@ void CDnaStation::SetConstraints(const std::string& sConstraints)
 }
 	
 
-void CDnaStation::SetCoordType(const std::string& sType) {
+void CDnaStation::SetCoordType(std::string_view sType) {
 	m_strType = trimstr(sType);
 	m_ctTypeSupplied = m_ctType = GetMyCoordTypeC();	
 }
 
 // X, Easting, Latitude
-void CDnaStation::SetXAxis(const std::string& str)
+void CDnaStation::SetXAxis(std::string_view str)
 {
 	switch (m_ctType)
 	{
@@ -324,7 +325,7 @@ void CDnaStation::SetXAxis(const std::string& str)
 
 
 // Y, Northing, Longitude
-void CDnaStation::SetYAxis(const std::string& str)
+void CDnaStation::SetYAxis(std::string_view str)
 {
 	switch (m_ctType)
 	{
@@ -340,14 +341,14 @@ void CDnaStation::SetYAxis(const std::string& str)
 
 
 // Z
-void CDnaStation::SetZAxis(const std::string& str)
+void CDnaStation::SetZAxis(std::string_view str)
 {
 	DoubleFromString(m_dZAxis, trimstr(str));
 }
 
 
 // Height
-void CDnaStation::SetHeight(const std::string& str)
+void CDnaStation::SetHeight(std::string_view str)
 {
 	if (GetMyCoordTypeC() == XYZ_type_i)
 		SetZAxis(str);
@@ -356,7 +357,7 @@ void CDnaStation::SetHeight(const std::string& str)
 }
 
 // Hemisphere zone
-void CDnaStation::SetHemisphereZone(const std::string& sHemisphereZone)
+void CDnaStation::SetHemisphereZone(std::string_view sHemisphereZone)
 {
 	m_strHemisphereZone = trimstr(sHemisphereZone);
 	if (m_strHemisphereZone.empty())
@@ -493,7 +494,7 @@ _COORD_TYPE_ CDnaStation::GetMyCoordTypeC() const
 }
 
 
-_HEIGHT_SYSTEM_ CDnaStation::GetHeightSystemC(const std::string& sType) const
+_HEIGHT_SYSTEM_ CDnaStation::GetHeightSystemC(std::string_view sType) const
 {
 	if (sType.compare(ELLIPSOIDAL_type) == 0)
 		return ELLIPSOIDAL_type_i;
@@ -510,7 +511,7 @@ _HEIGHT_SYSTEM_ CDnaStation::GetMyHeightSystemC() const
 
 // SetHeightSystem called by void Height_pimpl::system(const ::std::string& system)
 // where system is an attribute of the element Height (either "ellipsoidal" or "orthometric")
-void CDnaStation::SetHeightSystem(const std::string& sType)
+void CDnaStation::SetHeightSystem(std::string_view sType)
 {
 	SetHeightSystem(GetHeightSystemC(sType));
 }
@@ -975,5 +976,18 @@ std::string CDnaStation::CoordinateName(const char& c)
 	return "";
 }
 
+void CDnaStation::SerialiseImage(iostreams::image_archive& ar)
+{
+	ar & m_strName & m_strOriginalName
+		& m_dXAxis & m_dYAxis & m_dZAxis & m_dHeight
+		& m_dStdDevX & m_dStdDevY & m_dStdDevZ & m_dStdDevHt
+		& m_strConstraints & m_strType & m_strHemisphereZone & m_strDescription & m_strComment
+		& m_cLatConstraint & m_cLonConstraint & m_cHtConstraint
+		& m_ctType & m_ctTypeSupplied & m_htType
+		& m_dcurrentLatitude & m_dcurrentLongitude & m_dcurrentHeight & m_fgeoidSep
+		& m_dmeridianDef & m_dverticalDef & m_lfileOrder & m_lnameOrder & m_zone & m_unusedStation
+		& m_referenceFrame & m_epsgCode & m_epoch & m_constraintType;
+}
+
 }	// namespace measurements
 }	// namespace dynadjust
@@ -61,6 +61,10 @@ using namespace dynadjust::datum_parameters;
 #define XML_INDENT_2 "        "
 #define XML_INDENT_3 "            "
 
+namespace dynadjust { namespace iostreams {
+class image_archive;
+} }
+
 namespace dynadjust { namespace measurements {
 
 class CAStationList;
@@ -202,20 +206,20 @@ public:
 	static bool IsValidConstraint(const std::string& sConst);
 	static _COORD_TYPE_ GetCoordTypeC(const std::string& sType);
 	_COORD_TYPE_ GetMyCoordTypeC() const;
-	_HEIGHT_SYSTEM_ GetHeightSystemC(const std::string& sType) const;
+	_HEIGHT_SYSTEM_ GetHeightSystemC(std::string_view sType) const;
 	_HEIGHT_SYSTEM_ GetMyHeightSystemC() const;
 	inline _HEIGHT_SYSTEM_ GetMyHeightSystem() const { return m_htType;	}
 	
-	void SetHeightSystem(const std::string& sType);
+	void SetHeightSystem(std::string_view sType);
 	void SetHeightSystem(const _HEIGHT_SYSTEM_& type_i);
 
 	void SetStationRec(const station_t& stationRecord);
 
-	void SetXAxis(const std::string& str);
-	void SetYAxis(const std::string& str);
-	void SetZAxis(const std::string& str);
-	void SetHeight(const std::string& str);
-	void SetCoordType(const std::string& sType);
+	void SetXAxis(std::string_view str);
+	void SetYAxis(std::string_view str);
+	void SetZAxis(std::string_view str);
+	void SetHeight(std::string_view str);
+	void SetCoordType(std::string_view sType);
 
 	void ReduceStations_LLH(const CDnaEllipsoid* m_eEllipsoid, const CDnaProjection* m_pProjection);
 	void ReduceStations_XYZ(const CDnaEllipsoid* m_eEllipsoid, const CDnaProjection* m_pProjection);
@@ -229,12 +233,12 @@ public:
 	inline void SetHeight_d(const double& dHeight) { m_dHeight = dHeight; }
 	inline void SetcurrentHeight_d(const double& dHeight) { m_dcurrentHeight = dHeight; }
 	
-	inline void SetName(const std::string& sName) { m_strName = trimstr(sName); }
-	inline void SetOriginalName(const std::string& sName) { m_strOriginalName = trimstr(sName); }
+	inline void SetName(std::string_view sName) { m_strName = trimstr(sName); }
+	inline void SetOriginalName(std::string_view sName) { m_strOriginalName = trimstr(sName); }
 	inline void SetOriginalName() { m_strOriginalName = m_strName; }
-	void SetHemisphereZone(const std::string& sHemisphereZone);
-	inline void SetDescription(const std::string& sDescription) { m_strDescription = trimstr(sDescription); }
-	inline void SetComment(const std::string& sComment) { m_strComment = trimstr(sComment); }
+	void SetHemisphereZone(std::string_view sHemisphereZone);
+	inline void SetDescription(std::string_view sDescription) { m_strDescription = trimstr(sDescription); }
+	inline void SetComment(std::string_view sComment) { m_strComment = trimstr(sComment); }
 
 	inline void SetfileOrder(const UINT32& order) { m_lfileOrder = order; }
 	inline void SetnameOrder(const UINT32& order) { m_lnameOrder = order; }
@@ -246,11 +250,11 @@ public:
 	inline void SetStationUnused() { m_unusedStation = true; }
 	inline void SetStationUse(bool use) { m_unusedStation = use; }
 
-	void SetConstraints(const std::string& str);
+	void SetConstraints(std::string_view str);
 
-	void SetXAxisStdDev(const std::string& str);
-	void SetYAxisStdDev(const std::string& str);
-	void SetHeightStdDev(const std::string& str);
+	void SetXAxisStdDev(std::string_view str);
+	void SetYAxisStdDev(std::string_view str);
+	void SetHeightStdDev(std::string_view str);
 
 	void PrepareStnData(double& lat_east_x,	double& lon_north_y, double& ht_zone_z,
 		std::string& hemisphereZone, std::string& coordinateType,
@@ -283,14 +287,17 @@ public:
 
 	void WriteGeoidfile(std::ofstream* binary_stream);
 
+	// Saves or loads the station to or from an image (see dnaioimage.hpp)
+	void SerialiseImage(iostreams::image_archive& ar);
+
 	static std::string CoordinateName(const char& c);
 
 	inline std::string GetReferenceFrame() const { return m_referenceFrame; }
 	inline std::string GetEpoch() const { return m_epoch; }
 	
-	inline void SetReferenceFrame(const std::string& r) { m_referenceFrame = trimstr(r); }
-	inline void SetEpoch(const std::string& e) { m_epoch = trimstr(e); }
-	inline void SetEpsg(const std::string& e) { m_epsgCode = trimstr(e); }
+	inline void SetReferenceFrame(std::string_view r) { m_referenceFrame = trimstr(r); }
+	inline void SetEpoch(std::string_view e) { m_epoch = trimstr(e); }
+	inline void SetEpsg(std::string_view e) { m_epsgCode = trimstr(e); }
 
 	std::string m_strName;
 
@@ -0,0 +1,250 @@
+//============================================================================
+// Name         : dnamemory_pool.cpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : DynAdjust aligned buffer pool
+//============================================================================
+
+#include <include/memory/dnamemory_pool.hpp>
+
+#include <cstdlib>
+#include <iomanip>
+
+#if defined(_WIN32)
+#include <malloc.h>			// _aligned_malloc
+#else
+#include <sys/mman.h>		// madvise
+#endif
+
+namespace dynadjust { namespace memory {
+
+namespace {
+
+// Buffers of one size class held by one thread
+struct free_list_t
+{
+	free_list_t() : last_used_(0) {}
+
+	std::vector<void*>	buffers_;
+	std::size_t			last_used_;		// generation in which this class was last requested
+};
+
+typedef std::map<std::size_t, free_list_t> free_list_map;
+typedef free_list_map::iterator _it_free_list_map;
+
+buffer_pool_stats pool_stats_;
+
+// Default: 256 MB per thread
+std::atomic<std::size_t> pool_cache_limit_(256 * 1048576);
+
+void* system_allocate(const std::size_t& bytes)
+{
+	void* buffer(0);
+
+#if defined(_WIN32)
+	buffer = _aligned_malloc(bytes, POOL_ALIGNMENT);
+#else
+	// Align large buffers on a huge page boundary
+	std::size_t alignment(bytes >= POOL_HUGE_PAGE ? POOL_HUGE_PAGE : POOL_ALIGNMENT);
+	if (posix_memalign(&buffer, alignment, bytes) != 0)
+		return 0;
+#if defined(MADV_HUGEPAGE)
+	if (bytes >= POOL_HUGE_PAGE)
+		madvise(buffer, bytes, MADV_HUGEPAGE);
+#endif
+#endif
+
+	if (buffer != 0)
+		pool_stats_.system_allocs_++;
+	return buffer;
+}
+
+void system_free(void* buffer)
+{
+#if defined(_WIN32)
+	_aligned_free(buffer);
+#else
+	free(buffer);
+#endif
+	pool_stats_.system_frees_++;
+}
+
+// Free lists owned by one thread.  Buffers remaining on the lists
+// are returned to the system when the thread exits.
+class thread_cache
+{
+public:
+	thread_cache() : cached_bytes_(0), generation_(0) {}
+	~thread_cache() { release(); }
+
+	void release()
+	{
+		for (_it_free_list_map it = lists_.begin(); it != lists_.end(); ++it)
+			release(it);
+		lists_.clear();
+		cached_bytes_ = 0;
+	}
+
+	void release(_it_free_list_map& it)
+	{
+		std::vector<void*>::iterator _it_buf;
+		for (_it_buf = it->second.buffers_.begin(); _it_buf != it->second.buffers_.end(); ++_it_buf)
+			system_free(*_it_buf);
+		cached_bytes_ -= it->first * it->second.buffers_.size();
+		it->second.buffers_.clear();
+	}
+
+	free_list_map	lists_;
+	std::size_t		cached_bytes_;
+	std::size_t		generation_;
+};
+
+thread_local thread_cache pool_cache_;
+
+}	// namespace
+
+
+std::string buffer_pool_stats::summary() const
+{
+	std::stringstream ss;
+	std::size_t hits(pool_hits_), reqs(requests_);
+
+	ss << "Matrix buffer pool: " << reqs << " requests, " <<
+		hits << " recycled (" << std::fixed << std::setprecision(1) <<
+		(reqs > 0 ? 100. * hits / reqs : 0.) << "%), " <<
+		system_allocs_ << " system allocations, " <<
+		system_frees_ << " system frees, " <<
+		std::setprecision(2) << (static_cast<double>(bytes_requested_) / 1048576.) << " MB requested.";
+	return ss.str();
+}
+
+
+std::size_t buffer_pool::size_class(const std::size_t& bytes)
+{
+	// Small buffers: multiples of the alignment
+	if (bytes <= 4 * POOL_ALIGNMENT)
+		return (bytes == 0 ? POOL_ALIGNMENT :
+			((bytes + POOL_ALIGNMENT - 1) / POOL_ALIGNMENT) * POOL_ALIGNMENT);
+
+	// Large buffers: multiples of a huge page
+	if (bytes >= POOL_HUGE_PAGE)
+		return ((bytes + POOL_HUGE_PAGE - 1) / POOL_HUGE_PAGE) * POOL_HUGE_PAGE;
+
+	// Otherwise, four classes per power of two, which limits
+	// unused space to 25% of the buffer
+	std::size_t power(POOL_ALIGNMENT);
+	while (power * 2 < bytes)
+		power *= 2;
+	std::size_t step(power / 4);
+	return ((bytes + step - 1) / step) * step;
+}
+
+
+void* buffer_pool::allocate(const std::size_t& bytes)
+{
+	std::size_t sc(size_class(bytes));
+
+	pool_stats_.requests_++;
+	pool_stats_.bytes_requested_ += bytes;
+
+	free_list_t& list = pool_cache_.lists_[sc];
+	list.last_used_ = pool_cache_.generation_;
+
+	if (!list.buffers_.empty())
+	{
+		void* buffer(list.buffers_.back());
+		list.buffers_.pop_back();
+		pool_cache_.cached_bytes_ -= sc;
+		pool_stats_.pool_hits_++;
+		return buffer;
+	}
+
+	void* buffer(system_allocate(sc));
+	if (buffer == 0)
+	{
+		// Give cached memory back to the system and try again
+		release();
+		buffer = system_allocate(sc);
+	}
+	return buffer;
+}
+
+
+void buffer_pool::deallocate(void* buffer, const std::size_t& bytes)
+{
+	if (buffer == 0)
+		return;
+
+	std::size_t sc(size_class(bytes));
+
+	if (pool_cache_.cached_bytes_ + sc > pool_cache_limit_)
+	{
+		system_free(buffer);
+		return;
+	}
+
+	pool_cache_.lists_[sc].buffers_.push_back(buffer);
+	pool_cache_.cached_bytes_ += sc;
+}
+
+
+void buffer_pool::reset()
+{
+	_it_free_list_map it(pool_cache_.lists_.begin());
+	while (it != pool_cache_.lists_.end())
+	{
+		// Keep classes requested during this generation
+		if (it->second.last_used_ == pool_cache_.generation_)
+		{
+			++it;
+			continue;
+		}
+
+		pool_cache_.release(it);
+		it = pool_cache_.lists_.erase(it);
+	}
+
+	pool_cache_.generation_++;
+}
+
+
+void buffer_pool::release()
+{
+	pool_cache_.release();
+}
+
+
+void buffer_pool::set_cache_limit(const std::size_t& bytes)
+{
+	pool_cache_limit_ = bytes;
+}
+
+
+std::size_t buffer_pool::cache_limit()
+{
+	return pool_cache_limit_;
+}
+
+
+const buffer_pool_stats& buffer_pool::stats()
+{
+	return pool_stats_;
+}
+
+}	// namespace memory
+}	// namespace dynadjust
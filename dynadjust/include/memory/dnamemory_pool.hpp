@@ -0,0 +1,105 @@
+//============================================================================
+// Name         : dnamemory_pool.hpp
+// Author       : Roger Fraser
+// Contributors :
+// Version      : 1.00
+// Copyright    : Copyright 2017 Geoscience Australia
+//
+//                Licensed under the Apache License, Version 2.0 (the "License");
+//                you may not use this file except in compliance with the License.
+//                You may obtain a copy of the License at
+//
+//                http ://www.apache.org/licenses/LICENSE-2.0
+//
+//                Unless required by applicable law or agreed to in writing, software
+//                distributed under the License is distributed on an "AS IS" BASIS,
+//                WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//                See the License for the specific language governing permissions and
+//                limitations under the License.
+//
+// Description  : Interface for DynAdjust aligned buffer pool
+//                Buffers are 64-byte (cache line / AVX-512) aligned and are
+//                grouped into size classes.  Freed buffers are retained on
+//                a thread-local free list and recycled by the next request
+//                for the same size class, which avoids repeated system
+//                allocations for matrices of the same dimensions (e.g. the
+//                design, AtVinv and normals of a block on every iteration).
+//============================================================================
+
+#ifndef DNAMEMORY_POOL_H_
+#define DNAMEMORY_POOL_H_
+
+#if defined(_MSC_VER)
+	#if defined(LIST_INCLUDES_ON_BUILD)
+		#pragma message("  " __FILE__)
+	#endif
+#endif
+
+#include <cstddef>
+#include <atomic>
+#include <map>
+#include <vector>
+#include <sstream>
+#include <string>
+
+namespace dynadjust { namespace memory {
+
+// Alignment of all buffers (bytes)
+const std::size_t POOL_ALIGNMENT = 64;
+// Size classes above this size are multiples of POOL_HUGE_PAGE
+// and are advised to use transparent huge pages (Linux)
+const std::size_t POOL_HUGE_PAGE = 2097152;				// 2 MB
+
+// Allocation statistics (all threads)
+class buffer_pool_stats
+{
+public:
+	buffer_pool_stats()
+		: requests_(0), pool_hits_(0), system_allocs_(0), system_frees_(0)
+		, bytes_requested_(0) {}
+
+	std::string summary() const;
+
+	std::atomic<std::size_t> requests_;			// number of allocate() calls
+	std::atomic<std::size_t> pool_hits_;		// requests satisfied from a free list
+	std::atomic<std::size_t> system_allocs_;	// requests passed to the system allocator
+	std::atomic<std::size_t> system_frees_;		// buffers returned to the system
+	std::atomic<std::size_t> bytes_requested_;	// total bytes requested
+};
+
+class buffer_pool
+{
+public:
+	// Returns a zero-offset, POOL_ALIGNMENT aligned buffer of at least
+	// bytes size, or NULL if the system cannot supply the memory.
+	static void* allocate(const std::size_t& bytes);
+
+	// Returns buffer (of the requested size bytes) to this thread's
+	// free list.
+	static void deallocate(void* buffer, const std::size_t& bytes);
+
+	// Arena reset.  To be called once per iteration (by each thread which
+	// allocates matrices).  Free lists for size classes which were not
+	// requested since the previous reset are returned to the system, so
+	// that the cache follows the working set of the current iteration.
+	static void reset();
+
+	// Returns all buffers held on this thread's free lists to the system
+	static void release();
+
+	// Sets the maximum number of bytes which may be held on the free
+	// lists of one thread.  Buffers freed beyond this limit are returned
+	// to the system.  A limit of zero disables pooling.
+	static void set_cache_limit(const std::size_t& bytes);
+	static std::size_t cache_limit();
+
+	static const buffer_pool_stats& stats();
+
+	// Rounds bytes up to its size class
+	static std::size_t size_class(const std::size_t& bytes);
+};
+
+}	// namespace memory
+}	// namespace dynadjust
+
+#endif	// DNAMEMORY_POOL_H_